@@ -0,0 +1,345 @@
+//===============================================================================
+// @ Benchmark.cpp
+// ------------------------------------------------------------------------------
+// Accuracy and throughput of the vectorized transcendental functions
+//
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Evaluates each function in IvSIMDMath.h over a range of inputs and
+// compares it with the double precision C library for the maximum absolute,
+// relative and ulp error, then times it against the float C library
+// function applied one value at a time.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <IvSIMDMath.h>
+
+#include "BenchmarkTimer.h"
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+volatile float gBenchmarkSink = 0.0f;
+
+#if defined(IV_SSE2)
+
+#if defined(IV_AVX)
+typedef __m256 Lanes;
+#else
+typedef __m128 Lanes;
+#endif
+static const unsigned int kLanes = sizeof(Lanes)/sizeof(float);
+
+// inputs per pass; small enough to stay in cache
+static const unsigned int kCount = 4096;
+static const unsigned int kPasses = 2000;
+
+IV_ALIGN(32) static float sX[kCount];
+IV_ALIGN(32) static float sY[kCount];
+IV_ALIGN(32) static float sResult0[kCount];
+IV_ALIGN(32) static float sResult1[kCount];
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+struct Function
+{
+    const char* name;
+    float       xMin, xMax;         // range of x
+    float       yMin, yMax;         // range of y, for two-argument functions
+    bool        logarithmic;        // sample x evenly in log space
+
+    void        (*simd)( unsigned int count );      // into sResult0/1
+    void        (*libm)( unsigned int count );      // float C library
+    double      (*reference)( double x, double y ); // double C library
+    double      (*reference1)( double x, double y );// second result, or 0
+};
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ Lane-wide loops
+//-------------------------------------------------------------------------------
+// Apply each function to the first count inputs
+//-------------------------------------------------------------------------------
+static void SIMDSin( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; i += kLanes )
+        IvStore( &sResult0[i], IvSin( IvLoad<Lanes>( &sX[i] ) ) );
+}
+static void SIMDCos( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; i += kLanes )
+        IvStore( &sResult0[i], IvCos( IvLoad<Lanes>( &sX[i] ) ) );
+}
+static void SIMDSinCos( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; i += kLanes )
+    {
+        Lanes sina, cosa;
+        IvSinCos( IvLoad<Lanes>( &sX[i] ), sina, cosa );
+        IvStore( &sResult0[i], sina );
+        IvStore( &sResult1[i], cosa );
+    }
+}
+static void SIMDACos( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; i += kLanes )
+        IvStore( &sResult0[i], IvACos( IvLoad<Lanes>( &sX[i] ) ) );
+}
+static void SIMDATan2( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; i += kLanes )
+        IvStore( &sResult0[i], IvATan2( IvLoad<Lanes>( &sY[i] ), IvLoad<Lanes>( &sX[i] ) ) );
+}
+static void SIMDRecipSqrt( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; i += kLanes )
+        IvStore( &sResult0[i], IvRecipSqrt( IvLoad<Lanes>( &sX[i] ) ) );
+}
+static void SIMDExp( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; i += kLanes )
+        IvStore( &sResult0[i], IvExp( IvLoad<Lanes>( &sX[i] ) ) );
+}
+
+//-------------------------------------------------------------------------------
+// @ C library loops
+//-------------------------------------------------------------------------------
+// The same, one value at a time
+//-------------------------------------------------------------------------------
+static void LibmSin( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; ++i )
+        sResult0[i] = sinf( sX[i] );
+}
+static void LibmCos( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; ++i )
+        sResult0[i] = cosf( sX[i] );
+}
+static void LibmSinCos( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        sResult0[i] = sinf( sX[i] );
+        sResult1[i] = cosf( sX[i] );
+    }
+}
+static void LibmACos( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; ++i )
+        sResult0[i] = acosf( sX[i] );
+}
+static void LibmATan2( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; ++i )
+        sResult0[i] = atan2f( sY[i], sX[i] );
+}
+static void LibmRecipSqrt( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; ++i )
+        sResult0[i] = 1.0f/sqrtf( sX[i] );
+}
+static void LibmExp( unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; ++i )
+        sResult0[i] = expf( sX[i] );
+}
+
+//-------------------------------------------------------------------------------
+// @ Reference functions
+//-------------------------------------------------------------------------------
+// Double precision results to measure against
+//-------------------------------------------------------------------------------
+static double RefSin( double x, double )        { return sin( x ); }
+static double RefCos( double x, double )        { return cos( x ); }
+static double RefACos( double x, double )       { return acos( x ); }
+static double RefATan2( double x, double y )    { return atan2( y, x ); }
+static double RefRecipSqrt( double x, double )  { return 1.0/sqrt( x ); }
+static double RefExp( double x, double )        { return exp( x ); }
+
+//-------------------------------------------------------------------------------
+// @ Ulp()
+//-------------------------------------------------------------------------------
+// Spacing of floats at the reference value
+//-------------------------------------------------------------------------------
+static double
+Ulp( double reference )
+{
+    float magnitude = (float) fabs( reference );
+    if ( magnitude < 1.17549435e-38f )
+        magnitude = 1.17549435e-38f;
+    return (double) nextafterf( magnitude, 3.4e38f ) - (double) magnitude;
+
+}   // End of Ulp()
+
+//-------------------------------------------------------------------------------
+// @ Fill()
+//-------------------------------------------------------------------------------
+// Spread the inputs over the function's range.  x is stepped evenly so the
+// whole range is covered, and y is random so the pairs mix.
+//-------------------------------------------------------------------------------
+static void
+Fill( const Function& function, unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        double t = (i + 0.5)/count;
+        if ( function.logarithmic )
+            sX[i] = (float) exp( log( function.xMin ) + t*(log( function.xMax ) - log( function.xMin )) );
+        else
+            sX[i] = (float) (function.xMin + t*(function.xMax - function.xMin));
+        sY[i] = function.yMin + (function.yMax - function.yMin)*(float) rand()/(float) RAND_MAX;
+    }
+
+}   // End of Fill()
+
+//-------------------------------------------------------------------------------
+// @ Accumulate()
+//-------------------------------------------------------------------------------
+// Update the maximum errors of one result against its reference
+//-------------------------------------------------------------------------------
+static void
+Accumulate( float result, double reference,
+            double& absError, double& relError, double& ulpError )
+{
+    double error = fabs( (double) result - reference );
+    if ( error > absError )
+        absError = error;
+    if ( reference != 0.0 && error/fabs( reference ) > relError )
+        relError = error/fabs( reference );
+    if ( error/Ulp( reference ) > ulpError )
+        ulpError = error/Ulp( reference );
+
+}   // End of Accumulate()
+
+//-------------------------------------------------------------------------------
+// @ Measure()
+//-------------------------------------------------------------------------------
+// Print the errors and throughput of one function
+//-------------------------------------------------------------------------------
+static void
+Measure( const Function& function )
+{
+    // accuracy, over many more inputs than fit in one pass
+    double absError = 0.0, relError = 0.0, ulpError = 0.0;
+    for ( unsigned int block = 0; block < 256; ++block )
+    {
+        Function part = function;
+        if ( !function.logarithmic )
+        {
+            float width = (function.xMax - function.xMin)/256.0f;
+            part.xMin = function.xMin + block*width;
+            part.xMax = part.xMin + width;
+        }
+        else
+        {
+            double ratio = pow( (double) function.xMax/function.xMin, 1.0/256.0 );
+            part.xMin = (float) (function.xMin*pow( ratio, (double) block ));
+            part.xMax = (float) (part.xMin*ratio);
+        }
+        Fill( part, kCount );
+        function.simd( kCount );
+        for ( unsigned int i = 0; i < kCount; ++i )
+        {
+            Accumulate( sResult0[i], function.reference( sX[i], sY[i] ),
+                        absError, relError, ulpError );
+            if ( function.reference1 )
+                Accumulate( sResult1[i], function.reference1( sX[i], sY[i] ),
+                            absError, relError, ulpError );
+        }
+    }
+
+    // throughput
+    Fill( function, kCount );
+    double simdSeconds = BenchmarkSeconds( [&]() {
+        for ( unsigned int pass = 0; pass < kPasses; ++pass )
+        {
+            function.simd( kCount );
+            gBenchmarkSink = sResult0[pass % kCount];
+        }
+    } );
+    double libmSeconds = BenchmarkSeconds( [&]() {
+        for ( unsigned int pass = 0; pass < kPasses; ++pass )
+        {
+            function.libm( kCount );
+            gBenchmarkSink = sResult0[pass % kCount];
+        }
+    } );
+    double values = (double) kCount*kPasses;
+
+    printf( "%-10s %10.2e %10.2e %8.1f %10.1f %10.1f %8.2fx\n", function.name,
+            absError, relError, ulpError,
+            values/simdSeconds*1.0e-6, values/libmSeconds*1.0e-6,
+            libmSeconds/simdSeconds );
+
+}   // End of Measure()
+
+#endif
+
+//-------------------------------------------------------------------------------
+// @ main()
+//-------------------------------------------------------------------------------
+// Measure each function in turn
+//-------------------------------------------------------------------------------
+int
+main( int, char*[] )
+{
+#if defined(IV_SSE2)
+    // sin and cos are measured where the header quotes them, |x| < 100;
+    // sincos error is the worse of the two results
+    const Function functions[] =
+    {
+        { "sin",    -100.0f, 100.0f, 0.0f, 0.0f, false, SIMDSin, LibmSin, RefSin, 0 },
+        { "cos",    -100.0f, 100.0f, 0.0f, 0.0f, false, SIMDCos, LibmCos, RefCos, 0 },
+        { "sincos", -100.0f, 100.0f, 0.0f, 0.0f, false, SIMDSinCos, LibmSinCos, RefSin, RefCos },
+        { "acos",   -1.0f, 1.0f, 0.0f, 0.0f, false, SIMDACos, LibmACos, RefACos, 0 },
+        { "atan2",  -10.0f, 10.0f, -10.0f, 10.0f, false, SIMDATan2, LibmATan2, RefATan2, 0 },
+        { "rsqrt",  1.0e-6f, 1.0e6f, 0.0f, 0.0f, true, SIMDRecipSqrt, LibmRecipSqrt, RefRecipSqrt, 0 },
+        { "exp",    -80.0f, 80.0f, 0.0f, 0.0f, false, SIMDExp, LibmExp, RefExp, 0 },
+    };
+
+    printf( "%u lanes", kLanes );
+#if defined(IV_FMA)
+    printf( ", FMA" );
+#endif
+#if defined(IV_APPROX_SQRT)
+    printf( ", IV_APPROX_SQRT" );
+#endif
+#if defined(IV_APPROX_TRIG)
+    printf( ", IV_APPROX_TRIG" );
+#endif
+#if defined(IV_APPROX_EXP)
+    printf( ", IV_APPROX_EXP" );
+#endif
+    printf( "\n\n%-10s %10s %10s %8s %10s %10s %9s\n", "function",
+            "max abs", "max rel", "max ulp", "SIMD M/s", "libm M/s", "speedup" );
+
+    for ( unsigned int i = 0; i < sizeof(functions)/sizeof(functions[0]); ++i )
+    {
+        Measure( functions[i] );
+    }
+#else
+    printf( "Built with IV_NO_SIMD; there are no vectorized functions to measure.\n" );
+#endif
+
+    return 0;
+
+}   // End of main()
@@ -0,0 +1,199 @@
+//===============================================================================
+// @ Benchmark.cpp
+// ------------------------------------------------------------------------------
+// Throughput of the batched ray-triangle intersection tests
+//
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Finds the nearest triangle hit by each of a set of rays three ways: the
+// scalar TriangleIntersect() against each triangle in turn, each ray against
+// an IvTriangleStream, and the whole stream of rays against each triangle.
+// Prints rays per second for each, after checking they agree.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include <IvRay3.h>
+#include <IvTriangle.h>
+#include <IvTriangleStream.h>
+#include <IvVec3Stream.h>
+
+#include "BenchmarkTimer.h"
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+volatile float gBenchmarkSink = 0.0f;
+
+static const unsigned int kTriangles = 512;
+static const unsigned int kRays = 1024;
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ Random()
+//-------------------------------------------------------------------------------
+// Random point in the box [-extent,extent]^3
+//-------------------------------------------------------------------------------
+static IvVector3
+Random( float extent )
+{
+    float x = (2.0f*rand()/RAND_MAX - 1.0f)*extent;
+    float y = (2.0f*rand()/RAND_MAX - 1.0f)*extent;
+    float z = (2.0f*rand()/RAND_MAX - 1.0f)*extent;
+    return IvVector3( x, y, z );
+
+}   // End of Random()
+
+//-------------------------------------------------------------------------------
+// @ ScalarNearest()
+//-------------------------------------------------------------------------------
+// Nearest hit for each ray, one triangle at a time
+//-------------------------------------------------------------------------------
+static void
+ScalarNearest( IvTriangleHit* hits, const std::vector<IvRay3>& rays,
+               const std::vector<IvVector3>& vertices )
+{
+    for ( unsigned int r = 0; r < kRays; ++r )
+    {
+        hits[r] = IvTriangleHit();
+        for ( unsigned int i = 0; i < kTriangles; ++i )
+        {
+            float t;
+            if ( TriangleIntersect( t, vertices[3*i], vertices[3*i+1], vertices[3*i+2], rays[r] )
+                 && t < hits[r].t )
+            {
+                hits[r].t = t;
+                hits[r].index = (int) i;
+            }
+        }
+    }
+
+}   // End of ScalarNearest()
+
+//-------------------------------------------------------------------------------
+// @ Mismatches()
+//-------------------------------------------------------------------------------
+// Number of rays whose nearest triangle differs from the scalar result
+//-------------------------------------------------------------------------------
+static unsigned int
+Mismatches( const IvTriangleHit* hits, const IvTriangleHit* expected )
+{
+    unsigned int count = 0;
+    for ( unsigned int r = 0; r < kRays; ++r )
+    {
+        if ( hits[r].index != expected[r].index )
+            ++count;
+    }
+
+    return count;
+
+}   // End of Mismatches()
+
+//-------------------------------------------------------------------------------
+// @ main()
+//-------------------------------------------------------------------------------
+// Build the scene and time each method
+//-------------------------------------------------------------------------------
+int
+main( int, char*[] )
+{
+    srand( 1 );
+
+    // small triangles scattered through a box, and rays crossing it
+    std::vector<IvVector3> vertices( 3*kTriangles );
+    IvTriangleStream triangles( kTriangles );
+    for ( unsigned int i = 0; i < kTriangles; ++i )
+    {
+        IvVector3 center = Random( 10.0f );
+        vertices[3*i] = center + Random( 1.5f );
+        vertices[3*i+1] = center + Random( 1.5f );
+        vertices[3*i+2] = center + Random( 1.5f );
+        triangles.Set( i, vertices[3*i], vertices[3*i+1], vertices[3*i+2] );
+    }
+
+    std::vector<IvRay3> rays( kRays );
+    IvVec3Stream origins( kRays );
+    IvVec3Stream directions( kRays );
+    for ( unsigned int r = 0; r < kRays; ++r )
+    {
+        IvVector3 origin = Random( 15.0f );
+        IvVector3 direction = Random( 10.0f ) - origin;
+        direction.Normalize();
+        rays[r].Set( origin, direction );
+        origins.Set( r, origin );
+        directions.Set( r, direction );
+    }
+
+    std::vector<IvTriangleHit> scalarHits( kRays );
+    std::vector<IvTriangleHit> streamHits( kRays );
+    std::vector<IvTriangleHit> packetHits( kRays );
+
+    // scalar
+    double scalarSeconds = BenchmarkSeconds( [&]() {
+        ScalarNearest( &scalarHits[0], rays, vertices );
+        gBenchmarkSink = scalarHits[0].t;
+    } );
+
+    // one ray against the triangle stream
+    double streamSeconds = BenchmarkSeconds( [&]() {
+        for ( unsigned int r = 0; r < kRays; ++r )
+        {
+            streamHits[r] = IvTriangleHit();
+            TriangleIntersect( streamHits[r], rays[r], triangles );
+        }
+        gBenchmarkSink = streamHits[0].t;
+    } );
+
+    // the ray stream against one triangle at a time
+    double packetSeconds = BenchmarkSeconds( [&]() {
+        for ( unsigned int r = 0; r < kRays; ++r )
+        {
+            packetHits[r] = IvTriangleHit();
+        }
+        for ( unsigned int i = 0; i < kTriangles; ++i )
+        {
+            TriangleIntersect( &packetHits[0], origins, directions,
+                               vertices[3*i], vertices[3*i+1], vertices[3*i+2], (int) i );
+        }
+        gBenchmarkSink = packetHits[0].t;
+    } );
+
+    unsigned int hitCount = 0;
+    for ( unsigned int r = 0; r < kRays; ++r )
+    {
+        if ( scalarHits[r].index >= 0 )
+            ++hitCount;
+    }
+
+    printf( "%u rays against %u triangles, %u rays hit\n\n", kRays, kTriangles, hitCount );
+    printf( "%-24s %12s %14s %9s %11s\n", "method", "rays/s", "tests/s", "speedup", "mismatches" );
+    const char* names[3] = { "scalar", "1 ray vs SoA triangles", "ray stream vs 1 triangle" };
+    double seconds[3] = { scalarSeconds, streamSeconds, packetSeconds };
+    unsigned int mismatches[3] = { 0, Mismatches( &streamHits[0], &scalarHits[0] ),
+                                   Mismatches( &packetHits[0], &scalarHits[0] ) };
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        printf( "%-24s %12.0f %14.0f %8.2fx %11u\n", names[i],
+                kRays/seconds[i], (double) kRays*kTriangles/seconds[i],
+                scalarSeconds/seconds[i], mismatches[i] );
+    }
+
+    return 0;
+
+}   // End of main()
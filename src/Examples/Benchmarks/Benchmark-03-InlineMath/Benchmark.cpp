@@ -0,0 +1,259 @@
+//===============================================================================
+// @ Benchmark.cpp
+// ------------------------------------------------------------------------------
+// Cost of the IvMath operators, in the library or inlined
+//
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Times loops over arrays of vectors, quaternions and matrices, one operator
+// per loop, and a loop that propagates transforms down a hierarchy the way
+// IvHierarchy::UpdateWorldTransforms() does.  Whether the operators are
+// inlined is fixed when the libraries are built, so build and run this once
+// with INLINEMATH=False and once with INLINEMATH=True and compare.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <IvAffine34.h>
+#include <IvBoundingSphere.h>
+#include <IvCapsule.h>
+#include <IvMatrix44.h>
+#include <IvQuat.h>
+#include <IvVector3.h>
+
+#include "BenchmarkTimer.h"
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+volatile float gBenchmarkSink = 0.0f;
+
+// elements per pass; small enough to stay in cache
+static const unsigned int kCount = 1024;
+static const unsigned int kPasses = 2000;
+
+static IvVector3 sVectorA[kCount];
+static IvVector3 sVectorB[kCount];
+static IvVector3 sVectorResult[kCount];
+static float sScalarResult[kCount];
+static IvQuat sQuatA[kCount];
+static IvQuat sQuatB[kCount];
+static IvQuat sQuatResult[kCount];
+static IvMatrix44 sMatrixA[kCount];
+static IvMatrix44 sMatrixB[kCount];
+static IvMatrix44 sMatrixResult[kCount];
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// as in IvHierarchy
+struct Transform
+{
+    IvVector3 mTranslate;
+    float     mScale;
+    IvQuat    mRotate;
+};
+
+static unsigned char sParents[kCount];
+static Transform sLocalTransforms[kCount];
+static Transform sWorldTransforms[kCount];
+static IvAffine34 sWorldMatrices[kCount];
+static IvCapsule sLocalCapsules[kCount];
+static IvCapsule sWorldCapsules[kCount];
+static IvBoundingSphere sWorldSpheres[kCount];
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ Random()
+//-------------------------------------------------------------------------------
+// Random value in [-1,1]
+//-------------------------------------------------------------------------------
+static float
+Random()
+{
+    return 2.0f*rand()/RAND_MAX - 1.0f;
+
+}   // End of Random()
+
+//-------------------------------------------------------------------------------
+// @ RandomRotation()
+//-------------------------------------------------------------------------------
+// Random unit quaternion
+//-------------------------------------------------------------------------------
+static IvQuat
+RandomRotation()
+{
+    IvQuat quat( Random(), Random(), Random(), Random() );
+    quat.Normalize();
+    return quat;
+
+}   // End of RandomRotation()
+
+//-------------------------------------------------------------------------------
+// @ UpdateWorldTransforms()
+//-------------------------------------------------------------------------------
+// The body of IvHierarchy::UpdateWorldTransforms(), over kCount nodes
+//-------------------------------------------------------------------------------
+static void
+UpdateWorldTransforms()
+{
+    sWorldTransforms[0] = sLocalTransforms[0];
+    sWorldTransforms[0].mRotate.Normalize();
+    sWorldMatrices[0].Set( sWorldTransforms[0].mScale, sWorldTransforms[0].mRotate,
+                           sWorldTransforms[0].mTranslate );
+    sWorldCapsules[0] = sLocalCapsules[0].Transform( sWorldTransforms[0].mScale,
+                                                     sWorldTransforms[0].mRotate,
+                                                     sWorldTransforms[0].mTranslate );
+    sWorldSpheres[0].SetCenter( sWorldCapsules[0].GetSegment().GetCenter() );
+    sWorldSpheres[0].SetRadius( sWorldCapsules[0].GetSegment().Length()*0.5f
+                                + sWorldCapsules[0].GetRadius() );
+
+    for ( unsigned int i = 1; i < kCount; ++i )
+    {
+        int parent = sParents[i];
+        float parentScale = sWorldTransforms[parent].mScale;
+        sWorldTransforms[i].mTranslate =
+            sWorldTransforms[parent].mRotate.Rotate( sLocalTransforms[i].mTranslate );
+        sWorldTransforms[i].mTranslate *= parentScale;
+        sWorldTransforms[i].mTranslate += sWorldTransforms[parent].mTranslate;
+        sWorldTransforms[i].mScale = sLocalTransforms[i].mScale*parentScale;
+        sWorldTransforms[i].mRotate = sWorldTransforms[parent].mRotate*sLocalTransforms[i].mRotate;
+        sWorldTransforms[i].mRotate.Normalize();
+
+        sWorldMatrices[i].Set( sWorldTransforms[i].mScale, sWorldTransforms[i].mRotate,
+                               sWorldTransforms[i].mTranslate );
+        sWorldCapsules[i] = sLocalCapsules[i].Transform( sWorldTransforms[i].mScale,
+                                                         sWorldTransforms[i].mRotate,
+                                                         sWorldTransforms[i].mTranslate );
+        sWorldSpheres[i].SetCenter( sWorldCapsules[i].GetSegment().GetCenter() );
+        sWorldSpheres[i].SetRadius( sWorldCapsules[i].GetSegment().Length()*0.5f
+                                    + sWorldCapsules[i].GetRadius() );
+    }
+
+    for ( unsigned int i = kCount - 1; i > 0; --i )
+    {
+        int parent = sParents[i];
+        Merge( sWorldSpheres[parent], sWorldSpheres[parent], sWorldSpheres[i] );
+    }
+
+}   // End of UpdateWorldTransforms()
+
+//-------------------------------------------------------------------------------
+// @ Report()
+//-------------------------------------------------------------------------------
+// Time a loop of kCount operations and print nanoseconds per operation
+//-------------------------------------------------------------------------------
+template <class F> static void
+Report( const char* name, F loop )
+{
+    double seconds = BenchmarkSeconds( [&]() {
+        for ( unsigned int pass = 0; pass < kPasses; ++pass )
+        {
+            loop();
+        }
+    } );
+    printf( "%-28s %8.2f\n", name, seconds/((double) kCount*kPasses)*1.0e9 );
+
+}   // End of Report()
+
+//-------------------------------------------------------------------------------
+// @ main()
+//-------------------------------------------------------------------------------
+// Set up the data and time each operation
+//-------------------------------------------------------------------------------
+int
+main( int, char*[] )
+{
+    srand( 1 );
+    for ( unsigned int i = 0; i < kCount; ++i )
+    {
+        sVectorA[i].Set( Random(), Random(), Random() );
+        sVectorB[i].Set( Random(), Random(), Random() );
+        sQuatA[i] = RandomRotation();
+        sQuatB[i] = RandomRotation();
+        sMatrixA[i].Rotation( sQuatA[i] );
+        sMatrixA[i](0,3) = Random();
+        sMatrixB[i].Rotation( sQuatB[i] );
+        sMatrixB[i](1,3) = Random();
+
+        // a wide, shallow tree like a scene graph
+        sParents[i] = (unsigned char) (i == 0 ? 0 : (i - 1)/8);
+        sLocalTransforms[i].mTranslate = sVectorA[i];
+        sLocalTransforms[i].mScale = 1.0f + 0.01f*Random();
+        sLocalTransforms[i].mRotate = sQuatA[i];
+        sLocalCapsules[i] = IvCapsule( sVectorB[i], -sVectorB[i], 0.25f );
+    }
+
+#if defined(IV_INLINE_MATH)
+    printf( "IV_INLINE_MATH: operators inlined\n\n" );
+#else
+    printf( "Operators called from the library\n\n" );
+#endif
+    printf( "%-28s %8s\n", "operation", "ns/op" );
+
+    Report( "IvVector3 +", []() {
+        for ( unsigned int i = 0; i < kCount; ++i )
+            sVectorResult[i] = sVectorA[i] + sVectorB[i];
+        gBenchmarkSink = sVectorResult[0].x;
+    } );
+    Report( "IvVector3 Dot", []() {
+        for ( unsigned int i = 0; i < kCount; ++i )
+            sScalarResult[i] = sVectorA[i].Dot( sVectorB[i] );
+        gBenchmarkSink = sScalarResult[0];
+    } );
+    Report( "IvVector3 Cross", []() {
+        for ( unsigned int i = 0; i < kCount; ++i )
+            sVectorResult[i] = sVectorA[i].Cross( sVectorB[i] );
+        gBenchmarkSink = sVectorResult[0].x;
+    } );
+    Report( "IvVector3 Normalize", []() {
+        for ( unsigned int i = 0; i < kCount; ++i )
+        {
+            sVectorResult[i] = sVectorA[i];
+            sVectorResult[i].Normalize();
+        }
+        gBenchmarkSink = sVectorResult[0].x;
+    } );
+    Report( "IvQuat *", []() {
+        for ( unsigned int i = 0; i < kCount; ++i )
+            sQuatResult[i] = sQuatA[i]*sQuatB[i];
+        gBenchmarkSink = sQuatResult[0].Dot( sQuatResult[0] );
+    } );
+    Report( "IvQuat Rotate", []() {
+        for ( unsigned int i = 0; i < kCount; ++i )
+            sVectorResult[i] = sQuatA[i].Rotate( sVectorA[i] );
+        gBenchmarkSink = sVectorResult[0].x;
+    } );
+    Report( "IvMatrix44 *", []() {
+        for ( unsigned int i = 0; i < kCount; ++i )
+            sMatrixResult[i] = sMatrixA[i]*sMatrixB[i];
+        gBenchmarkSink = sMatrixResult[0](0,0);
+    } );
+    Report( "IvMatrix44 TransformPoint", []() {
+        for ( unsigned int i = 0; i < kCount; ++i )
+            sVectorResult[i] = sMatrixA[i].TransformPoint( sVectorA[i] );
+        gBenchmarkSink = sVectorResult[0].x;
+    } );
+    Report( "UpdateWorldTransforms node", []() {
+        UpdateWorldTransforms();
+        gBenchmarkSink = sWorldSpheres[0].GetRadius();
+    } );
+
+    return 0;
+
+}   // End of main()
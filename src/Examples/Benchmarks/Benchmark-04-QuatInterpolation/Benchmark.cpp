@@ -0,0 +1,234 @@
+//===============================================================================
+// @ Benchmark.cpp
+// ------------------------------------------------------------------------------
+// Speed and accuracy of quaternion Lerp, Slerp and ApproxSlerp
+//
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Interpolates arrays of random unit quaternion pairs with each method, one
+// pair at a time and with the batch functions, using a shared t and a t per
+// pair.  Prints nanoseconds per pair, how far the batch results are from
+// the scalar ones, and how far each method's normalized result is from the
+// scalar Slerp.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <IvQuat.h>
+
+#include "BenchmarkTimer.h"
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+volatile float gBenchmarkSink = 0.0f;
+
+// pairs per pass; small enough to stay in cache
+static const unsigned int kCount = 1024;
+static const unsigned int kPasses = 2000;
+static const float kSharedT = 0.3f;
+
+static IvQuat sStart[kCount];
+static IvQuat sEnd[kCount];
+static float sT[kCount];
+static IvQuat sScalar[kCount];
+static IvQuat sBatch[kCount];
+static IvQuat sReference[kCount];
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+struct Method
+{
+    const char* name;
+    void        (*scalar)( IvQuat&, const IvQuat&, const IvQuat&, float );
+    void        (*shared)( IvQuat*, const IvQuat*, const IvQuat*, float, unsigned int );
+    void        (*perPair)( IvQuat*, const IvQuat*, const IvQuat*, const float*, unsigned int );
+};
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ Random()
+//-------------------------------------------------------------------------------
+// Random value in [-1,1]
+//-------------------------------------------------------------------------------
+static float
+Random()
+{
+    return 2.0f*rand()/RAND_MAX - 1.0f;
+
+}   // End of Random()
+
+//-------------------------------------------------------------------------------
+// @ Method wrappers
+//-------------------------------------------------------------------------------
+// The interpolations are friends of IvQuat, found only through their
+// arguments, so wrap them for the method table
+//-------------------------------------------------------------------------------
+static void ScalarLerp( IvQuat& r, const IvQuat& a, const IvQuat& b, float t )
+    { Lerp( r, a, b, t ); }
+static void SharedLerp( IvQuat* r, const IvQuat* a, const IvQuat* b, float t, unsigned int n )
+    { Lerp( r, a, b, t, n ); }
+static void PerPairLerp( IvQuat* r, const IvQuat* a, const IvQuat* b, const float* t, unsigned int n )
+    { Lerp( r, a, b, t, n ); }
+static void ScalarSlerp( IvQuat& r, const IvQuat& a, const IvQuat& b, float t )
+    { Slerp( r, a, b, t ); }
+static void SharedSlerp( IvQuat* r, const IvQuat* a, const IvQuat* b, float t, unsigned int n )
+    { Slerp( r, a, b, t, n ); }
+static void PerPairSlerp( IvQuat* r, const IvQuat* a, const IvQuat* b, const float* t, unsigned int n )
+    { Slerp( r, a, b, t, n ); }
+static void ScalarApproxSlerp( IvQuat& r, const IvQuat& a, const IvQuat& b, float t )
+    { ApproxSlerp( r, a, b, t ); }
+static void SharedApproxSlerp( IvQuat* r, const IvQuat* a, const IvQuat* b, float t, unsigned int n )
+    { ApproxSlerp( r, a, b, t, n ); }
+static void PerPairApproxSlerp( IvQuat* r, const IvQuat* a, const IvQuat* b, const float* t,
+                                unsigned int n )
+    { ApproxSlerp( r, a, b, t, n ); }
+
+//-------------------------------------------------------------------------------
+// @ Distance()
+//-------------------------------------------------------------------------------
+// Distance between the rotations two quaternions represent, after
+// normalizing.  q and -q are the same rotation, so take the nearer.
+//-------------------------------------------------------------------------------
+static float
+Distance( const IvQuat& quat0, const IvQuat& quat1 )
+{
+    IvQuat a = quat0;
+    IvQuat b = quat1;
+    a.Normalize();
+    b.Normalize();
+    IvQuat difference = a - b;
+    IvQuat sum = a + b;
+    float distanceSq = difference.Dot( difference );
+    float sumSq = sum.Dot( sum );
+    return sqrtf( distanceSq < sumSq ? distanceSq : sumSq );
+
+}   // End of Distance()
+
+//-------------------------------------------------------------------------------
+// @ MaxDistance()
+//-------------------------------------------------------------------------------
+// Largest Distance() between two arrays
+//-------------------------------------------------------------------------------
+static float
+MaxDistance( const IvQuat* quats0, const IvQuat* quats1 )
+{
+    float maxDistance = 0.0f;
+    for ( unsigned int i = 0; i < kCount; ++i )
+    {
+        float distance = Distance( quats0[i], quats1[i] );
+        if ( distance > maxDistance )
+            maxDistance = distance;
+    }
+
+    return maxDistance;
+
+}   // End of MaxDistance()
+
+//-------------------------------------------------------------------------------
+// @ NanosecondsPerPair()
+//-------------------------------------------------------------------------------
+// Time kPasses passes of a loop over all pairs
+//-------------------------------------------------------------------------------
+template <class F> static double
+NanosecondsPerPair( F loop )
+{
+    double seconds = BenchmarkSeconds( [&]() {
+        for ( unsigned int pass = 0; pass < kPasses; ++pass )
+        {
+            loop();
+        }
+    } );
+
+    return seconds/((double) kCount*kPasses)*1.0e9;
+
+}   // End of NanosecondsPerPair()
+
+//-------------------------------------------------------------------------------
+// @ Measure()
+//-------------------------------------------------------------------------------
+// Print the timings and errors of one method
+//-------------------------------------------------------------------------------
+static void
+Measure( const Method& method )
+{
+    double scalarTime = NanosecondsPerPair( [&]() {
+        for ( unsigned int i = 0; i < kCount; ++i )
+            method.scalar( sScalar[i], sStart[i], sEnd[i], sT[i] );
+        gBenchmarkSink = sScalar[0].Dot( sScalar[0] );
+    } );
+    double sharedTime = NanosecondsPerPair( [&]() {
+        method.shared( sBatch, sStart, sEnd, kSharedT, kCount );
+        gBenchmarkSink = sBatch[0].Dot( sBatch[0] );
+    } );
+    double perPairTime = NanosecondsPerPair( [&]() {
+        method.perPair( sBatch, sStart, sEnd, sT, kCount );
+        gBenchmarkSink = sBatch[0].Dot( sBatch[0] );
+    } );
+
+    // sBatch and sScalar both hold the per-pair t results now
+    float batchError = MaxDistance( sBatch, sScalar );
+    float slerpError = MaxDistance( sBatch, sReference );
+
+    printf( "%-12s %9.2f %9.2f %9.2f %8.2fx %12.2e %12.2e\n", method.name,
+            scalarTime, sharedTime, perPairTime, scalarTime/perPairTime,
+            batchError, slerpError );
+
+}   // End of Measure()
+
+//-------------------------------------------------------------------------------
+// @ main()
+//-------------------------------------------------------------------------------
+// Set up the pairs and measure each method
+//-------------------------------------------------------------------------------
+int
+main( int, char*[] )
+{
+    srand( 1 );
+    for ( unsigned int i = 0; i < kCount; ++i )
+    {
+        sStart[i] = IvQuat( Random(), Random(), Random(), Random() );
+        sStart[i].Normalize();
+        sEnd[i] = IvQuat( Random(), Random(), Random(), Random() );
+        sEnd[i].Normalize();
+        sT[i] = 0.5f*(Random() + 1.0f);
+        Slerp( sReference[i], sStart[i], sEnd[i], sT[i] );
+    }
+
+    const Method methods[] =
+    {
+        { "Lerp", ScalarLerp, SharedLerp, PerPairLerp },
+        { "Slerp", ScalarSlerp, SharedSlerp, PerPairSlerp },
+        { "ApproxSlerp", ScalarApproxSlerp, SharedApproxSlerp, PerPairApproxSlerp },
+    };
+
+    printf( "%u random unit quaternion pairs, t in [0,1]\n\n", kCount );
+    printf( "%-12s %9s %9s %9s %9s %12s %12s\n", "method", "scalar",
+            "batch t", "batch t[]", "speedup", "vs scalar", "vs Slerp" );
+    printf( "%-12s %9s %9s %9s %9s %12s %12s\n", "", "ns/pair",
+            "ns/pair", "ns/pair", "", "max dist", "max dist" );
+    for ( unsigned int i = 0; i < sizeof(methods)/sizeof(methods[0]); ++i )
+    {
+        Measure( methods[i] );
+    }
+
+    return 0;
+
+}   // End of main()
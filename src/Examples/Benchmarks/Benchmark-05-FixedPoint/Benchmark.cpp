@@ -0,0 +1,373 @@
+//===============================================================================
+// @ Benchmark.cpp
+// ------------------------------------------------------------------------------
+// Cost and accuracy of the fixed-point types against float
+//
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Runs the same loops with float, IvFixed16 and IvFixed32 scalars, and the
+// vector and quaternion types built on them, and prints nanoseconds per
+// operation.  For the fixed-point types it also prints the largest
+// difference from the float result.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <IvFixed.h>
+#include <IvFixedQuat.h>
+#include <IvFixedVector3.h>
+#include <IvMath.h>
+#include <IvQuat.h>
+#include <IvVector3.h>
+
+#include "BenchmarkTimer.h"
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+volatile float gBenchmarkSink = 0.0f;
+
+// elements per pass; small enough to stay in cache
+static const unsigned int kCount = 1024;
+static const unsigned int kPasses = 2000;
+
+static float sA[kCount];
+static float sB[kCount];            // in [0.5,4], so safe to divide by
+static IvVector3 sVectorA[kCount];
+static IvVector3 sVectorB[kCount];
+static IvQuat sQuatA[kCount];
+static IvQuat sQuatB[kCount];
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// vector and quaternion types for each scalar
+template <class S> struct Types
+{
+    typedef IvFixedVector3<S>   Vector;
+    typedef IvFixedQuat<S>      Quat;
+};
+template <> struct Types<float>
+{
+    typedef IvVector3           Vector;
+    typedef IvQuat              Quat;
+};
+
+// float results, to measure the fixed-point ones against
+struct Results
+{
+    float       scalar[kCount];
+    IvVector3   vector[kCount];
+    IvQuat      quat[kCount];
+};
+
+enum Operation
+{
+    kAdd, kMultiply, kDivide, kSqrt, kBatchAdd, kBatchMultiply, kBatchDot,
+    kVectorDot, kVectorCross, kQuatMultiply, kQuatRotate, kOperationCount
+};
+
+static const char* sOperationNames[kOperationCount] =
+{
+    "scalar +", "scalar *", "scalar /", "IvSqrt", "batch Add", "batch Multiply",
+    "batch Dot", "vector Dot", "vector Cross", "quat *", "quat Rotate"
+};
+
+static Results sReference[kOperationCount];
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ Random()
+//-------------------------------------------------------------------------------
+// Random value in [low,high]
+//-------------------------------------------------------------------------------
+static float
+Random( float low, float high )
+{
+    return low + (high - low)*rand()/RAND_MAX;
+
+}   // End of Random()
+
+//-------------------------------------------------------------------------------
+// @ ToFloat()
+//-------------------------------------------------------------------------------
+// Float version of a result, whichever type it is
+//-------------------------------------------------------------------------------
+static inline float ToFloat( float value )                          { return value; }
+static inline const IvVector3& ToFloat( const IvVector3& value )    { return value; }
+static inline const IvQuat& ToFloat( const IvQuat& value )          { return value; }
+template <class T, int F> static inline float
+ToFloat( const IvFixed<T, F>& value )                               { return value.ToFloat(); }
+template <class S> static inline IvVector3
+ToFloat( const IvFixedVector3<S>& value )                           { return value.ToFloat(); }
+template <class S> static inline IvQuat
+ToFloat( const IvFixedQuat<S>& value )                              { return value.ToFloat(); }
+
+//-------------------------------------------------------------------------------
+// @ Difference()
+//-------------------------------------------------------------------------------
+// Distance between two float results
+//-------------------------------------------------------------------------------
+static float Difference( float a, float b )                     { return fabsf( a - b ); }
+static float Difference( const IvVector3& a, const IvVector3& b )
+{
+    IvVector3 difference = a - b;
+    return sqrtf( difference.Dot( difference ) );
+}
+static float Difference( const IvQuat& a, const IvQuat& b )
+{
+    IvQuat difference = a - b;
+    return sqrtf( difference.Dot( difference ) );
+}
+
+//-------------------------------------------------------------------------------
+// @ Batch operations
+//-------------------------------------------------------------------------------
+// The library's batch functions for the fixed-point types, and the
+// equivalent loops for float
+//-------------------------------------------------------------------------------
+static void BatchAdd( float* result, const float* a, const float* b, unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; ++i )
+        result[i] = a[i] + b[i];
+}
+static void BatchMultiply( float* result, const float* a, const float* b, unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; ++i )
+        result[i] = a[i]*b[i];
+}
+static void BatchDot( float* result, const IvVector3* a, const IvVector3* b, unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; ++i )
+        result[i] = a[i].x*b[i].x + a[i].y*b[i].y + a[i].z*b[i].z;
+}
+template <class S> static void
+BatchAdd( S* result, const S* a, const S* b, unsigned int count )       { Add( result, a, b, count ); }
+template <class S> static void
+BatchMultiply( S* result, const S* a, const S* b, unsigned int count )  { Multiply( result, a, b, count ); }
+template <class S> static void
+BatchDot( S* result, const IvFixedVector3<S>* a, const IvFixedVector3<S>* b, unsigned int count )
+{
+    Dot( result, a, b, count );
+}
+
+//-------------------------------------------------------------------------------
+// @ Time()
+//-------------------------------------------------------------------------------
+// Nanoseconds per element of a loop over kCount elements
+//-------------------------------------------------------------------------------
+template <class L> static double
+Time( L loop )
+{
+    double seconds = BenchmarkSeconds( [&]() {
+        for ( unsigned int pass = 0; pass < kPasses; ++pass )
+        {
+            loop();
+        }
+    } );
+
+    return seconds/((double) kCount*kPasses)*1.0e9;
+
+}   // End of Time()
+
+//-------------------------------------------------------------------------------
+// @ MaxDifference()
+//-------------------------------------------------------------------------------
+// Largest distance between results and the float ones
+//-------------------------------------------------------------------------------
+template <class R, class F> static float
+MaxDifference( const R* results, const F* expected )
+{
+    float maxDifference = 0.0f;
+    for ( unsigned int i = 0; i < kCount; ++i )
+    {
+        float difference = Difference( ToFloat( results[i] ), expected[i] );
+        if ( difference > maxDifference )
+            maxDifference = difference;
+    }
+
+    return maxDifference;
+
+}   // End of MaxDifference()
+
+//-------------------------------------------------------------------------------
+// @ Measure()
+//-------------------------------------------------------------------------------
+// Time each operation on scalar type S.  For float, keep the results as the
+// reference; otherwise compare the results with it.
+//-------------------------------------------------------------------------------
+template <class S> static void
+Measure( double* times, float* errors, bool record )
+{
+    typedef typename Types<S>::Vector Vector;
+    typedef typename Types<S>::Quat Quat;
+
+    static S a[kCount], b[kCount], result[kCount];
+    static Vector vectorA[kCount], vectorB[kCount], vectorResult[kCount];
+    static Quat quatA[kCount], quatB[kCount], quatResult[kCount];
+    for ( unsigned int i = 0; i < kCount; ++i )
+    {
+        a[i] = S( sA[i] );
+        b[i] = S( sB[i] );
+        vectorA[i] = Vector( sVectorA[i] );
+        vectorB[i] = Vector( sVectorB[i] );
+        quatA[i] = Quat( sQuatA[i] );
+        quatB[i] = Quat( sQuatB[i] );
+    }
+
+    for ( unsigned int op = 0; op < kOperationCount; ++op )
+    {
+        bool isVector = false, isQuat = false;
+        switch ( op )
+        {
+        case kAdd:
+            times[op] = Time( [&]() {
+                for ( unsigned int i = 0; i < kCount; ++i ) result[i] = a[i] + b[i];
+                gBenchmarkSink = ToFloat( result[0] );
+            } );
+            break;
+        case kMultiply:
+            times[op] = Time( [&]() {
+                for ( unsigned int i = 0; i < kCount; ++i ) result[i] = a[i]*b[i];
+                gBenchmarkSink = ToFloat( result[0] );
+            } );
+            break;
+        case kDivide:
+            times[op] = Time( [&]() {
+                for ( unsigned int i = 0; i < kCount; ++i ) result[i] = a[i]/b[i];
+                gBenchmarkSink = ToFloat( result[0] );
+            } );
+            break;
+        case kSqrt:
+            times[op] = Time( [&]() {
+                for ( unsigned int i = 0; i < kCount; ++i ) result[i] = IvSqrt( b[i] );
+                gBenchmarkSink = ToFloat( result[0] );
+            } );
+            break;
+        case kBatchAdd:
+            times[op] = Time( [&]() {
+                BatchAdd( result, a, b, kCount );
+                gBenchmarkSink = ToFloat( result[0] );
+            } );
+            break;
+        case kBatchMultiply:
+            times[op] = Time( [&]() {
+                BatchMultiply( result, a, b, kCount );
+                gBenchmarkSink = ToFloat( result[0] );
+            } );
+            break;
+        case kBatchDot:
+            times[op] = Time( [&]() {
+                BatchDot( result, vectorA, vectorB, kCount );
+                gBenchmarkSink = ToFloat( result[0] );
+            } );
+            break;
+        case kVectorDot:
+            times[op] = Time( [&]() {
+                for ( unsigned int i = 0; i < kCount; ++i ) result[i] = vectorA[i].Dot( vectorB[i] );
+                gBenchmarkSink = ToFloat( result[0] );
+            } );
+            break;
+        case kVectorCross:
+            times[op] = Time( [&]() {
+                for ( unsigned int i = 0; i < kCount; ++i ) vectorResult[i] = vectorA[i].Cross( vectorB[i] );
+                gBenchmarkSink = ToFloat( vectorResult[0] ).x;
+            } );
+            isVector = true;
+            break;
+        case kQuatMultiply:
+            times[op] = Time( [&]() {
+                for ( unsigned int i = 0; i < kCount; ++i ) quatResult[i] = quatA[i]*quatB[i];
+                gBenchmarkSink = ToFloat( quatResult[0] ).Dot( ToFloat( quatResult[0] ) );
+            } );
+            isQuat = true;
+            break;
+        case kQuatRotate:
+            times[op] = Time( [&]() {
+                for ( unsigned int i = 0; i < kCount; ++i ) vectorResult[i] = quatA[i].Rotate( vectorA[i] );
+                gBenchmarkSink = ToFloat( vectorResult[0] ).x;
+            } );
+            isVector = true;
+            break;
+        }
+
+        Results& reference = sReference[op];
+        if ( record )
+        {
+            for ( unsigned int i = 0; i < kCount; ++i )
+            {
+                reference.scalar[i] = ToFloat( result[i] );
+                reference.vector[i] = ToFloat( vectorResult[i] );
+                reference.quat[i] = ToFloat( quatResult[i] );
+            }
+            errors[op] = 0.0f;
+        }
+        else if ( isQuat )
+            errors[op] = MaxDifference( quatResult, reference.quat );
+        else if ( isVector )
+            errors[op] = MaxDifference( vectorResult, reference.vector );
+        else
+            errors[op] = MaxDifference( result, reference.scalar );
+    }
+
+}   // End of Measure()
+
+//-------------------------------------------------------------------------------
+// @ main()
+//-------------------------------------------------------------------------------
+// Set up the inputs and measure each type
+//-------------------------------------------------------------------------------
+int
+main( int, char*[] )
+{
+    srand( 1 );
+    for ( unsigned int i = 0; i < kCount; ++i )
+    {
+        sA[i] = Random( -4.0f, 4.0f );
+        sB[i] = Random( 0.5f, 4.0f );
+        sVectorA[i].Set( Random( -4.0f, 4.0f ), Random( -4.0f, 4.0f ), Random( -4.0f, 4.0f ) );
+        sVectorB[i].Set( Random( -4.0f, 4.0f ), Random( -4.0f, 4.0f ), Random( -4.0f, 4.0f ) );
+        sQuatA[i] = IvQuat( Random( -1.0f, 1.0f ), Random( -1.0f, 1.0f ),
+                            Random( -1.0f, 1.0f ), Random( -1.0f, 1.0f ) );
+        sQuatA[i].Normalize();
+        sQuatB[i] = IvQuat( Random( -1.0f, 1.0f ), Random( -1.0f, 1.0f ),
+                            Random( -1.0f, 1.0f ), Random( -1.0f, 1.0f ) );
+        sQuatB[i].Normalize();
+    }
+
+    double floatTimes[kOperationCount], fixed16Times[kOperationCount], fixed32Times[kOperationCount];
+    float floatErrors[kOperationCount], fixed16Errors[kOperationCount], fixed32Errors[kOperationCount];
+    Measure<float>( floatTimes, floatErrors, true );
+    Measure<IvFixed16>( fixed16Times, fixed16Errors, false );
+    Measure<IvFixed32>( fixed32Times, fixed32Errors, false );
+
+    printf( "%-16s %8s %10s %10s %10s %10s\n", "", "float", "IvFixed16", "IvFixed32",
+            "IvFixed16", "IvFixed32" );
+    printf( "%-16s %8s %10s %10s %10s %10s\n", "operation", "ns/op", "ns/op", "ns/op",
+            "max diff", "max diff" );
+    for ( unsigned int op = 0; op < kOperationCount; ++op )
+    {
+        printf( "%-16s %8.2f %10.2f %10.2f %10.2e %10.2e\n", sOperationNames[op],
+                floatTimes[op], fixed16Times[op], fixed32Times[op],
+                fixed16Errors[op], fixed32Errors[op] );
+    }
+
+    return 0;
+
+}   // End of main()
@@ -0,0 +1,61 @@
+//===============================================================================
+// @ BenchmarkTimer.h
+// ------------------------------------------------------------------------------
+// Wall clock timing shared by the benchmarks
+//
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// IvClock only has millisecond resolution and needs the platform layer, so
+// the benchmarks use the standard library's steady clock instead.  Each
+// measurement is repeated and the fastest run kept, which discards runs
+// that were interrupted.
+//
+//===============================================================================
+
+#ifndef __BenchmarkTimer__h__
+#define __BenchmarkTimer__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <chrono>
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// keeps results alive so the compiler can't drop the work being timed
+extern volatile float gBenchmarkSink;
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ BenchmarkSeconds()
+//-------------------------------------------------------------------------------
+// Fastest of several runs of a function, in seconds
+//-------------------------------------------------------------------------------
+template <class F> inline double
+BenchmarkSeconds( F function, unsigned int runs = 5 )
+{
+    double best = 1.0e30;
+    for ( unsigned int run = 0; run < runs; ++run )
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        if ( seconds.count() < best )
+            best = seconds.count();
+    }
+
+    return best;
+
+}   // End of BenchmarkSeconds()
+
+#endif
@@ -20,6 +20,7 @@
 
 #include <IvVector3.h>
 #include <IvBoundingSphere.h>
+#include <IvAABB.h>
 
 //-------------------------------------------------------------------------------
 //-- Classes --------------------------------------------------------------------
@@ -37,8 +38,12 @@ public:
     bool HasCollision( const CollisionObject* other ) const;
     inline void SetColliding( bool colliding ) { mColliding = colliding; }
 
-    inline float GetMinXExtent() { return mPosition.x - mSphere.GetRadius(); }
-    inline float GetMaxXExtent() { return mPosition.x + mSphere.GetRadius(); }
+    inline void GetBounds( IvAABB& box ) const
+    {
+        float radius = mSphere.GetRadius();
+        IvVector3 extents( radius, radius, radius );
+        box.Set( mPosition - extents, mPosition + extents );
+    }
 
 private:
     IvVector3           mPosition;
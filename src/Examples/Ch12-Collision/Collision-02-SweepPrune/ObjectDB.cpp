@@ -11,11 +11,13 @@
 //
 // This is the main class for this demo.  It manages a set of objects, and 
 // detects collisions between them by using a sweep-and-prune method, which is
-// handled in Update().  A list is created, storing the min and max x extents for
-// each object, with a pointer to each object.  The list is sorted by the x 
-// values.  Then we go through the extent list.  If it's a min extent, we check 
-// for collisions in the active list, and then add the object to the active list.
-// Otherwise we remove the object from the active list.
+// handled in Update().  For each of x, y and z, a list stores the min and max
+// extents of every object, sorted by value.  Objects move only a little each
+// frame, so the lists are nearly sorted already and an insertion sort fixes
+// them up in close to linear time.  Whenever a min and a max swap places the
+// two objects may have started or stopped overlapping, so the set of pairs
+// whose boxes overlap is kept up to date as we go.  Only those pairs need to
+// have their bounding spheres tested.
 //===============================================================================
 
 //-------------------------------------------------------------------------------
@@ -43,7 +45,9 @@
 ObjectDB::ObjectDB() : 
     mNumObjects( 0 ),
     mMaxObjects( 0 ), 
-    mObjects( 0 )
+    mObjects( 0 ),
+    mProxies( 0 ),
+    mBounds( 0 )
 {
 }   // End of ObjectDB::ObjectDB()
 
@@ -75,8 +79,8 @@ ObjectDB::Initialize( unsigned int maxObjects )
     // initialize members for this maximum size
     mMaxObjects = maxObjects;
     mObjects = new CollisionObject*[maxObjects];
-    mSweepData = new SweepPoint[2*maxObjects];
-    mActiveObjects = new CollisionObject*[maxObjects];
+    mProxies = new int[maxObjects];
+    mBounds = new IvAABB[maxObjects];
     mNumObjects = 0;
 
     return true;
@@ -95,13 +99,9 @@ ObjectDB::AddObject( CollisionObject* object )
     if ( mMaxObjects == 0 || mNumObjects == mMaxObjects )
         return false;
 
-    // add sweep data objects
-    mSweepData[ 2*mNumObjects ].mObject = object;
-    mSweepData[ 2*mNumObjects ].mXValue = object->GetMinXExtent();
-    mSweepData[ 2*mNumObjects ].mFinish = false;
-    mSweepData[ 2*mNumObjects+1 ].mObject = object;
-    mSweepData[ 2*mNumObjects+1 ].mXValue = object->GetMaxXExtent();
-    mSweepData[ 2*mNumObjects+1 ].mFinish = true;
+    // add extents to sweep-and-prune lists
+    object->GetBounds( mBounds[ mNumObjects ] );
+    mProxies[ mNumObjects ] = mSweepPrune.CreateProxy( mBounds[ mNumObjects ], object );
 
     // add new object to main list
     mObjects[ mNumObjects++ ] = object;
@@ -124,9 +124,12 @@ ObjectDB::Clean()
     }
 
     delete [] mObjects;
-    delete [] mSweepData;
-    delete [] mActiveObjects;
+    delete [] mProxies;
+    delete [] mBounds;
+    mSweepPrune.Clear();
     mObjects = 0;
+    mProxies = 0;
+    mBounds = 0;
     mMaxObjects = 0;
     mNumObjects = 0;
 }
@@ -145,69 +148,28 @@ ObjectDB::Update( float dt )
     for ( i = 0; i < mNumObjects; ++i )
     {
         mObjects[i]->Update( dt );
+        mObjects[i]->GetBounds( mBounds[i] );
     }
 
-    // update sweep data
-    for ( i = 0; i < 2*mNumObjects; ++i )
-    {
-        if ( !mSweepData[i].mFinish )
-            mSweepData[i].mXValue = 
-                mSweepData[i].mObject->GetMinXExtent();
-        else
-            mSweepData[i].mXValue = 
-                mSweepData[i].mObject->GetMaxXExtent();
-    }
-    
-    // bubble sort by x value
-    for ( i = 0; i < 2*mNumObjects-1; ++i )
+    // re-sort extents, updating overlapping pairs as they swap
+    mSweepPrune.MoveProxies( mProxies, mBounds, mNumObjects );
+    mSweepPrune.UpdatePairs();
+
+    // now check for collisions between overlapping pairs
+    const IvProxyPair* pairs = mSweepPrune.GetPairs();
+    for ( i = 0; i < mSweepPrune.GetPairCount(); ++i )
     {
-        for ( unsigned int j = 0; j < 2*mNumObjects-1-i; ++j )
-        {
-            if ( mSweepData[j+1].mXValue < mSweepData[j].mXValue )
-            {
-                SweepPoint temp = mSweepData[j];
-                mSweepData[j] = mSweepData[j+1];
-                mSweepData[j+1] = temp;
-            }
-        }
-    }
+        CollisionObject* object1 = 
+            static_cast<CollisionObject*>( mSweepPrune.GetUserData( pairs[i].proxyA ) );
+        CollisionObject* object2 = 
+            static_cast<CollisionObject*>( mSweepPrune.GetUserData( pairs[i].proxyB ) );
 
-    // now check for collisions
-    mNumActiveObjects = 0;
-    for ( i = 0; i < 2*mNumObjects; ++i )
-    {       
-        // we're done with this one
-        if ( mSweepData[i].mFinish )
-        {
-            // find this object in the list and remove it
-            for ( unsigned int j = 0; j < mNumActiveObjects; ++j )
-            {
-                // if found, move last object to its spot
-                if ( mActiveObjects[j] == mSweepData[i].mObject )
-                {
-                    mActiveObjects[j] = mActiveObjects[mNumActiveObjects-1];
-                    mNumActiveObjects--;
-                    break;
-                }
-            }
-        }
-        // we're entering the sweep space of an object
-        else
+        // if there's a collision
+        if ( object1->HasCollision( object2 ) )
         {
-            // check for collisions with all active objects
-            for ( unsigned int j = 0; j < mNumActiveObjects; ++j )
-            {
-                // if there's a collision
-                if ( mSweepData[i].mObject->HasCollision( mActiveObjects[j] ) )
-                {
-                    // respond
-                    mSweepData[i].mObject->SetColliding( true );
-                    mActiveObjects[j]->SetColliding( true );
-                }
-            }
-
-            // add to active list
-            mActiveObjects[mNumActiveObjects++] = mSweepData[i].mObject;
+            // respond
+            object1->SetColliding( true );
+            object2->SetColliding( true );
         }
     }
 
@@ -229,17 +191,14 @@ ObjectDB::Render()
         mObjects[i]->Render();
     }
 
-    // render the extents
+    // render the x extents
     ::IvSetWorldIdentity();
-    for ( i = 0; i < 2*mNumObjects; ++i )
+    for ( i = 0; i < mNumObjects; ++i )
     {
-
-        IvVector3 point1( mSweepData[i].mXValue, 1.0f, -1.0f );
-        IvVector3 point2( mSweepData[i].mXValue, -1.0f, -1.0f );
-        if ( mSweepData[i].mFinish )
-            IvDrawLine( point1, point2, kCyan );
-        else
-            IvDrawLine( point1, point2, kMagenta );
+        float minX = mBounds[i].GetMinima().x;
+        float maxX = mBounds[i].GetMaxima().x;
+        IvDrawLine( IvVector3( minX, 1.0f, -1.0f ), IvVector3( minX, -1.0f, -1.0f ), kMagenta );
+        IvDrawLine( IvVector3( maxX, 1.0f, -1.0f ), IvVector3( maxX, -1.0f, -1.0f ), kCyan );
     }
 
 }   // End of ObjectDB::Render()
@@ -12,6 +12,7 @@
 // To use this, you need to call Initialize() with the maximum number of objects
 // you expect to see.  Then you can add new objects using AddObject().  Calling
 // Update() will move the objects and update their collision status.
+// Collisions are found with an incremental sweep-and-prune; see ObjectDB.cpp.
 //===============================================================================
 
 #ifndef __ObjectDBDefs__
@@ -21,20 +22,14 @@
 //-- Dependencies ---------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+#include <IvSweepPrune.h>
+
 //-------------------------------------------------------------------------------
 //-- Classes --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
 class CollisionObject;
 
-// data structure for holding sweep point info
-struct SweepPoint
-{
-    float               mXValue;    // extent value
-    CollisionObject*    mObject;    // the object associated with this extent
-    bool                mFinish;    // whether this is a start or finish endpoint
-};
-
 // main class
 class ObjectDB
 {
@@ -53,9 +48,9 @@ private:
     unsigned int        mNumObjects;            // number of objects in database
     unsigned int        mMaxObjects;            // maximum number we can have
     CollisionObject**   mObjects;               // the array of object pointers
-    SweepPoint*         mSweepData;             // array of sweep-and-prune data
-    CollisionObject**   mActiveObjects;         // active list of potential colliders
-    unsigned int        mNumActiveObjects;      // number of members in active list
+    int*                mProxies;               // sweep-and-prune proxy for each object
+    IvAABB*             mBounds;                // bounds for each object this frame
+    IvSweepPrune        mSweepPrune;            // sorted extents and overlapping pairs
 };
 
 #endif
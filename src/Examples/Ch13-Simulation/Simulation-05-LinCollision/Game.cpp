@@ -109,6 +109,17 @@ Game::PostRendererInitialize()
 void
 Game::UpdateObjects( float dt )
 {
+    // if they touch during this step, advance to the time of impact and
+    // handle the collision there, so fast objects can't pass through
+    float impactTime = mPlayer->TimeOfImpact( mObstacle, dt );
+    if ( impactTime < dt )
+    {
+        mPlayer->Update( impactTime );
+        mObstacle->Update( impactTime );
+        mPlayer->HandleCollision( mObstacle );
+        dt -= impactTime;
+    }
+
     // update player
     mPlayer->Update( dt );
     // update obstacle
@@ -21,12 +21,18 @@
 #include <IvMatrix44.h>
 #include <IvMath.h>
 
+#include <IvTimeOfImpact.h>
+
 #include "SimObject.h"
 
 //-------------------------------------------------------------------------------
 //-- Static Members -------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+// bounds are shrunk by this much when sweeping, so objects stopped at the
+// time of impact are just overlapping and the collision gets handled
+static const float kContactSkin = 0.01f;
+
 //-------------------------------------------------------------------------------
 //-- Methods --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
@@ -282,6 +288,28 @@ SimObject::Colliding( const SimObject* other, IvVector3& collisionNormal,
 }   // End of SimObject::Colliding()
 
 
+//-------------------------------------------------------------------------------
+// @ SimObject::TimeOfImpact()
+//-------------------------------------------------------------------------------
+// First time within dt that this object touches another SimObject, taking
+// current velocities as constant.  Returns dt if they don't touch.
+//-------------------------------------------------------------------------------
+float 
+SimObject::TimeOfImpact( const SimObject* other, float dt ) const
+{
+    IvBoundingSphere sphere0( mSphere.GetCenter(), mSphere.GetRadius() - kContactSkin );
+    IvBoundingSphere sphere1( other->mSphere.GetCenter(), other->mSphere.GetRadius() - kContactSkin );
+
+    float time;
+    if ( !::TimeOfImpact( time, sphere0, mVelocity, sphere1, other->mVelocity, dt ) )
+    {
+        return dt;
+    }
+    return time;
+
+}   // End of SimObject::TimeOfImpact()
+
+
 //-------------------------------------------------------------------------------
 // @ SimObject::Render()
 //-------------------------------------------------------------------------------
@@ -41,6 +41,7 @@ public:
     void SetTranslate( const IvVector3& position );
 
     void HandleCollision( SimObject* other );
+    float TimeOfImpact( const SimObject* other, float dt ) const;
 
 protected:
     void        InitializeMoments();
@@ -109,12 +109,33 @@ Game::PostRendererInitialize()
 void
 Game::UpdateObjects( float dt )
 {
+    // if they touch during this step, advance to the time of impact and
+    // handle the collision there, so fast objects can't pass through
+    // the kept contacts are moved to the objects once per step, just
+    // before the first collision is handled
+    IvContactManifold& manifold = mContacts.Find( 0, 1 );
+    float impactTime = mPlayer->TimeOfImpact( mObstacle, dt );
+    bool impact = impactTime < dt;
+    if ( impact )
+    {
+        mPlayer->Update( impactTime );
+        mObstacle->Update( impactTime );
+        mPlayer->RefreshContacts( mObstacle, manifold );
+        mPlayer->HandleCollision( mObstacle, manifold );
+        dt -= impactTime;
+    }
+
     // update player
     mPlayer->Update( dt );
     // update obstacle
     mObstacle->Update( dt );
 
-    mPlayer->HandleCollision( mObstacle );
+    if ( !impact )
+        mPlayer->RefreshContacts( mObstacle, manifold );
+    mPlayer->HandleCollision( mObstacle, manifold );
+
+    // forget the contacts once the objects separate
+    mContacts.Prune();
     
 }   // End of Game::UpdateObjects()
 
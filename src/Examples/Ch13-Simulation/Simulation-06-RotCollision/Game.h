@@ -19,6 +19,7 @@
 //-------------------------------------------------------------------------------
 
 #include <IvGame.h>
+#include <IvContactManifold.h>
 
 //-------------------------------------------------------------------------------
 //-- Classes --------------------------------------------------------------------
@@ -39,6 +40,8 @@ public:
     Obstacle*       mObstacle;
 
 protected:
+    IvContactCache  mContacts;
+
     virtual void UpdateObjects( float dt );
     virtual void Render();
     
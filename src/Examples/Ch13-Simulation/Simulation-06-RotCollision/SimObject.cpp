@@ -21,6 +21,8 @@
 #include <IvMatrix44.h>
 #include <IvMath.h>
 
+#include <IvTimeOfImpact.h>
+
 #include "SimObject.h"
 #include "IvAssert.h"
 
@@ -28,6 +30,13 @@
 //-- Static Members -------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+// bounds are shrunk by this much when sweeping, so objects stopped at the
+// time of impact are just overlapping and the collision gets handled
+static const float kContactSkin = 0.01f;
+
+// passes over the contacts when resolving a collision
+static const unsigned int kSolverIterations = 4;
+
 //-------------------------------------------------------------------------------
 //-- Methods --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
@@ -220,13 +229,30 @@ SimObject::CurrentTorque( const IvVector3& position, const IvVector3& velocity,
 }   // End of SimObject::CurrentTorque()
 
 
+//-------------------------------------------------------------------------------
+// @ SimObject::RefreshContacts()
+//-------------------------------------------------------------------------------
+// Move the contacts kept from earlier steps with the objects.  Call once
+// per step, before the first HandleCollision(), so the contacts age once.
+//-------------------------------------------------------------------------------
+void
+SimObject::RefreshContacts( const SimObject* other, IvContactManifold& manifold ) const
+{
+    manifold.Refresh( mRotate, mTranslate, other->mRotate, other->mTranslate );
+
+}   // End of SimObject::RefreshContacts()
+
+
 //-------------------------------------------------------------------------------
 // @ SimObject::HandleCollision()
 //-------------------------------------------------------------------------------
-// Handle collisions between this object and another one
+// Handle collisions between this object and another one.  The manifold
+// keeps contacts from earlier steps, so a resting object is supported at
+// several points, and each contact starts from the impulse it needed last
+// step rather than from zero.
 //-------------------------------------------------------------------------------
 void
-SimObject::HandleCollision( SimObject* other )
+SimObject::HandleCollision( SimObject* other, IvContactManifold& manifold )
 {
     IvVector3 collisionNormal, collisionPoint;
     float penetration;
@@ -234,59 +260,119 @@ SimObject::HandleCollision( SimObject* other )
     // if the two objects are colliding
     if (Colliding(other, collisionNormal, collisionPoint, penetration))
     {
+        manifold.AddContact( collisionNormal, collisionPoint, penetration,
+                             mRotate, mTranslate, other->mRotate, other->mTranslate );
+
         // push out by penetration, scaled by relative masses
         float relativeMass = mMass/(mMass + other->mMass);
         mTranslate -= (1.0f-relativeMass)*penetration*collisionNormal;
         other->mTranslate += relativeMass*penetration*collisionNormal;
+    }
 
-        // compute relative velocity
-        IvVector3 r1 = collisionPoint - mTranslate;
-        IvVector3 r2 = collisionPoint - other->mTranslate;
-        IvVector3 vel1 = mVelocity + Cross( mAngularVelocity, r1 );
-        IvVector3 vel2 = other->mVelocity + Cross( other->mAngularVelocity, r2 );
-        IvVector3 relativeVelocity = vel1 - vel2;
+    // Note: this is different from the presentation in the book,
+    // which is incorrect. There is a single coefficient of restitution
+    // for each pair of objects. The following is a reasonable approximation,
+    // assuming that mElasticity represents the coefficient of resitution
+    // between this object and a perfectly elastic surface.
+    float restitution = mElasticity*other->mElasticity;
+
+    // set up each touching contact
+    IvVector3 r1[IvContactManifold::kMaxContacts];
+    IvVector3 r2[IvContactManifold::kMaxContacts];
+    float denominator[IvContactManifold::kMaxContacts];
+    float targetVel[IvContactManifold::kMaxContacts];
+    for ( unsigned int i = 0; i < manifold.GetCount(); ++i )
+    {
+        IvContactPoint& contact = manifold.GetContact( i );
+        if ( contact.penetration < 0.0f )
+        {
+            contact.normalImpulse = 0.0f;
+            continue;
+        }
 
-        // determine if we're heading away from each other
-        float vDotN = relativeVelocity.Dot( collisionNormal );
-        if (vDotN < 0)
-            return;
+        r1[i] = contact.point - mTranslate;
+        r2[i] = contact.point - other->mTranslate;
 
         // compute impulse factor
-        float denominator = (1.0f/mMass + 1.0f/other->mMass)*(collisionNormal.Dot(collisionNormal));
+        denominator[i] = 1.0f/mMass + 1.0f/other->mMass;
 
         // compute angular factors
-        IvVector3 cross1 = Cross(r1, collisionNormal);
-        IvVector3 cross2 = Cross(r2, collisionNormal);
-        cross1 = mWorldMomentsInverse*cross1;
-        cross2 = other->mWorldMomentsInverse*cross2;
-        IvVector3 sum = Cross(cross1, r1) + Cross(cross2, r2);
-        denominator += (sum.Dot(collisionNormal));
-
-        // Note: this is different from the presentation in the book,
-        // which is incorrect. There is a single coefficient of restitution
-        // for each pair of objects. The following is a reasonable approximation,
-        // assuming that mElasticity represents the coefficient of resitution
-        // between this object and a perfectly elastic surface.
-        float restitution = mElasticity*other->mElasticity;
-        // compute j
-        float modifiedVel = vDotN/denominator;
-        float j1 = -(1.0f+restitution)*modifiedVel;
-        float j2 = (1.0f+restitution)*modifiedVel;
-
-        // update velocities
-        mVelocity += j1/mMass*collisionNormal;
-        other->mVelocity += j2/other->mMass*collisionNormal;
-
-        // update angular velocities
-        mAngularMomentum += Cross(r1, j1*collisionNormal);
-        mAngularVelocity = mWorldMomentsInverse*mAngularMomentum;
-        other->mAngularMomentum += Cross(r2, j2*collisionNormal);
-        other->mAngularVelocity = other->mWorldMomentsInverse*other->mAngularMomentum;
+        IvVector3 cross1 = mWorldMomentsInverse*Cross(r1[i], contact.normal);
+        IvVector3 cross2 = other->mWorldMomentsInverse*Cross(r2[i], contact.normal);
+        IvVector3 sum = Cross(cross1, r1[i]) + Cross(cross2, r2[i]);
+        denominator[i] += sum.Dot(contact.normal);
+
+        // bounce off if heading towards each other
+        float vDotN = RelativeVelocity( other, r1[i], r2[i] ).Dot( contact.normal );
+        targetVel[i] = vDotN > 0.0f ? -restitution*vDotN : 0.0f;
+
+        // warm start with last step's impulse
+        ApplyImpulse( other, r1[i], r2[i], contact.normalImpulse*contact.normal );
+    }
+
+    // sequential impulses: each contact in turn removes its approach velocity,
+    // keeping its total impulse pushing the objects apart
+    for ( unsigned int iteration = 0; iteration < kSolverIterations; ++iteration )
+    {
+        for ( unsigned int i = 0; i < manifold.GetCount(); ++i )
+        {
+            IvContactPoint& contact = manifold.GetContact( i );
+            if ( contact.penetration < 0.0f )
+                continue;
+
+            float vDotN = RelativeVelocity( other, r1[i], r2[i] ).Dot( contact.normal );
+            float impulse = contact.normalImpulse + (vDotN - targetVel[i])/denominator[i];
+            if ( impulse < 0.0f )
+                impulse = 0.0f;
+            float delta = impulse - contact.normalImpulse;
+            contact.normalImpulse = impulse;
+
+            ApplyImpulse( other, r1[i], r2[i], delta*contact.normal );
+        }
     }
 
 }   // End of SimObject::HandleCollision()
 
 
+//-------------------------------------------------------------------------------
+// @ SimObject::RelativeVelocity()
+//-------------------------------------------------------------------------------
+// Velocity of this object relative to another at a contact, given the
+// offsets to the contact from each
+//-------------------------------------------------------------------------------
+IvVector3
+SimObject::RelativeVelocity( const SimObject* other, const IvVector3& r1, 
+                             const IvVector3& r2 ) const
+{
+    IvVector3 vel1 = mVelocity + Cross( mAngularVelocity, r1 );
+    IvVector3 vel2 = other->mVelocity + Cross( other->mAngularVelocity, r2 );
+    return vel1 - vel2;
+
+}   // End of SimObject::RelativeVelocity()
+
+
+//-------------------------------------------------------------------------------
+// @ SimObject::ApplyImpulse()
+//-------------------------------------------------------------------------------
+// Push this object back along impulse, and the other forward
+//-------------------------------------------------------------------------------
+void
+SimObject::ApplyImpulse( SimObject* other, const IvVector3& r1, const IvVector3& r2,
+                         const IvVector3& impulse )
+{
+    // update velocities
+    mVelocity -= (1.0f/mMass)*impulse;
+    other->mVelocity += (1.0f/other->mMass)*impulse;
+
+    // update angular velocities
+    mAngularMomentum -= Cross(r1, impulse);
+    mAngularVelocity = mWorldMomentsInverse*mAngularMomentum;
+    other->mAngularMomentum += Cross(r2, impulse);
+    other->mAngularVelocity = other->mWorldMomentsInverse*other->mAngularMomentum;
+
+}   // End of SimObject::ApplyImpulse()
+
+
 //-------------------------------------------------------------------------------
 // @ SimObject::Colliding()
 //-------------------------------------------------------------------------------
@@ -312,6 +398,31 @@ SimObject::Colliding( const SimObject* other, IvVector3& collisionNormal,
 }
 
 
+//-------------------------------------------------------------------------------
+// @ SimObject::TimeOfImpact()
+//-------------------------------------------------------------------------------
+// First time within dt that this object touches another SimObject, taking
+// current velocities as constant.  Returns dt if they don't touch.
+//-------------------------------------------------------------------------------
+float 
+SimObject::TimeOfImpact( const SimObject* other, float dt ) const
+{
+    IvCapsule capsule0( mWorldCapsule.GetSegment(), mWorldCapsule.GetRadius() - kContactSkin );
+    IvCapsule capsule1( other->mWorldCapsule.GetSegment(),
+                        other->mWorldCapsule.GetRadius() - kContactSkin );
+    IvRigidMotion motion0 = { mTranslate, mVelocity, mAngularVelocity };
+    IvRigidMotion motion1 = { other->mTranslate, other->mVelocity, other->mAngularVelocity };
+
+    float time;
+    if ( !::TimeOfImpact( time, capsule0, motion0, capsule1, motion1, dt, kContactSkin ) )
+    {
+        return dt;
+    }
+    return time;
+
+}   // End of SimObject::TimeOfImpact()
+
+
 //-------------------------------------------------------------------------------
 // @ SimObject::Render()
 //-------------------------------------------------------------------------------
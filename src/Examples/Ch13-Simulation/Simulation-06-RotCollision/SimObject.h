@@ -21,6 +21,7 @@
 #include <IvVector3.h>
 #include <IvMatrix33.h>
 #include <IvCapsule.h>
+#include <IvContactManifold.h>
 
 //-------------------------------------------------------------------------------
 //-- Classes --------------------------------------------------------------------
@@ -37,7 +38,9 @@ public:
     void SetMass( float mass );
     void SetBounds( float radius, float length );
 
-    void HandleCollision( SimObject* other );
+    void RefreshContacts( const SimObject* other, IvContactManifold& manifold ) const;
+    void HandleCollision( SimObject* other, IvContactManifold& manifold );
+    float TimeOfImpact( const SimObject* other, float dt ) const;
 
 protected:
     void        InitializeMoments();
@@ -48,6 +51,10 @@ protected:
                               const IvQuat& orientation, const IvVector3& angularVelocity );
     bool        Colliding( const SimObject* other, 
                     IvVector3& collisionNormal, IvVector3& collisionPoint, float& penetration ) const;
+    IvVector3   RelativeVelocity( const SimObject* other, const IvVector3& r1, 
+                                  const IvVector3& r2 ) const;
+    void        ApplyImpulse( SimObject* other, const IvVector3& r1, const IvVector3& r2,
+                              const IvVector3& impulse );
 
     IvQuat      mRotate;
     IvVector3   mTranslate;
@@ -26,6 +26,8 @@
 #include "Game.h"
 #include "Player.h"
 
+#include <thread>
+
 //-------------------------------------------------------------------------------
 //-- Static Members -------------------------------------------------------------
 //-------------------------------------------------------------------------------
@@ -65,6 +67,10 @@ Game::Game()
 
     mNumObjects = 0;
 
+    mNumThreads = std::thread::hardware_concurrency();
+    if ( mNumThreads < 1 )
+        mNumThreads = 1;
+
 }   // End of Game::Game()
 
 
@@ -191,13 +197,20 @@ Game::UpdateObjects( float dt )
     
     if (mUseCollision)
     {
-    for (unsigned int i = 0; i < mNumObjects; ++i)
-    {
-        for (unsigned int j = i+1; j < mNumObjects; ++j)
+        // only pairs whose bounds overlap can collide.  Pairs come back
+        // sorted, so they're handled in the same order as checking every
+        // pair would.
+        for (unsigned int i = 0; i < mNumObjects; ++i)
         {
-            mObjects[i].HandleCollision( &mObjects[j] );
+            mObjects[i].GetBounds( mBounds[i] );
+        }
+        mSortSweep.FindPairs( mBounds, mNumObjects, mNumThreads );
+
+        const IvProxyPair* pairs = mSortSweep.GetPairs();
+        for (unsigned int i = 0; i < mSortSweep.GetPairCount(); ++i)
+        {
+            mObjects[pairs[i].proxyA].HandleCollision( &mObjects[pairs[i].proxyB] );
         }
-    }
     }
     
     for (unsigned int i = 0; i < mNumObjects; ++i)
@@ -21,6 +21,7 @@
 //-------------------------------------------------------------------------------
 
 #include <IvGame.h>
+#include <IvSortSweep.h>
 #include "SimObject.h"
 
 //-------------------------------------------------------------------------------
@@ -43,6 +44,10 @@ public:
     SimObject       mObjects[kMaxObjects];
     unsigned int    mNumObjects;
 
+    IvAABB          mBounds[kMaxObjects];   // object bounds, for finding pairs
+    IvSortSweep     mSortSweep;             // finds overlapping pairs of bounds
+    unsigned int    mNumThreads;            // threads used to find pairs
+
     Player*         mPlayer;
     
     bool            mUseCollision;
@@ -22,6 +22,7 @@
 #include <IvQuat.h>
 #include <IvVector3.h>
 #include <IvMatrix33.h>
+#include <IvAABB.h>
 #include <IvBoundingSphere.h>
 
 //-------------------------------------------------------------------------------
@@ -42,6 +43,13 @@ public:
     void SetTranslate( const IvVector3& position );
 
     void HandleCollision( SimObject* other );
+
+    inline void GetBounds( IvAABB& box ) const
+    {
+        float radius = mSphere.GetRadius();
+        IvVector3 extents( radius, radius, radius );
+        box.Set( mSphere.GetCenter() - extents, mSphere.GetCenter() + extents );
+    }
     
     inline void SetConstantForce( const IvVector3& force ) { mConstantForce = force; }
     inline void SetConstantTorque( const IvVector3& torque ) { mConstantTorque = torque; }
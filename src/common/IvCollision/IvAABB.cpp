@@ -16,6 +16,7 @@
 //-------------------------------------------------------------------------------
 
 #include "IvAABB.h"
+#include "IvBoundingSphere.h"
 #include "IvVector3.h"
 #include "IvLine3.h"
 #include "IvRay3.h"
@@ -324,6 +325,29 @@ IvAABB::Intersect( const IvLineSegment3& segment ) const
 }
 
 
+//----------------------------------------------------------------------------
+// @ IvAABB::Intersect()
+// ---------------------------------------------------------------------------
+// Determine intersection between AABB and sphere
+//-----------------------------------------------------------------------------
+bool
+IvAABB::Intersect( const IvBoundingSphere& sphere ) const
+{
+    // squared distance from sphere center to nearest point in box
+    const IvVector3& center = sphere.GetCenter();
+    float distanceSquared = 0.0f;
+    for ( int i = 0; i < 3; ++i )
+    {
+        if ( center[i] < mMinima[i] )
+            distanceSquared += (mMinima[i] - center[i])*(mMinima[i] - center[i]);
+        else if ( center[i] > mMaxima[i] )
+            distanceSquared += (center[i] - mMaxima[i])*(center[i] - mMaxima[i]);
+    }
+
+    return distanceSquared <= sphere.GetRadius()*sphere.GetRadius();
+}
+
+
 //----------------------------------------------------------------------------
 // @ IvAABB:Classify()
 // ---------------------------------------------------------------------------
@@ -341,20 +365,20 @@ IvAABB::Classify( const IvPlane& plane ) const
     }
     else
     {
-        diagMin.x = mMinima.x;
-        diagMax.x = mMaxima.x;
+        diagMin.x = mMaxima.x;
+        diagMax.x = mMinima.x;
     }
 
     // set min/max values for y direction
-    if ( plane.GetNormal().x >= 0.0f )
+    if ( plane.GetNormal().y >= 0.0f )
     {
         diagMin.y = mMinima.y;
         diagMax.y = mMaxima.y;
     }
     else
     {
-        diagMin.y = mMinima.y;
-        diagMax.y = mMaxima.y;
+        diagMin.y = mMaxima.y;
+        diagMax.y = mMinima.y;
     }
 
     // set min/max values for z direction
@@ -365,8 +389,8 @@ IvAABB::Classify( const IvPlane& plane ) const
     }
     else
     {
-        diagMin.z = mMinima.z;
-        diagMax.z = mMaxima.z;
+        diagMin.z = mMaxima.z;
+        diagMax.z = mMinima.z;
     }
 
     // minimum on positive side of plane, box on positive side
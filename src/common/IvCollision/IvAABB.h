@@ -29,6 +29,7 @@
 //-- Typedefs, Structs ----------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+class IvBoundingSphere;
 class IvLine3;
 class IvRay3;
 class IvLineSegment3;
@@ -75,6 +76,7 @@ public:
     bool Intersect( const IvLine3& line ) const;
     bool Intersect( const IvRay3& ray ) const;
     bool Intersect( const IvLineSegment3& segment ) const;
+    bool Intersect( const IvBoundingSphere& sphere ) const;
 
     // signed distance to plane
     float Classify( const IvPlane& plane ) const;
@@ -0,0 +1,675 @@
+//===============================================================================
+// @ IvAABBTree.cpp
+//
+// Dynamic AABB tree for broad phase collision detection
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvAABBTree.h"
+#include <IvAssert.h>
+
+#include <algorithm>
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// initial size of node pool
+static const unsigned int kInitialCapacity = 16;
+// how far ahead of the motion to extend fat boxes
+static const float kDisplacementMultiplier = 2.0f;
+// depth of the query stacks; the balanced tree is far shallower
+static const unsigned int kStackSize = 256;
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ HalfArea()
+//-------------------------------------------------------------------------------
+// Half the surface area of a box, the insertion cost metric
+//-------------------------------------------------------------------------------
+static inline float
+HalfArea( const IvAABB& box )
+{
+    IvVector3 d = box.GetMaxima() - box.GetMinima();
+    return d.x*d.y + d.y*d.z + d.z*d.x;
+
+}   // End of HalfArea()
+
+
+//-------------------------------------------------------------------------------
+// @ Contains()
+//-------------------------------------------------------------------------------
+// Is inner entirely inside outer?
+//-------------------------------------------------------------------------------
+static inline bool
+Contains( const IvAABB& outer, const IvAABB& inner )
+{
+    const IvVector3& outerMin = outer.GetMinima();
+    const IvVector3& outerMax = outer.GetMaxima();
+    const IvVector3& innerMin = inner.GetMinima();
+    const IvVector3& innerMax = inner.GetMaxima();
+    return outerMin.x <= innerMin.x && outerMin.y <= innerMin.y && outerMin.z <= innerMin.z
+        && innerMax.x <= outerMax.x && innerMax.y <= outerMax.y && innerMax.z <= outerMax.z;
+
+}   // End of Contains()
+
+
+//-------------------------------------------------------------------------------
+// @ PairLess()
+//-------------------------------------------------------------------------------
+// Order pairs by first proxy, then second
+//-------------------------------------------------------------------------------
+static inline bool
+PairLess( const IvProxyPair& p0, const IvProxyPair& p1 )
+{
+    return p0.proxyA < p1.proxyA || (p0.proxyA == p1.proxyA && p0.proxyB < p1.proxyB);
+
+}   // End of PairLess()
+
+
+//-------------------------------------------------------------------------------
+// @ PairEqual()
+//-------------------------------------------------------------------------------
+// Same two proxies?
+//-------------------------------------------------------------------------------
+static inline bool
+PairEqual( const IvProxyPair& p0, const IvProxyPair& p1 )
+{
+    return p0.proxyA == p1.proxyA && p0.proxyB == p1.proxyB;
+
+}   // End of PairEqual()
+
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::IvAABBTree()
+//-------------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------------
+IvAABBTree::IvAABBTree( float margin ) :
+    mNodes( 0 ),
+    mCapacity( 0 ),
+    mRoot( -1 ),
+    mFreeList( -1 ),
+    mProxyCount( 0 ),
+    mMargin( margin )
+{
+    ASSERT( margin >= 0.0f );
+
+}   // End of IvAABBTree::IvAABBTree()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::~IvAABBTree()
+//-------------------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------------------
+IvAABBTree::~IvAABBTree()
+{
+    Clear();
+
+}   // End of IvAABBTree::~IvAABBTree()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::Clear()
+//-------------------------------------------------------------------------------
+// Remove all proxies
+//-------------------------------------------------------------------------------
+void
+IvAABBTree::Clear()
+{
+    delete [] mNodes;
+    mNodes = 0;
+    mCapacity = 0;
+    mRoot = -1;
+    mFreeList = -1;
+    mProxyCount = 0;
+
+}   // End of IvAABBTree::Clear()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::AllocateNode()
+//-------------------------------------------------------------------------------
+// Take a node from the free list, growing the pool if it's empty
+//-------------------------------------------------------------------------------
+int
+IvAABBTree::AllocateNode()
+{
+    if ( mFreeList == -1 )
+    {
+        unsigned int capacity = mCapacity > 0 ? 2*mCapacity : kInitialCapacity;
+        IvAABBTreeNode* nodes = new IvAABBTreeNode[capacity];
+        for ( unsigned int i = 0; i < mCapacity; ++i )
+        {
+            nodes[i] = mNodes[i];
+        }
+        delete [] mNodes;
+        mNodes = nodes;
+
+        // chain new nodes onto the free list
+        for ( unsigned int i = mCapacity; i < capacity; ++i )
+        {
+            mNodes[i].parent = (i + 1 < capacity) ? int(i + 1) : -1;
+            mNodes[i].height = -1;
+        }
+        mFreeList = int(mCapacity);
+        mCapacity = capacity;
+    }
+
+    int node = mFreeList;
+    mFreeList = mNodes[node].parent;
+    mNodes[node].userData = 0;
+    mNodes[node].parent = -1;
+    mNodes[node].child1 = -1;
+    mNodes[node].child2 = -1;
+    mNodes[node].height = 0;
+    return node;
+
+}   // End of IvAABBTree::AllocateNode()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::FreeNode()
+//-------------------------------------------------------------------------------
+// Return a node to the free list
+//-------------------------------------------------------------------------------
+void
+IvAABBTree::FreeNode( int node )
+{
+    ASSERT( 0 <= node && node < int(mCapacity) );
+
+    mNodes[node].parent = mFreeList;
+    mNodes[node].height = -1;
+    mFreeList = node;
+
+}   // End of IvAABBTree::FreeNode()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::CreateProxy()
+//-------------------------------------------------------------------------------
+// Add an object with the given bounds, returns its proxy
+//-------------------------------------------------------------------------------
+int
+IvAABBTree::CreateProxy( const IvAABB& box, void* userData )
+{
+    int proxy = AllocateNode();
+
+    IvVector3 margin( mMargin, mMargin, mMargin );
+    mNodes[proxy].box.Set( box.GetMinima() - margin, box.GetMaxima() + margin );
+    mNodes[proxy].userData = userData;
+    InsertLeaf( proxy );
+    ++mProxyCount;
+
+    return proxy;
+
+}   // End of IvAABBTree::CreateProxy()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::DestroyProxy()
+//-------------------------------------------------------------------------------
+// Remove an object
+//-------------------------------------------------------------------------------
+void
+IvAABBTree::DestroyProxy( int proxy )
+{
+    ASSERT( 0 <= proxy && proxy < int(mCapacity) && mNodes[proxy].IsLeaf() );
+
+    RemoveLeaf( proxy );
+    FreeNode( proxy );
+    --mProxyCount;
+
+}   // End of IvAABBTree::DestroyProxy()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::MoveProxy()
+//-------------------------------------------------------------------------------
+// Update an object's bounds.  Nothing changes while they stay inside the
+// fat box; otherwise the proxy gets a new fat box, stretched along the
+// displacement, and is reinserted.
+//-------------------------------------------------------------------------------
+bool
+IvAABBTree::MoveProxy( int proxy, const IvAABB& box, const IvVector3& displacement )
+{
+    ASSERT( 0 <= proxy && proxy < int(mCapacity) && mNodes[proxy].IsLeaf() );
+
+    if ( Contains( mNodes[proxy].box, box ) )
+        return false;
+
+    RemoveLeaf( proxy );
+
+    IvVector3 margin( mMargin, mMargin, mMargin );
+    IvVector3 minima = box.GetMinima() - margin;
+    IvVector3 maxima = box.GetMaxima() + margin;
+    IvVector3 predicted = kDisplacementMultiplier*displacement;
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        if ( predicted[i] < 0.0f )
+            minima[i] += predicted[i];
+        else
+            maxima[i] += predicted[i];
+    }
+    mNodes[proxy].box.Set( minima, maxima );
+
+    InsertLeaf( proxy );
+    return true;
+
+}   // End of IvAABBTree::MoveProxy()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::InsertLeaf()
+//-------------------------------------------------------------------------------
+// Descend to the sibling that adds the least area, pair the leaf with it
+// under a new parent, then refit and rebalance back up to the root
+//-------------------------------------------------------------------------------
+void
+IvAABBTree::InsertLeaf( int leaf )
+{
+    if ( mRoot == -1 )
+    {
+        mRoot = leaf;
+        mNodes[leaf].parent = -1;
+        return;
+    }
+
+    // find the best sibling -- copy the box, since AllocateNode() may move the pool
+    const IvAABB leafBox = mNodes[leaf].box;
+    int index = mRoot;
+    while ( !mNodes[index].IsLeaf() )
+    {
+        const IvAABBTreeNode& node = mNodes[index];
+        float area = HalfArea( node.box );
+        IvAABB combined;
+        Merge( combined, node.box, leafBox );
+        float combinedArea = HalfArea( combined );
+
+        // cost of making a new parent for this node and the leaf
+        float cost = 2.0f*combinedArea;
+        // cost the ancestors pay for pushing the leaf further down
+        float inheritanceCost = 2.0f*(combinedArea - area);
+
+        float childCost[2];
+        int children[2] = { node.child1, node.child2 };
+        for ( unsigned int i = 0; i < 2; ++i )
+        {
+            const IvAABBTreeNode& child = mNodes[children[i]];
+            Merge( combined, child.box, leafBox );
+            childCost[i] = HalfArea( combined ) + inheritanceCost;
+            if ( !child.IsLeaf() )
+                childCost[i] -= HalfArea( child.box );
+        }
+
+        if ( cost < childCost[0] && cost < childCost[1] )
+            break;
+        index = childCost[0] < childCost[1] ? children[0] : children[1];
+    }
+
+    // new parent for sibling and leaf
+    int sibling = index;
+    int oldParent = mNodes[sibling].parent;
+    int newParent = AllocateNode();
+    mNodes[newParent].parent = oldParent;
+    Merge( mNodes[newParent].box, leafBox, mNodes[sibling].box );
+    mNodes[newParent].height = mNodes[sibling].height + 1;
+    mNodes[newParent].child1 = sibling;
+    mNodes[newParent].child2 = leaf;
+    mNodes[sibling].parent = newParent;
+    mNodes[leaf].parent = newParent;
+
+    if ( oldParent == -1 )
+    {
+        mRoot = newParent;
+    }
+    else if ( mNodes[oldParent].child1 == sibling )
+    {
+        mNodes[oldParent].child1 = newParent;
+    }
+    else
+    {
+        mNodes[oldParent].child2 = newParent;
+    }
+
+    Refit( mNodes[leaf].parent );
+
+}   // End of IvAABBTree::InsertLeaf()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::RemoveLeaf()
+//-------------------------------------------------------------------------------
+// Unlink a leaf; its sibling takes the parent's place
+//-------------------------------------------------------------------------------
+void
+IvAABBTree::RemoveLeaf( int leaf )
+{
+    if ( leaf == mRoot )
+    {
+        mRoot = -1;
+        return;
+    }
+
+    int parent = mNodes[leaf].parent;
+    int grandParent = mNodes[parent].parent;
+    int sibling = mNodes[parent].child1 == leaf ? mNodes[parent].child2 : mNodes[parent].child1;
+
+    mNodes[sibling].parent = grandParent;
+    FreeNode( parent );
+    if ( grandParent == -1 )
+    {
+        mRoot = sibling;
+        return;
+    }
+
+    if ( mNodes[grandParent].child1 == parent )
+        mNodes[grandParent].child1 = sibling;
+    else
+        mNodes[grandParent].child2 = sibling;
+    Refit( grandParent );
+
+}   // End of IvAABBTree::RemoveLeaf()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::Refit()
+//-------------------------------------------------------------------------------
+// Rebalance and recompute bounds and heights from a node up to the root
+//-------------------------------------------------------------------------------
+void
+IvAABBTree::Refit( int index )
+{
+    while ( index != -1 )
+    {
+        index = Balance( index );
+
+        IvAABBTreeNode& node = mNodes[index];
+        const IvAABBTreeNode& child1 = mNodes[node.child1];
+        const IvAABBTreeNode& child2 = mNodes[node.child2];
+        node.height = 1 + (child1.height > child2.height ? child1.height : child2.height);
+        Merge( node.box, child1.box, child2.box );
+
+        index = node.parent;
+    }
+
+}   // End of IvAABBTree::Refit()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::Balance()
+//-------------------------------------------------------------------------------
+// If one child of A is more than one level taller than the other, rotate
+// it up to take A's place.  A keeps the shorter child plus the shorter
+// grandchild.  Returns the node now at A's position.
+//-------------------------------------------------------------------------------
+int
+IvAABBTree::Balance( int iA )
+{
+    IvAABBTreeNode& A = mNodes[iA];
+    if ( A.IsLeaf() || A.height < 2 )
+        return iA;
+
+    int balance = mNodes[A.child2].height - mNodes[A.child1].height;
+    if ( balance >= -1 && balance <= 1 )
+        return iA;
+
+    // child to rotate up, and the one that stays
+    int iC = balance > 1 ? A.child2 : A.child1;
+    int iB = balance > 1 ? A.child1 : A.child2;
+    IvAABBTreeNode& B = mNodes[iB];
+    IvAABBTreeNode& C = mNodes[iC];
+
+    // C takes A's place
+    C.parent = A.parent;
+    A.parent = iC;
+    if ( C.parent == -1 )
+        mRoot = iC;
+    else if ( mNodes[C.parent].child1 == iA )
+        mNodes[C.parent].child1 = iC;
+    else
+        mNodes[C.parent].child2 = iC;
+
+    // the taller grandchild stays with C, the shorter moves under A
+    int iF = C.child1;
+    int iG = C.child2;
+    if ( mNodes[iG].height > mNodes[iF].height )
+    {
+        int temp = iF;
+        iF = iG;
+        iG = temp;
+    }
+    IvAABBTreeNode& F = mNodes[iF];
+    IvAABBTreeNode& G = mNodes[iG];
+
+    C.child1 = iA;
+    C.child2 = iF;
+    A.child1 = iB;
+    A.child2 = iG;
+    G.parent = iA;
+
+    Merge( A.box, B.box, G.box );
+    Merge( C.box, A.box, F.box );
+    A.height = 1 + (B.height > G.height ? B.height : G.height);
+    C.height = 1 + (A.height > F.height ? A.height : F.height);
+
+    return iC;
+
+}   // End of IvAABBTree::Balance()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::GetHeight()
+//-------------------------------------------------------------------------------
+// Height of the tree, 0 for a single proxy and -1 if empty
+//-------------------------------------------------------------------------------
+int
+IvAABBTree::GetHeight() const
+{
+    return mRoot == -1 ? -1 : mNodes[mRoot].height;
+
+}   // End of IvAABBTree::GetHeight()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::Query()
+//-------------------------------------------------------------------------------
+// Proxies overlapping a box
+//-------------------------------------------------------------------------------
+unsigned int
+IvAABBTree::Query( int* results, unsigned int maxResults, const IvAABB& box ) const
+{
+    if ( mRoot == -1 )
+        return 0;
+
+    int stack[kStackSize];
+    unsigned int stackSize = 0;
+    unsigned int numResults = 0;
+    stack[stackSize++] = mRoot;
+    while ( stackSize > 0 )
+    {
+        const IvAABBTreeNode& node = mNodes[stack[--stackSize]];
+        if ( !node.box.Intersect( box ) )
+            continue;
+
+        if ( node.IsLeaf() )
+        {
+            if ( numResults == maxResults )
+                break;
+            results[numResults++] = int(&node - mNodes);
+        }
+        else
+        {
+            ASSERT( stackSize + 2 <= kStackSize );
+            stack[stackSize++] = node.child2;
+            stack[stackSize++] = node.child1;
+        }
+    }
+
+    return numResults;
+
+}   // End of IvAABBTree::Query()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::AddPairs()
+//-------------------------------------------------------------------------------
+// Append the pairs between one proxy and those it overlaps, ordered so
+// the lower proxy comes first.  If greaterOnly, only pairs with higher
+// numbered proxies are added.
+//-------------------------------------------------------------------------------
+unsigned int
+IvAABBTree::AddPairs( IvProxyPair* pairs, unsigned int numPairs, unsigned int maxPairs,
+                      int proxy, bool greaterOnly ) const
+{
+    const IvAABB& box = mNodes[proxy].box;
+
+    int stack[kStackSize];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = mRoot;
+    while ( stackSize > 0 && numPairs < maxPairs )
+    {
+        int index = stack[--stackSize];
+        const IvAABBTreeNode& node = mNodes[index];
+        if ( index == proxy || (greaterOnly && node.IsLeaf() && index < proxy) ||
+             !node.box.Intersect( box ) )
+            continue;
+
+        if ( node.IsLeaf() )
+        {
+            pairs[numPairs].proxyA = proxy < index ? proxy : index;
+            pairs[numPairs].proxyB = proxy < index ? index : proxy;
+            ++numPairs;
+        }
+        else
+        {
+            ASSERT( stackSize + 2 <= kStackSize );
+            stack[stackSize++] = node.child2;
+            stack[stackSize++] = node.child1;
+        }
+    }
+
+    return numPairs;
+
+}   // End of IvAABBTree::AddPairs()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::FindPairs()
+//-------------------------------------------------------------------------------
+// All overlapping pairs
+//-------------------------------------------------------------------------------
+unsigned int
+IvAABBTree::FindPairs( IvProxyPair* pairs, unsigned int maxPairs ) const
+{
+    unsigned int numPairs = 0;
+    for ( unsigned int i = 0; i < mCapacity && numPairs < maxPairs; ++i )
+    {
+        if ( mNodes[i].height == 0 )
+            numPairs = AddPairs( pairs, numPairs, maxPairs, int(i), true );
+    }
+    std::sort( pairs, pairs + numPairs, PairLess );
+
+    return numPairs;
+
+}   // End of IvAABBTree::FindPairs()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::FindPairs()
+//-------------------------------------------------------------------------------
+// Overlapping pairs involving the given proxies.  Pairs between two of
+// them turn up twice, so duplicates are removed.
+//-------------------------------------------------------------------------------
+unsigned int
+IvAABBTree::FindPairs( IvProxyPair* pairs, unsigned int maxPairs,
+                       const int* proxies, unsigned int numProxies ) const
+{
+    ASSERT( proxies || numProxies == 0 );
+
+    unsigned int numPairs = 0;
+    for ( unsigned int i = 0; i < numProxies && numPairs < maxPairs; ++i )
+    {
+        ASSERT( 0 <= proxies[i] && proxies[i] < int(mCapacity) && mNodes[proxies[i]].height == 0 );
+        numPairs = AddPairs( pairs, numPairs, maxPairs, proxies[i], false );
+    }
+    std::sort( pairs, pairs + numPairs, PairLess );
+
+    return (unsigned int)( std::unique( pairs, pairs + numPairs, PairEqual ) - pairs );
+
+}   // End of IvAABBTree::FindPairs()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::Validate()
+//-------------------------------------------------------------------------------
+// Check links, heights, bounds and counts
+//-------------------------------------------------------------------------------
+void
+IvAABBTree::Validate() const
+{
+#ifndef NDEBUG
+    unsigned int numLeaves = 0;
+    if ( mRoot != -1 )
+    {
+        ASSERT( mNodes[mRoot].parent == -1 );
+        numLeaves = ValidateNode( mRoot );
+    }
+    ASSERT( numLeaves == mProxyCount );
+
+    unsigned int numFree = 0;
+    for ( int index = mFreeList; index != -1; index = mNodes[index].parent )
+    {
+        ASSERT( mNodes[index].height == -1 );
+        ++numFree;
+    }
+    // a tree with n leaves has n-1 interior nodes
+    unsigned int numUsed = mProxyCount > 0 ? 2*mProxyCount - 1 : 0;
+    ASSERT( numFree + numUsed == mCapacity );
+#endif
+
+}   // End of IvAABBTree::Validate()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAABBTree::ValidateNode()
+//-------------------------------------------------------------------------------
+// Check a subtree, returns its number of leaves
+//-------------------------------------------------------------------------------
+unsigned int
+IvAABBTree::ValidateNode( int index ) const
+{
+    const IvAABBTreeNode& node = mNodes[index];
+    if ( node.IsLeaf() )
+    {
+        ASSERT( node.height == 0 );
+        return 1;
+    }
+
+    const IvAABBTreeNode& child1 = mNodes[node.child1];
+    const IvAABBTreeNode& child2 = mNodes[node.child2];
+    ASSERT( child1.parent == index && child2.parent == index );
+    ASSERT( node.height == 1 + (child1.height > child2.height ? child1.height : child2.height) );
+    ASSERT( Contains( node.box, child1.box ) && Contains( node.box, child2.box ) );
+
+    return ValidateNode( node.child1 ) + ValidateNode( node.child2 );
+
+}   // End of IvAABBTree::ValidateNode()
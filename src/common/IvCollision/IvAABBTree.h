@@ -0,0 +1,123 @@
+//===============================================================================
+// @ IvAABBTree.h
+//
+// Dynamic AABB tree for broad phase collision detection
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Each object is a proxy: a leaf holding a "fat" box, the object's bounds
+// expanded by a margin and by its predicted motion.  Moving an object only
+// touches the tree when its new bounds leave the fat box, and then it is
+// removed and reinserted in O(log n).  Insertion picks the sibling that
+// adds the least surface area, and tree rotations keep the tree balanced.
+//
+//===============================================================================
+
+#ifndef __IvAABBTree__h__
+#define __IvAABBTree__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvAABB.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// pair of overlapping proxies, with proxyA < proxyB
+struct IvProxyPair
+{
+    int proxyA;
+    int proxyB;
+};
+
+// tree node -- leaves are proxies
+struct IvAABBTreeNode
+{
+    inline bool IsLeaf() const { return child1 == -1; }
+
+    IvAABB      box;        // fat box for leaves, union of children otherwise
+    void*       userData;
+    int         parent;     // next free node when on the free list
+    int         child1;
+    int         child2;
+    int         height;     // 0 for leaves, -1 for free nodes
+};
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvAABBTree
+{
+public:
+    // constructor/destructor
+    explicit IvAABBTree( float margin = 0.1f );
+    ~IvAABBTree();
+
+    // proxies
+    int CreateProxy( const IvAABB& box, void* userData );
+    void DestroyProxy( int proxy );
+    // returns true if the proxy was reinserted -- its pairs may have changed
+    bool MoveProxy( int proxy, const IvAABB& box, const IvVector3& displacement );
+    void Clear();
+
+    // accessors
+    inline void* GetUserData( int proxy ) const       { return mNodes[proxy].userData; }
+    inline const IvAABB& GetFatBox( int proxy ) const { return mNodes[proxy].box; }
+    inline unsigned int GetProxyCount() const         { return mProxyCount; }
+    inline float GetMargin() const                    { return mMargin; }
+    int GetHeight() const;
+
+    // write the proxies whose fat boxes overlap box, up to maxResults,
+    // and return the number written
+    unsigned int Query( int* results, unsigned int maxResults, const IvAABB& box ) const;
+
+    // write overlapping pairs, up to maxPairs, and return the number written.
+    // Pairs are sorted and each appears once.
+    unsigned int FindPairs( IvProxyPair* pairs, unsigned int maxPairs ) const;
+    // only the pairs involving one of the given proxies, e.g. those moved
+    unsigned int FindPairs( IvProxyPair* pairs, unsigned int maxPairs,
+                            const int* proxies, unsigned int numProxies ) const;
+
+    // check the tree structure (debug builds)
+    void Validate() const;
+
+private:
+    // copy operations (unimplemented so we can't copy)
+    IvAABBTree( const IvAABBTree& other );
+    IvAABBTree& operator=( const IvAABBTree& other );
+
+    int AllocateNode();
+    void FreeNode( int node );
+    void InsertLeaf( int leaf );
+    void RemoveLeaf( int leaf );
+    void Refit( int node );
+    int Balance( int node );
+    unsigned int AddPairs( IvProxyPair* pairs, unsigned int numPairs, unsigned int maxPairs,
+                           int proxy, bool greaterOnly ) const;
+    unsigned int ValidateNode( int node ) const;
+
+    IvAABBTreeNode* mNodes;         // node pool
+    unsigned int    mCapacity;      // size of node pool
+    int             mRoot;          // -1 if empty
+    int             mFreeList;      // first free node, -1 if none
+    unsigned int    mProxyCount;    // number of leaves
+    float           mMargin;        // fat box expansion
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,994 @@
+//===============================================================================
+// @ IvBVH.cpp
+//
+// Static bounding volume hierarchy over axis-aligned boxes
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvBVH.h"
+#include "IvBoundingSphere.h"
+#include <IvAssert.h>
+#include <IvLineSegment3.h>
+#include <IvRay3.h>
+#include <IvSIMD.h>
+
+#include <algorithm>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// number of candidate split positions per axis, plus one
+static const unsigned int kNumBins = 16;
+// leaves larger than this are always split
+static const unsigned int kMaxLeafSize = 8;
+// below this depth, split at the median to bound the tree depth
+static const unsigned int kMedianDepth = IvBVH::kMaxDepth/2;
+// smallest subtree worth handing to another thread
+static const unsigned int kParallelSize = 4096;
+// smallest node worth splitting the bounds and binning passes between threads
+static const unsigned int kParallelBinSize = 65536;
+// cost of visiting a node, relative to testing one primitive
+static const float kTraversalCost = 1.0f;
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+namespace {
+
+// shared, read-only inputs to the build
+struct IvBVHBuildData
+{
+    const IvAABB*       boxes;
+    const IvVector3*    centroids;
+    unsigned int*       indices;    // reordered in place; threads own disjoint ranges
+};
+
+// bounds of a set of primitive boxes and of their centroids
+struct IvBVHBounds
+{
+    float           minima[3];
+    float           maxima[3];
+    float           centroidMinima[3];
+    float           centroidMaxima[3];
+};
+
+// bounds and count of the primitives whose centroids fall in one bin
+struct IvBVHBin
+{
+    float           minima[3];
+    float           maxima[3];
+    unsigned int    count;
+};
+
+// a row of bins for each axis
+struct IvBVHBins
+{
+    IvBVHBin        axis[3][kNumBins];
+};
+
+// maps centroids to bins along one axis
+struct IvBVHBinner
+{
+    inline unsigned int operator()( float value ) const
+    {
+        unsigned int bin = (unsigned int)( (value - mMin)*mScale );
+        return bin < kNumBins ? bin : kNumBins-1;
+    }
+
+    float mMin;
+    float mScale;
+};
+
+// true for primitives left of a split
+struct IvBVHLeftOfSplit
+{
+    inline bool operator()( unsigned int index ) const
+    {
+        return mBinner( mCentroids[index][mAxis] ) < mSplit;
+    }
+
+    const IvVector3*    mCentroids;
+    IvBVHBinner         mBinner;
+    unsigned int        mAxis;
+    unsigned int        mSplit;
+};
+
+// per-ray values for the node slab tests
+struct IvBVHRaySlab
+{
+    IvBVHRaySlab( const IvVector3& rayOrigin, const IvVector3& direction )
+    {
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            origin[i] = rayOrigin[i];
+            recipDirection[i] = 1.0f/direction[i];
+            nearSide[i] = recipDirection[i] >= 0.0f ? 0 : 1;
+        }
+#if defined(IV_SSE2)
+        // the fourth lane of each node half holds an index, masked off
+        xyzMask = _mm_castsi128_ps( _mm_set_epi32( 0, -1, -1, -1 ) );
+        origin4 = _mm_set_ps( 0.0f, origin[2], origin[1], origin[0] );
+        recip4 = _mm_set_ps( 0.0f, recipDirection[2], recipDirection[1], recipDirection[0] );
+        nearMaxMask = _mm_castsi128_ps( _mm_set_epi32( 0, -int(nearSide[2]), -int(nearSide[1]),
+                                                       -int(nearSide[0]) ) );
+#endif
+    }
+
+    float           origin[3];
+    float           recipDirection[3];
+    unsigned int    nearSide[3];    // 0 if entering through the minimum, 1 if the maximum
+#if defined(IV_SSE2)
+    __m128          xyzMask;
+    __m128          origin4;
+    __m128          recip4;
+    __m128          nearMaxMask;
+#endif
+};
+
+// orders primitives by centroid along one axis
+struct IvBVHCentroidLess
+{
+    inline bool operator()( unsigned int a, unsigned int b ) const
+    {
+        return mCentroids[a][mAxis] < mCentroids[b][mAxis];
+    }
+
+    const IvVector3*    mCentroids;
+    unsigned int        mAxis;
+};
+
+}
+
+//-------------------------------------------------------------------------------
+// @ Empty()
+//-------------------------------------------------------------------------------
+// Set bounds to an empty, inverted box
+//-------------------------------------------------------------------------------
+static inline void
+Empty( float* minima, float* maxima )
+{
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        minima[i] = FLT_MAX;
+        maxima[i] = -FLT_MAX;
+    }
+
+}   // End of Empty()
+
+
+//-------------------------------------------------------------------------------
+// @ Grow()
+//-------------------------------------------------------------------------------
+// Expand bounds to include a box
+//-------------------------------------------------------------------------------
+static inline void
+Grow( float* minima, float* maxima, const float* boxMinima, const float* boxMaxima )
+{
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        minima[i] = boxMinima[i] < minima[i] ? boxMinima[i] : minima[i];
+        maxima[i] = boxMaxima[i] > maxima[i] ? boxMaxima[i] : maxima[i];
+    }
+
+}   // End of Grow()
+
+
+//-------------------------------------------------------------------------------
+// @ HalfArea()
+//-------------------------------------------------------------------------------
+// Half the surface area of a box -- the SAH only needs ratios
+//-------------------------------------------------------------------------------
+static inline float
+HalfArea( const float* minima, const float* maxima )
+{
+    float dx = maxima[0] - minima[0];
+    float dy = maxima[1] - minima[1];
+    float dz = maxima[2] - minima[2];
+    return dx*dy + dy*dz + dz*dx;
+
+}   // End of HalfArea()
+
+
+//-------------------------------------------------------------------------------
+// @ ComputeBounds()
+//-------------------------------------------------------------------------------
+// Bounds of the primitives in [begin, end)
+//-------------------------------------------------------------------------------
+static void
+ComputeBounds( IvBVHBounds& bounds, const IvBVHBuildData& data, unsigned int begin,
+               unsigned int end )
+{
+    Empty( bounds.minima, bounds.maxima );
+    Empty( bounds.centroidMinima, bounds.centroidMaxima );
+    for ( unsigned int i = begin; i < end; ++i )
+    {
+        unsigned int index = data.indices[i];
+        const IvAABB& box = data.boxes[index];
+        Grow( bounds.minima, bounds.maxima, &box.GetMinima().x, &box.GetMaxima().x );
+        const float* centroid = &data.centroids[index].x;
+        Grow( bounds.centroidMinima, bounds.centroidMaxima, centroid, centroid );
+    }
+
+}   // End of ComputeBounds()
+
+
+//-------------------------------------------------------------------------------
+// @ BinPrimitives()
+//-------------------------------------------------------------------------------
+// Sort the primitives in [begin, end) into bins along each axis
+//-------------------------------------------------------------------------------
+static void
+BinPrimitives( IvBVHBins& bins, const IvBVHBinner* binners, const IvBVHBuildData& data,
+               unsigned int begin, unsigned int end )
+{
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        for ( unsigned int b = 0; b < kNumBins; ++b )
+        {
+            Empty( bins.axis[axis][b].minima, bins.axis[axis][b].maxima );
+            bins.axis[axis][b].count = 0;
+        }
+    }
+
+    for ( unsigned int i = begin; i < end; ++i )
+    {
+        unsigned int index = data.indices[i];
+        const float* boxMinima = &data.boxes[index].GetMinima().x;
+        const float* boxMaxima = &data.boxes[index].GetMaxima().x;
+        for ( unsigned int axis = 0; axis < 3; ++axis )
+        {
+            IvBVHBin& bin = bins.axis[axis][binners[axis]( data.centroids[index][axis] )];
+            Grow( bin.minima, bin.maxima, boxMinima, boxMaxima );
+            ++bin.count;
+        }
+    }
+
+}   // End of BinPrimitives()
+
+
+//-------------------------------------------------------------------------------
+// @ ParallelBounds()
+//-------------------------------------------------------------------------------
+// ComputeBounds() split into one block per thread and merged.  Bounds
+// merge exactly, so the result doesn't depend on the thread count.
+//-------------------------------------------------------------------------------
+static void
+ParallelBounds( IvBVHBounds& bounds, const IvBVHBuildData& data, unsigned int begin,
+                unsigned int end, unsigned int numThreads )
+{
+    unsigned int count = end - begin;
+    if ( numThreads < 2 || count < kParallelBinSize )
+    {
+        ComputeBounds( bounds, data, begin, end );
+        return;
+    }
+
+    unsigned int blockSize = (count + numThreads - 1)/numThreads;
+    std::vector<IvBVHBounds> blockBounds( numThreads );
+    std::vector<std::thread> workers;
+    for ( unsigned int t = 1; t < numThreads; ++t )
+    {
+        unsigned int blockBegin = begin + t*blockSize;
+        unsigned int blockEnd = blockBegin + blockSize < end ? blockBegin + blockSize : end;
+        if ( blockBegin > blockEnd )
+            blockBegin = blockEnd;
+        workers.push_back( std::thread( ComputeBounds, std::ref( blockBounds[t] ), std::cref( data ),
+                                        blockBegin, blockEnd ) );
+    }
+
+    // first block on the calling thread
+    ComputeBounds( bounds, data, begin, begin + blockSize );
+
+    for ( unsigned int t = 0; t < workers.size(); ++t )
+    {
+        workers[t].join();
+    }
+    for ( unsigned int t = 1; t < numThreads; ++t )
+    {
+        Grow( bounds.minima, bounds.maxima, blockBounds[t].minima, blockBounds[t].maxima );
+        Grow( bounds.centroidMinima, bounds.centroidMaxima,
+              blockBounds[t].centroidMinima, blockBounds[t].centroidMaxima );
+    }
+
+}   // End of ParallelBounds()
+
+
+//-------------------------------------------------------------------------------
+// @ ParallelBinPrimitives()
+//-------------------------------------------------------------------------------
+// BinPrimitives() split into one block per thread and merged
+//-------------------------------------------------------------------------------
+static void
+ParallelBinPrimitives( IvBVHBins& bins, const IvBVHBinner* binners, const IvBVHBuildData& data,
+                       unsigned int begin, unsigned int end, unsigned int numThreads )
+{
+    unsigned int count = end - begin;
+    if ( numThreads < 2 || count < kParallelBinSize )
+    {
+        BinPrimitives( bins, binners, data, begin, end );
+        return;
+    }
+
+    unsigned int blockSize = (count + numThreads - 1)/numThreads;
+    std::vector<IvBVHBins> blockBins( numThreads );
+    std::vector<std::thread> workers;
+    for ( unsigned int t = 1; t < numThreads; ++t )
+    {
+        unsigned int blockBegin = begin + t*blockSize;
+        unsigned int blockEnd = blockBegin + blockSize < end ? blockBegin + blockSize : end;
+        if ( blockBegin > blockEnd )
+            blockBegin = blockEnd;
+        workers.push_back( std::thread( BinPrimitives, std::ref( blockBins[t] ), binners,
+                                        std::cref( data ), blockBegin, blockEnd ) );
+    }
+
+    // first block on the calling thread
+    BinPrimitives( bins, binners, data, begin, begin + blockSize );
+
+    for ( unsigned int t = 0; t < workers.size(); ++t )
+    {
+        workers[t].join();
+    }
+    for ( unsigned int t = 1; t < numThreads; ++t )
+    {
+        for ( unsigned int axis = 0; axis < 3; ++axis )
+        {
+            for ( unsigned int b = 0; b < kNumBins; ++b )
+            {
+                IvBVHBin& bin = bins.axis[axis][b];
+                const IvBVHBin& blockBin = blockBins[t].axis[axis][b];
+                Grow( bin.minima, bin.maxima, blockBin.minima, blockBin.maxima );
+                bin.count += blockBin.count;
+            }
+        }
+    }
+
+}   // End of ParallelBinPrimitives()
+
+
+//-------------------------------------------------------------------------------
+// @ AppendSubtree()
+//-------------------------------------------------------------------------------
+// Append a subtree built on its own, rebasing its child links
+//-------------------------------------------------------------------------------
+static void
+AppendSubtree( std::vector<IvBVHNode>& nodes, const std::vector<IvBVHNode>& subtree )
+{
+    unsigned int base = (unsigned int) nodes.size();
+    nodes.insert( nodes.end(), subtree.begin(), subtree.end() );
+    for ( unsigned int i = base; i < nodes.size(); ++i )
+    {
+        if ( !nodes[i].IsLeaf() )
+            nodes[i].offset += base;
+    }
+
+}   // End of AppendSubtree()
+
+
+//-------------------------------------------------------------------------------
+// @ BuildSubtree()
+//-------------------------------------------------------------------------------
+// Build the tree over indices [begin, end), appending its nodes depth-first.
+// Large subtrees are split between threads, each building into its own
+// array; the arrays are joined in the same order the serial build uses.
+// Near the root, where there are fewer subtrees than threads, the passes
+// over the primitives are split between threads instead.
+//-------------------------------------------------------------------------------
+static void
+BuildSubtree( std::vector<IvBVHNode>& nodes, const IvBVHBuildData& data,
+              unsigned int begin, unsigned int end, unsigned int depth,
+              unsigned int numThreads )
+{
+    ASSERT( begin < end && depth < IvBVH::kMaxDepth );
+
+    unsigned int nodeIndex = (unsigned int) nodes.size();
+    nodes.push_back( IvBVHNode() );
+
+    IvBVHBounds bounds;
+    ParallelBounds( bounds, data, begin, end, numThreads );
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        nodes[nodeIndex].minima[i] = bounds.minima[i];
+        nodes[nodeIndex].maxima[i] = bounds.maxima[i];
+    }
+
+    unsigned int count = end - begin;
+    unsigned int mid = begin;
+    if ( depth >= kMedianDepth )
+    {
+        // deep in the tree -- halve the count to bound the depth
+        if ( count > kMaxLeafSize )
+        {
+            unsigned int axis = 0;
+            for ( unsigned int i = 1; i < 3; ++i )
+            {
+                if ( bounds.centroidMaxima[i] - bounds.centroidMinima[i] >
+                     bounds.centroidMaxima[axis] - bounds.centroidMinima[axis] )
+                    axis = i;
+            }
+            IvBVHCentroidLess less = { data.centroids, axis };
+            mid = begin + count/2;
+            std::nth_element( data.indices + begin, data.indices + mid, data.indices + end, less );
+        }
+    }
+    else
+    {
+        // bin the centroids along each axis
+        IvBVHBins bins;
+        IvBVHBinner binners[3];
+        for ( unsigned int axis = 0; axis < 3; ++axis )
+        {
+            float extent = bounds.centroidMaxima[axis] - bounds.centroidMinima[axis];
+            binners[axis].mMin = bounds.centroidMinima[axis];
+            binners[axis].mScale = extent > 0.0f ? float(kNumBins)/extent : 0.0f;
+        }
+        ParallelBinPrimitives( bins, binners, data, begin, end, numThreads );
+
+        // sweep each axis for the cheapest split:
+        // cost = area(left)*count(left) + area(right)*count(right)
+        float bestCost = FLT_MAX;
+        unsigned int bestAxis = 0;
+        unsigned int bestSplit = 0;
+        for ( unsigned int axis = 0; axis < 3; ++axis )
+        {
+            if ( binners[axis].mScale == 0.0f )
+                continue;
+
+            const IvBVHBin* row = bins.axis[axis];
+            float rightCost[kNumBins];
+            unsigned int rightCount[kNumBins];
+            float sweepMinima[3], sweepMaxima[3];
+            unsigned int sweepCount = 0;
+            Empty( sweepMinima, sweepMaxima );
+            for ( unsigned int b = kNumBins-1; b > 0; --b )
+            {
+                Grow( sweepMinima, sweepMaxima, row[b].minima, row[b].maxima );
+                sweepCount += row[b].count;
+                rightCount[b] = sweepCount;
+                rightCost[b] = sweepCount > 0 ? sweepCount*HalfArea( sweepMinima, sweepMaxima ) : 0.0f;
+            }
+
+            Empty( sweepMinima, sweepMaxima );
+            sweepCount = 0;
+            for ( unsigned int split = 1; split < kNumBins; ++split )
+            {
+                Grow( sweepMinima, sweepMaxima, row[split-1].minima, row[split-1].maxima );
+                sweepCount += row[split-1].count;
+                if ( sweepCount == 0 || rightCount[split] == 0 )
+                    continue;
+                float cost = sweepCount*HalfArea( sweepMinima, sweepMaxima ) + rightCost[split];
+                if ( cost < bestCost )
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = split;
+                }
+            }
+        }
+
+        float area = HalfArea( bounds.minima, bounds.maxima );
+        if ( bestSplit > 0 && ( count > kMaxLeafSize ||
+                                kTraversalCost*area + bestCost < count*area ) )
+        {
+            IvBVHLeftOfSplit leftOfSplit = { data.centroids, binners[bestAxis], bestAxis, bestSplit };
+            mid = (unsigned int)( std::partition( data.indices + begin, data.indices + end,
+                                                  leftOfSplit ) - data.indices );
+        }
+        else if ( count > kMaxLeafSize )
+        {
+            // centroids all coincide, any split is as good as another
+            mid = begin + count/2;
+        }
+    }
+
+    // leaf
+    if ( mid == begin || mid == end )
+    {
+        nodes[nodeIndex].offset = begin;
+        nodes[nodeIndex].count = count;
+        return;
+    }
+
+    // interior node -- first child follows directly
+    nodes[nodeIndex].count = 0;
+    if ( numThreads > 1 && count >= kParallelSize )
+    {
+        unsigned int leftThreads = numThreads/2;
+        std::vector<IvBVHNode> left;
+        std::vector<IvBVHNode> right;
+        std::thread worker( BuildSubtree, std::ref( left ), std::cref( data ), begin, mid,
+                            depth+1, leftThreads );
+        BuildSubtree( right, data, mid, end, depth+1, numThreads - leftThreads );
+        worker.join();
+
+        AppendSubtree( nodes, left );
+        nodes[nodeIndex].offset = (unsigned int) nodes.size();
+        AppendSubtree( nodes, right );
+    }
+    else
+    {
+        BuildSubtree( nodes, data, begin, mid, depth+1, numThreads );
+        nodes[nodeIndex].offset = (unsigned int) nodes.size();
+        BuildSubtree( nodes, data, mid, end, depth+1, numThreads );
+    }
+
+}   // End of BuildSubtree()
+
+
+//-------------------------------------------------------------------------------
+// @ RayHitsNode()
+//-------------------------------------------------------------------------------
+// Slab test against a node's box for parameters in [0, tMax].  Same result
+// as IvAABB::Intersect(), with the reciprocal direction and the near side of
+// each slab worked out once per ray so there are no branches per axis.
+//-------------------------------------------------------------------------------
+static inline bool
+RayHitsNode( float& tEnter, const IvBVHNode& node, const IvBVHRaySlab& ray, float tMax )
+{
+#if defined(IV_SSE2)
+    // nodes are 16-byte aligned, so each half is one load
+    __m128 minima = IvAnd( IvLoad<__m128>( node.minima ), ray.xyzMask );
+    __m128 maxima = IvAnd( IvLoad<__m128>( node.maxima ), ray.xyzMask );
+    __m128 s = IvMul( IvSub( IvSelect( ray.nearMaxMask, maxima, minima ), ray.origin4 ), ray.recip4 );
+    __m128 t = IvMul( IvSub( IvSelect( ray.nearMaxMask, minima, maxima ), ray.origin4 ), ray.recip4 );
+    // fourth lane clamps the interval to [0, tMax]
+    t = IvSelect( ray.xyzMask, t, _mm_set1_ps( tMax ) );
+    s = IvMax( s, _mm_shuffle_ps( s, s, _MM_SHUFFLE(1,0,3,2) ) );
+    s = IvMax( s, _mm_shuffle_ps( s, s, _MM_SHUFFLE(2,3,0,1) ) );
+    t = IvMin( t, _mm_shuffle_ps( t, t, _MM_SHUFFLE(1,0,3,2) ) );
+    t = IvMin( t, _mm_shuffle_ps( t, t, _MM_SHUFFLE(2,3,0,1) ) );
+    tEnter = _mm_cvtss_f32( s );
+    return _mm_comile_ss( s, t ) != 0;
+#else
+    const float* bounds[2] = { node.minima, node.maxima };
+    float tMin = 0.0f;
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        float s = (bounds[ray.nearSide[i]][i] - ray.origin[i])*ray.recipDirection[i];
+        float t = (bounds[1-ray.nearSide[i]][i] - ray.origin[i])*ray.recipDirection[i];
+        tMin = s > tMin ? s : tMin;
+        tMax = t < tMax ? t : tMax;
+    }
+    tEnter = tMin;
+    return tMin <= tMax;
+#endif
+
+}   // End of RayHitsNode()
+
+
+namespace {
+
+// query shapes for Gather() -- a node test and a primitive test
+
+struct IvBVHBoxQuery
+{
+    inline bool TestNode( const IvBVHNode& node ) const
+    {
+        const IvVector3& minima = mBox.GetMinima();
+        const IvVector3& maxima = mBox.GetMaxima();
+        return !( node.minima[0] > maxima.x || minima.x > node.maxima[0] ||
+                  node.minima[1] > maxima.y || minima.y > node.maxima[1] ||
+                  node.minima[2] > maxima.z || minima.z > node.maxima[2] );
+    }
+    inline bool TestPrimitive( const IvAABB& box ) const { return box.Intersect( mBox ); }
+
+    const IvAABB& mBox;
+};
+
+struct IvBVHSphereQuery
+{
+    inline bool TestNode( const IvBVHNode& node ) const
+    {
+        const IvVector3& center = mSphere.GetCenter();
+        float distanceSquared = 0.0f;
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            float d = center[i] < node.minima[i] ? node.minima[i] - center[i] :
+                      center[i] > node.maxima[i] ? center[i] - node.maxima[i] : 0.0f;
+            distanceSquared += d*d;
+        }
+        return distanceSquared <= mSphere.GetRadius()*mSphere.GetRadius();
+    }
+    inline bool TestPrimitive( const IvAABB& box ) const { return box.Intersect( mSphere ); }
+
+    const IvBoundingSphere& mSphere;
+};
+
+template <class Primitive>
+struct IvBVHSlabQuery
+{
+    IvBVHSlabQuery( const Primitive& primitive, float tMax ) :
+        mPrimitive( primitive ), mSlab( primitive.GetOrigin(), primitive.GetDirection() ), mTMax( tMax )
+    {
+    }
+    inline bool TestNode( const IvBVHNode& node ) const
+    {
+        float tEnter;
+        return RayHitsNode( tEnter, node, mSlab, mTMax );
+    }
+    inline bool TestPrimitive( const IvAABB& box ) const { return box.Intersect( mPrimitive ); }
+
+    const Primitive&    mPrimitive;
+    IvBVHRaySlab        mSlab;
+    float               mTMax;
+};
+
+}
+
+//-------------------------------------------------------------------------------
+// @ Gather()
+//-------------------------------------------------------------------------------
+// Depth-first walk collecting the primitives that pass the query
+//-------------------------------------------------------------------------------
+template <class Query>
+static unsigned int
+Gather( unsigned int* results, unsigned int maxResults, const Query& query,
+        const IvBVHNode* nodes, unsigned int nodeCount, const IvAABB* boxes,
+        const unsigned int* indices )
+{
+    ASSERT( results || maxResults == 0 );
+
+    if ( nodeCount == 0 || !query.TestNode( nodes[0] ) )
+        return 0;
+
+    unsigned int stack[IvBVH::kMaxDepth];
+    unsigned int stackSize = 0;
+    unsigned int numResults = 0;
+    unsigned int current = 0;
+    for ( ;; )
+    {
+        const IvBVHNode& node = nodes[current];
+        if ( node.IsLeaf() )
+        {
+            unsigned int last = node.offset + node.count;
+            for ( unsigned int i = node.offset; i < last; ++i )
+            {
+                if ( query.TestPrimitive( boxes[i] ) )
+                {
+                    if ( numResults == maxResults )
+                        return numResults;
+                    results[numResults++] = indices[i];
+                }
+            }
+        }
+        else
+        {
+            unsigned int left = current + 1;
+            unsigned int right = node.offset;
+            bool hitLeft = query.TestNode( nodes[left] );
+            bool hitRight = query.TestNode( nodes[right] );
+            if ( hitLeft )
+            {
+                if ( hitRight )
+                    stack[stackSize++] = right;
+                current = left;
+                continue;
+            }
+            if ( hitRight )
+            {
+                current = right;
+                continue;
+            }
+        }
+
+        if ( stackSize == 0 )
+            break;
+        current = stack[--stackSize];
+    }
+
+    return numResults;
+
+}   // End of Gather()
+
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvBVH::IvBVH()
+//-------------------------------------------------------------------------------
+// Default constructor -- empty tree
+//-------------------------------------------------------------------------------
+IvBVH::IvBVH() :
+    mCount( 0 ),
+    mNodeCount( 0 ),
+    mNodes( 0 ),
+    mNodeBuffer( 0 ),
+    mBoxes( 0 ),
+    mIndices( 0 )
+{
+}   // End of IvBVH::IvBVH()
+
+
+//-------------------------------------------------------------------------------
+// @ IvBVH::~IvBVH()
+//-------------------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------------------
+IvBVH::~IvBVH()
+{
+    Clear();
+
+}   // End of IvBVH::~IvBVH()
+
+
+//-------------------------------------------------------------------------------
+// @ IvBVH::Clear()
+//-------------------------------------------------------------------------------
+// Release the tree
+//-------------------------------------------------------------------------------
+void
+IvBVH::Clear()
+{
+    delete [] mNodeBuffer;
+    delete [] mBoxes;
+    delete [] mIndices;
+
+    mCount = 0;
+    mNodeCount = 0;
+    mNodes = 0;
+    mNodeBuffer = 0;
+    mBoxes = 0;
+    mIndices = 0;
+
+}   // End of IvBVH::Clear()
+
+
+//-------------------------------------------------------------------------------
+// @ IvBVH::Build()
+//-------------------------------------------------------------------------------
+// Build tree over a set of primitive boxes
+//-------------------------------------------------------------------------------
+void
+IvBVH::Build( const IvAABB* boxes, unsigned int count, unsigned int numThreads )
+{
+    Clear();
+    if ( count == 0 )
+        return;
+    ASSERT( boxes );
+
+    std::vector<IvVector3> centroids( count );
+    std::vector<unsigned int> indices( count );
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        centroids[i] = 0.5f*(boxes[i].GetMinima() + boxes[i].GetMaxima());
+        indices[i] = i;
+    }
+
+    IvBVHBuildData data = { boxes, &centroids[0], &indices[0] };
+    std::vector<IvBVHNode> nodes;
+    nodes.reserve( 2*(count/kMaxLeafSize) + 1 );
+    BuildSubtree( nodes, data, 0, count, 0, numThreads > 0 ? numThreads : 1 );
+
+    // copy out, with the nodes aligned to cache line halves
+    mCount = count;
+    mNodeCount = (unsigned int) nodes.size();
+    mNodeBuffer = new char[mNodeCount*sizeof(IvBVHNode) + 32];
+    mNodes = reinterpret_cast<IvBVHNode*>( (reinterpret_cast<size_t>(mNodeBuffer) + 31) & ~size_t(31) );
+    memcpy( mNodes, &nodes[0], mNodeCount*sizeof(IvBVHNode) );
+
+    mBoxes = new IvAABB[count];
+    mIndices = new unsigned int[count];
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        mBoxes[i] = boxes[indices[i]];
+        mIndices[i] = indices[i];
+    }
+
+}   // End of IvBVH::Build()
+
+
+//-------------------------------------------------------------------------------
+// @ IvBVH::Refit()
+//-------------------------------------------------------------------------------
+// Recompute node bounds bottom up.  Children are stored after their parent,
+// so walking the nodes backwards reaches them first.
+//-------------------------------------------------------------------------------
+void
+IvBVH::Refit( const IvAABB* boxes )
+{
+    if ( mCount == 0 )
+        return;
+    ASSERT( boxes );
+
+    for ( unsigned int i = 0; i < mCount; ++i )
+    {
+        mBoxes[i] = boxes[mIndices[i]];
+    }
+
+    for ( unsigned int n = mNodeCount; n > 0; --n )
+    {
+        IvBVHNode& node = mNodes[n-1];
+        Empty( node.minima, node.maxima );
+        if ( node.IsLeaf() )
+        {
+            unsigned int last = node.offset + node.count;
+            for ( unsigned int i = node.offset; i < last; ++i )
+            {
+                Grow( node.minima, node.maxima, &mBoxes[i].GetMinima().x, &mBoxes[i].GetMaxima().x );
+            }
+        }
+        else
+        {
+            const IvBVHNode& child0 = mNodes[n];
+            const IvBVHNode& child1 = mNodes[node.offset];
+            Grow( node.minima, node.maxima, child0.minima, child0.maxima );
+            Grow( node.minima, node.maxima, child1.minima, child1.maxima );
+        }
+    }
+
+}   // End of IvBVH::Refit()
+
+
+//-------------------------------------------------------------------------------
+// @ IvBVH::GetBounds()
+//-------------------------------------------------------------------------------
+// Box around all primitives
+//-------------------------------------------------------------------------------
+IvAABB
+IvBVH::GetBounds() const
+{
+    if ( mNodeCount == 0 )
+        return IvAABB();
+
+    return IvAABB( IvVector3( mNodes[0].minima[0], mNodes[0].minima[1], mNodes[0].minima[2] ),
+                   IvVector3( mNodes[0].maxima[0], mNodes[0].maxima[1], mNodes[0].maxima[2] ) );
+
+}   // End of IvBVH::GetBounds()
+
+
+//-------------------------------------------------------------------------------
+// @ IvBVH::Intersect()
+//-------------------------------------------------------------------------------
+// Primitives overlapping a box
+//-------------------------------------------------------------------------------
+unsigned int
+IvBVH::Intersect( unsigned int* results, unsigned int maxResults, const IvAABB& box ) const
+{
+    IvBVHBoxQuery query = { box };
+    return Gather( results, maxResults, query, mNodes, mNodeCount, mBoxes, mIndices );
+
+}   // End of IvBVH::Intersect()
+
+
+//-------------------------------------------------------------------------------
+// @ IvBVH::Intersect()
+//-------------------------------------------------------------------------------
+// Primitives overlapping a sphere
+//-------------------------------------------------------------------------------
+unsigned int
+IvBVH::Intersect( unsigned int* results, unsigned int maxResults,
+                  const IvBoundingSphere& sphere ) const
+{
+    IvBVHSphereQuery query = { sphere };
+    return Gather( results, maxResults, query, mNodes, mNodeCount, mBoxes, mIndices );
+
+}   // End of IvBVH::Intersect()
+
+
+//-------------------------------------------------------------------------------
+// @ IvBVH::Intersect()
+//-------------------------------------------------------------------------------
+// Primitives hit by a ray
+//-------------------------------------------------------------------------------
+unsigned int
+IvBVH::Intersect( unsigned int* results, unsigned int maxResults, const IvRay3& ray ) const
+{
+    IvBVHSlabQuery<IvRay3> query( ray, FLT_MAX );
+    return Gather( results, maxResults, query, mNodes, mNodeCount, mBoxes, mIndices );
+
+}   // End of IvBVH::Intersect()
+
+
+//-------------------------------------------------------------------------------
+// @ IvBVH::Intersect()
+//-------------------------------------------------------------------------------
+// Primitives hit by a line segment
+//-------------------------------------------------------------------------------
+unsigned int
+IvBVH::Intersect( unsigned int* results, unsigned int maxResults,
+                  const IvLineSegment3& segment ) const
+{
+    IvBVHSlabQuery<IvLineSegment3> query( segment, 1.0f );
+    return Gather( results, maxResults, query, mNodes, mNodeCount, mBoxes, mIndices );
+
+}   // End of IvBVH::Intersect()
+
+
+//-------------------------------------------------------------------------------
+// @ IvBVH::Intersect()
+//-------------------------------------------------------------------------------
+// Nearest primitive hit by a ray.  Children are visited nearest first, and
+// postponed subtrees are skipped once a hit is closer than their entry point.
+//-------------------------------------------------------------------------------
+bool
+IvBVH::Intersect( float& t, unsigned int& index, const IvRay3& ray,
+                  IvBVHRayTest test, void* userData ) const
+{
+    ASSERT( test );
+
+    IvBVHRaySlab slab( ray.GetOrigin(), ray.GetDirection() );
+    float tEnter;
+    if ( mNodeCount == 0 || !RayHitsNode( tEnter, mNodes[0], slab, t ) )
+        return false;
+
+    struct
+    {
+        unsigned int node;
+        float tEnter;
+    } stack[kMaxDepth];
+    unsigned int stackSize = 0;
+    unsigned int current = 0;
+    bool hit = false;
+    for ( ;; )
+    {
+        const IvBVHNode& node = mNodes[current];
+        if ( node.IsLeaf() )
+        {
+            unsigned int last = node.offset + node.count;
+            for ( unsigned int i = node.offset; i < last; ++i )
+            {
+                if ( test( t, mIndices[i], ray, userData ) )
+                {
+                    index = mIndices[i];
+                    hit = true;
+                }
+            }
+        }
+        else
+        {
+            unsigned int nearChild = current + 1;
+            unsigned int farChild = node.offset;
+            float tNear, tFar;
+            bool hitNear = RayHitsNode( tNear, mNodes[nearChild], slab, t );
+            bool hitFar = RayHitsNode( tFar, mNodes[farChild], slab, t );
+            if ( hitNear && hitFar )
+            {
+                if ( tFar < tNear )
+                {
+                    unsigned int temp = nearChild;
+                    nearChild = farChild;
+                    farChild = temp;
+                    tFar = tNear;
+                }
+                stack[stackSize].node = farChild;
+                stack[stackSize].tEnter = tFar;
+                ++stackSize;
+                current = nearChild;
+                continue;
+            }
+            if ( hitNear || hitFar )
+            {
+                current = hitNear ? nearChild : farChild;
+                continue;
+            }
+        }
+
+        // next postponed subtree that could still hold a nearer hit
+        do
+        {
+            if ( stackSize == 0 )
+                return hit;
+            --stackSize;
+        }
+        while ( stack[stackSize].tEnter > t );
+        current = stack[stackSize].node;
+    }
+
+}   // End of IvBVH::Intersect()
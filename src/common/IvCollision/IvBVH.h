@@ -0,0 +1,124 @@
+//===============================================================================
+// @ IvBVH.h
+//
+// Static bounding volume hierarchy over axis-aligned boxes
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// The tree is built top-down with a binned surface area heuristic and
+// stored depth-first in one array of 32-byte nodes: an interior node's
+// first child directly follows it, and the node stores the index of the
+// second child.  Leaves store a run of primitives, whose boxes are kept in
+// leaf order so the query tests walk memory linearly.
+//
+//===============================================================================
+
+#ifndef __IvBVH__h__
+#define __IvBVH__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvAABB.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvBoundingSphere;
+class IvLineSegment3;
+class IvRay3;
+
+// flattened tree node
+struct IvBVHNode
+{
+    float           minima[3];
+    unsigned int    offset;     // leaf: first primitive, interior: second child
+    float           maxima[3];
+    unsigned int    count;      // primitives in leaf, 0 for interior nodes
+
+    inline bool IsLeaf() const { return count > 0; }
+};
+
+// primitive test for the nearest-hit ray query -- return true and set t
+// if primitive index is hit by the ray nearer than the t passed in
+typedef bool (*IvBVHRayTest)( float& t, unsigned int index, const IvRay3& ray, void* userData );
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvBVH
+{
+public:
+    // largest tree depth; deeper subtrees are split at the median instead
+    static const unsigned int kMaxDepth = 64;
+
+    // constructor/destructor
+    IvBVH();
+    ~IvBVH();
+
+    // build over count primitive boxes, using up to numThreads threads
+    // (including the calling one).  The tree doesn't depend on the thread count.
+    void Build( const IvAABB* boxes, unsigned int count, unsigned int numThreads = 1 );
+    void Clear();
+
+    // new boxes for the same primitives, e.g. when a mesh deforms.  The
+    // tree keeps its shape, so queries slow down if primitives move far
+    // from where they were built; rebuild then.
+    void Refit( const IvAABB* boxes );
+
+    // accessors
+    inline unsigned int GetNodeCount() const      { return mNodeCount; }
+    inline unsigned int GetPrimitiveCount() const { return mCount; }
+    inline const IvBVHNode* GetNodes() const      { return mNodes; }
+    // original index of the i'th primitive in leaf order
+    inline const unsigned int* GetIndices() const { return mIndices; }
+    IvAABB GetBounds() const;
+
+    // overlap queries -- write the indices of the primitives whose boxes
+    // pass IvAABB::Intersect() to results, up to maxResults, and return
+    // the number written
+    unsigned int Intersect( unsigned int* results, unsigned int maxResults,
+                            const IvAABB& box ) const;
+    unsigned int Intersect( unsigned int* results, unsigned int maxResults,
+                            const IvBoundingSphere& sphere ) const;
+    unsigned int Intersect( unsigned int* results, unsigned int maxResults,
+                            const IvRay3& ray ) const;
+    unsigned int Intersect( unsigned int* results, unsigned int maxResults,
+                            const IvLineSegment3& segment ) const;
+
+    // nearest hit -- visits leaves front to back, calling test on each
+    // primitive whose box might be hit nearer than t.  On input t is the
+    // largest distance to consider; returns true and sets t and index if
+    // anything was hit.
+    bool Intersect( float& t, unsigned int& index, const IvRay3& ray,
+                    IvBVHRayTest test, void* userData ) const;
+
+private:
+    // copy operations (unimplemented so we can't copy)
+    IvBVH( const IvBVH& other );
+    IvBVH& operator=( const IvBVH& other );
+
+    unsigned int    mCount;         // number of primitives
+    unsigned int    mNodeCount;     // number of nodes
+    IvBVHNode*      mNodes;         // depth-first nodes, 32-byte aligned
+    char*           mNodeBuffer;    // unaligned node allocation
+    IvAABB*         mBoxes;         // primitive boxes in leaf order
+    unsigned int*   mIndices;       // original primitive indices in leaf order
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
@@ -26,10 +26,409 @@
 #include "IvAssert.h"
 #include "IvQuat.h"
 
+#include <float.h>
+#include <thread>
+#include <vector>
+
 //-------------------------------------------------------------------------------
 //-- Static Members -------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+// smallest point set worth splitting between threads
+static const unsigned int kParallelSize = 16384;
+
+// relative tolerance on the squared radius for points on the sphere
+static const float kContainTolerance = 1.0e-5f;
+
+// relative size below which support points are treated as collinear or
+// coplanar
+static const float kDegenerateTolerance = 1.0e-6f;
+
+// most points the exact fit adds before it stops and enlarges the sphere
+static const unsigned int kMaxPivots = 64;
+
+// directions to find extreme points along: the axes, then the box diagonals.
+// The exact fit only needs a starting point, so it uses just the axes.
+static const unsigned int kMaxDirections = 7;
+static const float kDirections[kMaxDirections][3] =
+{
+    { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+    { 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, -1.0f }, { 1.0f, -1.0f, 1.0f }, { 1.0f, -1.0f, -1.0f }
+};
+static const unsigned int kExactDirections = 3;
+static const unsigned int kApproximateDirections = kMaxDirections;
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// per-block results of the passes over the points
+struct IvSphereExtremes
+{
+    float           minDot[kMaxDirections];
+    float           maxDot[kMaxDirections];
+    unsigned int    minIndex[kMaxDirections];
+    unsigned int    maxIndex[kMaxDirections];
+};
+
+struct IvSphereFarthest
+{
+    IvVector3       center;
+    float           distanceSq;
+    unsigned int    index;
+};
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ Contains()
+//-------------------------------------------------------------------------------
+// Is point inside the sphere, within tolerance?  A negative radius squared
+// is an empty sphere.
+//-------------------------------------------------------------------------------
+static inline bool
+Contains( const IvVector3& center, float radiusSq, const IvVector3& point )
+{
+    return ::DistanceSquared( center, point ) <= radiusSq + kContainTolerance*radiusSq;
+
+}   // End of Contains()
+
+
+//-------------------------------------------------------------------------------
+// @ Circumsphere()
+//-------------------------------------------------------------------------------
+// Smallest sphere with all count (up to 4) support points on its surface.
+// Returns false if the points are collinear or coplanar, so there isn't one.
+//-------------------------------------------------------------------------------
+static bool
+Circumsphere( IvVector3& center, float& radiusSq, const IvVector3* support, unsigned int count )
+{
+    switch ( count )
+    {
+    case 0:
+        center = IvVector3::origin;
+        radiusSq = -1.0f;
+        return true;
+
+    case 1:
+        center = support[0];
+        radiusSq = 0.0f;
+        return true;
+
+    case 2:
+        center = 0.5f*(support[0] + support[1]);
+        radiusSq = ::DistanceSquared( center, support[0] );
+        return true;
+
+    case 3:
+        {
+            // center lies in the plane of the triangle
+            IvVector3 a = support[1] - support[0];
+            IvVector3 b = support[2] - support[0];
+            IvVector3 normal = a.Cross( b );
+            float normalSq = normal.Dot( normal );
+            float aSq = a.Dot( a );
+            float bSq = b.Dot( b );
+            if ( normalSq <= kDegenerateTolerance*aSq*bSq )
+                return false;
+
+            IvVector3 offset = (aSq*b - bSq*a).Cross( normal )/(2.0f*normalSq);
+            center = support[0] + offset;
+            radiusSq = offset.Dot( offset );
+            return true;
+        }
+
+    case 4:
+        {
+            IvVector3 a = support[1] - support[0];
+            IvVector3 b = support[2] - support[0];
+            IvVector3 c = support[3] - support[0];
+            float aSq = a.Dot( a );
+            float bSq = b.Dot( b );
+            float cSq = c.Dot( c );
+            IvVector3 bCrossC = b.Cross( c );
+            float det = 2.0f*a.Dot( bCrossC );
+            if ( det*det <= 4.0f*kDegenerateTolerance*aSq*bSq*cSq )
+                return false;
+
+            IvVector3 offset = (aSq*bCrossC + bSq*c.Cross( a ) + cSq*a.Cross( b ))/det;
+            center = support[0] + offset;
+            radiusSq = offset.Dot( offset );
+            return true;
+        }
+    }
+
+    ASSERT( false );
+    return false;
+
+}   // End of Circumsphere()
+
+
+//-------------------------------------------------------------------------------
+// @ SupportSphere()
+//-------------------------------------------------------------------------------
+// Sphere through the support points, or if they're degenerate, the smallest
+// sphere through two or three of them that contains the rest
+//-------------------------------------------------------------------------------
+static void
+SupportSphere( IvVector3& center, float& radiusSq, const IvVector3* support, unsigned int count )
+{
+    if ( Circumsphere( center, radiusSq, support, count ) )
+        return;
+
+    radiusSq = -1.0f;
+    for ( unsigned int mask = 0; mask < (1u << count); ++mask )
+    {
+        IvVector3 subset[4];
+        unsigned int subsetCount = 0;
+        for ( unsigned int i = 0; i < count; ++i )
+        {
+            if ( mask & (1u << i) )
+                subset[subsetCount++] = support[i];
+        }
+        if ( subsetCount < 2 || subsetCount == count )
+            continue;
+
+        IvVector3 subsetCenter;
+        float subsetRadiusSq;
+        if ( !Circumsphere( subsetCenter, subsetRadiusSq, subset, subsetCount ) 
+             || (radiusSq >= 0.0f && subsetRadiusSq >= radiusSq) )
+            continue;
+
+        unsigned int i = 0;
+        while ( i < count && Contains( subsetCenter, subsetRadiusSq, support[i] ) )
+            ++i;
+        if ( i == count )
+        {
+            center = subsetCenter;
+            radiusSq = subsetRadiusSq;
+        }
+    }
+    ASSERT( radiusSq >= 0.0f );
+
+}   // End of SupportSphere()
+
+
+//-------------------------------------------------------------------------------
+// @ MoveToFront()
+//-------------------------------------------------------------------------------
+// Welzl's algorithm: smallest sphere containing the first end points with
+// the support points on its surface.  Points found outside are moved to
+// the front of the array, so they're tested early next time.
+//-------------------------------------------------------------------------------
+static void
+MoveToFront( IvVector3& center, float& radiusSq, IvVector3* points, unsigned int end,
+             IvVector3* support, unsigned int supportCount )
+{
+    SupportSphere( center, radiusSq, support, supportCount );
+    if ( supportCount == 4 )
+        return;
+
+    for ( unsigned int i = 0; i < end; ++i )
+    {
+        if ( Contains( center, radiusSq, points[i] ) )
+            continue;
+
+        // point must be on the surface of the sphere for the first i points
+        support[supportCount] = points[i];
+        MoveToFront( center, radiusSq, points, i, support, supportCount + 1 );
+
+        IvVector3 point = points[i];
+        for ( unsigned int j = i; j > 0; --j )
+        {
+            points[j] = points[j - 1];
+        }
+        points[0] = point;
+    }
+
+}   // End of MoveToFront()
+
+
+//-------------------------------------------------------------------------------
+// @ SmallestSphere()
+//-------------------------------------------------------------------------------
+// Smallest sphere containing a small set of points, which get reordered
+//-------------------------------------------------------------------------------
+static void
+SmallestSphere( IvVector3& center, float& radiusSq, IvVector3* points, unsigned int count )
+{
+    IvVector3 support[4];
+    MoveToFront( center, radiusSq, points, count, support, 0 );
+
+}   // End of SmallestSphere()
+
+
+//-------------------------------------------------------------------------------
+// @ RunBlocks()
+//-------------------------------------------------------------------------------
+// Split the points into one block per thread, with the first block on the
+// calling thread.  Each block starts as a copy of blocks[0].
+//-------------------------------------------------------------------------------
+template <class Block>
+static void
+RunBlocks( std::vector<Block>& blocks,
+           void (*function)( Block&, const IvVector3*, unsigned int, unsigned int ),
+           const IvVector3* points, unsigned int numPoints, unsigned int numThreads )
+{
+    if ( numPoints < kParallelSize || numThreads < 2 )
+        numThreads = 1;
+    blocks.resize( numThreads, blocks[0] );
+
+    unsigned int blockSize = (numPoints + numThreads - 1)/numThreads;
+    std::vector<std::thread> workers;
+    for ( unsigned int t = 1; t < numThreads; ++t )
+    {
+        unsigned int begin = t*blockSize < numPoints ? t*blockSize : numPoints;
+        unsigned int end = begin + blockSize < numPoints ? begin + blockSize : numPoints;
+        workers.push_back( std::thread( function, std::ref( blocks[t] ), points, begin, end ) );
+    }
+
+    // first block on the calling thread
+    function( blocks[0], points, 0, blockSize < numPoints ? blockSize : numPoints );
+
+    for ( unsigned int t = 0; t < workers.size(); ++t )
+    {
+        workers[t].join();
+    }
+
+}   // End of RunBlocks()
+
+
+//-------------------------------------------------------------------------------
+// @ FindExtremes()
+//-------------------------------------------------------------------------------
+// Lowest and highest points along the first numDirections directions,
+// taking the first on ties
+//-------------------------------------------------------------------------------
+template <unsigned int numDirections>
+static void
+FindExtremes( IvSphereExtremes& extremes, const IvVector3* points,
+              unsigned int begin, unsigned int end )
+{
+    for ( unsigned int d = 0; d < numDirections; ++d )
+    {
+        extremes.minDot[d] = FLT_MAX;
+        extremes.maxDot[d] = -FLT_MAX;
+        extremes.minIndex[d] = begin;
+        extremes.maxIndex[d] = begin;
+    }
+
+    for ( unsigned int i = begin; i < end; ++i )
+    {
+        const IvVector3& point = points[i];
+        for ( unsigned int d = 0; d < numDirections; ++d )
+        {
+            float dot = kDirections[d][0]*point.x + kDirections[d][1]*point.y 
+                      + kDirections[d][2]*point.z;
+            if ( dot < extremes.minDot[d] )
+            {
+                extremes.minDot[d] = dot;
+                extremes.minIndex[d] = i;
+            }
+            if ( dot > extremes.maxDot[d] )
+            {
+                extremes.maxDot[d] = dot;
+                extremes.maxIndex[d] = i;
+            }
+        }
+    }
+
+}   // End of FindExtremes()
+
+
+//-------------------------------------------------------------------------------
+// @ FitExtremes()
+//-------------------------------------------------------------------------------
+// Collect the extreme points along the first numDirections directions
+//-------------------------------------------------------------------------------
+static void
+FitExtremes( std::vector<IvVector3>& extremePoints, const IvVector3* points, 
+             unsigned int numPoints, unsigned int numDirections, unsigned int numThreads )
+{
+    std::vector<IvSphereExtremes> blocks( 1 );
+    if ( numDirections == kExactDirections )
+        RunBlocks( blocks, FindExtremes<kExactDirections>, points, numPoints, numThreads );
+    else
+        RunBlocks( blocks, FindExtremes<kApproximateDirections>, points, numPoints, numThreads );
+
+    // blocks are in order, so keeping the first on ties matches one thread
+    IvSphereExtremes& extremes = blocks[0];
+    for ( unsigned int t = 1; t < blocks.size(); ++t )
+    {
+        for ( unsigned int d = 0; d < numDirections; ++d )
+        {
+            if ( blocks[t].minDot[d] < extremes.minDot[d] )
+            {
+                extremes.minDot[d] = blocks[t].minDot[d];
+                extremes.minIndex[d] = blocks[t].minIndex[d];
+            }
+            if ( blocks[t].maxDot[d] > extremes.maxDot[d] )
+            {
+                extremes.maxDot[d] = blocks[t].maxDot[d];
+                extremes.maxIndex[d] = blocks[t].maxIndex[d];
+            }
+        }
+    }
+
+    extremePoints.clear();
+    for ( unsigned int d = 0; d < numDirections; ++d )
+    {
+        extremePoints.push_back( points[extremes.minIndex[d]] );
+        extremePoints.push_back( points[extremes.maxIndex[d]] );
+    }
+
+}   // End of FitExtremes()
+
+
+//-------------------------------------------------------------------------------
+// @ FindFarthest()
+//-------------------------------------------------------------------------------
+// Point farthest from the center, taking the first on ties
+//-------------------------------------------------------------------------------
+static void
+FindFarthest( IvSphereFarthest& farthest, const IvVector3* points,
+              unsigned int begin, unsigned int end )
+{
+    farthest.distanceSq = -1.0f;
+    farthest.index = begin;
+    for ( unsigned int i = begin; i < end; ++i )
+    {
+        float distanceSq = ::DistanceSquared( farthest.center, points[i] );
+        if ( distanceSq > farthest.distanceSq )
+        {
+            farthest.distanceSq = distanceSq;
+            farthest.index = i;
+        }
+    }
+
+}   // End of FindFarthest()
+
+
+//-------------------------------------------------------------------------------
+// @ FindFarthest()
+//-------------------------------------------------------------------------------
+// Split between threads; the result doesn't depend on the thread count
+//-------------------------------------------------------------------------------
+static void
+FindFarthest( IvSphereFarthest& farthest, const IvVector3& center, const IvVector3* points,
+              unsigned int numPoints, unsigned int numThreads )
+{
+    std::vector<IvSphereFarthest> blocks( 1 );
+    blocks[0].center = center;
+    RunBlocks( blocks, FindFarthest, points, numPoints, numThreads );
+
+    farthest = blocks[0];
+    for ( unsigned int t = 1; t < blocks.size(); ++t )
+    {
+        if ( blocks[t].distanceSq > farthest.distanceSq )
+            farthest = blocks[t];
+    }
+
+}   // End of FindFarthest()
+
+
 //-------------------------------------------------------------------------------
 //-- Methods --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
@@ -117,41 +516,88 @@ IvBoundingSphere::operator!=( const IvBoundingSphere& other ) const
 //-------------------------------------------------------------------------------
 // @ IvBoundingSphere::Set()
 //-------------------------------------------------------------------------------
-// Set bounding sphere based on set of points
+// Set bounding sphere based on set of points.  The box fit centers the
+// sphere on the bounding box.  The approximate fit (EPOS) centers it on the
+// smallest sphere around the extreme points along 7 directions, which takes
+// two passes over the points.  The exact fit starts from the smallest
+// sphere around the extreme points along the axes, then repeatedly adds the
+// farthest point outside and recomputes (pivoting), so only a small set of
+// points ever goes through Welzl's algorithm.  Both give the same result
+// for any number of threads.
 //-------------------------------------------------------------------------------
 void
-IvBoundingSphere::Set( const IvVector3* points, unsigned int numPoints )
+IvBoundingSphere::Set( const IvVector3* points, unsigned int numPoints,
+                       FitMethod method, unsigned int numThreads )
 {
     ASSERT( points );
-    // compute minimal and maximal bounds
-    IvVector3 min(points[0]), max(points[0]);
-    unsigned int i;
-    for ( i = 1; i < numPoints; ++i )
+    ASSERT( numPoints > 0 );
+
+    if ( method == kBoxFit )
     {
-        if (points[i].x < min.x)
-            min.x = points[i].x;
-        else if (points[i].x > max.x )
-            max.x = points[i].x;
-        if (points[i].y < min.y)
-            min.y = points[i].y;
-        else if (points[i].y > max.y )
-            max.y = points[i].y;
-        if (points[i].z < min.z)
-            min.z = points[i].z;
-        else if (points[i].z > max.z )
-            max.z = points[i].z;
+        // compute minimal and maximal bounds
+        IvVector3 min(points[0]), max(points[0]);
+        unsigned int i;
+        for ( i = 1; i < numPoints; ++i )
+        {
+            if (points[i].x < min.x)
+                min.x = points[i].x;
+            else if (points[i].x > max.x )
+                max.x = points[i].x;
+            if (points[i].y < min.y)
+                min.y = points[i].y;
+            else if (points[i].y > max.y )
+                max.y = points[i].y;
+            if (points[i].z < min.z)
+                min.z = points[i].z;
+            else if (points[i].z > max.z )
+                max.z = points[i].z;
+        }
+        // compute center and radius
+        mCenter = 0.5f*(min + max);
+        float maxDistance = ::DistanceSquared( mCenter, points[0] );
+        for ( i = 1; i < numPoints; ++i )
+        {
+            float dist = ::DistanceSquared( mCenter, points[i] );
+            if (dist > maxDistance)
+                maxDistance = dist;
+        }
+        mRadius = ::IvSqrt( maxDistance );
+        return;
     }
-    // compute center and radius
-    mCenter = 0.5f*(min + max);
-    float maxDistance = ::DistanceSquared( mCenter, points[0] );
-    for ( i = 1; i < numPoints; ++i )
+
+    // smallest sphere around the extreme points
+    std::vector<IvVector3> workingSet;
+    FitExtremes( workingSet, points, numPoints,
+                 method == kExactFit ? kExactDirections : kApproximateDirections, numThreads );
+    IvVector3 center;
+    float radiusSq;
+    SmallestSphere( center, radiusSq, &workingSet[0], (unsigned int) workingSet.size() );
+
+    // the approximate fit just reaches out to the farthest point, and the
+    // exact fit adds the farthest point outside until there are none
+    IvSphereFarthest farthest;
+    unsigned int numPivots = (method == kExactFit) ? 0 : kMaxPivots;
+    for ( ;; )
     {
-        float dist = ::DistanceSquared( mCenter, points[i] );
-        if (dist > maxDistance)
-            maxDistance = dist;
+        FindFarthest( farthest, center, points, numPoints, numThreads );
+        if ( Contains( center, radiusSq, points[farthest.index] ) || numPivots == kMaxPivots )
+            break;
+
+        float lastRadiusSq = radiusSq;
+        workingSet.push_back( points[farthest.index] );
+        SmallestSphere( center, radiusSq, &workingSet[0], (unsigned int) workingSet.size() );
+        ++numPivots;
+
+        // if rounding stops the sphere growing, finish by enlarging it
+        if ( radiusSq <= lastRadiusSq )
+            numPivots = kMaxPivots;
     }
-    mRadius = ::IvSqrt( maxDistance );
-}
+
+    // make sure every point is inside, despite the tolerance
+    mCenter = center;
+    mRadius = ::IvSqrt( farthest.distanceSq > radiusSq ? farthest.distanceSq : radiusSq );
+
+}   // End of IvBoundingSphere::Set()
 
 
 //----------------------------------------------------------------------------
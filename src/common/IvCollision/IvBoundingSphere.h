@@ -41,6 +41,14 @@ class IvPlane;
 class IvBoundingSphere
 {
 public:
+    // ways of fitting a sphere to points in Set()
+    enum FitMethod
+    {
+        kBoxFit,            // center of the bounding box; fast but loose
+        kApproximateFit,    // sphere through extreme points, grown to fit
+        kExactFit           // smallest enclosing sphere
+    };
+
     // constructor/destructor
     inline IvBoundingSphere() :
         mCenter( 0.0f, 0.0f, 0.0f ), mRadius( 1.0f )
@@ -68,7 +76,10 @@ public:
     // manipulators
     inline void SetCenter( const IvVector3& center )  { mCenter = center; }
     inline void SetRadius( float radius )  { mRadius = radius; }
-    void Set( const IvVector3* points, unsigned int numPoints );
+    // fit to a set of points, splitting the passes over large sets between
+    // up to numThreads threads (including the calling one)
+    void Set( const IvVector3* points, unsigned int numPoints,
+              FitMethod method = kExactFit, unsigned int numThreads = 1 );
     void AddPoint( const IvVector3& point );
 
     // transform!
@@ -262,6 +262,42 @@ IvCapsule::Intersect( const IvCapsule& other ) const
 }
 
 
+//----------------------------------------------------------------------------
+// @ ::Intersect()
+// ---------------------------------------------------------------------------
+// Determine intersection between count pairs of capsules, using the batch
+// segment distance a block at a time
+//-----------------------------------------------------------------------------
+void
+Intersect( bool* result, const IvCapsule* capsules0, const IvCapsule* capsules1,
+           unsigned int count )
+{
+    const unsigned int kBlockSize = 64;
+    IvLineSegment3 segments0[kBlockSize];
+    IvLineSegment3 segments1[kBlockSize];
+    float distancesq[kBlockSize];
+
+    for ( unsigned int i = 0; i < count; i += kBlockSize )
+    {
+        unsigned int blockCount = (count - i < kBlockSize) ? count - i : kBlockSize;
+        for ( unsigned int j = 0; j < blockCount; ++j )
+        {
+            segments0[j] = capsules0[i + j].mSegment;
+            segments1[j] = capsules1[i + j].mSegment;
+        }
+
+        ::DistanceSquared( distancesq, 0, 0, segments0, segments1, blockCount );
+
+        for ( unsigned int j = 0; j < blockCount; ++j )
+        {
+            float radiusSum = capsules0[i + j].mRadius + capsules1[i + j].mRadius;
+            result[i + j] = ( distancesq[j] <= radiusSum*radiusSum );
+        }
+    }
+
+}   // End of ::Intersect()
+
+
 //----------------------------------------------------------------------------
 // @ IvCapsule::Intersect()
 // ---------------------------------------------------------------------------
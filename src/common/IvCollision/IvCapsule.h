@@ -87,6 +87,9 @@ public:
     bool Intersect( const IvLine3& line ) const;
     bool Intersect( const IvRay3& ray ) const;
     bool Intersect( const IvLineSegment3& segment ) const;
+    // batch capsule-capsule test for count pairs
+    friend void Intersect( bool* result, const IvCapsule* capsules0,
+                           const IvCapsule* capsules1, unsigned int count );
 
     // signed distance to plane
     float Classify( const IvPlane& plane ) const;
@@ -115,4 +118,7 @@ private:
 //-- Externs --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+void Intersect( bool* result, const IvCapsule* capsules0, const IvCapsule* capsules1,
+                unsigned int count );
+
 #endif
@@ -0,0 +1,297 @@
+//===============================================================================
+// @ IvContactManifold.cpp
+//
+// Persistent contact points between pairs of objects
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvContactManifold.h"
+#include <IvAssert.h>
+#include <IvQuat.h>
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ QuadArea()
+//-------------------------------------------------------------------------------
+// Twice the area of the largest quadrilateral on four points, squared,
+// whichever way they are joined
+//-------------------------------------------------------------------------------
+static float
+QuadArea( const IvVector3& p0, const IvVector3& p1, const IvVector3& p2, const IvVector3& p3 )
+{
+    float area0 = (p0 - p1).Cross( p2 - p3 ).LengthSquared();
+    float area1 = (p0 - p2).Cross( p1 - p3 ).LengthSquared();
+    float area2 = (p0 - p3).Cross( p1 - p2 ).LengthSquared();
+
+    float area = area0 > area1 ? area0 : area1;
+    return area > area2 ? area : area2;
+
+}   // End of QuadArea()
+
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvContactManifold::IvContactManifold()
+//-------------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------------
+IvContactManifold::IvContactManifold( float threshold ) :
+    mCount( 0 ),
+    mThreshold( threshold )
+{
+    ASSERT( threshold > 0.0f );
+
+}   // End of IvContactManifold::IvContactManifold()
+
+
+//-------------------------------------------------------------------------------
+// @ IvContactManifold::Refresh()
+//-------------------------------------------------------------------------------
+// Recompute the contacts from their local points
+//-------------------------------------------------------------------------------
+void
+IvContactManifold::Refresh( const IvQuat& rotation0, const IvVector3& translation0,
+                            const IvQuat& rotation1, const IvVector3& translation1 )
+{
+    // backwards, so removing swaps in contacts already done
+    for ( unsigned int i = mCount; i > 0; --i )
+    {
+        IvContactPoint& contact = mContacts[i-1];
+        IvVector3 world0 = rotation0.Rotate( contact.localPoint0 ) + translation0;
+        IvVector3 world1 = rotation1.Rotate( contact.localPoint1 ) + translation1;
+        IvVector3 offset = world0 - world1;
+
+        // separated along the normal
+        float penetration = offset.Dot( contact.normal );
+        if ( penetration < -mThreshold )
+        {
+            Remove( i-1 );
+            continue;
+        }
+
+        // slid apart across it
+        IvVector3 drift = offset - penetration*contact.normal;
+        if ( drift.LengthSquared() > mThreshold*mThreshold )
+        {
+            Remove( i-1 );
+            continue;
+        }
+
+        contact.point = 0.5f*(world0 + world1);
+        contact.penetration = penetration;
+        ++contact.lifetime;
+    }
+
+}   // End of IvContactManifold::Refresh()
+
+
+//-------------------------------------------------------------------------------
+// @ IvContactManifold::AddContact()
+//-------------------------------------------------------------------------------
+// Match the contact to one already there, or add it, replacing one if full
+//-------------------------------------------------------------------------------
+unsigned int
+IvContactManifold::AddContact( const IvVector3& collisionNormal,
+                               const IvVector3& collisionPoint, float penetration,
+                               const IvQuat& rotation0, const IvVector3& translation0,
+                               const IvQuat& rotation1, const IvVector3& translation1 )
+{
+    // the collision point is midway between the deepest points
+    IvVector3 world0 = collisionPoint + (0.5f*penetration)*collisionNormal;
+    IvVector3 world1 = collisionPoint - (0.5f*penetration)*collisionNormal;
+
+    IvContactPoint contact;
+    contact.localPoint0 = Conjugate( rotation0 ).Rotate( world0 - translation0 );
+    contact.localPoint1 = Conjugate( rotation1 ).Rotate( world1 - translation1 );
+    contact.point = collisionPoint;
+    contact.normal = collisionNormal;
+    contact.penetration = penetration;
+    contact.normalImpulse = 0.0f;
+    contact.lifetime = 0;
+
+    // same contact as before -- keep its impulse
+    int match = FindContact( contact.localPoint0 );
+    if ( match >= 0 )
+    {
+        contact.normalImpulse = mContacts[match].normalImpulse;
+        contact.lifetime = mContacts[match].lifetime;
+        mContacts[match] = contact;
+        return (unsigned int) match;
+    }
+
+    if ( mCount < kMaxContacts )
+    {
+        mContacts[mCount] = contact;
+        return mCount++;
+    }
+
+    unsigned int replace = ReplaceIndex( contact );
+    mContacts[replace] = contact;
+    return replace;
+
+}   // End of IvContactManifold::AddContact()
+
+
+//-------------------------------------------------------------------------------
+// @ IvContactManifold::FindContact()
+//-------------------------------------------------------------------------------
+// Nearest contact within the threshold, or -1
+//-------------------------------------------------------------------------------
+int
+IvContactManifold::FindContact( const IvVector3& localPoint0 ) const
+{
+    int nearest = -1;
+    float nearestSq = mThreshold*mThreshold;
+    for ( unsigned int i = 0; i < mCount; ++i )
+    {
+        float distanceSq = ::DistanceSquared( mContacts[i].localPoint0, localPoint0 );
+        if ( distanceSq < nearestSq )
+        {
+            nearestSq = distanceSq;
+            nearest = (int) i;
+        }
+    }
+
+    return nearest;
+
+}   // End of IvContactManifold::FindContact()
+
+
+//-------------------------------------------------------------------------------
+// @ IvContactManifold::ReplaceIndex()
+//-------------------------------------------------------------------------------
+// Contact to replace with a new one when full.  The deepest is kept, and of
+// the rest, the one whose replacement leaves the contacts covering the
+// largest area, which keeps the support stable.
+//-------------------------------------------------------------------------------
+unsigned int
+IvContactManifold::ReplaceIndex( const IvContactPoint& contact ) const
+{
+    ASSERT( mCount == kMaxContacts );
+
+    unsigned int deepest = 0;
+    for ( unsigned int i = 1; i < mCount; ++i )
+    {
+        if ( mContacts[i].penetration > mContacts[deepest].penetration )
+            deepest = i;
+    }
+
+    unsigned int replace = deepest == 0 ? 1 : 0;
+    float largestArea = -1.0f;
+    for ( unsigned int i = 0; i < mCount; ++i )
+    {
+        if ( i == deepest )
+            continue;
+
+        IvVector3 points[kMaxContacts];
+        for ( unsigned int j = 0; j < mCount; ++j )
+        {
+            points[j] = (j == i) ? contact.localPoint0 : mContacts[j].localPoint0;
+        }
+        float area = QuadArea( points[0], points[1], points[2], points[3] );
+        if ( area > largestArea )
+        {
+            largestArea = area;
+            replace = i;
+        }
+    }
+
+    return replace;
+
+}   // End of IvContactManifold::ReplaceIndex()
+
+
+//-------------------------------------------------------------------------------
+// @ IvContactManifold::Remove()
+//-------------------------------------------------------------------------------
+// Remove a contact, moving the last into its place
+//-------------------------------------------------------------------------------
+void
+IvContactManifold::Remove( unsigned int i )
+{
+    ASSERT( i < mCount );
+    mContacts[i] = mContacts[--mCount];
+
+}   // End of IvContactManifold::Remove()
+
+
+//-------------------------------------------------------------------------------
+// @ IvContactCache::IvContactCache()
+//-------------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------------
+IvContactCache::IvContactCache( float threshold ) :
+    mThreshold( threshold )
+{
+    ASSERT( threshold > 0.0f );
+
+}   // End of IvContactCache::IvContactCache()
+
+
+//-------------------------------------------------------------------------------
+// @ IvContactCache::Find()
+//-------------------------------------------------------------------------------
+// Look up the manifold for a pair, adding it if new
+//-------------------------------------------------------------------------------
+IvContactManifold&
+IvContactCache::Find( int proxyA, int proxyB )
+{
+    std::pair<int, int> key( proxyA, proxyB );
+    std::map< std::pair<int, int>, Entry >::iterator iter = mManifolds.find( key );
+    if ( iter == mManifolds.end() )
+    {
+        Entry entry;
+        entry.manifold.SetThreshold( mThreshold );
+        entry.found = false;
+        iter = mManifolds.insert( std::make_pair( key, entry ) ).first;
+    }
+    iter->second.found = true;
+
+    return iter->second.manifold;
+
+}   // End of IvContactCache::Find()
+
+
+//-------------------------------------------------------------------------------
+// @ IvContactCache::Prune()
+//-------------------------------------------------------------------------------
+// Drop manifolds no longer in use, and reset the rest for the next step
+//-------------------------------------------------------------------------------
+void
+IvContactCache::Prune()
+{
+    std::map< std::pair<int, int>, Entry >::iterator iter = mManifolds.begin();
+    while ( iter != mManifolds.end() )
+    {
+        if ( !iter->second.found || iter->second.manifold.GetCount() == 0 )
+        {
+            mManifolds.erase( iter++ );
+        }
+        else
+        {
+            iter->second.found = false;
+            ++iter;
+        }
+    }
+
+}   // End of IvContactCache::Prune()
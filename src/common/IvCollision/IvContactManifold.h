@@ -0,0 +1,134 @@
+//===============================================================================
+// @ IvContactManifold.h
+//
+// Persistent contact points between pairs of objects
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ComputeCollision finds a single contact each step.  A manifold keeps the
+// contacts found over several steps, up to four, stored in each object's
+// local frame so they move with the objects.  A new contact close to one
+// already there replaces it but keeps the impulse the solver accumulated
+// for it, which the solver can apply up front (warm starting).  Contacts
+// that separate or slide too far apart are dropped.
+//
+// The cache holds a manifold for each pair of objects from the broad
+// phase, and drops the manifolds of pairs that stop being found.
+//
+//===============================================================================
+
+#ifndef __IvContactManifold__h__
+#define __IvContactManifold__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <map>
+#include <IvVector3.h>
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvQuat;
+
+struct IvContactPoint
+{
+    IvVector3       localPoint0;    // deepest point of object 0, in its frame
+    IvVector3       localPoint1;    // deepest point of object 1, in its frame
+    IvVector3       point;          // world position, midway between the two
+    IvVector3       normal;         // world normal, from object 0 to object 1
+    float           penetration;    // negative once separated
+    float           normalImpulse;  // accumulated by the solver
+    unsigned int    lifetime;       // steps since the contact was first found
+};
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvContactManifold
+{
+public:
+    static const unsigned int kMaxContacts = 4;
+
+    // constructor/destructor
+    explicit IvContactManifold( float threshold = 0.02f );
+    inline ~IvContactManifold() {}
+
+    // contacts further apart than this are different contacts, and
+    // contacts that separate or slide by more than this are dropped
+    inline void SetThreshold( float threshold )     { mThreshold = threshold; }
+    inline float GetThreshold() const               { return mThreshold; }
+
+    // accessors
+    inline unsigned int GetCount() const            { return mCount; }
+    inline IvContactPoint& GetContact( unsigned int i )             { return mContacts[i]; }
+    inline const IvContactPoint& GetContact( unsigned int i ) const { return mContacts[i]; }
+    inline void Clear()                             { mCount = 0; }
+
+    // move the contacts with the objects, drop those that have separated or
+    // slid apart, and age the rest.  Call once per step before adding.
+    void Refresh( const IvQuat& rotation0, const IvVector3& translation0,
+                  const IvQuat& rotation1, const IvVector3& translation1 );
+
+    // add a contact from ComputeCollision.  Returns its index.
+    unsigned int AddContact( const IvVector3& collisionNormal,
+                             const IvVector3& collisionPoint, float penetration,
+                             const IvQuat& rotation0, const IvVector3& translation0,
+                             const IvQuat& rotation1, const IvVector3& translation1 );
+
+private:
+    int FindContact( const IvVector3& localPoint0 ) const;
+    unsigned int ReplaceIndex( const IvContactPoint& contact ) const;
+    void Remove( unsigned int i );
+
+    IvContactPoint  mContacts[kMaxContacts];
+    unsigned int    mCount;
+    float           mThreshold;
+};
+
+class IvContactCache
+{
+public:
+    // constructor/destructor
+    explicit IvContactCache( float threshold = 0.02f );
+    inline ~IvContactCache() {}
+
+    // manifold for a pair from the broad phase, created empty the first
+    // time the pair is found.  Pass the objects in the same order each step.
+    IvContactManifold& Find( int proxyA, int proxyB );
+
+    // drop manifolds not found since the last call, or with no contacts.
+    // Call once per step after the contacts are handled.
+    void Prune();
+
+    // accessors
+    inline unsigned int GetCount() const    { return (unsigned int) mManifolds.size(); }
+    inline void Clear()                     { mManifolds.clear(); }
+
+private:
+    struct Entry
+    {
+        IvContactManifold   manifold;
+        bool                found;
+    };
+
+    std::map< std::pair<int, int>, Entry >  mManifolds;
+    float                                   mThreshold;
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
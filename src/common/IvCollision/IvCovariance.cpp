@@ -20,264 +20,452 @@
 #include <IvMatrix33.h>
 #include <IvVector3.h>
 #include <IvMath.h>
+#include <IvSIMD.h>
+#include <IvSIMDMath.h>
 #include <string.h>
 
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// points summed at a time before merging into the running totals
+static const unsigned int kBlockSize = 256;
+
+// eigenvalues closer than this (relative to their spread) are solved with
+// Jacobi rotations rather than in closed form
+static const float kGapTolerance = 1.0e-3f;
+static const unsigned int kMaxSweeps = 16;
+
+// Register type for the batch eigensolver
+#if defined(IV_AVX)
+#define IV_EIGEN_SIMD
+typedef __m256 IvLanes;
+static const unsigned int kWidth = 8;
+#elif defined(IV_SSE2)
+#define IV_EIGEN_SIMD
+typedef __m128 IvLanes;
+static const unsigned int kWidth = 4;
+#endif
+
 //-------------------------------------------------------------------------------
 //-- Methods --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
 //-------------------------------------------------------------------------------
-// @ IvComputeCovarianceMatrix()
+// @ IvCovarianceAccumulator::Reset()
 //-------------------------------------------------------------------------------
-// Computes and returns the real, symmetric covariance matrix, along with the
-// mean vector.
+// Clear to an empty point set
 //-------------------------------------------------------------------------------
-void IvComputeCovarianceMatrix( IvMatrix33& C, IvVector3& mean,
-                              const IvVector3* points, unsigned int numPoints )
+void 
+IvCovarianceAccumulator::Reset()
 {
-    ASSERT(numPoints > 1);
+    mCount = 0;
+    mMean = IvVector3::origin;
+    memset( mM2, 0, sizeof(mM2) );
+
+}  // End of IvCovarianceAccumulator::Reset()
 
-    mean = IvVector3::origin;
 
-    // compute the mean (the centroid of the points)
-    unsigned int i;
-    for (i = 0; i < numPoints; i++)
-        mean += points[i];
+//-------------------------------------------------------------------------------
+// @ IvCovarianceAccumulator::Add()
+//-------------------------------------------------------------------------------
+// Add one point, using Welford's update
+//-------------------------------------------------------------------------------
+void 
+IvCovarianceAccumulator::Add( const IvVector3& point )
+{
+    ++mCount;
+    IvVector3 delta = point - mMean;
+    mMean += delta/(float)mCount;
+    IvVector3 delta2 = point - mMean;
+
+    mM2[0] += delta.x*delta2.x;
+    mM2[1] += delta.y*delta2.y;
+    mM2[2] += delta.z*delta2.z;
+    mM2[3] += delta.x*delta2.y;
+    mM2[4] += delta.x*delta2.z;
+    mM2[5] += delta.y*delta2.z;
 
-    mean /= (float)numPoints;
+}  // End of IvCovarianceAccumulator::Add()
 
-    // compute the (co)variances
-    float varX = 0.0f;
-    float varY = 0.0f;
-    float varZ = 0.0f;
-    float covXY = 0.0f;
-    float covXZ = 0.0f;
-    float covYZ = 0.0f;
 
-    for (i = 0; i < numPoints; i++)
+//-------------------------------------------------------------------------------
+// @ IvCovarianceAccumulator::Add()
+//-------------------------------------------------------------------------------
+// Add an array of points.  Each block of points is summed relative to its
+// first point, then merged in as a whole.
+//-------------------------------------------------------------------------------
+void 
+IvCovarianceAccumulator::Add( const IvVector3* points, unsigned int numPoints )
+{
+    ASSERT( sizeof(IvVector3) == 3*sizeof(float) );
+
+    for ( unsigned int i = 0; i < numPoints; i += kBlockSize )
     {
-        IvVector3 diff = points[i] - mean;
-        
-        varX += diff.x * diff.x;
-        varY += diff.y * diff.y;
-        varZ += diff.z * diff.z;
-        covXY += diff.x * diff.y;
-        covXZ += diff.x * diff.z;
-        covYZ += diff.y * diff.z;
+        unsigned int blockCount = (numPoints - i < kBlockSize) ? numPoints - i : kBlockSize;
+        const IvVector3* block = points + i;
+        const IvVector3 shift = block[0];
+
+        // sums of x, y, z, xx, yy, zz, xy, xz, yz
+        float sums[9];
+        memset( sums, 0, sizeof(sums) );
+        unsigned int j = 0;
+#if defined(IV_SSE2)
+        __m128 shiftX = _mm_set1_ps( shift.x );
+        __m128 shiftY = _mm_set1_ps( shift.y );
+        __m128 shiftZ = _mm_set1_ps( shift.z );
+        __m128 laneSums[9];
+        for ( unsigned int k = 0; k < 9; ++k )
+        {
+            laneSums[k] = _mm_setzero_ps();
+        }
+        for ( ; j + 4 <= blockCount; j += 4 )
+        {
+            __m128 x, y, z;
+            IvLoadXYZ4( &block[j].x, x, y, z );
+            x = _mm_sub_ps( x, shiftX );
+            y = _mm_sub_ps( y, shiftY );
+            z = _mm_sub_ps( z, shiftZ );
+            laneSums[0] = _mm_add_ps( laneSums[0], x );
+            laneSums[1] = _mm_add_ps( laneSums[1], y );
+            laneSums[2] = _mm_add_ps( laneSums[2], z );
+            laneSums[3] = IvMulAdd( x, x, laneSums[3] );
+            laneSums[4] = IvMulAdd( y, y, laneSums[4] );
+            laneSums[5] = IvMulAdd( z, z, laneSums[5] );
+            laneSums[6] = IvMulAdd( x, y, laneSums[6] );
+            laneSums[7] = IvMulAdd( x, z, laneSums[7] );
+            laneSums[8] = IvMulAdd( y, z, laneSums[8] );
+        }
+        IV_ALIGN(16) float lanes[4];
+        for ( unsigned int k = 0; k < 9; ++k )
+        {
+            _mm_store_ps( lanes, laneSums[k] );
+            sums[k] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        }
+#endif
+        for ( ; j < blockCount; ++j )
+        {
+            IvVector3 diff = block[j] - shift;
+            sums[0] += diff.x;
+            sums[1] += diff.y;
+            sums[2] += diff.z;
+            sums[3] += diff.x*diff.x;
+            sums[4] += diff.y*diff.y;
+            sums[5] += diff.z*diff.z;
+            sums[6] += diff.x*diff.y;
+            sums[7] += diff.x*diff.z;
+            sums[8] += diff.y*diff.z;
+        }
+
+        // convert to the block's mean and squared deviations
+        float recip = 1.0f/(float)blockCount;
+        IvVector3 mean( shift.x + sums[0]*recip, shift.y + sums[1]*recip, 
+                        shift.z + sums[2]*recip );
+        float M2[6];
+        M2[0] = sums[3] - sums[0]*sums[0]*recip;
+        M2[1] = sums[4] - sums[1]*sums[1]*recip;
+        M2[2] = sums[5] - sums[2]*sums[2]*recip;
+        M2[3] = sums[6] - sums[0]*sums[1]*recip;
+        M2[4] = sums[7] - sums[0]*sums[2]*recip;
+        M2[5] = sums[8] - sums[1]*sums[2]*recip;
+
+        Merge( blockCount, mean, M2 );
     }
 
-    // divide all of the (co)variances by n - 1 
-    // (skipping the division if n = 2, since that would be division by 1.0
-    if (numPoints > 2)
+}  // End of IvCovarianceAccumulator::Add()
+
+
+//-------------------------------------------------------------------------------
+// @ IvCovarianceAccumulator::Merge()
+//-------------------------------------------------------------------------------
+// Combine with the statistics of another, disjoint, set of points
+//-------------------------------------------------------------------------------
+void 
+IvCovarianceAccumulator::Merge( const IvCovarianceAccumulator& other )
+{
+    Merge( other.mCount, other.mMean, other.mM2 );
+
+}  // End of IvCovarianceAccumulator::Merge()
+
+
+//-------------------------------------------------------------------------------
+// @ IvCovarianceAccumulator::Merge()
+//-------------------------------------------------------------------------------
+// Combine with the count, mean and squared deviations of another set, 
+// using the pairwise update of Chan, Golub and LeVeque
+//-------------------------------------------------------------------------------
+void 
+IvCovarianceAccumulator::Merge( unsigned int count, const IvVector3& mean, const float* M2 )
+{
+    if ( count == 0 )
+        return;
+
+    if ( mCount == 0 )
     {
-        const float normalize = (float)(numPoints - 1);
-        varX /= normalize;
-        varY /= normalize;
-        varZ /= normalize;
-        covXY /= normalize;
-        covXZ /= normalize;
-        covYZ /= normalize;
+        mCount = count;
+        mMean = mean;
+        memcpy( mM2, M2, sizeof(mM2) );
+        return;
     }
 
+    unsigned int total = mCount + count;
+    IvVector3 delta = mean - mMean;
+    float weight = (float)mCount*(float)count/(float)total;
+
+    mM2[0] += M2[0] + delta.x*delta.x*weight;
+    mM2[1] += M2[1] + delta.y*delta.y*weight;
+    mM2[2] += M2[2] + delta.z*delta.z*weight;
+    mM2[3] += M2[3] + delta.x*delta.y*weight;
+    mM2[4] += M2[4] + delta.x*delta.z*weight;
+    mM2[5] += M2[5] + delta.y*delta.z*weight;
+
+    mMean += delta*((float)count/(float)total);
+    mCount = total;
+
+}  // End of IvCovarianceAccumulator::Merge()
+
+
+//-------------------------------------------------------------------------------
+// @ IvCovarianceAccumulator::GetCovarianceMatrix()
+//-------------------------------------------------------------------------------
+// Returns the real, symmetric (sample) covariance matrix
+//-------------------------------------------------------------------------------
+void 
+IvCovarianceAccumulator::GetCovarianceMatrix( IvMatrix33& C ) const
+{
+    ASSERT(mCount > 1);
+
+    // divide all of the (co)variances by n - 1 
+    const float normalize = 1.0f/(float)(mCount - 1);
+
     // pack values into the covariance matrix, which is symmetric
-    C(0,0) = varX;
-    C(1,1) = varY;
-    C(2,2) = varZ;
-    C(1,0) = C(0,1) = covXY;
-    C(2,0) = C(0,2) = covXZ;
-    C(1,2) = C(2,1) = covYZ;
+    C(0,0) = mM2[0]*normalize;
+    C(1,1) = mM2[1]*normalize;
+    C(2,2) = mM2[2]*normalize;
+    C(1,0) = C(0,1) = mM2[3]*normalize;
+    C(2,0) = C(0,2) = mM2[4]*normalize;
+    C(1,2) = C(2,1) = mM2[5]*normalize;
+
+}  // End of IvCovarianceAccumulator::GetCovarianceMatrix()
+
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvComputeCovarianceMatrix()
+//-------------------------------------------------------------------------------
+// Computes and returns the real, symmetric covariance matrix, along with the
+// mean vector.
+//-------------------------------------------------------------------------------
+void IvComputeCovarianceMatrix( IvMatrix33& C, IvVector3& mean,
+                              const IvVector3* points, unsigned int numPoints )
+{
+    ASSERT(numPoints > 1);
+
+    IvCovarianceAccumulator accumulator;
+    accumulator.Add( points, numPoints );
+
+    mean = accumulator.GetMean();
+    accumulator.GetCovarianceMatrix( C );
 
 }  // End of IvComputeCovarianceMatrix()
 
 
 //-------------------------------------------------------------------------------
-// @ IvSymmetricHouseholder3x3()
+// @ IvEigenvector()
 //-------------------------------------------------------------------------------
-// 
+// Given the rows of A - lambda*I, for a simple eigenvalue lambda, returns
+// the unit eigenvector as the largest cross product of two rows.
 //-------------------------------------------------------------------------------
-static void IvSymmetricHouseholder3x3 (const IvMatrix33& M, IvMatrix33& Q, 
-                                    IvVector3& diag, IvVector3& subd)
+static bool IvEigenvector( IvVector3& v, const IvVector3& r0, const IvVector3& r1,
+                           const IvVector3& r2 )
 {
-    // Computes the Householder reduction of M, computing:
-    //
-    // T = Q^t M Q
-    //
-    //   Input:   
-    //     symmetric 3x3 matrix M
-    //   Output:  
-    //     orthogonal matrix Q
-    //     diag, diagonal entries of T
-    //     subd, lower-triangle entries of T (T is symmetric)
-
-    // T will be stored as follows (because it is symmetric and tridiagonal):
-    //
-    // | diag[0]  subd[0]  0       |
-    // | subd[0]  diag[1]  subd[1] |
-    // | 0        subd[1]  diag[2] |
-
-    diag[0] = M(0,0); // in both cases below, T(0,0) = M(0,0) 
-    subd[2] = 0; // T is to be a tri-diagonal matrix - the (2,0) and (0,2) 
-                 // entries must be zero, so we don't need subd[2] for this step
-
-    // so we know that T will actually be:
-    //
-    // | M(0,0)   subd[0]  0       |
-    // | subd[0]  diag[1]  subd[1] |
-    // | 0        subd[1]  diag[2] |
-
-    // so the only question remaining is the lower-right block and subd[0]
-
-    if ( IvAbs(M(2,0)) < kEpsilon )
+    IvVector3 c01 = r0.Cross(r1);
+    IvVector3 c02 = r0.Cross(r2);
+    IvVector3 c12 = r1.Cross(r2);
+    float d01 = c01.Dot(c01);
+    float d02 = c02.Dot(c02);
+    float d12 = c12.Dot(c12);
+
+    float dmax = d01;
+    v = c01;
+    if ( d02 > dmax )
     {
-        // if M(2,0) (and thus M(0,2)) is zero, then the matrix is already in
-        // tridiagonal form.  As such, the Q matix is the identity, and we
-        // just extract the diagonal and subdiagonal components of T as-is
-        Q.Identity();
-
-        // so we see that T will actually be:
-        //
-        // | M(0,0)  M(1,0)  0      |
-        // | M(1,0)  M(1,1)  M(2,1) |
-        // | 0       M(2,1)  M(2,2) |
-        diag[1] = M(1,1);
-        diag[2] = M(2,2);
-
-        subd[0] = M(1,0);
-        subd[1] = M(2,1);
+        dmax = d02;
+        v = c02;
     }
-    else
+    if ( d12 > dmax )
     {
-        // grab the lower triangle of the matrix, minus a, which we don't need
-        // (see above)
-        // |       |
-        // | b d   |
-        // | c e f |
-        const float b = M(1,0);
-        const float c = M(2,0);
-        const float d = M(1,1);
-        const float e = M(2,1);
-        const float f = M(2,2);
-
-        // normalize b and c to unit length and store in u and v
-        // we want the lower-right block we create to be orthonormal
-        const float L = IvSqrt(b * b + c * c);
-        const float u = b / L;
-        const float v = c / L;
-        Q.SetRows(IvVector3(1.0f, 0.0f, 0.0f),
-                  IvVector3(0.0f, u,    v),
-                  IvVector3(0.0f, v,    -u));
-
-        float q = 2 * u * e + v * (f - d);
-        diag[1] = d + v * q;
-        diag[2] = f - v * q;
-
-        subd[0] = L;
-        subd[1] = e - u * q;
-
-        // so we see that T will actually be:
-        //
-        // | M(0,0)  L       0     |
-        // | L       d+c*q   e-b*q |
-        // | 0       e-b*q   f-c*q |
+        dmax = d12;
+        v = c12;
     }
-}  // End of IvSymmetricHouseholder3x3
+    if ( !(dmax > 0.0f) )
+        return false;
+
+    v *= 1.0f/IvSqrt(dmax);
+    return true;
+
+}  // End of IvEigenvector()
+
 
 //-------------------------------------------------------------------------------
-// @ IvQLAlgorithm()
+// @ IvClosedFormEigenvectors()
 //-------------------------------------------------------------------------------
-// 
+// Eigenvalues from the roots of the characteristic cubic, using the
+// trigonometric solution, then eigenvectors from cross products.  Returns
+// false if the eigenvalues are too close together for this to be accurate.
 //-------------------------------------------------------------------------------
-static int IvQLAlgorithm (IvMatrix33& M, IvVector3& diag, IvVector3& subd)
+static bool IvClosedFormEigenvectors( IvVector3& v1, IvVector3& v2, IvVector3& v3, 
+                                      const IvMatrix33& A )
 {
-    // QL iteration with implicit shifting to reduce matrix from tridiagonal
-    // to diagonal
+    // shift by the mean eigenvalue and scale
+    float m = (A(0,0) + A(1,1) + A(2,2))/3.0f;
+    float k00 = A(0,0) - m;
+    float k11 = A(1,1) - m;
+    float k22 = A(2,2) - m;
+    float a01 = A(0,1);
+    float a02 = A(0,2);
+    float a12 = A(1,2);
+    float p2 = (k00*k00 + k11*k11 + k22*k22 + 2.0f*(a01*a01 + a02*a02 + a12*a12))/6.0f;
+    if ( !(p2 > 0.0f) )
+        return false;
+    float p = IvSqrt(p2);
+
+    // half the determinant of the shifted matrix, relative to p^3
+    float det = k00*(k11*k22 - a12*a12) - a01*(a01*k22 - a12*a02) 
+              + a02*(a01*a12 - k11*a02);
+    float r = det/(2.0f*p2*p);
+    if ( r < -1.0f )
+        r = -1.0f;
+    else if ( r > 1.0f )
+        r = 1.0f;
+
+    // eigenvalues, from largest to smallest
+    float phi = acosf(r)/3.0f;
+    float sinPhi, cosPhi;
+    ::IvSinCos( phi, sinPhi, cosPhi );
+    float lambda1 = m + 2.0f*p*cosPhi;
+    float lambda3 = m - p*(cosPhi + 1.7320508075688772f*sinPhi);
+    float lambda2 = 3.0f*m - lambda1 - lambda3;
+    if ( lambda1 - lambda2 <= kGapTolerance*p || lambda2 - lambda3 <= kGapTolerance*p )
+        return false;
+
+    // eigenvectors for the two extremes; the middle one completes the basis
+    IvVector3 row0( A(0,0), a01, a02 );
+    IvVector3 row1( a01, A(1,1), a12 );
+    IvVector3 row2( a02, a12, A(2,2) );
+    if ( !IvEigenvector( v1, IvVector3( row0.x - lambda1, row0.y, row0.z ),
+                         IvVector3( row1.x, row1.y - lambda1, row1.z ),
+                         IvVector3( row2.x, row2.y, row2.z - lambda1 ) ) )
+        return false;
+    if ( !IvEigenvector( v3, IvVector3( row0.x - lambda3, row0.y, row0.z ),
+                         IvVector3( row1.x, row1.y - lambda3, row1.z ),
+                         IvVector3( row2.x, row2.y, row2.z - lambda3 ) ) )
+        return false;
+
+    // make v3 exactly orthogonal to v1, then v2 gives a right-handed basis
+    v3 -= v3.Dot(v1)*v1;
+    v3.Normalize();
+    v2 = v3.Cross(v1);
+
+    return true;
+
+}  // End of IvClosedFormEigenvectors()
 
-    int L;
-    for (L = 0; L < 3; L++)
+
+//-------------------------------------------------------------------------------
+// @ IvJacobiEigenvectors()
+//-------------------------------------------------------------------------------
+// Diagonalizes A with cyclic Jacobi rotations, leaving the eigenvectors in 
+// the columns of Q.  Used when eigenvalues are repeated or nearly so.
+//-------------------------------------------------------------------------------
+static void IvJacobiEigenvectors( IvMatrix33& Q, IvVector3& eigenvalues, 
+                                  const IvMatrix33& A )
+{
+    float a[3][3];
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        for ( unsigned int j = 0; j < 3; ++j )
+        {
+            a[i][j] = A(i,j);
+        }
+    }
+    Q.Identity();
+
+    static const unsigned int pIndex[3] = { 0, 0, 1 };
+    static const unsigned int qIndex[3] = { 1, 2, 2 };
+    for ( unsigned int sweep = 0; sweep < kMaxSweeps; ++sweep )
     {
-        // As this is an iterative process, we need to keep a maximum number of
-        // iterations, just in case something is wrong - we cannot afford to
-        // loop forever
-        const int maxIterations = 32;
+        // stop once the off-diagonal is negligible
+        float off = a[0][1]*a[0][1] + a[0][2]*a[0][2] + a[1][2]*a[1][2];
+        float diag = a[0][0]*a[0][0] + a[1][1]*a[1][1] + a[2][2]*a[2][2];
+        if ( off <= 1.0e-14f*diag )
+            break;
 
-        int iter;
-        for (iter = 0; iter < maxIterations; iter++)
+        for ( unsigned int r = 0; r < 3; ++r )
         {
-            int m;
-            for (m = L; m <= 1; m++)
+            unsigned int p = pIndex[r];
+            unsigned int q = qIndex[r];
+            float apq = a[p][q];
+            if ( apq == 0.0f )
+                continue;
+
+            // rotation that zeroes a[p][q]
+            float theta = (a[q][q] - a[p][p])/(2.0f*apq);
+            float t = 1.0f/(IvAbs(theta) + IvSqrt(theta*theta + 1.0f));
+            if ( theta < 0.0f )
+                t = -t;
+            float c = 1.0f/IvSqrt(t*t + 1.0f);
+            float s = t*c;
+
+            // A = J^T A J, Q = Q J
+            for ( unsigned int k = 0; k < 3; ++k )
             {
-                float dd = IvAbs(diag[m]) + IvAbs(diag[m+1]);
-                if ( IvAbs(subd[m]) + dd == dd )
-                    break;
+                float akp = a[k][p];
+                float akq = a[k][q];
+                a[k][p] = c*akp - s*akq;
+                a[k][q] = s*akp + c*akq;
             }
-            if ( m == L )
-                break;
-
-            float g = (diag[L+1]-diag[L])/(2*subd[L]);
-            float r = IvSqrt(g*g+1);
-            if ( g < 0 )
-                g = diag[m]-diag[L]+subd[L]/(g-r);
-            else
-                g = diag[m]-diag[L]+subd[L]/(g+r);
-            float s = 1, c = 1, p = 0;
-            for (int i = m-1; i >= L; i--)
+            for ( unsigned int k = 0; k < 3; ++k )
+            {
+                float apk = a[p][k];
+                float aqk = a[q][k];
+                a[p][k] = c*apk - s*aqk;
+                a[q][k] = s*apk + c*aqk;
+            }
+            for ( unsigned int k = 0; k < 3; ++k )
             {
-                float f = s*subd[i], b = c*subd[i];
-                if ( IvAbs(f) >= IvAbs(g) )
-                {
-                    c = g/f;
-                    r = IvSqrt(c*c+1);
-                    subd[i+1] = f*r;
-                    c *= (s = 1/r);
-                }
-                else
-                {
-                    s = f/g;
-                    r = IvSqrt(s*s+1);
-                    subd[i+1] = g*r;
-                    s *= (c = 1/r);
-                }
-                g = diag[i+1]-p;
-                r = (diag[i]-g)*s+2*b*c;
-                p = s*r;
-                diag[i+1] = g+p;
-                g = c*r-b;
-
-                for (int k = 0; k < 3; k++)
-                {
-                    f = M(k,i+1);
-                    M(k,i+1) = s*M(k,i)+c*f;
-                    M(k,i) = c*M(k,i)-s*f;
-                }
+                float qkp = Q(k,p);
+                float qkq = Q(k,q);
+                Q(k,p) = c*qkp - s*qkq;
+                Q(k,q) = s*qkp + c*qkq;
             }
-            diag[L] -= p;
-            subd[L] = g;
-            subd[m] = 0;
         }
-
-        // exceptional case - matrix took more iterations than should be 
-        // possible to move to diagonal form
-        if ( iter == maxIterations )
-            return 0;
     }
 
-    return 1;
-}  // End of IvQLAlgorithm
+    eigenvalues.Set( a[0][0], a[1][1], a[2][2] );
+
+}  // End of IvJacobiEigenvectors()
+
 
 //-------------------------------------------------------------------------------
 // @ IvGetRealSymmetricEigenvectors()
 //-------------------------------------------------------------------------------
-// 
+// Returns the eigenvectors of a real symmetric matrix, sorted by decreasing
+// eigenvalue and forming a right-handed basis
 //-------------------------------------------------------------------------------
 void IvGetRealSymmetricEigenvectors( IvVector3& v1, IvVector3& v2, IvVector3& v3, 
                                    const IvMatrix33& A )
 {    
+    // well separated eigenvalues can be found directly
+    if ( IvClosedFormEigenvectors( v1, v2, v3, A ) )
+        return;
+
     IvVector3 eigenvalues;
-    IvVector3 lowerTriangle;
     IvMatrix33 Q;
-
-    IvSymmetricHouseholder3x3 (A, Q, eigenvalues, lowerTriangle);
-    IvQLAlgorithm(Q, eigenvalues, lowerTriangle);
+    IvJacobiEigenvectors( Q, eigenvalues, A );
 
     // Sort the eigenvalues from greatest to smallest, and use these indices
     // to sort the eigenvectors
@@ -336,3 +524,175 @@ void IvGetRealSymmetricEigenvectors( IvVector3& v1, IvVector3& v2, IvVector3& v3
         v3 = -v3;
 }  // End of IvGetRealSymmetricEigenvectors
 
+
+
+#if defined(IV_EIGEN_SIMD)
+//-------------------------------------------------------------------------------
+// @ IvEigenvectorLanes()
+//-------------------------------------------------------------------------------
+// IvEigenvector() across kWidth matrices.  Returns a mask of the lanes 
+// where a non-zero cross product was found.
+//-------------------------------------------------------------------------------
+static inline IvLanes IvEigenvectorLanes( IvLanes* v, IvLanes lambda, const IvLanes* a )
+{
+    // rows of A - lambda*I; a holds a00, a11, a22, a01, a02, a12
+    IvLanes r00 = IvSub( a[0], lambda ), r01 = a[3], r02 = a[4];
+    IvLanes r10 = a[3], r11 = IvSub( a[1], lambda ), r12 = a[5];
+    IvLanes r20 = a[4], r21 = a[5], r22 = IvSub( a[2], lambda );
+
+    // r0 x r1
+    IvLanes bx = IvSub( IvMul( r01, r12 ), IvMul( r02, r11 ) );
+    IvLanes by = IvSub( IvMul( r02, r10 ), IvMul( r00, r12 ) );
+    IvLanes bz = IvSub( IvMul( r00, r11 ), IvMul( r01, r10 ) );
+    IvLanes dmax = IvMulAdd( bz, bz, IvMulAdd( by, by, IvMul( bx, bx ) ) );
+
+    // r0 x r2
+    IvLanes cx = IvSub( IvMul( r01, r22 ), IvMul( r02, r21 ) );
+    IvLanes cy = IvSub( IvMul( r02, r20 ), IvMul( r00, r22 ) );
+    IvLanes cz = IvSub( IvMul( r00, r21 ), IvMul( r01, r20 ) );
+    IvLanes d = IvMulAdd( cz, cz, IvMulAdd( cy, cy, IvMul( cx, cx ) ) );
+    IvLanes larger = IvCmpLt( dmax, d );
+    bx = IvSelect( larger, cx, bx );
+    by = IvSelect( larger, cy, by );
+    bz = IvSelect( larger, cz, bz );
+    dmax = IvMax( dmax, d );
+
+    // r1 x r2
+    cx = IvSub( IvMul( r11, r22 ), IvMul( r12, r21 ) );
+    cy = IvSub( IvMul( r12, r20 ), IvMul( r10, r22 ) );
+    cz = IvSub( IvMul( r10, r21 ), IvMul( r11, r20 ) );
+    d = IvMulAdd( cz, cz, IvMulAdd( cy, cy, IvMul( cx, cx ) ) );
+    larger = IvCmpLt( dmax, d );
+    bx = IvSelect( larger, cx, bx );
+    by = IvSelect( larger, cy, by );
+    bz = IvSelect( larger, cz, bz );
+    dmax = IvMax( dmax, d );
+
+    const IvLanes zero = IvBroadcast<IvLanes>( 0.0f );
+    const IvLanes one = IvBroadcast<IvLanes>( 1.0f );
+    IvLanes valid = IvCmpLt( zero, dmax );
+    IvLanes scale = IvDiv( one, IvSqrt( IvSelect( valid, dmax, one ) ) );
+    v[0] = IvMul( bx, scale );
+    v[1] = IvMul( by, scale );
+    v[2] = IvMul( bz, scale );
+    return valid;
+
+}  // End of IvEigenvectorLanes()
+#endif
+
+
+//-------------------------------------------------------------------------------
+// @ IvGetRealSymmetricEigenvectors()
+//-------------------------------------------------------------------------------
+// Batch version for count matrices.  The closed form solution runs on 4 or 
+// 8 matrices at a time; those with close eigenvalues are redone singly.
+//-------------------------------------------------------------------------------
+void IvGetRealSymmetricEigenvectors( IvVector3* v1, IvVector3* v2, IvVector3* v3, 
+                                   const IvMatrix33* A, unsigned int count )
+{
+    unsigned int i = 0;
+#if defined(IV_EIGEN_SIMD)
+    const IvLanes zero = IvBroadcast<IvLanes>( 0.0f );
+    const IvLanes one = IvBroadcast<IvLanes>( 1.0f );
+    const IvLanes third = IvBroadcast<IvLanes>( 1.0f/3.0f );
+    const IvLanes tolerance = IvBroadcast<IvLanes>( kGapTolerance );
+
+    IV_ALIGN(32) float lanes[9][kWidth];
+    IvLanes a[6];
+    for ( ; i + kWidth <= count; i += kWidth )
+    {
+        // gather a00, a11, a22, a01, a02, a12
+        for ( unsigned int lane = 0; lane < kWidth; ++lane )
+        {
+            const IvMatrix33& matrix = A[i + lane];
+            lanes[0][lane] = matrix(0,0);
+            lanes[1][lane] = matrix(1,1);
+            lanes[2][lane] = matrix(2,2);
+            lanes[3][lane] = matrix(0,1);
+            lanes[4][lane] = matrix(0,2);
+            lanes[5][lane] = matrix(1,2);
+        }
+        for ( unsigned int k = 0; k < 6; ++k )
+        {
+            a[k] = IvLoad<IvLanes>( lanes[k] );
+        }
+
+        // shift by the mean eigenvalue and scale
+        IvLanes m = IvMul( IvAdd( IvAdd( a[0], a[1] ), a[2] ), third );
+        IvLanes k00 = IvSub( a[0], m );
+        IvLanes k11 = IvSub( a[1], m );
+        IvLanes k22 = IvSub( a[2], m );
+        IvLanes off = IvMulAdd( a[5], a[5], IvMulAdd( a[4], a[4], IvMul( a[3], a[3] ) ) );
+        IvLanes p2 = IvMulAdd( k22, k22, IvMulAdd( k11, k11, IvMul( k00, k00 ) ) );
+        p2 = IvMul( IvAdd( p2, IvAdd( off, off ) ), IvBroadcast<IvLanes>( 1.0f/6.0f ) );
+        IvLanes valid = IvCmpLt( zero, p2 );
+        IvLanes p = IvSqrt( p2 );
+
+        // half the determinant of the shifted matrix, relative to p^3
+        IvLanes det = IvMul( k00, IvSub( IvMul( k11, k22 ), IvMul( a[5], a[5] ) ) );
+        det = IvSub( det, IvMul( a[3], IvSub( IvMul( a[3], k22 ), IvMul( a[5], a[4] ) ) ) );
+        det = IvAdd( det, IvMul( a[4], IvSub( IvMul( a[3], a[5] ), IvMul( k11, a[4] ) ) ) );
+        IvLanes denom = IvMul( IvAdd( p2, p2 ), p );
+        IvLanes r = IvDiv( det, IvSelect( valid, denom, one ) );
+        r = IvMin( IvMax( r, IvSub( zero, one ) ), one );
+
+        // eigenvalues, from largest to smallest
+        IvLanes sinPhi, cosPhi;
+        IvSinCos( IvMul( IvACos( r ), third ), sinPhi, cosPhi );
+        IvLanes lambda1 = IvMulAdd( IvAdd( p, p ), cosPhi, m );
+        IvLanes lambda3 = IvSub( m, IvMul( p, IvMulAdd( IvBroadcast<IvLanes>( 1.7320508075688772f ),
+                                                      sinPhi, cosPhi ) ) );
+        IvLanes lambda2 = IvSub( IvSub( IvMul( IvBroadcast<IvLanes>( 3.0f ), m ), lambda1 ), lambda3 );
+        IvLanes gap = IvMul( tolerance, p );
+        valid = IvAnd( valid, IvCmpLt( gap, IvSub( lambda1, lambda2 ) ) );
+        valid = IvAnd( valid, IvCmpLt( gap, IvSub( lambda2, lambda3 ) ) );
+
+        // eigenvectors for the two extremes
+        IvLanes e1[3], e3[3];
+        valid = IvAnd( valid, IvEigenvectorLanes( e1, lambda1, a ) );
+        valid = IvAnd( valid, IvEigenvectorLanes( e3, lambda3, a ) );
+
+        // make e3 exactly orthogonal to e1, then e2 gives a right-handed basis
+        IvLanes dot = IvMulAdd( e3[2], e1[2], IvMulAdd( e3[1], e1[1], IvMul( e3[0], e1[0] ) ) );
+        e3[0] = IvSub( e3[0], IvMul( dot, e1[0] ) );
+        e3[1] = IvSub( e3[1], IvMul( dot, e1[1] ) );
+        e3[2] = IvSub( e3[2], IvMul( dot, e1[2] ) );
+        IvLanes length2 = IvMulAdd( e3[2], e3[2], IvMulAdd( e3[1], e3[1], IvMul( e3[0], e3[0] ) ) );
+        IvLanes scale = IvDiv( one, IvSqrt( IvSelect( valid, length2, one ) ) );
+        e3[0] = IvMul( e3[0], scale );
+        e3[1] = IvMul( e3[1], scale );
+        e3[2] = IvMul( e3[2], scale );
+
+        IvStore( lanes[0], e1[0] );
+        IvStore( lanes[1], e1[1] );
+        IvStore( lanes[2], e1[2] );
+        IvStore( lanes[3], IvSub( IvMul( e3[1], e1[2] ), IvMul( e3[2], e1[1] ) ) );
+        IvStore( lanes[4], IvSub( IvMul( e3[2], e1[0] ), IvMul( e3[0], e1[2] ) ) );
+        IvStore( lanes[5], IvSub( IvMul( e3[0], e1[1] ), IvMul( e3[1], e1[0] ) ) );
+        IvStore( lanes[6], e3[0] );
+        IvStore( lanes[7], e3[1] );
+        IvStore( lanes[8], e3[2] );
+
+        int solved = IvMoveMask( valid );
+        for ( unsigned int lane = 0; lane < kWidth; ++lane )
+        {
+            if ( solved & (1 << lane) )
+            {
+                v1[i + lane].Set( lanes[0][lane], lanes[1][lane], lanes[2][lane] );
+                v2[i + lane].Set( lanes[3][lane], lanes[4][lane], lanes[5][lane] );
+                v3[i + lane].Set( lanes[6][lane], lanes[7][lane], lanes[8][lane] );
+            }
+            else
+            {
+                IvGetRealSymmetricEigenvectors( v1[i + lane], v2[i + lane], v3[i + lane],
+                                                A[i + lane] );
+            }
+        }
+    }
+#endif
+    for ( ; i < count; ++i )
+    {
+        IvGetRealSymmetricEigenvectors( v1[i], v2[i], v3[i], A[i] );
+    }
+
+}  // End of IvGetRealSymmetricEigenvectors()
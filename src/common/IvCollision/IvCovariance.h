@@ -20,13 +20,49 @@
 //-- Dependencies ---------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+#include "IvVector3.h"
+
 //-------------------------------------------------------------------------------
 //-- Typedefs, Structs ----------------------------------------------------------
 //-------------------------------------------------------------------------------
 
-class IvVector3;
 class IvMatrix33;
 
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// Single pass mean and covariance of a point set.  Points can be added in
+// any order, and accumulators built over separate parts of the set (e.g. on
+// different threads) can be merged.
+class IvCovarianceAccumulator
+{
+public:
+    // constructor/destructor
+    inline IvCovarianceAccumulator() { Reset(); }
+    inline ~IvCovarianceAccumulator() {}
+
+    // manipulators
+    void Reset();
+    void Add( const IvVector3& point );
+    void Add( const IvVector3* points, unsigned int numPoints );
+    void Merge( const IvCovarianceAccumulator& other );
+
+    // accessors
+    inline unsigned int GetCount() const { return mCount; }
+    inline const IvVector3& GetMean() const { return mMean; }
+    void GetCovarianceMatrix( IvMatrix33& C ) const;   // needs at least 2 points
+
+protected:
+    void Merge( unsigned int count, const IvVector3& mean, const float* M2 );
+
+    unsigned int mCount;
+    IvVector3    mMean;
+    float        mM2[6];     // sums of squared deviations: xx, yy, zz, xy, xz, yz
+
+private:
+};
+
 //-------------------------------------------------------------------------------
 //-- Functions ------------------------------------------------------------------
 //-------------------------------------------------------------------------------
@@ -35,6 +71,9 @@ void IvComputeCovarianceMatrix( IvMatrix33& C, IvVector3& mean,
                               const IvVector3* points, unsigned int numPoints );
 void IvGetRealSymmetricEigenvectors( IvVector3& v1, IvVector3& v2, IvVector3& v3, 
                                    const IvMatrix33& A );
+// batch version for count matrices
+void IvGetRealSymmetricEigenvectors( IvVector3* v1, IvVector3* v2, IvVector3* v3, 
+                                   const IvMatrix33* A, unsigned int count );
 
 //-------------------------------------------------------------------------------
 //-- Inlines --------------------------------------------------------------------
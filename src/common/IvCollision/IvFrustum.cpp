@@ -0,0 +1,381 @@
+//===============================================================================
+// @ IvFrustum.cpp
+//
+// View frustum class for culling
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <IvAssert.h>
+#include "IvFrustum.h"
+#include "IvAABB.h"
+#include "IvBoundingSphere.h"
+#include <IvMatrix44.h>
+#include <IvSIMD.h>
+#include <IvVec3Stream.h>
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// Register type for the batch culls
+#if defined(IV_AVX)
+#define IV_FRUSTUM_SIMD
+typedef __m256 IvLanes;
+static const unsigned int kWidth = 8;
+#elif defined(IV_SSE2)
+#define IV_FRUSTUM_SIMD
+typedef __m128 IvLanes;
+static const unsigned int kWidth = 4;
+#endif
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#if defined(IV_FRUSTUM_SIMD)
+//-------------------------------------------------------------------------------
+// @ UpdatePlaneCache()
+//-------------------------------------------------------------------------------
+// Record the culling plane for the culled lanes of one group
+//-------------------------------------------------------------------------------
+static inline void
+UpdatePlaneCache( unsigned char* planeCache, IvLanes culledBy, int outsideMask )
+{
+    IV_ALIGN(32) float index[kWidth];
+    IvStore( index, culledBy );
+    for ( unsigned int lane = 0; lane < kWidth; ++lane )
+    {
+        unsigned char cached = planeCache[lane];
+        planeCache[lane] = ((outsideMask >> lane) & 1) ? (unsigned char) index[lane] : cached;
+    }
+
+}   // End of UpdatePlaneCache()
+#endif
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvFrustum::IvFrustum()
+//-------------------------------------------------------------------------------
+// Default constructor -- the clip volume of an identity matrix
+//-------------------------------------------------------------------------------
+IvFrustum::IvFrustum()
+{
+    IvMatrix44 identity;
+    Set( identity );
+
+}   // End of IvFrustum::IvFrustum()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFrustum::IvFrustum()
+//-------------------------------------------------------------------------------
+// Construct from projection*view matrix
+//-------------------------------------------------------------------------------
+IvFrustum::IvFrustum( const IvMatrix44& viewProjection, bool zeroToOneDepth )
+{
+    Set( viewProjection, zeroToOneDepth );
+
+}   // End of IvFrustum::IvFrustum()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFrustum::Set()
+//-------------------------------------------------------------------------------
+// Extract planes from projection*view matrix.  A point p is inside when
+// -w <= x,y <= w and -w (or 0) <= z <= w for (x,y,z,w) = M*p, so each plane
+// is a sum or difference of the bottom row and one other row.
+//-------------------------------------------------------------------------------
+void
+IvFrustum::Set( const IvMatrix44& M, bool zeroToOneDepth )
+{
+    mPlanes[kLeft].Set( M(3,0) + M(0,0), M(3,1) + M(0,1), M(3,2) + M(0,2), M(3,3) + M(0,3) );
+    mPlanes[kRight].Set( M(3,0) - M(0,0), M(3,1) - M(0,1), M(3,2) - M(0,2), M(3,3) - M(0,3) );
+    mPlanes[kBottom].Set( M(3,0) + M(1,0), M(3,1) + M(1,1), M(3,2) + M(1,2), M(3,3) + M(1,3) );
+    mPlanes[kTop].Set( M(3,0) - M(1,0), M(3,1) - M(1,1), M(3,2) - M(1,2), M(3,3) - M(1,3) );
+    if ( zeroToOneDepth )
+    {
+        mPlanes[kNear].Set( M(2,0), M(2,1), M(2,2), M(2,3) );
+    }
+    else
+    {
+        mPlanes[kNear].Set( M(3,0) + M(2,0), M(3,1) + M(2,1), M(3,2) + M(2,2), M(3,3) + M(2,3) );
+    }
+    mPlanes[kFar].Set( M(3,0) - M(2,0), M(3,1) - M(2,1), M(3,2) - M(2,2), M(3,3) - M(2,3) );
+
+}   // End of IvFrustum::Set()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFrustum::IsVisible()
+//-------------------------------------------------------------------------------
+// Returns false if sphere is entirely outside one of the planes
+//-------------------------------------------------------------------------------
+bool
+IvFrustum::IsVisible( const IvBoundingSphere& sphere ) const
+{
+    for ( unsigned int i = 0; i < kNumPlanes; ++i )
+    {
+        if ( sphere.Classify( mPlanes[i] ) < 0.0f )
+            return false;
+    }
+    return true;
+
+}   // End of IvFrustum::IsVisible()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFrustum::IsVisible()
+//-------------------------------------------------------------------------------
+// Returns false if box is entirely outside one of the planes
+//-------------------------------------------------------------------------------
+bool
+IvFrustum::IsVisible( const IvAABB& box ) const
+{
+    for ( unsigned int i = 0; i < kNumPlanes; ++i )
+    {
+        if ( box.Classify( mPlanes[i] ) < 0.0f )
+            return false;
+    }
+    return true;
+
+}   // End of IvFrustum::IsVisible()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFrustum::Cull()
+//-------------------------------------------------------------------------------
+// Batch sphere test.  A sphere is outside a plane when its center is more
+// than its radius behind it.
+//-------------------------------------------------------------------------------
+unsigned int
+IvFrustum::Cull( unsigned int* visible, const IvVec3Stream& centers, const float* radii,
+                 unsigned char* planeCache ) const
+{
+    ASSERT( visible && radii );
+
+    const unsigned int count = centers.GetCount();
+    const float* x = centers.GetX();
+    const float* y = centers.GetY();
+    const float* z = centers.GetZ();
+    unsigned int numVisible = 0;
+    unsigned int i = 0;
+#if defined(IV_FRUSTUM_SIMD)
+    const int allLanes = (1 << kWidth) - 1;
+    const IvLanes zero = IvBroadcast<IvLanes>( 0.0f );
+    IvLanes planes[kNumPlanes][4];
+    IvLanes planeIndex[kNumPlanes];
+    for ( unsigned int p = 0; p < kNumPlanes; ++p )
+    {
+        const IvVector3& normal = mPlanes[p].GetNormal();
+        planes[p][0] = IvBroadcast<IvLanes>( normal.x );
+        planes[p][1] = IvBroadcast<IvLanes>( normal.y );
+        planes[p][2] = IvBroadcast<IvLanes>( normal.z );
+        planes[p][3] = IvBroadcast<IvLanes>( mPlanes[p].GetOffset() );
+        planeIndex[p] = IvBroadcast<IvLanes>( (float) p );
+    }
+
+    for ( ; i + kWidth <= count; i += kWidth )
+    {
+        IvLanes cx = IvLoad<IvLanes>( x + i );
+        IvLanes cy = IvLoad<IvLanes>( y + i );
+        IvLanes cz = IvLoad<IvLanes>( z + i );
+        IvLanes negRadius = IvSub( zero, IvLoadU<IvLanes>( radii + i ) );
+
+        // try the plane that last culled the group's first object --
+        // if it culls the whole group we're done
+        IvLanes outside = zero;
+        IvLanes culledBy = zero;
+        if ( planeCache )
+        {
+            unsigned int p = planeCache[i] < kNumPlanes ? planeCache[i] : 0;
+            const IvLanes* plane = planes[p];
+            IvLanes test = IvMulAdd( plane[2], cz, IvMulAdd( plane[1], cy,
+                                     IvMulAdd( plane[0], cx, plane[3] ) ) );
+            outside = IvCmpLt( test, negRadius );
+            if ( IvMoveMask( outside ) == allLanes )
+                continue;
+            culledBy = IvAnd( outside, planeIndex[p] );
+        }
+
+        // otherwise test all the planes -- cheaper than branching per plane
+        for ( unsigned int p = 0; p < kNumPlanes; ++p )
+        {
+            const IvLanes* plane = planes[p];
+            IvLanes test = IvMulAdd( plane[2], cz, IvMulAdd( plane[1], cy,
+                                     IvMulAdd( plane[0], cx, plane[3] ) ) );
+            IvLanes culled = IvAndNot( outside, IvCmpLt( test, negRadius ) );
+            culledBy = IvSelect( culled, planeIndex[p], culledBy );
+            outside = IvOr( outside, culled );
+        }
+        int outsideMask = IvMoveMask( outside );
+        if ( planeCache )
+            UpdatePlaneCache( planeCache + i, culledBy, outsideMask );
+
+        // compact the survivors
+        for ( unsigned int lane = 0; lane < kWidth; ++lane )
+        {
+            visible[numVisible] = i + lane;
+            numVisible += ((~outsideMask) >> lane) & 1;
+        }
+    }
+#endif
+    for ( ; i < count; ++i )
+    {
+        unsigned int p = (planeCache && planeCache[i] < kNumPlanes) ? planeCache[i] : 0;
+        bool inside = true;
+        for ( unsigned int k = 0; k < kNumPlanes; ++k )
+        {
+            if ( mPlanes[p].Test( IvVector3( x[i], y[i], z[i] ) ) < -radii[i] )
+            {
+                if ( planeCache )
+                    planeCache[i] = (unsigned char)p;
+                inside = false;
+                break;
+            }
+            if ( ++p == kNumPlanes )
+                p = 0;
+        }
+        if ( inside )
+            visible[numVisible++] = i;
+    }
+
+    return numVisible;
+
+}   // End of IvFrustum::Cull()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFrustum::Cull()
+//-------------------------------------------------------------------------------
+// Batch AABB test.  A box is outside a plane when the corner farthest along
+// the plane normal is behind it.
+//-------------------------------------------------------------------------------
+unsigned int
+IvFrustum::Cull( unsigned int* visible, const IvVec3Stream& minima, const IvVec3Stream& maxima,
+                 unsigned char* planeCache ) const
+{
+    ASSERT( visible );
+    ASSERT( minima.GetCount() == maxima.GetCount() );
+
+    const unsigned int count = minima.GetCount();
+    const float* bounds[2][3] =
+    {
+        { minima.GetX(), minima.GetY(), minima.GetZ() },
+        { maxima.GetX(), maxima.GetY(), maxima.GetZ() }
+    };
+
+    // which bound gives the farthest corner, per plane and axis
+    unsigned int corner[kNumPlanes][3];
+    for ( unsigned int p = 0; p < kNumPlanes; ++p )
+    {
+        const IvVector3& normal = mPlanes[p].GetNormal();
+        for ( unsigned int j = 0; j < 3; ++j )
+        {
+            corner[p][j] = ( normal[j] >= 0.0f ) ? 1 : 0;
+        }
+    }
+
+    unsigned int numVisible = 0;
+    unsigned int i = 0;
+#if defined(IV_FRUSTUM_SIMD)
+    const int allLanes = (1 << kWidth) - 1;
+    const IvLanes zero = IvBroadcast<IvLanes>( 0.0f );
+    IvLanes planes[kNumPlanes][4];
+    IvLanes planeIndex[kNumPlanes];
+    for ( unsigned int p = 0; p < kNumPlanes; ++p )
+    {
+        const IvVector3& normal = mPlanes[p].GetNormal();
+        planes[p][0] = IvBroadcast<IvLanes>( normal.x );
+        planes[p][1] = IvBroadcast<IvLanes>( normal.y );
+        planes[p][2] = IvBroadcast<IvLanes>( normal.z );
+        planes[p][3] = IvBroadcast<IvLanes>( mPlanes[p].GetOffset() );
+        planeIndex[p] = IvBroadcast<IvLanes>( (float) p );
+    }
+
+    for ( ; i + kWidth <= count; i += kWidth )
+    {
+        IvLanes box[2][3];
+        for ( unsigned int j = 0; j < 3; ++j )
+        {
+            box[0][j] = IvLoad<IvLanes>( bounds[0][j] + i );
+            box[1][j] = IvLoad<IvLanes>( bounds[1][j] + i );
+        }
+
+        // try the plane that last culled the group's first object --
+        // if it culls the whole group we're done
+        IvLanes outside = zero;
+        IvLanes culledBy = zero;
+        if ( planeCache )
+        {
+            unsigned int p = planeCache[i] < kNumPlanes ? planeCache[i] : 0;
+            const IvLanes* plane = planes[p];
+            IvLanes test = IvMulAdd( plane[2], box[corner[p][2]][2],
+                           IvMulAdd( plane[1], box[corner[p][1]][1],
+                           IvMulAdd( plane[0], box[corner[p][0]][0], plane[3] ) ) );
+            outside = IvCmpLt( test, zero );
+            if ( IvMoveMask( outside ) == allLanes )
+                continue;
+            culledBy = IvAnd( outside, planeIndex[p] );
+        }
+
+        // otherwise test all the planes -- cheaper than branching per plane
+        for ( unsigned int p = 0; p < kNumPlanes; ++p )
+        {
+            const IvLanes* plane = planes[p];
+            IvLanes test = IvMulAdd( plane[2], box[corner[p][2]][2],
+                           IvMulAdd( plane[1], box[corner[p][1]][1],
+                           IvMulAdd( plane[0], box[corner[p][0]][0], plane[3] ) ) );
+            IvLanes culled = IvAndNot( outside, IvCmpLt( test, zero ) );
+            culledBy = IvSelect( culled, planeIndex[p], culledBy );
+            outside = IvOr( outside, culled );
+        }
+        int outsideMask = IvMoveMask( outside );
+        if ( planeCache )
+            UpdatePlaneCache( planeCache + i, culledBy, outsideMask );
+
+        // compact the survivors
+        for ( unsigned int lane = 0; lane < kWidth; ++lane )
+        {
+            visible[numVisible] = i + lane;
+            numVisible += ((~outsideMask) >> lane) & 1;
+        }
+    }
+#endif
+    for ( ; i < count; ++i )
+    {
+        unsigned int p = (planeCache && planeCache[i] < kNumPlanes) ? planeCache[i] : 0;
+        bool inside = true;
+        for ( unsigned int k = 0; k < kNumPlanes; ++k )
+        {
+            IvVector3 farthest( bounds[corner[p][0]][0][i], bounds[corner[p][1]][1][i],
+                                bounds[corner[p][2]][2][i] );
+            if ( mPlanes[p].Test( farthest ) < 0.0f )
+            {
+                if ( planeCache )
+                    planeCache[i] = (unsigned char)p;
+                inside = false;
+                break;
+            }
+            if ( ++p == kNumPlanes )
+                p = 0;
+        }
+        if ( inside )
+            visible[numVisible++] = i;
+    }
+
+    return numVisible;
+
+}   // End of IvFrustum::Cull()
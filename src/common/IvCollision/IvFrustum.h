@@ -0,0 +1,97 @@
+//===============================================================================
+// @ IvFrustum.h
+//
+// View frustum class for culling
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// The six planes are extracted from a combined projection*view matrix and
+// face inward, so a bounding volume is culled if it classifies as entirely
+// on the negative side of any plane.  The batch Cull() calls test 4 or 8
+// objects at a time, stored as structure-of-arrays bounds.
+//
+//===============================================================================
+
+#ifndef __IvFrustum__h__
+#define __IvFrustum__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvPlane.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvAABB;
+class IvBoundingSphere;
+class IvMatrix44;
+class IvVec3Stream;
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvFrustum
+{
+public:
+    enum
+    {
+        kLeft = 0,
+        kRight,
+        kBottom,
+        kTop,
+        kNear,
+        kFar,
+        kNumPlanes
+    };
+
+    // constructor/destructor
+    IvFrustum();
+    explicit IvFrustum( const IvMatrix44& viewProjection, bool zeroToOneDepth = false );
+    inline ~IvFrustum() {}
+
+    // manipulators
+    // zeroToOneDepth is for projections that map depth to [0,1] (D3D)
+    // rather than [-1,1] (OpenGL)
+    void Set( const IvMatrix44& viewProjection, bool zeroToOneDepth = false );
+
+    // accessors
+    inline const IvPlane& GetPlane( unsigned int i ) const { return mPlanes[i]; }
+
+    // single object tests -- true if not entirely outside
+    bool IsVisible( const IvBoundingSphere& sphere ) const;
+    bool IsVisible( const IvAABB& box ) const;
+
+    // batch tests -- write the indices of the objects not entirely outside
+    // to visible (which must hold one entry per object) and return how many.
+    // planeCache, if given, holds one entry per object: the plane that last
+    // culled it, which is tried first next time.  Groups of objects start
+    // from the entry of their first object.  Zero the cache before first
+    // use; entries outside [0, kNumPlanes) are treated as 0.
+    unsigned int Cull( unsigned int* visible, const IvVec3Stream& centers,
+                       const float* radii, unsigned char* planeCache = 0 ) const;
+    unsigned int Cull( unsigned int* visible, const IvVec3Stream& minima,
+                       const IvVec3Stream& maxima, unsigned char* planeCache = 0 ) const;
+
+protected:
+    IvPlane mPlanes[kNumPlanes];
+
+private:
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
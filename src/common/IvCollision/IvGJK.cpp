@@ -0,0 +1,989 @@
+//===============================================================================
+// @ IvGJK.cpp
+//
+// GJK and EPA queries between convex shapes
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvGJK.h"
+#include "IvSupportMap.h"
+#include <IvAssert.h>
+#include <IvMath.h>
+#include <float.h>
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// iteration limits; both loops normally stop long before these
+static const unsigned int kMaxIterations = 64;
+static const unsigned int kMaxPolytopeIterations = 64;
+
+// polytope sizes, from the iteration limit and Euler's formula
+static const unsigned int kMaxPolytopeVertices = kMaxPolytopeIterations + 4;
+static const unsigned int kMaxPolytopeFaces = 2*kMaxPolytopeVertices;
+
+// GJK stops when a new support point improves the squared distance by less
+// than this fraction
+static const float kRelativeTolerance = 1.0e-5f;
+
+// squared distance, relative to the squared size of the simplex, taken as
+// touching the origin
+static const float kOverlapTolerance = 1.0e-10f;
+
+// relative size below which simplex vertices are treated as coincident,
+// collinear or coplanar
+static const float kDegenerateTolerance = 1.0e-8f;
+
+// EPA stops when a new support point moves the nearest face by less than
+// this fraction of the polytope size
+static const float kPolytopeTolerance = 1.0e-4f;
+
+// height above a polytope face, relative to the polytope size, below which
+// a new support point doesn't see it; less than kPolytopeTolerance, so the
+// nearest face is always seen
+static const float kVisibleTolerance = 1.0e-5f;
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// point on the Minkowski difference shape0 - shape1
+struct IvGJKVertex
+{
+    IvVector3   point;          // point0 - point1
+    IvVector3   point0;
+    IvVector3   point1;
+    IvVector3   direction;      // search direction that found it
+};
+
+struct IvGJKSimplex
+{
+    IvGJKVertex     vertices[4];
+    float           weights[4];     // barycentric coordinates of the closest point
+    unsigned int    count;
+};
+
+enum IvGJKStatus
+{
+    kGJKSeparated,      // stopped early; the shapes are apart
+    kGJKConverged,      // found the closest point
+    kGJKOverlap         // the simplex contains the origin
+};
+
+struct IvPolytopeFace
+{
+    unsigned int    vertices[3];    // counterclockwise seen from outside
+    IvVector3       normal;
+    float           distance;       // from the origin
+};
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ SupportVertex()
+//-------------------------------------------------------------------------------
+// Point of the Minkowski difference farthest along direction, with or
+// without the margins
+//-------------------------------------------------------------------------------
+static void
+SupportVertex( IvGJKVertex& vertex, const IvSupportMap& shape0, const IvSupportMap& shape1,
+               const IvVector3& direction, bool addMargins )
+{
+    vertex.direction = direction;
+    vertex.point0 = shape0.Support( direction );
+    vertex.point1 = shape1.Support( -direction );
+    if ( addMargins )
+    {
+        float lengthSq = direction.LengthSquared();
+        if ( lengthSq > 0.0f )
+        {
+            IvVector3 unit = ::IvRecipSqrt( lengthSq )*direction;
+            vertex.point0 += shape0.GetMargin()*unit;
+            vertex.point1 -= shape1.GetMargin()*unit;
+        }
+    }
+    vertex.point = vertex.point0 - vertex.point1;
+
+}   // End of SupportVertex()
+
+
+//-------------------------------------------------------------------------------
+// @ ClosestOnSegment()
+//-------------------------------------------------------------------------------
+// Smallest part of the segment ab holding the point closest to the origin
+//-------------------------------------------------------------------------------
+static void
+ClosestOnSegment( IvGJKSimplex& result, const IvGJKVertex& a, const IvGJKVertex& b )
+{
+    IvVector3 ab = b.point - a.point;
+    float t = -a.point.Dot( ab );
+    float lengthSq = ab.Dot( ab );
+    if ( t <= 0.0f )
+    {
+        result.vertices[0] = a;
+        result.weights[0] = 1.0f;
+        result.count = 1;
+    }
+    else if ( t >= lengthSq )
+    {
+        result.vertices[0] = b;
+        result.weights[0] = 1.0f;
+        result.count = 1;
+    }
+    else
+    {
+        t /= lengthSq;
+        result.vertices[0] = a;
+        result.vertices[1] = b;
+        result.weights[0] = 1.0f - t;
+        result.weights[1] = t;
+        result.count = 2;
+    }
+
+}   // End of ClosestOnSegment()
+
+
+//-------------------------------------------------------------------------------
+// @ ClosestOnTriangle()
+//-------------------------------------------------------------------------------
+// Smallest part of the triangle abc holding the point closest to the
+// origin, found by testing its Voronoi regions in turn
+//-------------------------------------------------------------------------------
+static void
+ClosestOnTriangle( IvGJKSimplex& result, const IvGJKVertex& a, const IvGJKVertex& b,
+                   const IvGJKVertex& c )
+{
+    IvVector3 ab = b.point - a.point;
+    IvVector3 ac = c.point - a.point;
+
+    // vertex region of a
+    float d1 = -ab.Dot( a.point );
+    float d2 = -ac.Dot( a.point );
+    if ( d1 <= 0.0f && d2 <= 0.0f )
+    {
+        result.vertices[0] = a;
+        result.weights[0] = 1.0f;
+        result.count = 1;
+        return;
+    }
+
+    // vertex region of b
+    float d3 = -ab.Dot( b.point );
+    float d4 = -ac.Dot( b.point );
+    if ( d3 >= 0.0f && d4 <= d3 )
+    {
+        result.vertices[0] = b;
+        result.weights[0] = 1.0f;
+        result.count = 1;
+        return;
+    }
+
+    // edge region of ab
+    float vc = d1*d4 - d3*d2;
+    if ( vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f )
+    {
+        float t = d1/(d1 - d3);
+        result.vertices[0] = a;
+        result.vertices[1] = b;
+        result.weights[0] = 1.0f - t;
+        result.weights[1] = t;
+        result.count = 2;
+        return;
+    }
+
+    // vertex region of c
+    float d5 = -ab.Dot( c.point );
+    float d6 = -ac.Dot( c.point );
+    if ( d6 >= 0.0f && d5 <= d6 )
+    {
+        result.vertices[0] = c;
+        result.weights[0] = 1.0f;
+        result.count = 1;
+        return;
+    }
+
+    // edge region of ac
+    float vb = d5*d2 - d1*d6;
+    if ( vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f )
+    {
+        float t = d2/(d2 - d6);
+        result.vertices[0] = a;
+        result.vertices[1] = c;
+        result.weights[0] = 1.0f - t;
+        result.weights[1] = t;
+        result.count = 2;
+        return;
+    }
+
+    // edge region of bc
+    float va = d3*d6 - d5*d4;
+    if ( va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f )
+    {
+        float t = (d4 - d3)/((d4 - d3) + (d5 - d6));
+        result.vertices[0] = b;
+        result.vertices[1] = c;
+        result.weights[0] = 1.0f - t;
+        result.weights[1] = t;
+        result.count = 2;
+        return;
+    }
+
+    // face region
+    float denom = va + vb + vc;
+    if ( denom <= 0.0f )
+    {
+        // degenerate triangle; use its longest edge
+        float abSq = ab.Dot( ab );
+        float acSq = ac.Dot( ac );
+        float bcSq = (c.point - b.point).LengthSquared();
+        if ( abSq >= acSq && abSq >= bcSq )
+            ClosestOnSegment( result, a, b );
+        else if ( acSq >= bcSq )
+            ClosestOnSegment( result, a, c );
+        else
+            ClosestOnSegment( result, b, c );
+        return;
+    }
+    float v = vb/denom;
+    float w = vc/denom;
+    result.vertices[0] = a;
+    result.vertices[1] = b;
+    result.vertices[2] = c;
+    result.weights[0] = 1.0f - v - w;
+    result.weights[1] = v;
+    result.weights[2] = w;
+    result.count = 3;
+
+}   // End of ClosestOnTriangle()
+
+
+//-------------------------------------------------------------------------------
+// @ CombinePoints()
+//-------------------------------------------------------------------------------
+// Closest point on the simplex, and the points on each shape that make it
+//-------------------------------------------------------------------------------
+static IvVector3
+CombinePoints( const IvGJKSimplex& simplex, IvVector3* point0 = 0, IvVector3* point1 = 0 )
+{
+    IvVector3 point = simplex.weights[0]*simplex.vertices[0].point;
+    for ( unsigned int i = 1; i < simplex.count; ++i )
+    {
+        point += simplex.weights[i]*simplex.vertices[i].point;
+    }
+
+    if ( point0 && point1 )
+    {
+        *point0 = simplex.weights[0]*simplex.vertices[0].point0;
+        *point1 = simplex.weights[0]*simplex.vertices[0].point1;
+        for ( unsigned int i = 1; i < simplex.count; ++i )
+        {
+            *point0 += simplex.weights[i]*simplex.vertices[i].point0;
+            *point1 += simplex.weights[i]*simplex.vertices[i].point1;
+        }
+    }
+
+    return point;
+
+}   // End of CombinePoints()
+
+
+//-------------------------------------------------------------------------------
+// @ ReduceSimplex()
+//-------------------------------------------------------------------------------
+// Reduce the simplex to the smallest part holding the point closest to the
+// origin, and return that point.  A tetrahedron holding the origin is left
+// as it is.
+//-------------------------------------------------------------------------------
+static IvVector3
+ReduceSimplex( IvGJKSimplex& simplex )
+{
+    const IvGJKVertex* v = simplex.vertices;
+    switch ( simplex.count )
+    {
+    case 1:
+        simplex.weights[0] = 1.0f;
+        break;
+
+    case 2:
+        {
+            IvGJKSimplex result;
+            ClosestOnSegment( result, v[0], v[1] );
+            simplex = result;
+        }
+        break;
+
+    case 3:
+        {
+            IvGJKSimplex result;
+            ClosestOnTriangle( result, v[0], v[1], v[2] );
+            simplex = result;
+        }
+        break;
+
+    case 4:
+        {
+            // test each face the origin is outside of, treating faces of
+            // a flat tetrahedron as all outside
+            static const unsigned int faces[4][4] =
+            {
+                { 0, 1, 2, 3 }, { 0, 2, 3, 1 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 }
+            };
+            IvGJKSimplex best;
+            float bestDistanceSq = FLT_MAX;
+            bool inside = true;
+            for ( unsigned int f = 0; f < 4; ++f )
+            {
+                const IvGJKVertex& a = v[faces[f][0]];
+                const IvGJKVertex& b = v[faces[f][1]];
+                const IvGJKVertex& c = v[faces[f][2]];
+                IvVector3 normal = (b.point - a.point).Cross( c.point - a.point );
+                IvVector3 toOpposite = v[faces[f][3]].point - a.point;
+                float originSide = -normal.Dot( a.point );
+                float oppositeSide = normal.Dot( toOpposite );
+                if ( originSide*oppositeSide > 0.0f
+                     && oppositeSide*oppositeSide > kDegenerateTolerance*normal.LengthSquared()
+                                                    *toOpposite.LengthSquared() )
+                    continue;
+
+                inside = false;
+                IvGJKSimplex result;
+                ClosestOnTriangle( result, a, b, c );
+                float distanceSq = CombinePoints( result ).LengthSquared();
+                if ( distanceSq < bestDistanceSq )
+                {
+                    bestDistanceSq = distanceSq;
+                    best = result;
+                }
+            }
+
+            if ( inside )
+                return IvVector3::origin;
+            simplex = best;
+        }
+        break;
+
+    default:
+        ASSERT( false );
+        break;
+    }
+
+    return CombinePoints( simplex );
+
+}   // End of ReduceSimplex()
+
+
+//-------------------------------------------------------------------------------
+// @ AddVertex()
+//-------------------------------------------------------------------------------
+// Add a vertex to the simplex unless it's already there.  Returns false for
+// a repeat.
+//-------------------------------------------------------------------------------
+static bool
+AddVertex( IvGJKSimplex& simplex, const IvGJKVertex& vertex )
+{
+    ASSERT( simplex.count < 4 );
+    for ( unsigned int i = 0; i < simplex.count; ++i )
+    {
+        IvVector3 diff = simplex.vertices[i].point - vertex.point;
+        if ( diff.LengthSquared() <= kDegenerateTolerance*vertex.point.LengthSquared() )
+            return false;
+    }
+
+    simplex.vertices[simplex.count] = vertex;
+    simplex.weights[simplex.count] = 0.0f;
+    ++simplex.count;
+    return true;
+
+}   // End of AddVertex()
+
+
+//-------------------------------------------------------------------------------
+// @ SolveGJK()
+//-------------------------------------------------------------------------------
+// Find the point of the Minkowski difference closest to the origin.  If
+// stopEarly is set, stops as soon as the distance is certain to be more or
+// less than separation.
+//-------------------------------------------------------------------------------
+static IvGJKStatus
+SolveGJK( IvGJKSimplex& simplex, IvVector3& closest,
+          const IvSupportMap& shape0, const IvSupportMap& shape1, bool addMargins,
+          bool stopEarly, float separation, IvGJKCache* cache )
+{
+    // start from the cached simplex, or toward shape1
+    IvGJKVertex vertex;
+    simplex.count = 0;
+    if ( cache )
+    {
+        for ( unsigned int i = 0; i < cache->GetCount(); ++i )
+        {
+            SupportVertex( vertex, shape0, shape1, cache->GetDirection( i ), addMargins );
+            AddVertex( simplex, vertex );
+        }
+    }
+    if ( simplex.count == 0 )
+    {
+        IvVector3 direction = shape1.GetCenter() - shape0.GetCenter();
+        if ( direction.LengthSquared() == 0.0f )
+            direction = IvVector3::xAxis;
+        SupportVertex( vertex, shape0, shape1, direction, addMargins );
+        AddVertex( simplex, vertex );
+    }
+
+    IvGJKStatus status;
+    unsigned int iterations = 0;
+    for ( ;; )
+    {
+        closest = ReduceSimplex( simplex );
+        float closestSq = closest.LengthSquared();
+        float sizeSq = 0.0f;
+        for ( unsigned int i = 0; i < simplex.count; ++i )
+        {
+            float lengthSq = simplex.vertices[i].point.LengthSquared();
+            if ( lengthSq > sizeSq )
+                sizeSq = lengthSq;
+        }
+        if ( simplex.count == 4 || closestSq <= kOverlapTolerance*sizeSq
+             || (stopEarly && closestSq <= separation*separation) )
+        {
+            status = kGJKOverlap;
+            break;
+        }
+        if ( iterations == kMaxIterations )
+        {
+            status = kGJKConverged;
+            break;
+        }
+        ++iterations;
+
+        // support point toward the origin bounds the distance from below
+        SupportVertex( vertex, shape0, shape1, -closest, addMargins );
+        float bound = closest.Dot( vertex.point );
+        if ( stopEarly && bound > 0.0f && bound*bound > separation*separation*closestSq )
+        {
+            status = kGJKSeparated;
+            break;
+        }
+        if ( closestSq - bound <= kRelativeTolerance*closestSq || !AddVertex( simplex, vertex ) )
+        {
+            status = kGJKConverged;
+            break;
+        }
+    }
+
+    if ( cache )
+    {
+        IvVector3 directions[4];
+        for ( unsigned int i = 0; i < simplex.count; ++i )
+        {
+            directions[i] = simplex.vertices[i].direction;
+        }
+        cache->Set( directions, simplex.count );
+        cache->SetIterations( iterations );
+    }
+
+    return status;
+
+}   // End of SolveGJK()
+
+
+//-------------------------------------------------------------------------------
+// @ CompleteSimplex()
+//-------------------------------------------------------------------------------
+// Grow a simplex of the cores that touches the origin into a tetrahedron,
+// for EPA.  Returns false if the Minkowski difference of the cores is flat.
+//-------------------------------------------------------------------------------
+static bool
+CompleteSimplex( IvGJKSimplex& simplex, const IvSupportMap& shape0, const IvSupportMap& shape1 )
+{
+    IvGJKVertex vertex;
+    while ( simplex.count < 4 )
+    {
+        const IvGJKVertex* v = simplex.vertices;
+        IvVector3 directions[6];
+        unsigned int numDirections = 0;
+        if ( simplex.count == 1 )
+        {
+            directions[0] = IvVector3::xAxis;
+            directions[1] = -IvVector3::xAxis;
+            directions[2] = IvVector3::yAxis;
+            directions[3] = -IvVector3::yAxis;
+            directions[4] = IvVector3::zAxis;
+            directions[5] = -IvVector3::zAxis;
+            numDirections = 6;
+        }
+        else if ( simplex.count == 2 )
+        {
+            // directions around the edge, starting across the axis it's
+            // least aligned with
+            IvVector3 edge = v[1].point - v[0].point;
+            IvVector3 axis = IvVector3::xAxis;
+            if ( IvAbs( edge.y ) < IvAbs( edge.x ) && IvAbs( edge.y ) <= IvAbs( edge.z ) )
+                axis = IvVector3::yAxis;
+            else if ( IvAbs( edge.z ) < IvAbs( edge.x ) )
+                axis = IvVector3::zAxis;
+            directions[0] = edge.Cross( axis );
+            directions[1] = -directions[0];
+            directions[2] = edge.Cross( directions[0] );
+            directions[3] = -directions[2];
+            numDirections = 4;
+        }
+        else
+        {
+            directions[0] = (v[1].point - v[0].point).Cross( v[2].point - v[0].point );
+            directions[1] = -directions[0];
+            numDirections = 2;
+        }
+
+        // take the first that adds a dimension
+        unsigned int i = 0;
+        for ( ; i < numDirections; ++i )
+        {
+            SupportVertex( vertex, shape0, shape1, directions[i], false );
+            IvVector3 offset = vertex.point - v[0].point;
+            float offsetSq = offset.LengthSquared();
+            float scaleSq = offsetSq + v[0].point.LengthSquared();
+            if ( simplex.count == 2 )
+            {
+                IvVector3 edge = v[1].point - v[0].point;
+                offsetSq = edge.Cross( offset ).LengthSquared()/edge.LengthSquared();
+            }
+            else if ( simplex.count == 3 )
+            {
+                float height = offset.Dot( directions[0] );
+                offsetSq = height*height/directions[0].LengthSquared();
+            }
+            if ( offsetSq > kDegenerateTolerance*scaleSq )
+                break;
+        }
+        if ( i == numDirections )
+            return false;
+
+        simplex.vertices[simplex.count] = vertex;
+        simplex.weights[simplex.count] = 0.0f;
+        ++simplex.count;
+    }
+
+    return true;
+
+}   // End of CompleteSimplex()
+
+
+//-------------------------------------------------------------------------------
+// @ FlatNormal()
+//-------------------------------------------------------------------------------
+// Normal to a flat simplex that touches the origin, turned toward hint.  The
+// simplex has no depth along it.
+//-------------------------------------------------------------------------------
+static IvVector3
+FlatNormal( const IvGJKSimplex& simplex, const IvVector3& hint )
+{
+    // normal of the largest triangle, and the longest edge
+    const IvGJKVertex* v = simplex.vertices;
+    IvVector3 normal = IvVector3::origin;
+    IvVector3 edge = IvVector3::origin;
+    float normalSq = 0.0f;
+    float edgeSq = 0.0f;
+    for ( unsigned int i = 0; i < simplex.count; ++i )
+    {
+        for ( unsigned int j = i + 1; j < simplex.count; ++j )
+        {
+            IvVector3 ij = v[j].point - v[i].point;
+            if ( ij.LengthSquared() > edgeSq )
+            {
+                edge = ij;
+                edgeSq = ij.LengthSquared();
+            }
+            for ( unsigned int k = j + 1; k < simplex.count; ++k )
+            {
+                IvVector3 cross = ij.Cross( v[k].point - v[i].point );
+                if ( cross.LengthSquared() > normalSq )
+                {
+                    normal = cross;
+                    normalSq = cross.LengthSquared();
+                }
+            }
+        }
+    }
+
+    // a segment or point leaves a choice, so take what's left of the hint
+    if ( normalSq <= kDegenerateTolerance*edgeSq*edgeSq )
+    {
+        normal = hint;
+        if ( edgeSq > 0.0f )
+            normal -= (hint.Dot( edge )/edgeSq)*edge;
+        if ( normal.LengthSquared() <= kDegenerateTolerance*hint.LengthSquared() )
+        {
+            normal = edge.Cross( IvAbs( edge.z ) < IvAbs( edge.x ) ? IvVector3::zAxis
+                                                                  : IvVector3::xAxis );
+            if ( normal.LengthSquared() == 0.0f )
+                normal = IvVector3::zAxis;
+        }
+    }
+
+    if ( normal.Dot( hint ) < 0.0f )
+        normal = -normal;
+    normal.Normalize();
+    return normal;
+
+}   // End of FlatNormal()
+
+
+//-------------------------------------------------------------------------------
+// @ MakeFace()
+//-------------------------------------------------------------------------------
+// Set up a polytope face.  Returns false if it's too thin to have a
+// reliable normal.
+//-------------------------------------------------------------------------------
+static bool
+MakeFace( IvPolytopeFace& face, const IvGJKVertex* vertices,
+          unsigned int i0, unsigned int i1, unsigned int i2 )
+{
+    const IvVector3& p0 = vertices[i0].point;
+    IvVector3 edge1 = vertices[i1].point - p0;
+    IvVector3 edge2 = vertices[i2].point - p0;
+    IvVector3 normal = edge1.Cross( edge2 );
+    float lengthSq = normal.LengthSquared();
+    if ( lengthSq <= kDegenerateTolerance*edge1.LengthSquared()*edge2.LengthSquared() )
+        return false;
+
+    face.vertices[0] = i0;
+    face.vertices[1] = i1;
+    face.vertices[2] = i2;
+    face.normal = ::IvRecipSqrt( lengthSq )*normal;
+    face.distance = face.normal.Dot( p0 );
+    return true;
+
+}   // End of MakeFace()
+
+
+//-------------------------------------------------------------------------------
+// @ AddHorizonEdge()
+//-------------------------------------------------------------------------------
+// Add an edge of a removed face.  An edge shared with another removed face
+// is inside the hole, and cancels out.  Returns false if there's no room.
+//-------------------------------------------------------------------------------
+static bool
+AddHorizonEdge( unsigned int (*edges)[2], unsigned int& numEdges, unsigned int i0, unsigned int i1 )
+{
+    for ( unsigned int e = 0; e < numEdges; ++e )
+    {
+        if ( edges[e][0] == i1 && edges[e][1] == i0 )
+        {
+            --numEdges;
+            edges[e][0] = edges[numEdges][0];
+            edges[e][1] = edges[numEdges][1];
+            return true;
+        }
+    }
+
+    if ( numEdges == kMaxPolytopeFaces )
+        return false;
+    edges[numEdges][0] = i0;
+    edges[numEdges][1] = i1;
+    ++numEdges;
+    return true;
+
+}   // End of AddHorizonEdge()
+
+
+//-------------------------------------------------------------------------------
+// @ ExpandPolytope()
+//-------------------------------------------------------------------------------
+// EPA: grow the tetrahedron toward the surface of the Minkowski difference
+// of the cores until its face nearest the origin is on the surface.
+// Returns that face's normal and distance, and the points on each core
+// under the origin's projection onto it.  Returns false if the tetrahedron
+// is too flat to start from.
+//-------------------------------------------------------------------------------
+static bool
+ExpandPolytope( IvVector3& normal, float& depth, IvVector3& point0, IvVector3& point1,
+                const IvGJKSimplex& simplex,
+                const IvSupportMap& shape0, const IvSupportMap& shape1 )
+{
+    ASSERT( simplex.count == 4 );
+    IvGJKVertex vertices[kMaxPolytopeVertices];
+    IvPolytopeFace faces[kMaxPolytopeFaces];
+    IvPolytopeFace newFaces[kMaxPolytopeFaces];
+    bool visible[kMaxPolytopeFaces];
+    unsigned int edges[kMaxPolytopeFaces][2];
+    unsigned int numVertices = 4;
+    unsigned int numFaces = 0;
+
+    // orient the tetrahedron so its faces wind outward
+    for ( unsigned int i = 0; i < 4; ++i )
+    {
+        vertices[i] = simplex.vertices[i];
+    }
+    IvVector3 a = vertices[1].point - vertices[0].point;
+    IvVector3 b = vertices[2].point - vertices[0].point;
+    IvVector3 c = vertices[3].point - vertices[0].point;
+    if ( a.Cross( b ).Dot( c ) > 0.0f )
+    {
+        IvGJKVertex swap = vertices[1];
+        vertices[1] = vertices[2];
+        vertices[2] = swap;
+    }
+    static const unsigned int tetrahedron[4][3] =
+    {
+        { 0, 1, 2 }, { 0, 3, 1 }, { 0, 2, 3 }, { 1, 3, 2 }
+    };
+    float size = 0.0f;
+    for ( unsigned int i = 0; i < 4; ++i )
+    {
+        if ( MakeFace( faces[numFaces], vertices, tetrahedron[i][0], tetrahedron[i][1],
+                       tetrahedron[i][2] ) )
+            ++numFaces;
+        float length = vertices[i].point.Length();
+        if ( length > size )
+            size = length;
+    }
+    if ( numFaces < 4 )
+        return false;
+
+    unsigned int nearest = 0;
+    for ( unsigned int iteration = 0; ; ++iteration )
+    {
+        nearest = 0;
+        for ( unsigned int f = 1; f < numFaces; ++f )
+        {
+            if ( faces[f].distance < faces[nearest].distance )
+                nearest = f;
+        }
+        if ( iteration == kMaxPolytopeIterations || numVertices == kMaxPolytopeVertices )
+            break;
+
+        // done when the surface is no farther out than the face
+        IvGJKVertex vertex;
+        SupportVertex( vertex, shape0, shape1, faces[nearest].normal, false );
+        float distance = faces[nearest].normal.Dot( vertex.point );
+        if ( distance - faces[nearest].distance <= kPolytopeTolerance*size )
+            break;
+        unsigned int newVertex = numVertices;
+        vertices[newVertex] = vertex;
+
+        // find the faces the new vertex can see, ignoring any it's nearly
+        // level with, and the edges of the hole they leave
+        float tolerance = kVisibleTolerance*size;
+        unsigned int numVisible = 0;
+        unsigned int numEdges = 0;
+        bool closed = true;
+        for ( unsigned int f = 0; f < numFaces; ++f )
+        {
+            const IvPolytopeFace& face = faces[f];
+            visible[f] = face.normal.Dot( vertex.point - vertices[face.vertices[0]].point )
+                         > tolerance;
+            if ( visible[f] )
+            {
+                ++numVisible;
+                closed = closed
+                    && AddHorizonEdge( edges, numEdges, face.vertices[0], face.vertices[1] )
+                    && AddHorizonEdge( edges, numEdges, face.vertices[1], face.vertices[2] )
+                    && AddHorizonEdge( edges, numEdges, face.vertices[2], face.vertices[0] );
+            }
+        }
+        closed = closed && numEdges >= 3 && numFaces - numVisible + numEdges <= kMaxPolytopeFaces;
+        for ( unsigned int e = 0; e < numEdges && closed; ++e )
+        {
+            closed = MakeFace( newFaces[e], vertices, edges[e][0], edges[e][1], newVertex );
+        }
+
+        // if the hole can't be closed, the nearest face is as good as it gets
+        if ( !closed )
+            break;
+
+        unsigned int numKept = 0;
+        for ( unsigned int f = 0; f < numFaces; ++f )
+        {
+            if ( !visible[f] )
+                faces[numKept++] = faces[f];
+        }
+        for ( unsigned int e = 0; e < numEdges; ++e )
+        {
+            faces[numKept++] = newFaces[e];
+        }
+        numFaces = numKept;
+        ++numVertices;
+        float length = vertex.point.Length();
+        if ( length > size )
+            size = length;
+    }
+
+    // barycentric coordinates of the origin's projection onto the face
+    const IvPolytopeFace& face = faces[nearest];
+    const IvGJKVertex& v0 = vertices[face.vertices[0]];
+    const IvGJKVertex& v1 = vertices[face.vertices[1]];
+    const IvGJKVertex& v2 = vertices[face.vertices[2]];
+    IvVector3 e0 = v1.point - v0.point;
+    IvVector3 e1 = v2.point - v0.point;
+    IvVector3 e2 = face.distance*face.normal - v0.point;
+    float d00 = e0.Dot( e0 );
+    float d01 = e0.Dot( e1 );
+    float d11 = e1.Dot( e1 );
+    float d20 = e2.Dot( e0 );
+    float d21 = e2.Dot( e1 );
+    float denom = d00*d11 - d01*d01;
+    float u = 0.0f;
+    float v = 0.0f;
+    if ( denom > 0.0f )
+    {
+        u = (d11*d20 - d01*d21)/denom;
+        v = (d00*d21 - d01*d20)/denom;
+    }
+
+    normal = face.normal;
+    point0 = (1.0f - u - v)*v0.point0 + u*v1.point0 + v*v2.point0;
+    point1 = (1.0f - u - v)*v0.point1 + u*v1.point1 + v*v2.point1;
+
+    // the surface bounds the depth along the normal, and the origin is
+    // inside it; keep to those if the polytope has gone wrong
+    IvGJKVertex vertex;
+    SupportVertex( vertex, shape0, shape1, normal, false );
+    float extent = normal.Dot( vertex.point );
+    depth = face.distance;
+    if ( depth > extent )
+        depth = extent;
+    if ( depth < 0.0f )
+        depth = 0.0f;
+    return true;
+
+}   // End of ExpandPolytope()
+
+
+//-------------------------------------------------------------------------------
+// @ ::Intersect()
+//-------------------------------------------------------------------------------
+// Test for overlap, stopping early with either answer
+//-------------------------------------------------------------------------------
+bool
+Intersect( const IvSupportMap& shape0, const IvSupportMap& shape1, IvGJKCache* cache )
+{
+    float marginSum = shape0.GetMargin() + shape1.GetMargin();
+    IvGJKSimplex simplex;
+    IvVector3 closest;
+    IvGJKStatus status = SolveGJK( simplex, closest, shape0, shape1, false, true, marginSum, cache );
+
+    return status == kGJKOverlap
+        || (status == kGJKConverged && closest.LengthSquared() <= marginSum*marginSum);
+
+}   // End of ::Intersect()
+
+
+//-------------------------------------------------------------------------------
+// @ ::Distance()
+//-------------------------------------------------------------------------------
+// Distance and closest points between shapes
+//-------------------------------------------------------------------------------
+float
+Distance( IvVector3& point0, IvVector3& point1,
+          const IvSupportMap& shape0, const IvSupportMap& shape1, IvGJKCache* cache )
+{
+    float margin0 = shape0.GetMargin();
+    float margin1 = shape1.GetMargin();
+    IvGJKSimplex simplex;
+    IvVector3 closest;
+    IvGJKStatus status = SolveGJK( simplex, closest, shape0, shape1, false, false, 0.0f, cache );
+    CombinePoints( simplex, &point0, &point1 );
+    if ( status == kGJKOverlap )
+        return 0.0f;
+
+    float distance = closest.Length();
+    if ( distance <= margin0 + margin1 )
+        return 0.0f;
+
+    // move out from the cores to the surfaces
+    IvVector3 normal = -closest/distance;
+    point0 += margin0*normal;
+    point1 -= margin1*normal;
+    return distance - margin0 - margin1;
+
+}   // End of ::Distance()
+
+
+//-------------------------------------------------------------------------------
+// @ ::ComputeCollision()
+//-------------------------------------------------------------------------------
+// Collision normal, point and penetration between shapes.  If only the
+// margins overlap, they come from the closest points of the cores;
+// otherwise EPA finds them for the cores, and the margins are added.
+//-------------------------------------------------------------------------------
+bool
+ComputeCollision( const IvSupportMap& shape0, const IvSupportMap& shape1,
+                  IvVector3& collisionNormal, IvVector3& collisionPoint,
+                  float& penetration, IvGJKCache* cache )
+{
+    float margin0 = shape0.GetMargin();
+    float margin1 = shape1.GetMargin();
+    float marginSum = margin0 + margin1;
+    IvGJKSimplex simplex;
+    IvVector3 closest;
+    IvVector3 point0, point1;
+    IvGJKStatus status = SolveGJK( simplex, closest, shape0, shape1, false, false, 0.0f, cache );
+    if ( status != kGJKOverlap )
+    {
+        float distance = closest.Length();
+        if ( distance > marginSum )
+            return false;
+
+        CombinePoints( simplex, &point0, &point1 );
+        collisionNormal = -closest/distance;
+        point0 += margin0*collisionNormal;
+        point1 -= margin1*collisionNormal;
+        penetration = marginSum - distance;
+        collisionPoint = 0.5f*(point0 + point1);
+        return true;
+    }
+
+    // cores overlap, so expand them; the margins add to the depth
+    if ( CompleteSimplex( simplex, shape0, shape1 )
+         && ExpandPolytope( collisionNormal, penetration, point0, point1, simplex, shape0, shape1 ) )
+    {
+        penetration += marginSum;
+    }
+    else
+    {
+        // flat contact, as for crossing segments; only the margins overlap
+        collisionNormal = FlatNormal( simplex, shape1.GetCenter() - shape0.GetCenter() );
+        CombinePoints( simplex, &point0, &point1 );
+        penetration = marginSum;
+    }
+    point0 += margin0*collisionNormal;
+    point1 -= margin1*collisionNormal;
+    collisionPoint = 0.5f*(point0 + point1);
+    return true;
+
+}   // End of ::ComputeCollision()
+
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvGJKCache::Set()
+//-------------------------------------------------------------------------------
+// Keep the search directions of a simplex
+//-------------------------------------------------------------------------------
+void
+IvGJKCache::Set( const IvVector3* directions, unsigned int count )
+{
+    ASSERT( count <= 4 );
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        mDirections[i] = directions[i];
+    }
+    mCount = count;
+
+}   // End of IvGJKCache::Set()
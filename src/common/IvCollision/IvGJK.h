@@ -0,0 +1,97 @@
+//===============================================================================
+// @ IvGJK.h
+//
+// GJK and EPA queries between convex shapes
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// GJK finds the distance between two convex shapes as the distance from
+// the origin to their Minkowski difference, by iterating on a simplex of
+// up to four support points.  When the shapes overlap, EPA expands that
+// simplex into a polytope until it finds the face of the difference
+// nearest the origin, which gives the penetration depth and normal.
+//
+// Shapes are given by the support functions in IvSupportMap.h.  GJK and
+// EPA run on the core shapes and the margins are added afterwards, so
+// spheres and capsules come out exact.
+//
+// Each query can be given the cache for its pair of shapes, which keeps
+// the search directions of the final simplex.  The next query rebuilds
+// its first simplex from them, so when the shapes have moved only a
+// little it converges in an iteration or two.
+//
+//===============================================================================
+
+#ifndef __IvGJK__h__
+#define __IvGJK__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <IvVector3.h>
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvSupportMap;
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvGJKCache
+{
+public:
+    // constructor/destructor
+    inline IvGJKCache() : mCount( 0 ), mIterations( 0 ) {}
+    inline ~IvGJKCache() {}
+
+    // forget the last simplex, e.g. when the pair is new
+    inline void Reset()                     { mCount = 0; }
+
+    // search directions of the last simplex
+    inline unsigned int GetCount() const    { return mCount; }
+    inline const IvVector3& GetDirection( unsigned int i ) const { return mDirections[i]; }
+    void Set( const IvVector3* directions, unsigned int count );
+
+    // GJK iterations taken by the last query
+    inline unsigned int GetIterations() const      { return mIterations; }
+    inline void SetIterations( unsigned int count ) { mIterations = count; }
+
+private:
+    IvVector3       mDirections[4];
+    unsigned int    mCount;
+    unsigned int    mIterations;
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// do the shapes overlap?  Stops as soon as either answer is certain.
+bool Intersect( const IvSupportMap& shape0, const IvSupportMap& shape1,
+                IvGJKCache* cache = 0 );
+
+// distance between the shapes, and the closest point on each.  Returns 0
+// if they overlap, and the points are then undefined.
+float Distance( IvVector3& point0, IvVector3& point1,
+                const IvSupportMap& shape0, const IvSupportMap& shape1,
+                IvGJKCache* cache = 0 );
+
+// collision parameters, as for the primitive classes: returns true if the
+// shapes overlap, with the normal pointing from shape0 to shape1
+bool ComputeCollision( const IvSupportMap& shape0, const IvSupportMap& shape1,
+                       IvVector3& collisionNormal, IvVector3& collisionPoint,
+                       float& penetration, IvGJKCache* cache = 0 );
+
+#endif
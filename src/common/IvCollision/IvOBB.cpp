@@ -22,15 +22,32 @@
 #include <IvMath.h>
 #include <IvMatrix33.h>
 #include "IvOBB.h"
+#include "IvOBBStream.h"
+#include "IvAABBTree.h"
 #include <IvPlane.h>
 #include <IvQuat.h>
 #include <IvRay3.h>
+#include <IvSIMD.h>
 #include <IvVector3.h>
 
 //-------------------------------------------------------------------------------
 //-- Static Members -------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+// box pairs tested between reorderings of the separating axes
+static const unsigned int kReorderInterval = 4096;
+
+// Register type for the batch box tests
+#if defined(IV_AVX)
+#define IV_OBB_SIMD
+typedef __m256 IvLanes;
+static const unsigned int kWidth = 8;
+#elif defined(IV_SSE2)
+#define IV_OBB_SIMD
+typedef __m128 IvLanes;
+static const unsigned int kWidth = 4;
+#endif
+
 //-------------------------------------------------------------------------------
 //-- Methods --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
@@ -373,6 +390,346 @@ IvOBB::Intersect( const IvOBB& other ) const
 }
 
 
+#if defined(IV_OBB_SIMD)
+// terms of the separating axis test for kWidth box pairs, shared by all axes
+struct IvOBBLanes
+{
+    IvLanes R[3][3];        // R(i,j) = Ai . Bj
+    IvLanes Rabs[3][3];     // |R(i,j)|
+    IvLanes c[3];           // center of B relative to A, in A's frame
+    IvLanes a[3];           // extents of A
+    IvLanes b[3];           // extents of B
+    int     parallel;       // lanes where some pair of axes is near parallel
+};
+
+//----------------------------------------------------------------------------
+// @ SetupLanes()
+// ---------------------------------------------------------------------------
+// Compute the rotation of B relative to A, its absolute value and the
+// relative translation, once for all fifteen axes.  Each box is given as 15
+// lanes: center, three axes and extents, x/y/z each.
+//-----------------------------------------------------------------------------
+static inline void
+SetupLanes( IvOBBLanes& lanes, const IvLanes* boxA, const IvLanes* boxB )
+{
+    const IvLanes signMask = IvBroadcast<IvLanes>( -0.0f );
+    const IvLanes one = IvBroadcast<IvLanes>( 1.0f );
+    const IvLanes epsilon = IvBroadcast<IvLanes>( kEpsilon );
+
+    IvLanes parallel = IvBroadcast<IvLanes>( 0.0f );
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        const IvLanes* axisA = boxA + 3 + 3*i;
+        for ( unsigned int j = 0; j < 3; ++j )
+        {
+            const IvLanes* axisB = boxB + 3 + 3*j;
+            lanes.R[i][j] = IvMulAdd( axisA[2], axisB[2],
+                                      IvMulAdd( axisA[1], axisB[1], IvMul( axisA[0], axisB[0] ) ) );
+            lanes.Rabs[i][j] = IvAndNot( signMask, lanes.R[i][j] );
+            // if magnitude of dot product between axes is close to one
+            parallel = IvOr( parallel, IvCmpLe( one, IvAdd( lanes.Rabs[i][j], epsilon ) ) );
+        }
+    }
+    lanes.parallel = IvMoveMask( parallel );
+
+    IvLanes dx = IvSub( boxB[0], boxA[0] );
+    IvLanes dy = IvSub( boxB[1], boxA[1] );
+    IvLanes dz = IvSub( boxB[2], boxA[2] );
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        const IvLanes* axisA = boxA + 3 + 3*i;
+        lanes.c[i] = IvMulAdd( axisA[2], dz, IvMulAdd( axisA[1], dy, IvMul( axisA[0], dx ) ) );
+        lanes.a[i] = boxA[12 + i];
+        lanes.b[i] = boxB[12 + i];
+    }
+
+}   // End of SetupLanes()
+
+
+//----------------------------------------------------------------------------
+// @ SeparatingLanes()
+// ---------------------------------------------------------------------------
+// Returns a mask of the lanes the given axis separates, using the same
+// terms as IvOBB::Intersect().  The axis is a template argument so each
+// one compiles down to fixed loads from the shared terms.
+//-----------------------------------------------------------------------------
+template <unsigned int axis>
+static inline IvLanes
+SeparatingLanes( const IvOBBLanes& lanes )
+{
+    const IvLanes signMask = IvBroadcast<IvLanes>( -0.0f );
+    const IvLanes (&R)[3][3] = lanes.R;
+    const IvLanes (&Rabs)[3][3] = lanes.Rabs;
+    const IvLanes* c = lanes.c;
+    const IvLanes* a = lanes.a;
+    const IvLanes* b = lanes.b;
+
+    IvLanes cTest, aTest, bTest;
+    if ( axis < 3 )
+    {
+        // separating axis Ai
+        const unsigned int i = axis;
+        cTest = c[i];
+        aTest = a[i];
+        bTest = IvMulAdd( b[2], Rabs[i][2], IvMulAdd( b[1], Rabs[i][1], IvMul( b[0], Rabs[i][0] ) ) );
+    }
+    else if ( axis < 6 )
+    {
+        // separating axis Bj
+        const unsigned int j = axis - 3;
+        cTest = IvMulAdd( c[2], R[2][j], IvMulAdd( c[1], R[1][j], IvMul( c[0], R[0][j] ) ) );
+        aTest = IvMulAdd( a[2], Rabs[2][j], IvMulAdd( a[1], Rabs[1][j], IvMul( a[0], Rabs[0][j] ) ) );
+        bTest = b[j];
+    }
+    else
+    {
+        // separating axis Ai x Bj
+        const unsigned int i = (axis - 6)/3;
+        const unsigned int j = (axis - 6)%3;
+        const unsigned int i1 = (i + 1)%3, i2 = (i + 2)%3;
+        const unsigned int j1 = (j + 1)%3, j2 = (j + 2)%3;
+        cTest = IvSub( IvMul( c[i2], R[i1][j] ), IvMul( c[i1], R[i2][j] ) );
+        aTest = IvMulAdd( a[i1], Rabs[i2][j], IvMul( a[i2], Rabs[i1][j] ) );
+        bTest = IvMulAdd( b[j1], Rabs[i][j2], IvMul( b[j2], Rabs[i][j1] ) );
+    }
+
+    return IvCmpLt( IvAdd( aTest, bTest ), IvAndNot( signMask, cTest ) );
+
+}   // End of SeparatingLanes()
+
+
+//----------------------------------------------------------------------------
+// @ SeparatingLanes()
+// ---------------------------------------------------------------------------
+// Select the test for an axis chosen at run time
+//-----------------------------------------------------------------------------
+static inline IvLanes
+SeparatingLanes( const IvOBBLanes& lanes, unsigned int axis )
+{
+    switch ( axis )
+    {
+    case 0:  return SeparatingLanes<0>( lanes );
+    case 1:  return SeparatingLanes<1>( lanes );
+    case 2:  return SeparatingLanes<2>( lanes );
+    case 3:  return SeparatingLanes<3>( lanes );
+    case 4:  return SeparatingLanes<4>( lanes );
+    case 5:  return SeparatingLanes<5>( lanes );
+    case 6:  return SeparatingLanes<6>( lanes );
+    case 7:  return SeparatingLanes<7>( lanes );
+    case 8:  return SeparatingLanes<8>( lanes );
+    case 9:  return SeparatingLanes<9>( lanes );
+    case 10: return SeparatingLanes<10>( lanes );
+    case 11: return SeparatingLanes<11>( lanes );
+    case 12: return SeparatingLanes<12>( lanes );
+    case 13: return SeparatingLanes<13>( lanes );
+    default: return SeparatingLanes<14>( lanes );
+    }
+
+}   // End of SeparatingLanes()
+
+
+//----------------------------------------------------------------------------
+// @ SeparateLanes()
+// ---------------------------------------------------------------------------
+// Try the axes in order until every lane is separated or the axes run
+// out.  Returns the lanes separated, plus those already set in done.  The
+// edge axes are skipped for lanes with parallel axes, as in the single test.
+//-----------------------------------------------------------------------------
+static inline int
+SeparateLanes( const IvOBBLanes& lanes, int done, const unsigned char* axes,
+               IvOBBAxisOrder* order )
+{
+    const int allLanes = (1 << kWidth) - 1;
+    for ( unsigned int k = 0; k < IvOBBAxisOrder::kNumAxes && done != allLanes; ++k )
+    {
+        unsigned int axis = axes[k];
+        int separated = IvMoveMask( SeparatingLanes( lanes, axis ) ) & ~done;
+        if ( axis >= 6 )
+            separated &= ~lanes.parallel;
+        if ( separated == 0 )
+            continue;
+
+        done |= separated;
+        if ( order )
+        {
+            unsigned int count = 0;
+            for ( ; separated; separated &= separated - 1 )
+                ++count;
+            order->AddRejections( axis, count );
+        }
+    }
+
+    return done;
+
+}   // End of SeparateLanes()
+#endif
+
+
+//----------------------------------------------------------------------------
+// @ GetAxes()
+// ---------------------------------------------------------------------------
+// Copy out the current axis order, or the default one
+//-----------------------------------------------------------------------------
+static inline void
+GetAxes( unsigned char* axes, const IvOBBAxisOrder* order )
+{
+    for ( unsigned int k = 0; k < IvOBBAxisOrder::kNumAxes; ++k )
+    {
+        axes[k] = (unsigned char)( order ? order->GetAxis( k ) : k );
+    }
+
+}   // End of GetAxes()
+
+
+//----------------------------------------------------------------------------
+// @ Intersect()
+// ---------------------------------------------------------------------------
+// Determine intersection between one OBB and each OBB in a stream
+//-----------------------------------------------------------------------------
+void
+Intersect( bool* result, const IvOBB& box, const IvOBBStream& boxes, IvOBBAxisOrder* order )
+{
+    unsigned int count = boxes.GetCount();
+#if defined(IV_OBB_SIMD)
+    // the single box in every lane
+    IvLanes boxA[15];
+    const IvMatrix33& rotation = box.GetRotation();
+    for ( unsigned int k = 0; k < 3; ++k )
+    {
+        boxA[k] = IvBroadcast<IvLanes>( box.GetCenter()[k] );
+        for ( unsigned int axis = 0; axis < 3; ++axis )
+        {
+            boxA[3 + 3*axis + k] = IvBroadcast<IvLanes>( rotation(k,axis) );
+        }
+        boxA[12 + k] = IvBroadcast<IvLanes>( box.GetExtents()[k] );
+    }
+
+    // the stream's lanes are aligned and padded, so can be loaded directly
+    const IvVec3Stream* streams[5] = { &boxes.GetCenters(), &boxes.GetAxis( 0 ),
+        &boxes.GetAxis( 1 ), &boxes.GetAxis( 2 ), &boxes.GetExtents() };
+    const float* lanePointers[15];
+    for ( unsigned int s = 0; s < 5; ++s )
+    {
+        lanePointers[3*s] = streams[s]->GetX();
+        lanePointers[3*s + 1] = streams[s]->GetY();
+        lanePointers[3*s + 2] = streams[s]->GetZ();
+    }
+
+    unsigned char axes[IvOBBAxisOrder::kNumAxes];
+    GetAxes( axes, order );
+
+    IvLanes boxB[15];
+    IvOBBLanes lanes;
+    for ( unsigned int i = 0; i < count; i += kWidth )
+    {
+        for ( unsigned int k = 0; k < 15; ++k )
+        {
+            boxB[k] = IvLoad<IvLanes>( lanePointers[k] + i );
+        }
+        SetupLanes( lanes, boxA, boxB );
+
+        // padding lanes start out done
+        unsigned int groupCount = (count - i < kWidth) ? count - i : kWidth;
+        int separated = SeparateLanes( lanes, ((1 << kWidth) - 1) & ~((1 << groupCount) - 1),
+                                       axes, order );
+        for ( unsigned int lane = 0; lane < groupCount; ++lane )
+        {
+            result[i + lane] = ( (separated >> lane) & 1 ) == 0;
+        }
+
+        if ( order )
+        {
+            order->AddTests( groupCount );
+            GetAxes( axes, order );
+        }
+    }
+#else
+    // axis order only applies to the lane-wide tests
+    (void) order;
+    IvOBB other;
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        boxes.Get( i, other );
+        result[i] = box.Intersect( other );
+    }
+#endif
+
+}   // End of ::Intersect()
+
+
+//----------------------------------------------------------------------------
+// @ Intersect()
+// ---------------------------------------------------------------------------
+// Determine intersection between count pairs of OBBs from a stream
+//-----------------------------------------------------------------------------
+void
+Intersect( bool* result, const IvOBBStream& boxes, const IvProxyPair* pairs,
+           unsigned int count, IvOBBAxisOrder* order )
+{
+#if defined(IV_OBB_SIMD)
+    const IvVec3Stream* streams[5] = { &boxes.GetCenters(), &boxes.GetAxis( 0 ),
+        &boxes.GetAxis( 1 ), &boxes.GetAxis( 2 ), &boxes.GetExtents() };
+    const float* lanePointers[15];
+    for ( unsigned int s = 0; s < 5; ++s )
+    {
+        lanePointers[3*s] = streams[s]->GetX();
+        lanePointers[3*s + 1] = streams[s]->GetY();
+        lanePointers[3*s + 2] = streams[s]->GetZ();
+    }
+
+    unsigned char axes[IvOBBAxisOrder::kNumAxes];
+    GetAxes( axes, order );
+
+    unsigned int indicesA[kWidth];
+    unsigned int indicesB[kWidth];
+    IvLanes boxA[15];
+    IvLanes boxB[15];
+    IvOBBLanes lanes;
+    for ( unsigned int i = 0; i < count; i += kWidth )
+    {
+        // gather, padding the last group with copies of the first pair
+        unsigned int groupCount = (count - i < kWidth) ? count - i : kWidth;
+        for ( unsigned int lane = 0; lane < kWidth; ++lane )
+        {
+            const IvProxyPair& pair = pairs[lane < groupCount ? i + lane : i];
+            indicesA[lane] = (unsigned int) pair.proxyA;
+            indicesB[lane] = (unsigned int) pair.proxyB;
+        }
+        for ( unsigned int k = 0; k < 15; ++k )
+        {
+            boxA[k] = IvGather<IvLanes>( lanePointers[k], indicesA );
+            boxB[k] = IvGather<IvLanes>( lanePointers[k], indicesB );
+        }
+        SetupLanes( lanes, boxA, boxB );
+
+        int separated = SeparateLanes( lanes, ((1 << kWidth) - 1) & ~((1 << groupCount) - 1),
+                                       axes, order );
+        for ( unsigned int lane = 0; lane < groupCount; ++lane )
+        {
+            result[i + lane] = ( (separated >> lane) & 1 ) == 0;
+        }
+
+        if ( order )
+        {
+            order->AddTests( groupCount );
+            GetAxes( axes, order );
+        }
+    }
+#else
+    // axis order only applies to the lane-wide tests
+    (void) order;
+    IvOBB boxA, boxB;
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        boxes.Get( pairs[i].proxyA, boxA );
+        boxes.Get( pairs[i].proxyB, boxB );
+        result[i] = boxA.Intersect( boxB );
+    }
+#endif
+
+}   // End of ::Intersect()
+
+
 //----------------------------------------------------------------------------
 // @ IvOBB::Intersect()
 // ---------------------------------------------------------------------------
@@ -647,3 +1004,67 @@ Merge( IvOBB& result, const IvOBB& b0, const IvOBB& b1 )
     result.mExtents = newExtents;
 
 }   // End of Merge()
+
+
+//-------------------------------------------------------------------------------
+// @ IvOBBAxisOrder::IvOBBAxisOrder()
+//-------------------------------------------------------------------------------
+// Default constructor
+//-------------------------------------------------------------------------------
+IvOBBAxisOrder::IvOBBAxisOrder()
+{
+    Reset();
+
+}   // End of IvOBBAxisOrder::IvOBBAxisOrder()
+
+
+//-------------------------------------------------------------------------------
+// @ IvOBBAxisOrder::Reset()
+//-------------------------------------------------------------------------------
+// Return to the default order, forgetting all results
+//-------------------------------------------------------------------------------
+void
+IvOBBAxisOrder::Reset()
+{
+    for ( unsigned int k = 0; k < kNumAxes; ++k )
+    {
+        mOrder[k] = (unsigned char) k;
+        mRejections[k] = 0;
+    }
+    mTestCount = 0;
+
+}   // End of IvOBBAxisOrder::Reset()
+
+
+//-------------------------------------------------------------------------------
+// @ IvOBBAxisOrder::AddTests()
+//-------------------------------------------------------------------------------
+// Count tests done.  Every so often sort the axes by how many boxes they
+// have separated, keeping the current order for ties, and halve the counts
+// so the order follows recent results.
+//-------------------------------------------------------------------------------
+void
+IvOBBAxisOrder::AddTests( unsigned int count )
+{
+    mTestCount += count;
+    if ( mTestCount < kReorderInterval )
+        return;
+
+    for ( unsigned int k = 1; k < kNumAxes; ++k )
+    {
+        unsigned char axis = mOrder[k];
+        unsigned int m = k;
+        for ( ; m > 0 && mRejections[mOrder[m - 1]] < mRejections[axis]; --m )
+        {
+            mOrder[m] = mOrder[m - 1];
+        }
+        mOrder[m] = axis;
+    }
+
+    for ( unsigned int k = 0; k < kNumAxes; ++k )
+    {
+        mRejections[k] /= 2;
+    }
+    mTestCount = 0;
+
+}   // End of IvOBBAxisOrder::AddTests()
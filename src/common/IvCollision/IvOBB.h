@@ -34,6 +34,8 @@ class IvLine3;
 class IvRay3;
 class IvLineSegment3;
 class IvPlane;
+class IvOBBStream;
+struct IvProxyPair;
 
 //-------------------------------------------------------------------------------
 //-- Classes --------------------------------------------------------------------
@@ -96,6 +98,37 @@ protected:
 private:
 };
 
+// Order the batch box tests try the separating axes in.  Axes 0-2 are the
+// first box's axes A0-A2, 3-5 are the second box's B0-B2, and 6 + 3*i + j
+// is Ai x Bj.  The tests count how many boxes each axis separates, and
+// every so often the axes are sorted so the most successful go first.
+class IvOBBAxisOrder
+{
+public:
+    static const unsigned int kNumAxes = 15;
+
+    // constructor/destructor
+    IvOBBAxisOrder();
+    inline ~IvOBBAxisOrder() {}
+
+    // back to the order of the single box test, with no history
+    void Reset();
+
+    // accessors
+    inline unsigned int GetAxis( unsigned int i ) const       { return mOrder[i]; }
+    inline unsigned int GetRejections( unsigned int axis ) const { return mRejections[axis]; }
+
+    // record count boxes separated by axis
+    inline void AddRejections( unsigned int axis, unsigned int count ) { mRejections[axis] += count; }
+    // record count box pairs tested, and reorder once enough have been
+    void AddTests( unsigned int count );
+
+private:
+    unsigned char   mOrder[kNumAxes];
+    unsigned int    mRejections[kNumAxes];  // decays each time the axes are reordered
+    unsigned int    mTestCount;             // since the last reorder
+};
+
 //-------------------------------------------------------------------------------
 //-- Inlines --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
@@ -104,4 +137,14 @@ private:
 //-- Externs --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+// batch box-box tests, 4 or 8 pairs at a time.  The axes are tried in the
+// given order, or the single box test's order if order is 0, and the order
+// is updated with the results.
+// one box against each box in a stream; result holds boxes.GetCount() values
+void Intersect( bool* result, const IvOBB& box, const IvOBBStream& boxes,
+                IvOBBAxisOrder* order = 0 );
+// count pairs of boxes from a stream
+void Intersect( bool* result, const IvOBBStream& boxes, const IvProxyPair* pairs,
+                unsigned int count, IvOBBAxisOrder* order = 0 );
+
 #endif
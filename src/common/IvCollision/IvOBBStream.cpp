@@ -0,0 +1,121 @@
+//===============================================================================
+// @ IvOBBStream.cpp
+//
+// Structure-of-arrays container for oriented boxes
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvOBBStream.h"
+#include "IvOBB.h"
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvOBBStream::IvOBBStream()
+//-------------------------------------------------------------------------------
+// Construct a stream of count zero boxes
+//-------------------------------------------------------------------------------
+IvOBBStream::IvOBBStream( unsigned int count ) :
+    mCenters( count ),
+    mExtents( count )
+{
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        mAxes[i].Resize( count );
+    }
+
+}   // End of IvOBBStream::IvOBBStream()
+
+
+//-------------------------------------------------------------------------------
+// @ IvOBBStream::Resize()
+//-------------------------------------------------------------------------------
+// Change the number of boxes
+//-------------------------------------------------------------------------------
+void
+IvOBBStream::Resize( unsigned int count )
+{
+    mCenters.Resize( count );
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        mAxes[i].Resize( count );
+    }
+    mExtents.Resize( count );
+
+}   // End of IvOBBStream::Resize()
+
+
+//-------------------------------------------------------------------------------
+// @ IvOBBStream::Get()
+//-------------------------------------------------------------------------------
+// Gather one box
+//-------------------------------------------------------------------------------
+void
+IvOBBStream::Get( unsigned int i, IvOBB& box ) const
+{
+    IvMatrix33 rotation;
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        IvVector3 column = mAxes[axis].Get( i );
+        rotation(0,axis) = column.x;
+        rotation(1,axis) = column.y;
+        rotation(2,axis) = column.z;
+    }
+    box.SetCenter( mCenters.Get( i ) );
+    box.SetRotation( rotation );
+    box.SetExtents( mExtents.Get( i ) );
+
+}   // End of IvOBBStream::Get()
+
+
+//-------------------------------------------------------------------------------
+// @ IvOBBStream::Set()
+//-------------------------------------------------------------------------------
+// Scatter one box
+//-------------------------------------------------------------------------------
+void
+IvOBBStream::Set( unsigned int i, const IvOBB& box )
+{
+    const IvMatrix33& rotation = box.GetRotation();
+    mCenters.Set( i, box.GetCenter() );
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        mAxes[axis].Set( i, IvVector3( rotation(0,axis), rotation(1,axis), rotation(2,axis) ) );
+    }
+    mExtents.Set( i, box.GetExtents() );
+
+}   // End of IvOBBStream::Set()
+
+
+//-------------------------------------------------------------------------------
+// @ IvOBBStream::Set()
+//-------------------------------------------------------------------------------
+// Resize to count and copy in an array of boxes
+//-------------------------------------------------------------------------------
+void
+IvOBBStream::Set( const IvOBB* boxes, unsigned int count )
+{
+    Resize( count );
+
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        Set( i, boxes[i] );
+    }
+
+}   // End of IvOBBStream::Set()
@@ -0,0 +1,78 @@
+//===============================================================================
+// @ IvOBBStream.h
+//
+// Structure-of-arrays container for oriented boxes
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Each box is kept as its center, its three axes (the columns of its
+// rotation) and its extents, each in its own IvVec3Stream, which is what
+// the batch box tests in IvOBB.h consume.  Padding boxes are all zero.
+//
+//===============================================================================
+
+#ifndef __IvOBBStream__h__
+#define __IvOBBStream__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <IvVec3Stream.h>
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvOBB;
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvOBBStream
+{
+public:
+    // constructor/destructor
+    inline IvOBBStream() {}
+    explicit IvOBBStream( unsigned int count );
+    inline ~IvOBBStream() {}
+
+    // size -- existing boxes are kept, new ones are zero
+    void Resize( unsigned int count );
+    inline unsigned int GetCount() const       { return mCenters.GetCount(); }
+    inline unsigned int GetPaddedCount() const { return mCenters.GetPaddedCount(); }
+
+    // element accessors
+    void Get( unsigned int i, IvOBB& box ) const;
+    void Set( unsigned int i, const IvOBB& box );
+
+    // resize and copy in an array of boxes
+    void Set( const IvOBB* boxes, unsigned int count );
+
+    // lane accessors
+    inline const IvVec3Stream& GetCenters() const { return mCenters; }
+    inline const IvVec3Stream& GetAxis( unsigned int i ) const { return mAxes[i]; }
+    inline const IvVec3Stream& GetExtents() const { return mExtents; }
+
+protected:
+    IvVec3Stream mCenters;
+    IvVec3Stream mAxes[3];      // columns of the rotation
+    IvVec3Stream mExtents;
+
+private:
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,682 @@
+//===============================================================================
+// @ IvSortSweep.cpp
+//
+// Multithreaded sort-and-sweep for broad phase collision detection
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// All of the work is divided into tasks of a fixed size, which threads
+// take in turn.  Each task writes only its own output, and outputs are
+// combined in task order, so how the tasks are shared out has no effect on
+// the result.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvSortSweep.h"
+#include <IvAssert.h>
+#include <IvMath.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string.h>
+#include <thread>
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// boxes per chunk of the input, and entries per sweep task
+static const unsigned int kChunkSize = 2048;
+// fewest boxes worth starting threads for
+static const unsigned int kParallelSize = 4096;
+// fewest boxes per column, on average
+static const float kColumnTarget = 32.0f;
+// narrowest column, in average box extents
+static const float kMinColumnExtents = 4.0f;
+// most copies of each box, on average, before the grid is made coarser
+static const unsigned int kMaxCopies = 4;
+// most columns across either grid axis
+static const int kMaxGridSize = 1024;
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+namespace {
+
+// box center and extent statistics over one chunk
+struct IvSortSweepStats
+{
+    double          sum[3];
+    double          sumSquares[3];
+    double          extentSum[3];
+    float           centerMin[3];
+    float           centerMax[3];
+};
+
+// orders entries by their minimum on the sweep axis, then by index
+struct IvSortSweepEntryLess
+{
+    inline bool operator()( const IvSortSweepEntry& a, const IvSortSweepEntry& b ) const
+    {
+        return a.minima[0] < b.minima[0] || (a.minima[0] == b.minima[0] && a.index < b.index);
+    }
+};
+
+// orders pairs by first proxy, then by second
+struct IvSortSweepPairLess
+{
+    inline bool operator()( const IvProxyPair& a, const IvProxyPair& b ) const
+    {
+        return a.proxyA < b.proxyA || (a.proxyA == b.proxyA && a.proxyB < b.proxyB);
+    }
+};
+
+// accumulate center and extent statistics for one chunk of boxes
+struct IvSortSweepStatsTask
+{
+    void operator()( unsigned int chunk ) const
+    {
+        unsigned int begin = chunk*kChunkSize;
+        unsigned int end = begin + kChunkSize < count ? begin + kChunkSize : count;
+        IvSortSweepStats& chunkStats = stats[chunk];
+        for ( unsigned int axis = 0; axis < 3; ++axis )
+        {
+            chunkStats.sum[axis] = 0.0;
+            chunkStats.sumSquares[axis] = 0.0;
+            chunkStats.extentSum[axis] = 0.0;
+            chunkStats.centerMin[axis] = FLT_MAX;
+            chunkStats.centerMax[axis] = -FLT_MAX;
+        }
+        for ( unsigned int i = begin; i < end; ++i )
+        {
+            const IvVector3& minima = boxes[i].GetMinima();
+            const IvVector3& maxima = boxes[i].GetMaxima();
+            for ( unsigned int axis = 0; axis < 3; ++axis )
+            {
+                float center = 0.5f*(minima[axis] + maxima[axis]);
+                chunkStats.sum[axis] += center;
+                chunkStats.sumSquares[axis] += double(center)*double(center);
+                chunkStats.extentSum[axis] += maxima[axis] - minima[axis];
+                if ( center < chunkStats.centerMin[axis] )
+                    chunkStats.centerMin[axis] = center;
+                if ( center > chunkStats.centerMax[axis] )
+                    chunkStats.centerMax[axis] = center;
+            }
+        }
+    }
+
+    const IvAABB*       boxes;
+    unsigned int        count;
+    IvSortSweepStats*   stats;
+};
+
+// count the entries one chunk of boxes adds to each column
+struct IvSortSweepCountTask
+{
+    void operator()( unsigned int chunk ) const
+    {
+        unsigned int begin = chunk*kChunkSize;
+        unsigned int end = begin + kChunkSize < count ? begin + kChunkSize : count;
+        unsigned int* chunkCounts = counts + chunk*numColumns;
+        for ( unsigned int i = begin; i < end; ++i )
+        {
+            const IvVector3& minima = boxes[i].GetMinima();
+            const IvVector3& maxima = boxes[i].GetMaxima();
+            int low0 = grid.Cell( minima[grid.axis[1]], 0 );
+            int high0 = grid.Cell( maxima[grid.axis[1]], 0 );
+            int low1 = grid.Cell( minima[grid.axis[2]], 1 );
+            int high1 = grid.Cell( maxima[grid.axis[2]], 1 );
+            for ( int c1 = low1; c1 <= high1; ++c1 )
+            {
+                for ( int c0 = low0; c0 <= high0; ++c0 )
+                {
+                    ++chunkCounts[c1*grid.size[0] + c0];
+                }
+            }
+        }
+    }
+
+    const IvAABB*       boxes;
+    unsigned int        count;
+    IvSortSweepGrid     grid;
+    unsigned int        numColumns;
+    unsigned int*       counts;
+};
+
+// copy one chunk of boxes into each column they touch.  Offsets start as
+// this chunk's first entry in each column.
+struct IvSortSweepFillTask
+{
+    void operator()( unsigned int chunk ) const
+    {
+        unsigned int begin = chunk*kChunkSize;
+        unsigned int end = begin + kChunkSize < count ? begin + kChunkSize : count;
+        unsigned int* chunkOffsets = offsets + chunk*numColumns;
+        for ( unsigned int i = begin; i < end; ++i )
+        {
+            const IvVector3& minima = boxes[i].GetMinima();
+            const IvVector3& maxima = boxes[i].GetMaxima();
+            IvSortSweepEntry entry;
+            for ( unsigned int axis = 0; axis < 3; ++axis )
+            {
+                entry.minima[axis] = minima[grid.axis[axis]];
+                entry.maxima[axis] = maxima[grid.axis[axis]];
+            }
+            entry.index = i;
+            entry.pad = 0;
+
+            int low0 = grid.Cell( entry.minima[1], 0 );
+            int high0 = grid.Cell( entry.maxima[1], 0 );
+            int low1 = grid.Cell( entry.minima[2], 1 );
+            int high1 = grid.Cell( entry.maxima[2], 1 );
+            for ( int c1 = low1; c1 <= high1; ++c1 )
+            {
+                for ( int c0 = low0; c0 <= high0; ++c0 )
+                {
+                    entries[chunkOffsets[c1*grid.size[0] + c0]++] = entry;
+                }
+            }
+        }
+    }
+
+    const IvAABB*       boxes;
+    unsigned int        count;
+    IvSortSweepGrid     grid;
+    unsigned int        numColumns;
+    unsigned int*       offsets;
+    IvSortSweepEntry*   entries;
+};
+
+// sort and sweep one run of columns.  A pair that shares several columns
+// is only kept in the one holding the corner of their overlap nearest the
+// grid origin.
+struct IvSortSweepTask
+{
+    void operator()( unsigned int task ) const
+    {
+        std::vector<IvProxyPair>& pairs = taskPairs[task];
+        pairs.clear();
+        for ( unsigned int column = taskColumns[task]; column < taskColumns[task + 1]; ++column )
+        {
+            unsigned int begin = columnStart[column];
+            unsigned int end = columnStart[column + 1];
+            std::sort( entries + begin, entries + end, IvSortSweepEntryLess() );
+
+            int c0 = int(column) % grid.size[0];
+            int c1 = int(column) / grid.size[0];
+            for ( unsigned int i = begin; i < end; ++i )
+            {
+                const IvSortSweepEntry& a = entries[i];
+                for ( unsigned int j = i + 1; j < end && entries[j].minima[0] <= a.maxima[0]; ++j )
+                {
+                    const IvSortSweepEntry& b = entries[j];
+                    if ( b.minima[1] > a.maxima[1] || a.minima[1] > b.maxima[1]
+                         || b.minima[2] > a.maxima[2] || a.minima[2] > b.maxima[2] )
+                        continue;
+                    float corner0 = a.minima[1] > b.minima[1] ? a.minima[1] : b.minima[1];
+                    float corner1 = a.minima[2] > b.minima[2] ? a.minima[2] : b.minima[2];
+                    if ( grid.Cell( corner0, 0 ) != c0 || grid.Cell( corner1, 1 ) != c1 )
+                        continue;
+
+                    IvProxyPair pair;
+                    pair.proxyA = int(a.index < b.index ? a.index : b.index);
+                    pair.proxyB = int(a.index < b.index ? b.index : a.index);
+                    pairs.push_back( pair );
+                }
+            }
+        }
+    }
+
+    IvSortSweepEntry*           entries;
+    const unsigned int*         columnStart;
+    const unsigned int*         taskColumns;
+    IvSortSweepGrid             grid;
+    std::vector<IvProxyPair>*   taskPairs;
+};
+
+// copy one task's pairs into place and sort them
+struct IvSortSweepGatherTask
+{
+    void operator()( unsigned int task ) const
+    {
+        const std::vector<IvProxyPair>& source = taskPairs[task];
+        if ( source.empty() )
+            return;
+        memcpy( pairs + offsets[task], &source[0], source.size()*sizeof(IvProxyPair) );
+        std::sort( pairs + offsets[task], pairs + offsets[task + 1], IvSortSweepPairLess() );
+    }
+
+    const std::vector<IvProxyPair>* taskPairs;
+    const unsigned int*             offsets;
+    IvProxyPair*                    pairs;
+};
+
+// merge two neighboring sorted runs into the destination
+template <class T, class Less>
+struct IvSortSweepMergeTask
+{
+    void operator()( unsigned int task ) const
+    {
+        unsigned int begin = bounds[2*task];
+        unsigned int middle = bounds[2*task + 1 < numRuns ? 2*task + 1 : numRuns];
+        unsigned int end = bounds[2*task + 2 < numRuns ? 2*task + 2 : numRuns];
+        std::merge( source + begin, source + middle, source + middle, source + end,
+                    destination + begin, Less() );
+    }
+
+    const T*            source;
+    T*                  destination;
+    const unsigned int* bounds;
+    unsigned int        numRuns;
+};
+
+}   // namespace
+
+//-------------------------------------------------------------------------------
+// @ RunTaskQueue()
+//-------------------------------------------------------------------------------
+// Run tasks until there are none left
+//-------------------------------------------------------------------------------
+template <class Task>
+static void
+RunTaskQueue( const Task* task, std::atomic<unsigned int>* nextTask, unsigned int numTasks )
+{
+    for ( ;; )
+    {
+        unsigned int index = nextTask->fetch_add( 1 );
+        if ( index >= numTasks )
+            break;
+        (*task)( index );
+    }
+
+}   // End of RunTaskQueue()
+
+
+//-------------------------------------------------------------------------------
+// @ RunTasks()
+//-------------------------------------------------------------------------------
+// Run numTasks tasks on up to numThreads threads, including the calling one
+//-------------------------------------------------------------------------------
+template <class Task>
+static void
+RunTasks( const Task& task, unsigned int numTasks, unsigned int numThreads )
+{
+    if ( numThreads > numTasks )
+        numThreads = numTasks;
+    if ( numThreads < 2 )
+    {
+        for ( unsigned int t = 0; t < numTasks; ++t )
+        {
+            task( t );
+        }
+        return;
+    }
+
+    std::atomic<unsigned int> nextTask( 0 );
+    std::vector<std::thread> workers;
+    for ( unsigned int t = 1; t < numThreads; ++t )
+    {
+        workers.push_back( std::thread( RunTaskQueue<Task>, &task, &nextTask, numTasks ) );
+    }
+
+    RunTaskQueue( &task, &nextTask, numTasks );
+
+    for ( unsigned int t = 0; t < workers.size(); ++t )
+    {
+        workers[t].join();
+    }
+
+}   // End of RunTasks()
+
+
+//-------------------------------------------------------------------------------
+// @ MergeRuns()
+//-------------------------------------------------------------------------------
+// Merge sorted runs of data, delimited by bounds, a pair of runs per task
+// until one is left.  Returns whichever of data and scratch ends up holding
+// the result.
+//-------------------------------------------------------------------------------
+template <class T, class Less>
+static T*
+MergeRuns( T* data, T* scratch, std::vector<unsigned int>& bounds, unsigned int numThreads )
+{
+    unsigned int numRuns = (unsigned int) bounds.size() - 1;
+    while ( numRuns > 1 )
+    {
+        unsigned int numMerged = (numRuns + 1)/2;
+
+        IvSortSweepMergeTask<T, Less> merge;
+        merge.source = data;
+        merge.destination = scratch;
+        merge.bounds = &bounds[0];
+        merge.numRuns = numRuns;
+        RunTasks( merge, numMerged, numThreads );
+
+        for ( unsigned int r = 1; r < numMerged; ++r )
+        {
+            bounds[r] = bounds[2*r];
+        }
+        bounds[numMerged] = bounds[numRuns];
+        bounds.resize( numMerged + 1 );
+        numRuns = numMerged;
+        std::swap( data, scratch );
+    }
+
+    return data;
+
+}   // End of MergeRuns()
+
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvSortSweep::IvSortSweep()
+//-------------------------------------------------------------------------------
+// Default constructor
+//-------------------------------------------------------------------------------
+IvSortSweep::IvSortSweep() :
+    mCount( 0 )
+{
+    Clear();
+
+}   // End of IvSortSweep::IvSortSweep()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSortSweep::~IvSortSweep()
+//-------------------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------------------
+IvSortSweep::~IvSortSweep()
+{
+}   // End of IvSortSweep::~IvSortSweep()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSortSweep::Clear()
+//-------------------------------------------------------------------------------
+// Release everything
+//-------------------------------------------------------------------------------
+void
+IvSortSweep::Clear()
+{
+    mCount = 0;
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        mGrid.axis[i] = i;
+    }
+    for ( unsigned int i = 0; i < 2; ++i )
+    {
+        mGrid.origin[i] = 0.0f;
+        mGrid.recipCellSize[i] = 0.0f;
+        mGrid.size[i] = 1;
+    }
+
+    std::vector<IvSortSweepEntry>().swap( mEntries );
+    std::vector<unsigned int>().swap( mColumnStart );
+    std::vector<unsigned int>().swap( mChunkCounts );
+    std::vector<unsigned int>().swap( mTaskColumns );
+    std::vector< std::vector<IvProxyPair> >().swap( mTaskPairs );
+    std::vector<IvProxyPair>().swap( mPairs );
+    std::vector<IvProxyPair>().swap( mPairScratch );
+
+}   // End of IvSortSweep::Clear()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSortSweep::FindPairs()
+//-------------------------------------------------------------------------------
+// Find all overlapping pairs of boxes
+//-------------------------------------------------------------------------------
+void
+IvSortSweep::FindPairs( const IvAABB* boxes, unsigned int count, unsigned int numThreads )
+{
+    ASSERT( boxes || count == 0 );
+
+    mCount = count;
+    mPairs.clear();
+    if ( count == 0 )
+        return;
+
+    if ( numThreads < 1 || count < kParallelSize )
+        numThreads = 1;
+
+    SetupGrid( boxes, numThreads );
+    FillColumns( boxes, numThreads );
+    Sweep( numThreads );
+    SortPairs( numThreads );
+
+}   // End of IvSortSweep::FindPairs()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSortSweep::SetupGrid()
+//-------------------------------------------------------------------------------
+// Sweep along the axis where the box centers vary the most, so the fewest
+// boxes overlap along it, and size the columns across the other two from
+// the spread of the centers and the average box extent.  Chunk statistics
+// are added in order, so the grid doesn't depend on the thread count.
+//-------------------------------------------------------------------------------
+void
+IvSortSweep::SetupGrid( const IvAABB* boxes, unsigned int numThreads )
+{
+    unsigned int numChunks = (mCount + kChunkSize - 1)/kChunkSize;
+    std::vector<IvSortSweepStats> stats( numChunks );
+
+    IvSortSweepStatsTask task;
+    task.boxes = boxes;
+    task.count = mCount;
+    task.stats = &stats[0];
+    RunTasks( task, numChunks, numThreads );
+
+    IvSortSweepStats total = stats[0];
+    for ( unsigned int c = 1; c < numChunks; ++c )
+    {
+        for ( unsigned int axis = 0; axis < 3; ++axis )
+        {
+            total.sum[axis] += stats[c].sum[axis];
+            total.sumSquares[axis] += stats[c].sumSquares[axis];
+            total.extentSum[axis] += stats[c].extentSum[axis];
+            if ( stats[c].centerMin[axis] < total.centerMin[axis] )
+                total.centerMin[axis] = stats[c].centerMin[axis];
+            if ( stats[c].centerMax[axis] > total.centerMax[axis] )
+                total.centerMax[axis] = stats[c].centerMax[axis];
+        }
+    }
+
+    // count times the variance on each axis
+    double recipCount = 1.0/double(mCount);
+    double bestVariance = -1.0;
+    unsigned int sweepAxis = 0;
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        double variance = total.sumSquares[axis] - total.sum[axis]*total.sum[axis]*recipCount;
+        if ( variance > bestVariance )
+        {
+            bestVariance = variance;
+            sweepAxis = axis;
+        }
+    }
+    mGrid.axis[0] = sweepAxis;
+    mGrid.axis[1] = sweepAxis == 2 ? 0 : sweepAxis + 1;
+    mGrid.axis[2] = mGrid.axis[1] == 2 ? 0 : mGrid.axis[1] + 1;
+
+    // square columns, wide enough that most boxes touch only one, and
+    // holding enough boxes that sorting them is worthwhile
+    float range[2];
+    float extent = 0.0f;
+    for ( unsigned int g = 0; g < 2; ++g )
+    {
+        unsigned int axis = mGrid.axis[g + 1];
+        range[g] = total.centerMax[axis] - total.centerMin[axis];
+        float averageExtent = float(total.extentSum[axis]*recipCount);
+        if ( averageExtent > extent )
+            extent = averageExtent;
+        mGrid.origin[g] = total.centerMin[axis];
+    }
+    float cellSize = kMinColumnExtents*extent;
+    float areaSize = IvSqrt( range[0]*range[1]*kColumnTarget/float(mCount) );
+    if ( areaSize > cellSize )
+        cellSize = areaSize;
+
+    for ( unsigned int g = 0; g < 2; ++g )
+    {
+        float cells = cellSize > 0.0f ? range[g]/cellSize : 0.0f;
+        mGrid.size[g] = cells < float(kMaxGridSize) ? int(cells) + 1 : kMaxGridSize;
+        mGrid.recipCellSize[g] = cellSize > 0.0f ? 1.0f/cellSize : 0.0f;
+    }
+
+}   // End of IvSortSweep::SetupGrid()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSortSweep::FillColumns()
+//-------------------------------------------------------------------------------
+// Copy each box into every column it touches.  Each chunk counts its
+// entries per column, and the counts give each chunk its own place to write
+// in every column, in the same order for any number of threads.
+//-------------------------------------------------------------------------------
+void
+IvSortSweep::FillColumns( const IvAABB* boxes, unsigned int numThreads )
+{
+    unsigned int numChunks = (mCount + kChunkSize - 1)/kChunkSize;
+    unsigned int numColumns;
+    unsigned int numEntries;
+    for ( ;; )
+    {
+        numColumns = (unsigned int)( mGrid.size[0]*mGrid.size[1] );
+        mChunkCounts.assign( numChunks*numColumns, 0 );
+
+        IvSortSweepCountTask count;
+        count.boxes = boxes;
+        count.count = mCount;
+        count.grid = mGrid;
+        count.numColumns = numColumns;
+        count.counts = &mChunkCounts[0];
+        RunTasks( count, numChunks, numThreads );
+
+        numEntries = 0;
+        for ( unsigned int i = 0; i < mChunkCounts.size(); ++i )
+        {
+            numEntries += mChunkCounts[i];
+        }
+        if ( numEntries <= kMaxCopies*mCount || numColumns == 1 )
+            break;
+
+        // too many boxes are in several columns, so make them wider
+        for ( unsigned int g = 0; g < 2; ++g )
+        {
+            mGrid.size[g] = (mGrid.size[g] + 1)/2;
+            mGrid.recipCellSize[g] *= 0.5f;
+        }
+    }
+
+    // turn counts into write offsets, column by column and then chunk by chunk
+    mColumnStart.resize( numColumns + 1 );
+    unsigned int offset = 0;
+    for ( unsigned int column = 0; column < numColumns; ++column )
+    {
+        mColumnStart[column] = offset;
+        for ( unsigned int chunk = 0; chunk < numChunks; ++chunk )
+        {
+            unsigned int& chunkCount = mChunkCounts[chunk*numColumns + column];
+            unsigned int chunkOffset = offset;
+            offset += chunkCount;
+            chunkCount = chunkOffset;
+        }
+    }
+    mColumnStart[numColumns] = offset;
+
+    mEntries.resize( numEntries );
+
+    IvSortSweepFillTask fill;
+    fill.boxes = boxes;
+    fill.count = mCount;
+    fill.grid = mGrid;
+    fill.numColumns = numColumns;
+    fill.offsets = &mChunkCounts[0];
+    fill.entries = &mEntries[0];
+    RunTasks( fill, numChunks, numThreads );
+
+}   // End of IvSortSweep::FillColumns()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSortSweep::Sweep()
+//-------------------------------------------------------------------------------
+// Sort and sweep the columns, grouped into runs of about a chunk's worth
+// of entries each
+//-------------------------------------------------------------------------------
+void
+IvSortSweep::Sweep( unsigned int numThreads )
+{
+    unsigned int numColumns = (unsigned int) mColumnStart.size() - 1;
+    mTaskColumns.clear();
+    mTaskColumns.push_back( 0 );
+    for ( unsigned int column = 1; column < numColumns; ++column )
+    {
+        if ( mColumnStart[column] - mColumnStart[mTaskColumns.back()] >= kChunkSize )
+            mTaskColumns.push_back( column );
+    }
+    mTaskColumns.push_back( numColumns );
+
+    unsigned int numTasks = (unsigned int) mTaskColumns.size() - 1;
+    if ( mTaskPairs.size() < numTasks )
+        mTaskPairs.resize( numTasks );
+
+    IvSortSweepTask task;
+    task.entries = &mEntries[0];
+    task.columnStart = &mColumnStart[0];
+    task.taskColumns = &mTaskColumns[0];
+    task.grid = mGrid;
+    task.taskPairs = &mTaskPairs[0];
+    RunTasks( task, numTasks, numThreads );
+
+}   // End of IvSortSweep::Sweep()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSortSweep::SortPairs()
+//-------------------------------------------------------------------------------
+// Gather the pairs from each task, sort each task's pairs and merge them
+//-------------------------------------------------------------------------------
+void
+IvSortSweep::SortPairs( unsigned int numThreads )
+{
+    unsigned int numTasks = (unsigned int) mTaskColumns.size() - 1;
+    std::vector<unsigned int> bounds( numTasks + 1 );
+    bounds[0] = 0;
+    for ( unsigned int t = 0; t < numTasks; ++t )
+    {
+        bounds[t + 1] = bounds[t] + (unsigned int) mTaskPairs[t].size();
+    }
+    unsigned int numPairs = bounds[numTasks];
+    if ( numPairs == 0 )
+        return;
+
+    mPairs.resize( numPairs );
+    mPairScratch.resize( numPairs );
+
+    IvSortSweepGatherTask gather;
+    gather.taskPairs = &mTaskPairs[0];
+    gather.offsets = &bounds[0];
+    gather.pairs = &mPairs[0];
+    RunTasks( gather, numTasks, numThreads );
+
+    IvProxyPair* sorted =
+        MergeRuns<IvProxyPair, IvSortSweepPairLess>( &mPairs[0], &mPairScratch[0], bounds, numThreads );
+    if ( sorted != &mPairs[0] )
+        mPairs.swap( mPairScratch );
+
+}   // End of IvSortSweep::SortPairs()
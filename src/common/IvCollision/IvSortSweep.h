@@ -0,0 +1,123 @@
+//===============================================================================
+// @ IvSortSweep.h
+//
+// Multithreaded sort-and-sweep for broad phase collision detection
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Finds every overlapping pair in a set of boxes from scratch, rather than
+// tracking changes between frames as IvSweepPrune does.  Sweeping along a
+// single axis tests each box against every other box it overlaps along
+// that axis, which gets expensive for large sets, so space is first split
+// into a grid of columns across the other two axes.  Each box goes into
+// every column it touches, and each column is sorted by box minimum along
+// its length and swept on its own.  Columns are shared out between
+// threads, and the pairs are sorted at the end, so the result is the same
+// for any number of threads.
+//
+//===============================================================================
+
+#ifndef __IvSortSweep__h__
+#define __IvSortSweep__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <vector>
+
+#include "IvAABBTree.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// box bounds in a column, with the sweep axis first
+struct IvSortSweepEntry
+{
+    float           minima[3];
+    float           maxima[3];
+    unsigned int    index;          // position in the original array
+    unsigned int    pad;
+};
+
+// column layout; axis[0] is the sweep axis, and the columns divide the
+// other two
+struct IvSortSweepGrid
+{
+    // column coordinate of a value along axis[1 + gridAxis]
+    inline int Cell( float value, unsigned int gridAxis ) const
+    {
+        float cell = (value - origin[gridAxis])*recipCellSize[gridAxis];
+        if ( !(cell > 0.0f) )
+            return 0;
+        return cell < float(size[gridAxis]) ? int(cell) : size[gridAxis] - 1;
+    }
+
+    unsigned int    axis[3];
+    float           origin[2];
+    float           recipCellSize[2];
+    int             size[2];
+};
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvSortSweep
+{
+public:
+    // constructor/destructor
+    IvSortSweep();
+    ~IvSortSweep();
+
+    // find the overlapping pairs among count boxes, indexed by their position
+    // in the array, using up to numThreads threads
+    void FindPairs( const IvAABB* boxes, unsigned int count, unsigned int numThreads = 1 );
+    void Clear();
+
+    // accessors
+    inline unsigned int GetCount() const          { return mCount; }
+    inline unsigned int GetSweepAxis() const      { return mGrid.axis[0]; }
+    inline unsigned int GetColumnCount() const    { return mGrid.size[0]*mGrid.size[1]; }
+
+    // pairs from the last FindPairs(), with proxyA < proxyB, sorted by
+    // proxyA and then by proxyB
+    inline unsigned int GetPairCount() const      { return (unsigned int) mPairs.size(); }
+    inline const IvProxyPair* GetPairs() const    { return mPairs.empty() ? 0 : &mPairs[0]; }
+
+private:
+    // copy operations (unimplemented so we can't copy)
+    IvSortSweep( const IvSortSweep& other );
+    IvSortSweep& operator=( const IvSortSweep& other );
+
+    void SetupGrid( const IvAABB* boxes, unsigned int numThreads );
+    void FillColumns( const IvAABB* boxes, unsigned int numThreads );
+    void Sweep( unsigned int numThreads );
+    void SortPairs( unsigned int numThreads );
+
+    unsigned int        mCount;             // number of boxes
+    IvSortSweepGrid     mGrid;              // sweep axis and columns
+
+    std::vector<IvSortSweepEntry>           mEntries;       // bounds, grouped by column
+    std::vector<unsigned int>               mColumnStart;   // first entry of each column
+    std::vector<unsigned int>               mChunkCounts;   // entries per chunk and column
+    std::vector<unsigned int>               mTaskColumns;   // first column of each sweep task
+    std::vector< std::vector<IvProxyPair> > mTaskPairs;     // sweep output per task
+    std::vector<IvProxyPair>                mPairs;         // sorted result
+    std::vector<IvProxyPair>                mPairScratch;   // merge buffer
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,734 @@
+//===============================================================================
+// @ IvSpatialHash.cpp
+//
+// Hierarchical hashed grid for broad phase collision detection
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Building is linear in the number of objects: each object's cell is hashed
+// to a bucket, the buckets are counted, and a prefix sum gives where each
+// bucket's objects go in the sorted arrays.  Different cells can share a
+// bucket, so every sorted entry keeps its cell coordinates to check against.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvSpatialHash.h"
+#include <IvAssert.h>
+
+#include <math.h>
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// bucket for objects too large for any level
+static const unsigned int kOversize = 0xffffffff;
+
+// neighboring cells after the center one, in the order x, then y, then z --
+// each pair of objects on the same level is found from the first of them
+static const int kForwardCells[13][3] =
+{
+    { 1, 0, 0 },
+    { -1, 1, 0 }, { 0, 1, 0 }, { 1, 1, 0 },
+    { -1, -1, 1 }, { 0, -1, 1 }, { 1, -1, 1 },
+    { -1, 0, 1 }, { 0, 0, 1 }, { 1, 0, 1 },
+    { -1, 1, 1 }, { 0, 1, 1 }, { 1, 1, 1 }
+};
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ BoxesOverlap()
+//-------------------------------------------------------------------------------
+// Same test as IvAABB::Intersect(), inlined for the inner loops
+//-------------------------------------------------------------------------------
+static inline bool
+BoxesOverlap( const IvAABB& box0, const IvAABB& box1 )
+{
+    const IvVector3& min0 = box0.GetMinima();
+    const IvVector3& max0 = box0.GetMaxima();
+    const IvVector3& min1 = box1.GetMinima();
+    const IvVector3& max1 = box1.GetMaxima();
+    return min0.x <= max1.x && min1.x <= max0.x
+        && min0.y <= max1.y && min1.y <= max0.y
+        && min0.z <= max1.z && min1.z <= max0.z;
+
+}   // End of BoxesOverlap()
+
+
+//-------------------------------------------------------------------------------
+// @ SpheresOverlap()
+//-------------------------------------------------------------------------------
+// Same test as IvBoundingSphere::Intersect(), inlined for the inner loops
+//-------------------------------------------------------------------------------
+static inline bool
+SpheresOverlap( const IvBoundingSphere& sphere0, const IvBoundingSphere& sphere1 )
+{
+    float radiusSum = sphere0.GetRadius() + sphere1.GetRadius();
+    IvVector3 centerDiff = sphere1.GetCenter() - sphere0.GetCenter();
+    return centerDiff.LengthSquared() <= radiusSum*radiusSum;
+
+}   // End of SpheresOverlap()
+
+
+//-------------------------------------------------------------------------------
+// @ SphereBounds()
+//-------------------------------------------------------------------------------
+// Box around a sphere
+//-------------------------------------------------------------------------------
+static inline IvAABB
+SphereBounds( const IvBoundingSphere& sphere )
+{
+    float radius = sphere.GetRadius();
+    IvVector3 extents( radius, radius, radius );
+    return IvAABB( sphere.GetCenter() - extents, sphere.GetCenter() + extents );
+
+}   // End of SphereBounds()
+
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::IvSpatialHash()
+//-------------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------------
+IvSpatialHash::IvSpatialHash( float cellSize ) :
+    mCellSize( cellSize ),
+    mCount( 0 ),
+    mCapacity( 0 ),
+    mHashedCount( 0 ),
+    mUseSpheres( false ),
+    mBoxes( 0 ),
+    mSpheres( 0 ),
+    mIndices( 0 ),
+    mCells( 0 ),
+    mObjectCells( 0 ),
+    mObjectBuckets( 0 ),
+    mBucketStart( 0 ),
+    mOccupied( 0 ),
+    mTableSize( 0 ),
+    mLevelMask( 0 )
+{
+    ASSERT( cellSize > 0.0f );
+    for ( unsigned int level = 0; level < kMaxLevels; ++level )
+    {
+        mLevelCounts[level] = 0;
+    }
+
+}   // End of IvSpatialHash::IvSpatialHash()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::~IvSpatialHash()
+//-------------------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------------------
+IvSpatialHash::~IvSpatialHash()
+{
+    Clear();
+
+}   // End of IvSpatialHash::~IvSpatialHash()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::SetCellSize()
+//-------------------------------------------------------------------------------
+// Set base cell size
+//-------------------------------------------------------------------------------
+void
+IvSpatialHash::SetCellSize( float cellSize )
+{
+    ASSERT( cellSize > 0.0f );
+    mCellSize = cellSize;
+
+}   // End of IvSpatialHash::SetCellSize()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::Clear()
+//-------------------------------------------------------------------------------
+// Remove all objects and free memory
+//-------------------------------------------------------------------------------
+void
+IvSpatialHash::Clear()
+{
+    delete [] mBoxes;
+    delete [] mSpheres;
+    delete [] mIndices;
+    delete [] mCells;
+    delete [] mObjectCells;
+    delete [] mObjectBuckets;
+    delete [] mBucketStart;
+    delete [] mOccupied;
+    mBoxes = 0;
+    mSpheres = 0;
+    mIndices = 0;
+    mCells = 0;
+    mObjectCells = 0;
+    mObjectBuckets = 0;
+    mBucketStart = 0;
+    mOccupied = 0;
+
+    mCount = 0;
+    mCapacity = 0;
+    mHashedCount = 0;
+    mTableSize = 0;
+    mLevelMask = 0;
+    for ( unsigned int level = 0; level < kMaxLevels; ++level )
+    {
+        mLevelCounts[level] = 0;
+    }
+
+}   // End of IvSpatialHash::Clear()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::Reserve()
+//-------------------------------------------------------------------------------
+// Make room for count objects.  Memory is kept between builds, so it is
+// only allocated when the count grows.
+//-------------------------------------------------------------------------------
+void
+IvSpatialHash::Reserve( unsigned int count )
+{
+    if ( count > mCapacity )
+    {
+        delete [] mBoxes;
+        delete [] mSpheres;
+        delete [] mIndices;
+        delete [] mCells;
+        delete [] mObjectCells;
+        delete [] mObjectBuckets;
+        delete [] mBucketStart;
+        delete [] mOccupied;
+
+        mCapacity = count;
+        // twice as many buckets as objects, to keep sharing low
+        mTableSize = 16;
+        while ( mTableSize < 2*count )
+        {
+            mTableSize *= 2;
+        }
+        mBoxes = 0;
+        mSpheres = 0;
+        mIndices = new unsigned int[mCapacity];
+        mCells = new int[4*mCapacity];
+        mObjectCells = new int[4*mCapacity];
+        mObjectBuckets = new unsigned int[mCapacity];
+        mBucketStart = new unsigned int[mTableSize + 1];
+        mOccupied = new unsigned int[mTableSize/32];
+    }
+
+    // bounds are allocated for whichever type is in use
+    if ( mUseSpheres && !mSpheres )
+    {
+        delete [] mBoxes;
+        mBoxes = 0;
+        mSpheres = new IvBoundingSphere[mCapacity];
+    }
+    else if ( !mUseSpheres && !mBoxes )
+    {
+        delete [] mSpheres;
+        mSpheres = 0;
+        mBoxes = new IvAABB[mCapacity];
+    }
+
+    mCount = count;
+    mLevelMask = 0;
+    for ( unsigned int level = 0; level < kMaxLevels; ++level )
+    {
+        mLevelCounts[level] = 0;
+    }
+
+}   // End of IvSpatialHash::Reserve()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::Bucket()
+//-------------------------------------------------------------------------------
+// Hash a cell to a bucket.  Only y, z and the level are hashed; cells next
+// to each other in x go in consecutive buckets, so a row of neighbors is
+// stored together.
+//-------------------------------------------------------------------------------
+inline unsigned int
+IvSpatialHash::Bucket( int x, int y, int z, int level ) const
+{
+    unsigned int h = (unsigned int)(y)*0xd8163841u ^ (unsigned int)(z)*0xcb1ab31fu
+                   ^ (unsigned int)(level)*0x165667b1u;
+    h ^= h >> 15;
+    return (h + (unsigned int)(x)) & (mTableSize - 1);
+
+}   // End of IvSpatialHash::Bucket()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::IsOccupied()
+//-------------------------------------------------------------------------------
+// Does a bucket hold any objects?  Most neighboring cells are empty, and
+// the bit array is small enough to stay in cache.
+//-------------------------------------------------------------------------------
+inline bool
+IvSpatialHash::IsOccupied( unsigned int bucket ) const
+{
+    return (mOccupied[bucket >> 5] & (1u << (bucket & 31))) != 0;
+
+}   // End of IvSpatialHash::IsOccupied()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::Assign()
+//-------------------------------------------------------------------------------
+// Find the level and cell for an object of the given center and size
+//-------------------------------------------------------------------------------
+void
+IvSpatialHash::Assign( unsigned int index, const IvVector3& center, float size )
+{
+    int level = 0;
+    float cellSize = mCellSize;
+    while ( size > cellSize && level < int(kMaxLevels) )
+    {
+        cellSize *= 2.0f;
+        ++level;
+    }
+
+    int* cell = mObjectCells + 4*index;
+    if ( level == int(kMaxLevels) )
+    {
+        cell[0] = cell[1] = cell[2] = 0;
+        cell[3] = level;
+        mObjectBuckets[index] = kOversize;
+        return;
+    }
+
+    float recipCellSize = 1.0f/cellSize;
+    cell[0] = int(floorf( center.x*recipCellSize ));
+    cell[1] = int(floorf( center.y*recipCellSize ));
+    cell[2] = int(floorf( center.z*recipCellSize ));
+    cell[3] = level;
+    mObjectBuckets[index] = Bucket( cell[0], cell[1], cell[2], level );
+    ++mLevelCounts[level];
+    mLevelMask |= 1u << level;
+
+}   // End of IvSpatialHash::Assign()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::Sort()
+//-------------------------------------------------------------------------------
+// Counting sort of objects by bucket.  Objects keep their original order
+// within a bucket, and oversize objects go last.
+//-------------------------------------------------------------------------------
+void
+IvSpatialHash::Sort()
+{
+    unsigned int* start = mBucketStart;
+    for ( unsigned int b = 0; b <= mTableSize; ++b )
+    {
+        start[b] = 0;
+    }
+
+    // count, then turn counts into the first entry of each bucket
+    mHashedCount = 0;
+    for ( unsigned int i = 0; i < mCount; ++i )
+    {
+        if ( mObjectBuckets[i] != kOversize )
+        {
+            ++start[mObjectBuckets[i]];
+            ++mHashedCount;
+        }
+    }
+    unsigned int sum = 0;
+    for ( unsigned int b = 0; b < mTableSize; b += 32 )
+    {
+        unsigned int bits = 0;
+        for ( unsigned int i = 0; i < 32; ++i )
+        {
+            unsigned int bucketCount = start[b + i];
+            start[b + i] = sum;
+            sum += bucketCount;
+            bits |= (bucketCount > 0 ? 1u : 0u) << i;
+        }
+        mOccupied[b/32] = bits;
+    }
+
+    // scatter, which leaves each start at the end of its bucket
+    unsigned int numOversize = 0;
+    for ( unsigned int i = 0; i < mCount; ++i )
+    {
+        unsigned int bucket = mObjectBuckets[i];
+        unsigned int entry = bucket != kOversize ? start[bucket]++ : mHashedCount + numOversize++;
+        mIndices[entry] = i;
+        for ( unsigned int j = 0; j < 4; ++j )
+        {
+            mCells[4*entry + j] = mObjectCells[4*i + j];
+        }
+    }
+
+    // shift back to starts
+    for ( unsigned int b = mTableSize; b > 0; --b )
+    {
+        start[b] = start[b - 1];
+    }
+    start[0] = 0;
+
+}   // End of IvSpatialHash::Sort()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::Build()
+//-------------------------------------------------------------------------------
+// Rebuild from boxes
+//-------------------------------------------------------------------------------
+void
+IvSpatialHash::Build( const IvAABB* boxes, unsigned int count )
+{
+    ASSERT( boxes || count == 0 );
+
+    mUseSpheres = false;
+    Reserve( count );
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        const IvVector3& minima = boxes[i].GetMinima();
+        const IvVector3& maxima = boxes[i].GetMaxima();
+        IvVector3 size = maxima - minima;
+        float maxSize = size.x > size.y ? size.x : size.y;
+        maxSize = maxSize > size.z ? maxSize : size.z;
+        Assign( i, 0.5f*(minima + maxima), maxSize );
+    }
+    Sort();
+
+    for ( unsigned int entry = 0; entry < count; ++entry )
+    {
+        mBoxes[entry] = boxes[mIndices[entry]];
+    }
+
+}   // End of IvSpatialHash::Build()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::Build()
+//-------------------------------------------------------------------------------
+// Rebuild from spheres
+//-------------------------------------------------------------------------------
+void
+IvSpatialHash::Build( const IvBoundingSphere* spheres, unsigned int count )
+{
+    ASSERT( spheres || count == 0 );
+
+    mUseSpheres = true;
+    Reserve( count );
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        Assign( i, spheres[i].GetCenter(), 2.0f*spheres[i].GetRadius() );
+    }
+    Sort();
+
+    for ( unsigned int entry = 0; entry < count; ++entry )
+    {
+        mSpheres[entry] = spheres[mIndices[entry]];
+    }
+
+}   // End of IvSpatialHash::Build()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::Overlap()
+//-------------------------------------------------------------------------------
+// Does an entry overlap a box?
+//-------------------------------------------------------------------------------
+inline bool
+IvSpatialHash::Overlap( unsigned int entry, const IvAABB& box ) const
+{
+    return mUseSpheres ? box.Intersect( mSpheres[entry] ) : BoxesOverlap( mBoxes[entry], box );
+
+}   // End of IvSpatialHash::Overlap()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::Overlap()
+//-------------------------------------------------------------------------------
+// Does an entry overlap a sphere?
+//-------------------------------------------------------------------------------
+inline bool
+IvSpatialHash::Overlap( unsigned int entry, const IvBoundingSphere& sphere ) const
+{
+    return mUseSpheres ? SpheresOverlap( mSpheres[entry], sphere ) : mBoxes[entry].Intersect( sphere );
+
+}   // End of IvSpatialHash::Overlap()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::Overlap()
+//-------------------------------------------------------------------------------
+// Do two entries overlap?
+//-------------------------------------------------------------------------------
+inline bool
+IvSpatialHash::Overlap( unsigned int entry0, unsigned int entry1 ) const
+{
+    return mUseSpheres ? SpheresOverlap( mSpheres[entry0], mSpheres[entry1] )
+                       : BoxesOverlap( mBoxes[entry0], mBoxes[entry1] );
+
+}   // End of IvSpatialHash::Overlap()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::QueryCells()
+//-------------------------------------------------------------------------------
+// Append the objects overlapping a box or a sphere, whose bounds are
+// given.  An object can only overlap if its center is within half a cell
+// of the bounds, which limits the cells to visit on each level.  When that
+// would be more cells than the level has objects, they are all tested.
+//-------------------------------------------------------------------------------
+unsigned int
+IvSpatialHash::QueryCells( unsigned int* results, unsigned int numResults,
+                           unsigned int maxResults, const IvAABB& bounds,
+                           const IvAABB* box, const IvBoundingSphere* sphere ) const
+{
+    const IvVector3& minima = bounds.GetMinima();
+    const IvVector3& maxima = bounds.GetMaxima();
+    float cellSize = mCellSize;
+    for ( unsigned int level = 0; level < kMaxLevels; ++level, cellSize *= 2.0f )
+    {
+        if ( !(mLevelMask & (1u << level)) )
+            continue;
+
+        float recipCellSize = 1.0f/cellSize;
+        float lo[3], hi[3];
+        float numCells = 1.0f;
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            lo[i] = floorf( (minima[i] - 0.5f*cellSize)*recipCellSize );
+            hi[i] = floorf( (maxima[i] + 0.5f*cellSize)*recipCellSize );
+            numCells *= hi[i] - lo[i] + 1.0f;
+        }
+
+        if ( numCells > float(mLevelCounts[level]) )
+        {
+            for ( unsigned int entry = 0; entry < mHashedCount; ++entry )
+            {
+                if ( mCells[4*entry + 3] != int(level) )
+                    continue;
+                if ( box ? Overlap( entry, *box ) : Overlap( entry, *sphere ) )
+                {
+                    if ( numResults == maxResults )
+                        return numResults;
+                    results[numResults++] = mIndices[entry];
+                }
+            }
+            continue;
+        }
+
+        for ( int z = int(lo[2]); z <= int(hi[2]); ++z )
+        {
+            for ( int y = int(lo[1]); y <= int(hi[1]); ++y )
+            {
+                for ( int x = int(lo[0]); x <= int(hi[0]); ++x )
+                {
+                    unsigned int bucket = Bucket( x, y, z, int(level) );
+                    if ( !IsOccupied( bucket ) )
+                        continue;
+                    for ( unsigned int entry = mBucketStart[bucket];
+                          entry < mBucketStart[bucket + 1]; ++entry )
+                    {
+                        const int* cell = mCells + 4*entry;
+                        if ( cell[0] != x || cell[1] != y || cell[2] != z || cell[3] != int(level) )
+                            continue;
+                        if ( box ? Overlap( entry, *box ) : Overlap( entry, *sphere ) )
+                        {
+                            if ( numResults == maxResults )
+                                return numResults;
+                            results[numResults++] = mIndices[entry];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // oversize objects are always tested
+    for ( unsigned int entry = mHashedCount; entry < mCount; ++entry )
+    {
+        if ( box ? Overlap( entry, *box ) : Overlap( entry, *sphere ) )
+        {
+            if ( numResults == maxResults )
+                return numResults;
+            results[numResults++] = mIndices[entry];
+        }
+    }
+
+    return numResults;
+
+}   // End of IvSpatialHash::QueryCells()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::Query()
+//-------------------------------------------------------------------------------
+// Objects overlapping a box
+//-------------------------------------------------------------------------------
+unsigned int
+IvSpatialHash::Query( unsigned int* results, unsigned int maxResults,
+                      const IvAABB& box ) const
+{
+    return QueryCells( results, 0, maxResults, box, &box, 0 );
+
+}   // End of IvSpatialHash::Query()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::Query()
+//-------------------------------------------------------------------------------
+// Objects overlapping a sphere
+//-------------------------------------------------------------------------------
+unsigned int
+IvSpatialHash::Query( unsigned int* results, unsigned int maxResults,
+                      const IvBoundingSphere& sphere ) const
+{
+    return QueryCells( results, 0, maxResults, SphereBounds( sphere ), 0, &sphere );
+
+}   // End of IvSpatialHash::Query()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSpatialHash::FindPairs()
+//-------------------------------------------------------------------------------
+// All overlapping pairs.  Each object looks at the forward half of its
+// neighbors on its own level, so a pair on one level is found once, and at
+// the cells of coarser levels its bounds could reach.  Oversize objects
+// test all the others.
+//-------------------------------------------------------------------------------
+unsigned int
+IvSpatialHash::FindPairs( IvProxyPair* pairs, unsigned int maxPairs ) const
+{
+    unsigned int numPairs = 0;
+    for ( unsigned int entry = 0; entry < mHashedCount; ++entry )
+    {
+        const int* cell = mCells + 4*entry;
+        int level = cell[3];
+        unsigned int index = mIndices[entry];
+
+        // later objects in the same cell
+        unsigned int bucket = Bucket( cell[0], cell[1], cell[2], level );
+        for ( unsigned int other = entry + 1; other < mBucketStart[bucket + 1]; ++other )
+        {
+            const int* otherCell = mCells + 4*other;
+            if ( otherCell[0] == cell[0] && otherCell[1] == cell[1] && otherCell[2] == cell[2]
+                 && otherCell[3] == level && Overlap( entry, other ) )
+            {
+                if ( numPairs == maxPairs )
+                    return numPairs;
+                unsigned int otherIndex = mIndices[other];
+                pairs[numPairs].proxyA = int(index < otherIndex ? index : otherIndex);
+                pairs[numPairs].proxyB = int(index < otherIndex ? otherIndex : index);
+                ++numPairs;
+            }
+        }
+
+        // forward neighbors on the same level
+        for ( unsigned int n = 0; n < 13; ++n )
+        {
+            int x = cell[0] + kForwardCells[n][0];
+            int y = cell[1] + kForwardCells[n][1];
+            int z = cell[2] + kForwardCells[n][2];
+            bucket = Bucket( x, y, z, level );
+            if ( !IsOccupied( bucket ) )
+                continue;
+            for ( unsigned int other = mBucketStart[bucket]; other < mBucketStart[bucket + 1]; ++other )
+            {
+                const int* otherCell = mCells + 4*other;
+                if ( otherCell[0] == x && otherCell[1] == y && otherCell[2] == z
+                     && otherCell[3] == level && Overlap( entry, other ) )
+                {
+                    if ( numPairs == maxPairs )
+                        return numPairs;
+                    unsigned int otherIndex = mIndices[other];
+                    pairs[numPairs].proxyA = int(index < otherIndex ? index : otherIndex);
+                    pairs[numPairs].proxyB = int(index < otherIndex ? otherIndex : index);
+                    ++numPairs;
+                }
+            }
+        }
+
+        // neighbors on coarser levels, within half a cell of the bounds
+        unsigned int coarseMask = mLevelMask & ~((2u << level) - 1);
+        if ( coarseMask == 0 )
+            continue;
+        IvAABB bounds = mUseSpheres ? SphereBounds( mSpheres[entry] ) : mBoxes[entry];
+        const IvVector3& minima = bounds.GetMinima();
+        const IvVector3& maxima = bounds.GetMaxima();
+        float cellSize = mCellSize*float(1u << (level + 1));
+        for ( int coarse = level + 1; coarse < int(kMaxLevels); ++coarse, cellSize *= 2.0f )
+        {
+            if ( !(coarseMask & (1u << coarse)) )
+                continue;
+
+            float recipCellSize = 1.0f/cellSize;
+            int lo[3], hi[3];
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                lo[i] = int(floorf( (minima[i] - 0.5f*cellSize)*recipCellSize ));
+                hi[i] = int(floorf( (maxima[i] + 0.5f*cellSize)*recipCellSize ));
+            }
+            for ( int z = lo[2]; z <= hi[2]; ++z )
+            {
+                for ( int y = lo[1]; y <= hi[1]; ++y )
+                {
+                    for ( int x = lo[0]; x <= hi[0]; ++x )
+                    {
+                        bucket = Bucket( x, y, z, coarse );
+                        if ( !IsOccupied( bucket ) )
+                            continue;
+                        for ( unsigned int other = mBucketStart[bucket];
+                              other < mBucketStart[bucket + 1]; ++other )
+                        {
+                            const int* otherCell = mCells + 4*other;
+                            if ( otherCell[0] == x && otherCell[1] == y && otherCell[2] == z
+                                 && otherCell[3] == coarse && Overlap( entry, other ) )
+                            {
+                                if ( numPairs == maxPairs )
+                                    return numPairs;
+                                unsigned int otherIndex = mIndices[other];
+                                pairs[numPairs].proxyA = int(index < otherIndex ? index : otherIndex);
+                                pairs[numPairs].proxyB = int(index < otherIndex ? otherIndex : index);
+                                ++numPairs;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // oversize objects against everything after them
+    for ( unsigned int entry = mHashedCount; entry < mCount; ++entry )
+    {
+        unsigned int index = mIndices[entry];
+        for ( unsigned int other = 0; other < mCount; ++other )
+        {
+            if ( (other >= mHashedCount && other <= entry) || !Overlap( entry, other ) )
+                continue;
+            if ( numPairs == maxPairs )
+                return numPairs;
+            unsigned int otherIndex = mIndices[other];
+            pairs[numPairs].proxyA = int(index < otherIndex ? index : otherIndex);
+            pairs[numPairs].proxyB = int(index < otherIndex ? otherIndex : index);
+            ++numPairs;
+        }
+    }
+
+    return numPairs;
+
+}   // End of IvSpatialHash::FindPairs()
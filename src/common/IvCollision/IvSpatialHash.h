@@ -0,0 +1,119 @@
+//===============================================================================
+// @ IvSpatialHash.h
+//
+// Hierarchical hashed grid for broad phase collision detection
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Space is divided into cubic cells, at a series of levels that double in
+// size from the base cell size.  Each object goes in the cell containing
+// its center, at the finest level whose cells are at least as large as the
+// object, so it can only overlap objects in neighboring cells.  Only
+// occupied cells are stored, hashed into a table that is rebuilt from
+// scratch by a counting sort every time the grid is built.
+//
+//===============================================================================
+
+#ifndef __IvSpatialHash__h__
+#define __IvSpatialHash__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvAABB.h"
+#include "IvAABBTree.h"
+#include "IvBoundingSphere.h"
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvSpatialHash
+{
+public:
+    // number of cell levels; objects too large for the last level are
+    // tested against everything
+    static const unsigned int kMaxLevels = 16;
+
+    // constructor/destructor
+    explicit IvSpatialHash( float cellSize = 1.0f );
+    ~IvSpatialHash();
+
+    // base cell size, used from the next Build() on.  Pick about the size
+    // of the common objects.
+    void SetCellSize( float cellSize );
+    inline float GetCellSize() const        { return mCellSize; }
+
+    // rebuild over count objects, indexed by their position in the array
+    void Build( const IvAABB* boxes, unsigned int count );
+    void Build( const IvBoundingSphere* spheres, unsigned int count );
+    void Clear();
+
+    // accessors
+    inline unsigned int GetCount() const    { return mCount; }
+    inline unsigned int GetLevelCount( unsigned int level ) const
+                                            { return level < kMaxLevels ? mLevelCounts[level] : 0; }
+
+    // neighbor queries -- write the indices of the objects overlapping the
+    // given bounds to results, up to maxResults, and return the number written
+    unsigned int Query( unsigned int* results, unsigned int maxResults,
+                        const IvAABB& box ) const;
+    unsigned int Query( unsigned int* results, unsigned int maxResults,
+                        const IvBoundingSphere& sphere ) const;
+
+    // write overlapping pairs, up to maxPairs, and return the number written.
+    // Each pair appears once, with proxyA < proxyB.
+    unsigned int FindPairs( IvProxyPair* pairs, unsigned int maxPairs ) const;
+
+private:
+    // copy operations (unimplemented so we can't copy)
+    IvSpatialHash( const IvSpatialHash& other );
+    IvSpatialHash& operator=( const IvSpatialHash& other );
+
+    void Reserve( unsigned int count );
+    void Assign( unsigned int index, const IvVector3& center, float size );
+    void Sort();
+    inline unsigned int Bucket( int x, int y, int z, int level ) const;
+    inline bool IsOccupied( unsigned int bucket ) const;
+    inline bool Overlap( unsigned int entry, const IvAABB& box ) const;
+    inline bool Overlap( unsigned int entry, const IvBoundingSphere& sphere ) const;
+    inline bool Overlap( unsigned int entry0, unsigned int entry1 ) const;
+    unsigned int QueryCells( unsigned int* results, unsigned int numResults,
+                             unsigned int maxResults, const IvAABB& bounds,
+                             const IvAABB* box, const IvBoundingSphere* sphere ) const;
+
+    float               mCellSize;          // size of level 0 cells
+    unsigned int        mCount;             // number of objects
+    unsigned int        mCapacity;          // size of object arrays
+    unsigned int        mHashedCount;       // objects in the table, the rest are oversize
+    bool                mUseSpheres;        // built from spheres rather than boxes
+
+    IvAABB*             mBoxes;             // bounds in sorted order
+    IvBoundingSphere*   mSpheres;
+    unsigned int*       mIndices;           // original index in sorted order
+    int*                mCells;             // x, y, z, level in sorted order
+
+    int*                mObjectCells;       // x, y, z, level in original order
+    unsigned int*       mObjectBuckets;     // bucket in original order
+
+    unsigned int*       mBucketStart;       // first sorted entry for each bucket
+    unsigned int*       mOccupied;          // bit set for each non-empty bucket
+    unsigned int        mTableSize;         // number of buckets, power of two
+    unsigned int        mLevelCounts[kMaxLevels];
+    unsigned int        mLevelMask;         // bit set for each occupied level
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
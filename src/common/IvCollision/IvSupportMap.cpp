@@ -0,0 +1,224 @@
+//===============================================================================
+// @ IvSupportMap.cpp
+//
+// Support functions for convex shapes
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvSupportMap.h"
+#include "IvBoundingSphere.h"
+#include "IvCapsule.h"
+#include "IvOBB.h"
+#include <IvAssert.h>
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvOBBSupport::Support()
+//-------------------------------------------------------------------------------
+// Corner farthest along direction
+//-------------------------------------------------------------------------------
+IvVector3
+IvOBBSupport::Support( const IvVector3& direction ) const
+{
+    // direction in box space picks the corner
+    const IvMatrix33& rotation = mBox->GetRotation();
+    const IvVector3& extents = mBox->GetExtents();
+    IvVector3 local = direction*rotation;
+    IvVector3 corner( local.x < 0.0f ? -extents.x : extents.x,
+                      local.y < 0.0f ? -extents.y : extents.y,
+                      local.z < 0.0f ? -extents.z : extents.z );
+
+    return mBox->GetCenter() + rotation*corner;
+
+}   // End of IvOBBSupport::Support()
+
+
+//-------------------------------------------------------------------------------
+// @ IvOBBSupport::GetCenter()
+//-------------------------------------------------------------------------------
+// Box center
+//-------------------------------------------------------------------------------
+IvVector3
+IvOBBSupport::GetCenter() const
+{
+    return mBox->GetCenter();
+
+}   // End of IvOBBSupport::GetCenter()
+
+
+//-------------------------------------------------------------------------------
+// @ IvCapsuleSupport::Support()
+//-------------------------------------------------------------------------------
+// Segment endpoint farthest along direction
+//-------------------------------------------------------------------------------
+IvVector3
+IvCapsuleSupport::Support( const IvVector3& direction ) const
+{
+    const IvLineSegment3& segment = mCapsule->GetSegment();
+    if ( direction.Dot( segment.GetDirection() ) > 0.0f )
+        return segment.GetEndpoint1();
+
+    return segment.GetEndpoint0();
+
+}   // End of IvCapsuleSupport::Support()
+
+
+//-------------------------------------------------------------------------------
+// @ IvCapsuleSupport::GetCenter()
+//-------------------------------------------------------------------------------
+// Segment center
+//-------------------------------------------------------------------------------
+IvVector3
+IvCapsuleSupport::GetCenter() const
+{
+    return mCapsule->GetSegment().GetCenter();
+
+}   // End of IvCapsuleSupport::GetCenter()
+
+
+//-------------------------------------------------------------------------------
+// @ IvCapsuleSupport::GetMargin()
+//-------------------------------------------------------------------------------
+// Capsule radius
+//-------------------------------------------------------------------------------
+float
+IvCapsuleSupport::GetMargin() const
+{
+    return mCapsule->GetRadius();
+
+}   // End of IvCapsuleSupport::GetMargin()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSphereSupport::Support()
+//-------------------------------------------------------------------------------
+// Core is a single point
+//-------------------------------------------------------------------------------
+IvVector3
+IvSphereSupport::Support( const IvVector3& ) const
+{
+    return mSphere->GetCenter();
+
+}   // End of IvSphereSupport::Support()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSphereSupport::GetCenter()
+//-------------------------------------------------------------------------------
+// Sphere center
+//-------------------------------------------------------------------------------
+IvVector3
+IvSphereSupport::GetCenter() const
+{
+    return mSphere->GetCenter();
+
+}   // End of IvSphereSupport::GetCenter()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSphereSupport::GetMargin()
+//-------------------------------------------------------------------------------
+// Sphere radius
+//-------------------------------------------------------------------------------
+float
+IvSphereSupport::GetMargin() const
+{
+    return mSphere->GetRadius();
+
+}   // End of IvSphereSupport::GetMargin()
+
+
+//-------------------------------------------------------------------------------
+// @ IvPointCloudSupport::IvPointCloudSupport()
+//-------------------------------------------------------------------------------
+// Points already in place
+//-------------------------------------------------------------------------------
+IvPointCloudSupport::IvPointCloudSupport( const IvVector3* points, unsigned int numPoints ) :
+    mPoints( points ),
+    mNumPoints( numPoints ),
+    mTranslation( IvVector3::origin )
+{
+    ASSERT( points && numPoints > 0 );
+    mRotation.Identity();
+
+}   // End of IvPointCloudSupport::IvPointCloudSupport()
+
+
+//-------------------------------------------------------------------------------
+// @ IvPointCloudSupport::IvPointCloudSupport()
+//-------------------------------------------------------------------------------
+// Points placed by rotation and then translation
+//-------------------------------------------------------------------------------
+IvPointCloudSupport::IvPointCloudSupport( const IvVector3* points, unsigned int numPoints,
+                                          const IvMatrix33& rotation,
+                                          const IvVector3& translation ) :
+    mPoints( points ),
+    mNumPoints( numPoints ),
+    mRotation( rotation ),
+    mTranslation( translation )
+{
+    ASSERT( points && numPoints > 0 );
+
+}   // End of IvPointCloudSupport::IvPointCloudSupport()
+
+
+//-------------------------------------------------------------------------------
+// @ IvPointCloudSupport::Support()
+//-------------------------------------------------------------------------------
+// Point farthest along direction, taking the first on ties
+//-------------------------------------------------------------------------------
+IvVector3
+IvPointCloudSupport::Support( const IvVector3& direction ) const
+{
+    IvVector3 local = direction*mRotation;
+    unsigned int best = 0;
+    float bestDot = local.Dot( mPoints[0] );
+    for ( unsigned int i = 1; i < mNumPoints; ++i )
+    {
+        float dot = local.Dot( mPoints[i] );
+        if ( dot > bestDot )
+        {
+            bestDot = dot;
+            best = i;
+        }
+    }
+
+    return mRotation*mPoints[best] + mTranslation;
+
+}   // End of IvPointCloudSupport::Support()
+
+
+//-------------------------------------------------------------------------------
+// @ IvPointCloudSupport::GetCenter()
+//-------------------------------------------------------------------------------
+// Average of the points
+//-------------------------------------------------------------------------------
+IvVector3
+IvPointCloudSupport::GetCenter() const
+{
+    IvVector3 sum = mPoints[0];
+    for ( unsigned int i = 1; i < mNumPoints; ++i )
+    {
+        sum += mPoints[i];
+    }
+
+    return mRotation*(sum/float(mNumPoints)) + mTranslation;
+
+}   // End of IvPointCloudSupport::GetCenter()
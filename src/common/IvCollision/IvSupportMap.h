@@ -0,0 +1,130 @@
+//===============================================================================
+// @ IvSupportMap.h
+//
+// Support functions for convex shapes
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// A convex shape is described to the GJK and EPA queries in IvGJK.h by its
+// support function, which returns the point of the shape farthest along a
+// given direction.  Rounded shapes are split into a core shape and a
+// margin, the radius of a sphere swept over the core: a capsule is a line
+// segment with a margin, and a sphere is a point with one.  The adapters
+// here keep a pointer to the shape rather than a copy, so the shape must
+// outlive them.
+//
+//===============================================================================
+
+#ifndef __IvSupportMap__h__
+#define __IvSupportMap__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <IvMatrix33.h>
+#include <IvVector3.h>
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvOBB;
+class IvCapsule;
+class IvBoundingSphere;
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvSupportMap
+{
+public:
+    // constructor/destructor
+    inline IvSupportMap() {}
+    virtual ~IvSupportMap() {}
+
+    // point of the core farthest along direction, which need not be
+    // normalized
+    virtual IvVector3 Support( const IvVector3& direction ) const = 0;
+
+    // a point inside the core
+    virtual IvVector3 GetCenter() const = 0;
+
+    // radius swept over the core
+    virtual float GetMargin() const { return 0.0f; }
+};
+
+class IvOBBSupport : public IvSupportMap
+{
+public:
+    explicit IvOBBSupport( const IvOBB& box ) : mBox( &box ) {}
+
+    virtual IvVector3 Support( const IvVector3& direction ) const;
+    virtual IvVector3 GetCenter() const;
+
+private:
+    const IvOBB*    mBox;
+};
+
+class IvCapsuleSupport : public IvSupportMap
+{
+public:
+    explicit IvCapsuleSupport( const IvCapsule& capsule ) : mCapsule( &capsule ) {}
+
+    // core is the capsule's segment
+    virtual IvVector3 Support( const IvVector3& direction ) const;
+    virtual IvVector3 GetCenter() const;
+    virtual float GetMargin() const;
+
+private:
+    const IvCapsule*    mCapsule;
+};
+
+class IvSphereSupport : public IvSupportMap
+{
+public:
+    explicit IvSphereSupport( const IvBoundingSphere& sphere ) : mSphere( &sphere ) {}
+
+    // core is the sphere's center
+    virtual IvVector3 Support( const IvVector3& direction ) const;
+    virtual IvVector3 GetCenter() const;
+    virtual float GetMargin() const;
+
+private:
+    const IvBoundingSphere* mSphere;
+};
+
+// convex hull of a set of points, given in a local space and placed by a
+// rotation and translation
+class IvPointCloudSupport : public IvSupportMap
+{
+public:
+    IvPointCloudSupport( const IvVector3* points, unsigned int numPoints );
+    IvPointCloudSupport( const IvVector3* points, unsigned int numPoints,
+                         const IvMatrix33& rotation, const IvVector3& translation );
+
+    // linear search over the points
+    virtual IvVector3 Support( const IvVector3& direction ) const;
+    virtual IvVector3 GetCenter() const;
+
+private:
+    const IvVector3*    mPoints;
+    unsigned int        mNumPoints;
+    IvMatrix33          mRotation;
+    IvVector3           mTranslation;
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,1080 @@
+//===============================================================================
+// @ IvSweepPrune.cpp
+//
+// Incremental sweep-and-prune for broad phase collision detection
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// The pair set always matches the endpoint order: two proxies overlap when
+// each one's min endpoint comes before the other's max on all three axes.
+// A swap of two endpoints only changes that for their two proxies, so
+// swapping a min past a max is the only time a pair needs to be added or
+// removed.  Pairs that stop overlapping stay in the set, flagged, until
+// UpdatePairs() so that a pair can end and begin again within one frame
+// without reporting anything.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvSweepPrune.h"
+#include <IvAssert.h>
+
+#include <algorithm>
+#include <float.h>
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// initial sizes of proxy pool and pair set
+static const unsigned int kInitialProxies = 16;
+static const unsigned int kInitialPairs = 64;
+
+// sentinel endpoint owners -- the low one sorts as a min, the high as a max
+static const unsigned int kLowSentinel = 0xfffffffe;
+static const unsigned int kHighSentinel = 0xffffffff;
+
+// pair state flags
+static const unsigned char kPairCurrent = 0x01;     // overlapping now
+static const unsigned char kPairPrevious = 0x02;    // overlapping at last UpdatePairs()
+static const unsigned char kPairTouched = 0x04;     // on the touched list
+
+// proxy free list markers
+static const int kProxyInUse = -2;
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// endpoint for bulk sorting
+struct SortEndpoint
+{
+    float           value;
+    unsigned int    owner;
+};
+
+// open proxy in the bulk sweep, with its y and z endpoint positions
+struct ActiveProxy
+{
+    int             proxy;
+    unsigned int    minY;
+    unsigned int    maxY;
+    unsigned int    minZ;
+    unsigned int    maxZ;
+};
+
+//-------------------------------------------------------------------------------
+// @ EndpointLess()
+//-------------------------------------------------------------------------------
+// Order endpoints by value, with mins before maxes at equal values so that
+// touching boxes count as overlapping, as in IvAABB::Intersect()
+//-------------------------------------------------------------------------------
+static inline bool
+EndpointLess( const SortEndpoint& e0, const SortEndpoint& e1 )
+{
+    return e0.value < e1.value
+        || (e0.value == e1.value && (e0.owner & 1) < (e1.owner & 1));
+
+}   // End of EndpointLess()
+
+
+//-------------------------------------------------------------------------------
+// @ PairHash()
+//-------------------------------------------------------------------------------
+// Mix two proxy indices into a hash value
+//-------------------------------------------------------------------------------
+static inline unsigned int
+PairHash( int proxyA, int proxyB )
+{
+    unsigned int h = (unsigned int)(proxyA)*0x9e3779b1u + (unsigned int)(proxyB);
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    return h;
+
+}   // End of PairHash()
+
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::IvSweepPrune()
+//-------------------------------------------------------------------------------
+// Constructor
+//-------------------------------------------------------------------------------
+IvSweepPrune::IvSweepPrune() :
+    mProxies( 0 ),
+    mProxyCapacity( 0 ),
+    mProxyCount( 0 ),
+    mFreeList( -1 ),
+    mPendingFree( 0 ),
+    mPendingCount( 0 ),
+    mEndpointCapacity( 0 ),
+    mPairs( 0 ),
+    mPairFlags( 0 ),
+    mPairCount( 0 ),
+    mPairCapacity( 0 ),
+    mHash( 0 ),
+    mHashSize( 0 ),
+    mTouched( 0 ),
+    mTouchedCount( 0 ),
+    mBeginPairs( 0 ),
+    mBeginCount( 0 ),
+    mEndPairs( 0 ),
+    mEndCount( 0 )
+{
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        mValues[axis] = 0;
+        mOwners[axis] = 0;
+        mPositions[axis] = 0;
+    }
+
+}   // End of IvSweepPrune::IvSweepPrune()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::~IvSweepPrune()
+//-------------------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------------------
+IvSweepPrune::~IvSweepPrune()
+{
+    Clear();
+
+}   // End of IvSweepPrune::~IvSweepPrune()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::Clear()
+//-------------------------------------------------------------------------------
+// Remove all proxies and pairs
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::Clear()
+{
+    delete [] mProxies;
+    delete [] mPendingFree;
+    mProxies = 0;
+    mPendingFree = 0;
+    mProxyCapacity = 0;
+    mProxyCount = 0;
+    mFreeList = -1;
+    mPendingCount = 0;
+
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        delete [] mValues[axis];
+        delete [] mOwners[axis];
+        delete [] mPositions[axis];
+        mValues[axis] = 0;
+        mOwners[axis] = 0;
+        mPositions[axis] = 0;
+    }
+    mEndpointCapacity = 0;
+
+    delete [] mPairs;
+    delete [] mPairFlags;
+    delete [] mHash;
+    delete [] mTouched;
+    delete [] mBeginPairs;
+    delete [] mEndPairs;
+    mPairs = 0;
+    mPairFlags = 0;
+    mHash = 0;
+    mTouched = 0;
+    mBeginPairs = 0;
+    mEndPairs = 0;
+    mPairCount = 0;
+    mPairCapacity = 0;
+    mHashSize = 0;
+    mTouchedCount = 0;
+    mBeginCount = 0;
+    mEndCount = 0;
+
+}   // End of IvSweepPrune::Clear()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::AllocateProxy()
+//-------------------------------------------------------------------------------
+// Take a proxy from the free list, growing the pool if it's empty
+//-------------------------------------------------------------------------------
+int
+IvSweepPrune::AllocateProxy()
+{
+    if ( mFreeList == -1 )
+    {
+        unsigned int capacity = mProxyCapacity > 0 ? 2*mProxyCapacity : kInitialProxies;
+        IvSweepPruneProxy* proxies = new IvSweepPruneProxy[capacity];
+        int* pendingFree = new int[capacity];
+        for ( unsigned int i = 0; i < mProxyCapacity; ++i )
+        {
+            proxies[i] = mProxies[i];
+        }
+        for ( unsigned int axis = 0; axis < 3; ++axis )
+        {
+            unsigned int* positions = new unsigned int[2*capacity];
+            for ( unsigned int i = 0; i < 2*mProxyCapacity; ++i )
+            {
+                positions[i] = mPositions[axis][i];
+            }
+            delete [] mPositions[axis];
+            mPositions[axis] = positions;
+        }
+        for ( unsigned int i = 0; i < mPendingCount; ++i )
+        {
+            pendingFree[i] = mPendingFree[i];
+        }
+        delete [] mProxies;
+        delete [] mPendingFree;
+        mProxies = proxies;
+        mPendingFree = pendingFree;
+
+        // chain new proxies onto the free list
+        for ( unsigned int i = mProxyCapacity; i < capacity; ++i )
+        {
+            mProxies[i].userData = 0;
+            mProxies[i].next = (i + 1 < capacity) ? int(i + 1) : -1;
+        }
+        mFreeList = int(mProxyCapacity);
+        mProxyCapacity = capacity;
+    }
+
+    int proxy = mFreeList;
+    mFreeList = mProxies[proxy].next;
+    mProxies[proxy].next = kProxyInUse;
+    return proxy;
+
+}   // End of IvSweepPrune::AllocateProxy()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::ReserveEndpoints()
+//-------------------------------------------------------------------------------
+// Make room for the endpoints of numProxies proxies, plus the sentinels
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::ReserveEndpoints( unsigned int numProxies )
+{
+    unsigned int needed = 2*numProxies + 2;
+    if ( needed <= mEndpointCapacity )
+        return;
+
+    unsigned int capacity = mEndpointCapacity > 0 ? 2*mEndpointCapacity : 2*kInitialProxies + 2;
+    if ( capacity < needed )
+        capacity = needed;
+
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        float* values = new float[capacity];
+        unsigned int* owners = new unsigned int[capacity];
+        if ( mEndpointCapacity > 0 )
+        {
+            for ( unsigned int i = 0; i < 2*mProxyCount + 2; ++i )
+            {
+                values[i] = mValues[axis][i];
+                owners[i] = mOwners[axis][i];
+            }
+        }
+        else
+        {
+            values[0] = -FLT_MAX;
+            owners[0] = kLowSentinel;
+            values[1] = FLT_MAX;
+            owners[1] = kHighSentinel;
+        }
+        delete [] mValues[axis];
+        delete [] mOwners[axis];
+        mValues[axis] = values;
+        mOwners[axis] = owners;
+    }
+    mEndpointCapacity = capacity;
+
+}   // End of IvSweepPrune::ReserveEndpoints()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::CreateProxy()
+//-------------------------------------------------------------------------------
+// Add an object with the given bounds, returns its proxy.  The endpoints
+// start at the top of each axis and are sorted down into place; pairs are
+// only tracked while sorting the last axis, once the others are in order.
+//-------------------------------------------------------------------------------
+int
+IvSweepPrune::CreateProxy( const IvAABB& box, void* userData )
+{
+    ReserveEndpoints( mProxyCount + 1 );
+    int proxy = AllocateProxy();
+    mProxies[proxy].userData = userData;
+
+    unsigned int top = 2*mProxyCount + 1;
+    ++mProxyCount;
+    const IvVector3& minima = box.GetMinima();
+    const IvVector3& maxima = box.GetMaxima();
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        ASSERT( -FLT_MAX < minima[axis] && minima[axis] <= maxima[axis]
+                && maxima[axis] < FLT_MAX );
+
+        float* values = mValues[axis];
+        unsigned int* owners = mOwners[axis];
+        values[top + 2] = FLT_MAX;
+        owners[top + 2] = kHighSentinel;
+        values[top] = minima[axis];
+        owners[top] = unsigned(proxy) << 1;
+        values[top + 1] = maxima[axis];
+        owners[top + 1] = (unsigned(proxy) << 1) | 1;
+        mPositions[axis][2*proxy] = top;
+        mPositions[axis][2*proxy + 1] = top + 1;
+
+        SortMinDown( axis, top, axis == 2 );
+        SortMaxDown( axis, top + 1, axis == 2 );
+    }
+
+    return proxy;
+
+}   // End of IvSweepPrune::CreateProxy()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::CreateProxies()
+//-------------------------------------------------------------------------------
+// Add many objects at once.  The new endpoints are appended and each axis
+// is re-sorted, then one sweep along x finds the new pairs.  Pairs found
+// that already exist are left as they are.
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::CreateProxies( int* proxies, const IvAABB* boxes, void* const* userData,
+                             unsigned int count )
+{
+    if ( count == 0 )
+        return;
+    ASSERT( proxies && boxes );
+
+    ReserveEndpoints( mProxyCount + count );
+    unsigned int first = 2*mProxyCount + 1;
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        int proxy = AllocateProxy();
+        mProxies[proxy].userData = userData ? userData[i] : 0;
+        proxies[i] = proxy;
+
+        const IvVector3& minima = boxes[i].GetMinima();
+        const IvVector3& maxima = boxes[i].GetMaxima();
+        for ( unsigned int axis = 0; axis < 3; ++axis )
+        {
+            ASSERT( -FLT_MAX < minima[axis] && minima[axis] <= maxima[axis]
+                    && maxima[axis] < FLT_MAX );
+            mValues[axis][first + 2*i] = minima[axis];
+            mOwners[axis][first + 2*i] = unsigned(proxy) << 1;
+            mValues[axis][first + 2*i + 1] = maxima[axis];
+            mOwners[axis][first + 2*i + 1] = (unsigned(proxy) << 1) | 1;
+        }
+    }
+    mProxyCount += count;
+
+    // sort each axis, between the sentinels
+    unsigned int numEndpoints = 2*mProxyCount;
+    SortEndpoint* sorted = new SortEndpoint[numEndpoints];
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        float* values = mValues[axis];
+        unsigned int* owners = mOwners[axis];
+        for ( unsigned int i = 0; i < numEndpoints; ++i )
+        {
+            sorted[i].value = values[i + 1];
+            sorted[i].owner = owners[i + 1];
+        }
+        std::sort( sorted, sorted + numEndpoints, EndpointLess );
+        for ( unsigned int i = 0; i < numEndpoints; ++i )
+        {
+            values[i + 1] = sorted[i].value;
+            owners[i + 1] = sorted[i].owner;
+            mPositions[axis][sorted[i].owner] = i + 1;
+        }
+        values[numEndpoints + 1] = FLT_MAX;
+        owners[numEndpoints + 1] = kHighSentinel;
+    }
+    delete [] sorted;
+
+    // sweep along x, keeping the proxies whose x ranges are open along with
+    // copies of their y and z positions, so the overlap tests read memory
+    // in order
+    ActiveProxy* active = new ActiveProxy[mProxyCount];
+    unsigned int* activeIndex = new unsigned int[mProxyCapacity];
+    unsigned int numActive = 0;
+    const unsigned int* owners = mOwners[0];
+    const unsigned int* positionsY = mPositions[1];
+    const unsigned int* positionsZ = mPositions[2];
+    for ( unsigned int i = 1; i <= numEndpoints; ++i )
+    {
+        unsigned int owner = owners[i];
+        int proxy = int(owner >> 1);
+        if ( owner & 1 )
+        {
+            unsigned int index = activeIndex[proxy];
+            active[index] = active[--numActive];
+            activeIndex[active[index].proxy] = index;
+        }
+        else
+        {
+            ActiveProxy entry = { proxy, positionsY[owner], positionsY[owner + 1],
+                                  positionsZ[owner], positionsZ[owner + 1] };
+            for ( unsigned int j = 0; j < numActive; ++j )
+            {
+                const ActiveProxy& other = active[j];
+                if ( entry.minY < other.maxY && other.minY < entry.maxY
+                     && entry.minZ < other.maxZ && other.minZ < entry.maxZ )
+                    AddPair( proxy, other.proxy );
+            }
+            activeIndex[proxy] = numActive;
+            active[numActive++] = entry;
+        }
+    }
+    delete [] active;
+    delete [] activeIndex;
+
+}   // End of IvSweepPrune::CreateProxies()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::DestroyProxy()
+//-------------------------------------------------------------------------------
+// Remove an object.  Its endpoints are moved to the top of each axis and
+// dropped; moving past the others on x removes all of its pairs.
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::DestroyProxy( int proxy )
+{
+    ASSERT( 0 <= proxy && proxy < int(mProxyCapacity) && mProxies[proxy].next == kProxyInUse );
+
+    unsigned int top = 2*mProxyCount + 1;
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        const unsigned int* positions = mPositions[axis];
+        mValues[axis][positions[2*proxy + 1]] = FLT_MAX;
+        SortMaxUp( axis, positions[2*proxy + 1], axis == 0 );
+        mValues[axis][positions[2*proxy]] = FLT_MAX;
+        SortMinUp( axis, positions[2*proxy], axis == 0 );
+        ASSERT( positions[2*proxy] == top - 2 && positions[2*proxy + 1] == top - 1 );
+
+        mValues[axis][top - 2] = FLT_MAX;
+        mOwners[axis][top - 2] = kHighSentinel;
+    }
+    --mProxyCount;
+
+    // hold the index back so its end events can't be confused with a new proxy
+    mProxies[proxy].userData = 0;
+    mProxies[proxy].next = -1;
+    mPendingFree[mPendingCount++] = proxy;
+
+}   // End of IvSweepPrune::DestroyProxy()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::MoveProxy()
+//-------------------------------------------------------------------------------
+// Update an object's bounds.  On each axis, endpoints that grow the box
+// are sorted first, so a min never has to pass its own max.
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::MoveProxy( int proxy, const IvAABB& box )
+{
+    ASSERT( 0 <= proxy && proxy < int(mProxyCapacity) && mProxies[proxy].next == kProxyInUse );
+
+    const IvVector3& minima = box.GetMinima();
+    const IvVector3& maxima = box.GetMaxima();
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        ASSERT( -FLT_MAX < minima[axis] && minima[axis] <= maxima[axis]
+                && maxima[axis] < FLT_MAX );
+
+        float* values = mValues[axis];
+        const unsigned int* positions = mPositions[axis];
+        float dMin = minima[axis] - values[positions[2*proxy]];
+        float dMax = maxima[axis] - values[positions[2*proxy + 1]];
+        values[positions[2*proxy]] = minima[axis];
+        values[positions[2*proxy + 1]] = maxima[axis];
+
+        if ( dMin < 0.0f )
+            SortMinDown( axis, positions[2*proxy], true );
+        if ( dMax > 0.0f )
+            SortMaxUp( axis, positions[2*proxy + 1], true );
+        if ( dMin > 0.0f )
+            SortMinUp( axis, positions[2*proxy], true );
+        if ( dMax < 0.0f )
+            SortMaxDown( axis, positions[2*proxy + 1], true );
+    }
+
+}   // End of IvSweepPrune::MoveProxy()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::MoveProxies()
+//-------------------------------------------------------------------------------
+// Update many objects' bounds.  All the new values are written first,
+// then a single insertion sort pass over each axis puts them in order.
+// The pass walks the endpoint arrays front to back, rather than jumping
+// around them proxy by proxy.
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::MoveProxies( const int* proxies, const IvAABB* boxes, unsigned int count )
+{
+    ASSERT( (proxies && boxes) || count == 0 );
+
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        float* values = mValues[axis];
+        const unsigned int* positions = mPositions[axis];
+        for ( unsigned int i = 0; i < count; ++i )
+        {
+            int proxy = proxies[i];
+            ASSERT( 0 <= proxy && proxy < int(mProxyCapacity)
+                    && mProxies[proxy].next == kProxyInUse );
+            float minimum = boxes[i].GetMinima()[axis];
+            float maximum = boxes[i].GetMaxima()[axis];
+            ASSERT( -FLT_MAX < minimum && minimum <= maximum && maximum < FLT_MAX );
+            values[positions[2*proxy]] = minimum;
+            values[positions[2*proxy + 1]] = maximum;
+        }
+    }
+
+    // each endpoint that's out of order moves down past those that belong
+    // after it, which covers those that need to move up
+    unsigned int numEndpoints = 2*mProxyCount + 1;
+    for ( unsigned int axis = 0; axis < 3 && count > 0; ++axis )
+    {
+        const float* values = mValues[axis];
+        const unsigned int* owners = mOwners[axis];
+        for ( unsigned int i = 2; i < numEndpoints; ++i )
+        {
+            if ( owners[i] & 1 )
+            {
+                if ( values[i - 1] > values[i] )
+                    SortMaxDown( axis, i, true );
+            }
+            else
+            {
+                if ( values[i - 1] > values[i] || (values[i - 1] == values[i] && (owners[i - 1] & 1)) )
+                    SortMinDown( axis, i, true );
+            }
+        }
+    }
+
+}   // End of IvSweepPrune::MoveProxies()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::GetBox()
+//-------------------------------------------------------------------------------
+// Current bounds of a proxy
+//-------------------------------------------------------------------------------
+IvAABB
+IvSweepPrune::GetBox( int proxy ) const
+{
+    ASSERT( 0 <= proxy && proxy < int(mProxyCapacity) && mProxies[proxy].next == kProxyInUse );
+
+    IvVector3 minima, maxima;
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        minima[axis] = mValues[axis][mPositions[axis][2*proxy]];
+        maxima[axis] = mValues[axis][mPositions[axis][2*proxy + 1]];
+    }
+    return IvAABB( minima, maxima );
+
+}   // End of IvSweepPrune::GetBox()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::Overlap()
+//-------------------------------------------------------------------------------
+// Do two proxies overlap, according to the endpoint order?
+//-------------------------------------------------------------------------------
+inline bool
+IvSweepPrune::Overlap( int proxyA, int proxyB ) const
+{
+    unsigned int minA = unsigned(proxyA) << 1;
+    unsigned int minB = unsigned(proxyB) << 1;
+    for ( unsigned int axis = 0; axis < 3; ++axis )
+    {
+        const unsigned int* positions = mPositions[axis];
+        if ( positions[minB + 1] < positions[minA] || positions[minA + 1] < positions[minB] )
+            return false;
+    }
+    return true;
+
+}   // End of IvSweepPrune::Overlap()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::SortMinDown()
+//-------------------------------------------------------------------------------
+// Insertion sort a min endpoint toward the start.  Passing a max may start
+// an overlap, which is checked once the two have swapped.
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::SortMinDown( unsigned int axis, unsigned int index, bool updatePairs )
+{
+    float* values = mValues[axis];
+    unsigned int* owners = mOwners[axis];
+    unsigned int* positions = mPositions[axis];
+    float value = values[index];
+    unsigned int owner = owners[index];
+    int proxy = int(owner >> 1);
+
+    unsigned int j = index - 1;
+    while ( values[j] > value || (values[j] == value && (owners[j] & 1)) )
+    {
+        unsigned int other = owners[j];
+        values[j + 1] = values[j];
+        owners[j + 1] = other;
+        positions[other] = j + 1;
+        positions[owner] = j;
+        if ( updatePairs && (other & 1) && Overlap( proxy, int(other >> 1) ) )
+            AddPair( proxy, int(other >> 1) );
+        --j;
+    }
+    values[j + 1] = value;
+    owners[j + 1] = owner;
+
+}   // End of IvSweepPrune::SortMinDown()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::SortMinUp()
+//-------------------------------------------------------------------------------
+// Insertion sort a min endpoint toward the end.  Passing a max ends an
+// overlap, if there was one before the swap.
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::SortMinUp( unsigned int axis, unsigned int index, bool updatePairs )
+{
+    float* values = mValues[axis];
+    unsigned int* owners = mOwners[axis];
+    unsigned int* positions = mPositions[axis];
+    float value = values[index];
+    unsigned int owner = owners[index];
+    int proxy = int(owner >> 1);
+
+    unsigned int j = index + 1;
+    while ( values[j] < value )
+    {
+        unsigned int other = owners[j];
+        if ( updatePairs && (other & 1) && Overlap( proxy, int(other >> 1) ) )
+            RemovePair( proxy, int(other >> 1) );
+        values[j - 1] = values[j];
+        owners[j - 1] = other;
+        positions[other] = j - 1;
+        positions[owner] = j;
+        ++j;
+    }
+    values[j - 1] = value;
+    owners[j - 1] = owner;
+
+}   // End of IvSweepPrune::SortMinUp()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::SortMaxDown()
+//-------------------------------------------------------------------------------
+// Insertion sort a max endpoint toward the start.  Passing a min ends an
+// overlap, if there was one before the swap.
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::SortMaxDown( unsigned int axis, unsigned int index, bool updatePairs )
+{
+    float* values = mValues[axis];
+    unsigned int* owners = mOwners[axis];
+    unsigned int* positions = mPositions[axis];
+    float value = values[index];
+    unsigned int owner = owners[index];
+    int proxy = int(owner >> 1);
+
+    unsigned int j = index - 1;
+    while ( values[j] > value )
+    {
+        unsigned int other = owners[j];
+        if ( updatePairs && !(other & 1) && Overlap( proxy, int(other >> 1) ) )
+            RemovePair( proxy, int(other >> 1) );
+        values[j + 1] = values[j];
+        owners[j + 1] = other;
+        positions[other] = j + 1;
+        positions[owner] = j;
+        --j;
+    }
+    values[j + 1] = value;
+    owners[j + 1] = owner;
+
+}   // End of IvSweepPrune::SortMaxDown()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::SortMaxUp()
+//-------------------------------------------------------------------------------
+// Insertion sort a max endpoint toward the end.  Passing a min may start
+// an overlap, which is checked once the two have swapped.
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::SortMaxUp( unsigned int axis, unsigned int index, bool updatePairs )
+{
+    float* values = mValues[axis];
+    unsigned int* owners = mOwners[axis];
+    unsigned int* positions = mPositions[axis];
+    float value = values[index];
+    unsigned int owner = owners[index];
+    int proxy = int(owner >> 1);
+
+    unsigned int j = index + 1;
+    while ( values[j] < value || (values[j] == value && !(owners[j] & 1)) )
+    {
+        unsigned int other = owners[j];
+        values[j - 1] = values[j];
+        owners[j - 1] = other;
+        positions[other] = j - 1;
+        positions[owner] = j;
+        if ( updatePairs && !(other & 1) && Overlap( proxy, int(other >> 1) ) )
+            AddPair( proxy, int(other >> 1) );
+        ++j;
+    }
+    values[j - 1] = value;
+    owners[j - 1] = owner;
+
+}   // End of IvSweepPrune::SortMaxUp()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::FindPair()
+//-------------------------------------------------------------------------------
+// Index of a pair in the set, or -1.  Proxies must be in order.
+//-------------------------------------------------------------------------------
+int
+IvSweepPrune::FindPair( int proxyA, int proxyB ) const
+{
+    if ( mHashSize == 0 )
+        return -1;
+
+    unsigned int mask = mHashSize - 1;
+    unsigned int slot = PairHash( proxyA, proxyB ) & mask;
+    while ( mHash[slot] != -1 )
+    {
+        const IvProxyPair& pair = mPairs[mHash[slot]];
+        if ( pair.proxyA == proxyA && pair.proxyB == proxyB )
+            return mHash[slot];
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+
+}   // End of IvSweepPrune::FindPair()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::AddPair()
+//-------------------------------------------------------------------------------
+// Mark a pair as overlapping, adding it to the set if needed
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::AddPair( int proxyA, int proxyB )
+{
+    if ( proxyB < proxyA )
+        std::swap( proxyA, proxyB );
+
+    int pair = FindPair( proxyA, proxyB );
+    if ( pair != -1 )
+    {
+        if ( !(mPairFlags[pair] & kPairCurrent) )
+        {
+            mPairFlags[pair] |= kPairCurrent;
+            TouchPair( pair );
+        }
+        return;
+    }
+
+    // grow everything sized by the pair count together
+    if ( mPairCount == mPairCapacity )
+    {
+        unsigned int capacity = mPairCapacity > 0 ? 2*mPairCapacity : kInitialPairs;
+        IvProxyPair* pairs = new IvProxyPair[capacity];
+        unsigned char* flags = new unsigned char[capacity];
+        int* touched = new int[capacity];
+        for ( unsigned int i = 0; i < mPairCount; ++i )
+        {
+            pairs[i] = mPairs[i];
+            flags[i] = mPairFlags[i];
+        }
+        for ( unsigned int i = 0; i < mTouchedCount; ++i )
+        {
+            touched[i] = mTouched[i];
+        }
+        IvProxyPair* beginPairs = new IvProxyPair[capacity];
+        IvProxyPair* endPairs = new IvProxyPair[capacity];
+        for ( unsigned int i = 0; i < mBeginCount; ++i )
+        {
+            beginPairs[i] = mBeginPairs[i];
+        }
+        for ( unsigned int i = 0; i < mEndCount; ++i )
+        {
+            endPairs[i] = mEndPairs[i];
+        }
+        delete [] mPairs;
+        delete [] mPairFlags;
+        delete [] mTouched;
+        delete [] mBeginPairs;
+        delete [] mEndPairs;
+        mPairs = pairs;
+        mPairFlags = flags;
+        mTouched = touched;
+        mBeginPairs = beginPairs;
+        mEndPairs = endPairs;
+        mPairCapacity = capacity;
+
+        ResizeHash( 2*capacity );
+    }
+
+    pair = int(mPairCount++);
+    mPairs[pair].proxyA = proxyA;
+    mPairs[pair].proxyB = proxyB;
+    mPairFlags[pair] = kPairCurrent;
+    TouchPair( pair );
+
+    unsigned int mask = mHashSize - 1;
+    unsigned int slot = PairHash( proxyA, proxyB ) & mask;
+    while ( mHash[slot] != -1 )
+    {
+        slot = (slot + 1) & mask;
+    }
+    mHash[slot] = pair;
+
+}   // End of IvSweepPrune::AddPair()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::RemovePair()
+//-------------------------------------------------------------------------------
+// Mark a pair as no longer overlapping
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::RemovePair( int proxyA, int proxyB )
+{
+    if ( proxyB < proxyA )
+        std::swap( proxyA, proxyB );
+
+    int pair = FindPair( proxyA, proxyB );
+    ASSERT( pair != -1 );
+    if ( pair != -1 && (mPairFlags[pair] & kPairCurrent) )
+    {
+        mPairFlags[pair] &= ~kPairCurrent;
+        TouchPair( pair );
+    }
+
+}   // End of IvSweepPrune::RemovePair()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::TouchPair()
+//-------------------------------------------------------------------------------
+// Remember that a pair changed this frame
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::TouchPair( int pair )
+{
+    if ( !(mPairFlags[pair] & kPairTouched) )
+    {
+        mPairFlags[pair] |= kPairTouched;
+        mTouched[mTouchedCount++] = pair;
+    }
+
+}   // End of IvSweepPrune::TouchPair()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::ErasePair()
+//-------------------------------------------------------------------------------
+// Take a pair out of the set.  The hole in the hash table is filled by
+// shifting back later entries of the same probe run, and the last pair
+// moves into the hole in the pair array.
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::ErasePair( int pair )
+{
+    unsigned int mask = mHashSize - 1;
+    unsigned int slot = PairHash( mPairs[pair].proxyA, mPairs[pair].proxyB ) & mask;
+    while ( mHash[slot] != pair )
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    unsigned int next = (slot + 1) & mask;
+    while ( mHash[next] != -1 )
+    {
+        const IvProxyPair& entry = mPairs[mHash[next]];
+        unsigned int home = PairHash( entry.proxyA, entry.proxyB ) & mask;
+        // move the entry back if its home isn't between the hole and it
+        if ( ((next - home) & mask) >= ((next - slot) & mask) )
+        {
+            mHash[slot] = mHash[next];
+            slot = next;
+        }
+        next = (next + 1) & mask;
+    }
+    mHash[slot] = -1;
+
+    int last = int(--mPairCount);
+    if ( pair != last )
+    {
+        slot = PairHash( mPairs[last].proxyA, mPairs[last].proxyB ) & mask;
+        while ( mHash[slot] != last )
+        {
+            slot = (slot + 1) & mask;
+        }
+        mHash[slot] = pair;
+        mPairs[pair] = mPairs[last];
+        mPairFlags[pair] = mPairFlags[last];
+    }
+
+}   // End of IvSweepPrune::ErasePair()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::ResizeHash()
+//-------------------------------------------------------------------------------
+// Rebuild the hash table at a new size
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::ResizeHash( unsigned int size )
+{
+    ASSERT( (size & (size - 1)) == 0 && size > mPairCount );
+
+    delete [] mHash;
+    mHash = new int[size];
+    mHashSize = size;
+    for ( unsigned int i = 0; i < size; ++i )
+    {
+        mHash[i] = -1;
+    }
+
+    unsigned int mask = size - 1;
+    for ( unsigned int i = 0; i < mPairCount; ++i )
+    {
+        unsigned int slot = PairHash( mPairs[i].proxyA, mPairs[i].proxyB ) & mask;
+        while ( mHash[slot] != -1 )
+        {
+            slot = (slot + 1) & mask;
+        }
+        mHash[slot] = int(i);
+    }
+
+}   // End of IvSweepPrune::ResizeHash()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::UpdatePairs()
+//-------------------------------------------------------------------------------
+// Compare each pair that changed against its state at the last call,
+// reporting begin and end events, then drop the pairs that ended and
+// release the destroyed proxies
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::UpdatePairs()
+{
+    mBeginCount = 0;
+    mEndCount = 0;
+    unsigned int numErased = 0;
+    for ( unsigned int i = 0; i < mTouchedCount; ++i )
+    {
+        int pair = mTouched[i];
+        unsigned char flags = mPairFlags[pair];
+        if ( flags & kPairCurrent )
+        {
+            if ( !(flags & kPairPrevious) )
+                mBeginPairs[mBeginCount++] = mPairs[pair];
+            mPairFlags[pair] = kPairCurrent | kPairPrevious;
+        }
+        else
+        {
+            if ( flags & kPairPrevious )
+                mEndPairs[mEndCount++] = mPairs[pair];
+            mTouched[numErased++] = pair;
+        }
+    }
+    mTouchedCount = 0;
+
+    // erase from the back, so the pairs moved into the holes are never
+    // ones still to be erased
+    std::sort( mTouched, mTouched + numErased );
+    while ( numErased > 0 )
+    {
+        ErasePair( mTouched[--numErased] );
+    }
+
+    for ( unsigned int i = 0; i < mPendingCount; ++i )
+    {
+        mProxies[mPendingFree[i]].next = mFreeList;
+        mFreeList = mPendingFree[i];
+    }
+    mPendingCount = 0;
+
+}   // End of IvSweepPrune::UpdatePairs()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSweepPrune::Validate()
+//-------------------------------------------------------------------------------
+// Check the endpoint order and indices, and that the current pairs are
+// exactly the overlapping proxies
+//-------------------------------------------------------------------------------
+void
+IvSweepPrune::Validate() const
+{
+#ifndef NDEBUG
+    unsigned int numEndpoints = GetEndpointCount();
+    for ( unsigned int axis = 0; axis < 3 && numEndpoints > 0; ++axis )
+    {
+        const float* values = mValues[axis];
+        const unsigned int* owners = mOwners[axis];
+        ASSERT( owners[0] == kLowSentinel && owners[numEndpoints - 1] == kHighSentinel );
+        for ( unsigned int i = 1; i < numEndpoints - 1; ++i )
+        {
+            SortEndpoint e0 = { values[i], owners[i] };
+            SortEndpoint e1 = { values[i - 1], owners[i - 1] };
+            ASSERT( !EndpointLess( e0, e1 ) );
+            ASSERT( mProxies[owners[i] >> 1].next == kProxyInUse );
+            ASSERT( mPositions[axis][owners[i]] == i );
+        }
+    }
+
+    unsigned int numOverlaps = 0;
+    for ( unsigned int a = 0; a < mProxyCapacity; ++a )
+    {
+        if ( mProxies[a].next != kProxyInUse )
+            continue;
+        for ( unsigned int b = a + 1; b < mProxyCapacity; ++b )
+        {
+            if ( mProxies[b].next != kProxyInUse || !Overlap( int(a), int(b) ) )
+                continue;
+            ++numOverlaps;
+            int pair = FindPair( int(a), int(b) );
+            ASSERT( pair != -1 && (mPairFlags[pair] & kPairCurrent) );
+        }
+    }
+
+    unsigned int numCurrent = 0;
+    for ( unsigned int i = 0; i < mPairCount; ++i )
+    {
+        ASSERT( FindPair( mPairs[i].proxyA, mPairs[i].proxyB ) == int(i) );
+        if ( mPairFlags[i] & kPairCurrent )
+            ++numCurrent;
+    }
+    ASSERT( numCurrent == numOverlaps );
+#endif
+
+}   // End of IvSweepPrune::Validate()
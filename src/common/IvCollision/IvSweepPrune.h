@@ -0,0 +1,146 @@
+//===============================================================================
+// @ IvSweepPrune.h
+//
+// Incremental sweep-and-prune for broad phase collision detection
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Each proxy's box contributes a min and a max endpoint to a sorted list
+// on each of the three axes.  Objects move little between frames, so the
+// lists are kept sorted with an insertion sort, and each time two
+// endpoints swap the overlap of their proxies may have changed.  The
+// overlapping pairs persist in a hash set between frames, and calling
+// UpdatePairs() at the end of a frame reports which pairs began and which
+// ended overlapping since the last call.
+//
+//===============================================================================
+
+#ifndef __IvSweepPrune__h__
+#define __IvSweepPrune__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvAABBTree.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// proxy user data, and free list link when unused
+struct IvSweepPruneProxy
+{
+    void*           userData;
+    int             next;       // next free proxy, -2 while in use
+};
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvSweepPrune
+{
+public:
+    // constructor/destructor
+    IvSweepPrune();
+    ~IvSweepPrune();
+
+    // proxies -- box coordinates must be less than FLT_MAX in magnitude
+    int CreateProxy( const IvAABB& box, void* userData );
+    // add many proxies at once, sorting rather than inserting one by one
+    void CreateProxies( int* proxies, const IvAABB* boxes, void* const* userData,
+                        unsigned int count );
+    // the proxy index is not reused until after the next UpdatePairs()
+    void DestroyProxy( int proxy );
+    void MoveProxy( int proxy, const IvAABB& box );
+    // move many proxies at once, faster when most of them are moving
+    void MoveProxies( const int* proxies, const IvAABB* boxes, unsigned int count );
+    void Clear();
+
+    // collect the pair changes since the last call
+    void UpdatePairs();
+
+    // accessors
+    inline void* GetUserData( int proxy ) const   { return mProxies[proxy].userData; }
+    inline unsigned int GetProxyCount() const     { return mProxyCount; }
+    IvAABB GetBox( int proxy ) const;
+    // sorted endpoint values on an axis, including a sentinel at each end
+    inline unsigned int GetEndpointCount() const  { return mValues[0] ? 2*mProxyCount + 2 : 0; }
+    inline const float* GetEndpoints( unsigned int axis ) const { return mValues[axis]; }
+
+    // overlapping pairs as of the last UpdatePairs(), in no particular order
+    inline unsigned int GetPairCount() const      { return mPairCount; }
+    inline const IvProxyPair* GetPairs() const    { return mPairs; }
+    // pairs that began or ended overlapping during the last UpdatePairs()
+    inline unsigned int GetBeginCount() const     { return mBeginCount; }
+    inline const IvProxyPair* GetBeginPairs() const { return mBeginPairs; }
+    inline unsigned int GetEndCount() const       { return mEndCount; }
+    inline const IvProxyPair* GetEndPairs() const { return mEndPairs; }
+
+    // check sort order and pairs against brute force (debug builds)
+    void Validate() const;
+
+private:
+    // copy operations (unimplemented so we can't copy)
+    IvSweepPrune( const IvSweepPrune& other );
+    IvSweepPrune& operator=( const IvSweepPrune& other );
+
+    int AllocateProxy();
+    void ReserveEndpoints( unsigned int numProxies );
+
+    // move one endpoint into place, updating pairs as it passes others
+    void SortMinDown( unsigned int axis, unsigned int index, bool updatePairs );
+    void SortMinUp( unsigned int axis, unsigned int index, bool updatePairs );
+    void SortMaxDown( unsigned int axis, unsigned int index, bool updatePairs );
+    void SortMaxUp( unsigned int axis, unsigned int index, bool updatePairs );
+    inline bool Overlap( int proxyA, int proxyB ) const;
+
+    // persistent pair set
+    int FindPair( int proxyA, int proxyB ) const;
+    void AddPair( int proxyA, int proxyB );
+    void RemovePair( int proxyA, int proxyB );
+    void TouchPair( int pair );
+    void ErasePair( int pair );
+    void ResizeHash( unsigned int size );
+
+    IvSweepPruneProxy*  mProxies;           // proxy pool
+    unsigned int        mProxyCapacity;     // size of proxy pool
+    unsigned int        mProxyCount;        // proxies in use
+    int                 mFreeList;          // first free proxy, -1 if none
+    int*                mPendingFree;       // destroyed since the last UpdatePairs()
+    unsigned int        mPendingCount;
+
+    float*              mValues[3];         // endpoint values on each axis
+    unsigned int*       mOwners[3];         // endpoint proxy << 1 | 1 for max
+    unsigned int*       mPositions[3];      // endpoint index, by owner
+    unsigned int        mEndpointCapacity;  // size of endpoint arrays
+
+    IvProxyPair*        mPairs;             // pair set, dense
+    unsigned char*      mPairFlags;         // pair state, parallel to mPairs
+    unsigned int        mPairCount;
+    unsigned int        mPairCapacity;
+    int*                mHash;              // open addressed indices into mPairs
+    unsigned int        mHashSize;          // power of two
+    int*                mTouched;           // pairs changed since the last UpdatePairs()
+    unsigned int        mTouchedCount;
+
+    IvProxyPair*        mBeginPairs;        // events from the last UpdatePairs()
+    unsigned int        mBeginCount;
+    IvProxyPair*        mEndPairs;
+    unsigned int        mEndCount;
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,257 @@
+//===============================================================================
+// @ IvTimeOfImpact.cpp
+//
+// Continuous collision detection for moving spheres and capsules
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvTimeOfImpact.h"
+#include "IvAABBTree.h"
+#include "IvBoundingSphere.h"
+#include "IvCapsule.h"
+#include <IvAssert.h>
+#include <IvLineSegment3.h>
+#include <IvMath.h>
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// most conservative advancement steps; if reached, the time so far is
+// returned, which is still no later than the impact
+static const unsigned int kMaxIterations = 128;
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ MovePoint()
+//-------------------------------------------------------------------------------
+// Where a point of the object is after time t
+//-------------------------------------------------------------------------------
+static IvVector3
+MovePoint( const IvVector3& point, const IvRigidMotion& motion, float t )
+{
+    IvVector3 offset = point - motion.center;
+    float speedSq = motion.angularVelocity.LengthSquared();
+    if ( speedSq > 0.0f )
+    {
+        // rotate offset about the axis (Rodrigues' formula)
+        float speed = ::IvSqrt( speedSq );
+        IvVector3 axis = (1.0f/speed)*motion.angularVelocity;
+        float sinAngle, cosAngle;
+        ::IvSinCos( speed*t, sinAngle, cosAngle );
+        offset = cosAngle*offset + sinAngle*axis.Cross( offset )
+               + ((1.0f - cosAngle)*axis.Dot( offset ))*axis;
+    }
+
+    return motion.center + t*motion.velocity + offset;
+
+}   // End of MovePoint()
+
+
+//-------------------------------------------------------------------------------
+// @ MaxOffset()
+//-------------------------------------------------------------------------------
+// Distance from the center of rotation to the farthest point of the
+// capsule's segment
+//-------------------------------------------------------------------------------
+static float
+MaxOffset( const IvCapsule& capsule, const IvRigidMotion& motion )
+{
+    const IvLineSegment3& segment = capsule.GetSegment();
+    float distanceSq0 = ::DistanceSquared( segment.GetEndpoint0(), motion.center );
+    float distanceSq1 = ::DistanceSquared( segment.GetEndpoint1(), motion.center );
+
+    return ::IvSqrt( distanceSq0 > distanceSq1 ? distanceSq0 : distanceSq1 );
+
+}   // End of MaxOffset()
+
+
+//-------------------------------------------------------------------------------
+// @ ::TimeOfImpact()
+//-------------------------------------------------------------------------------
+// Solve for the time the distance between centers reaches the sum of radii
+//-------------------------------------------------------------------------------
+bool
+TimeOfImpact( float& time,
+              const IvBoundingSphere& sphere0, const IvVector3& velocity0,
+              const IvBoundingSphere& sphere1, const IvVector3& velocity1,
+              float maxTime )
+{
+    // relative to sphere0
+    IvVector3 offset = sphere1.GetCenter() - sphere0.GetCenter();
+    IvVector3 velocity = velocity1 - velocity0;
+    float radiusSum = sphere0.GetRadius() + sphere1.GetRadius();
+
+    // already overlapping
+    float c = offset.Dot( offset ) - radiusSum*radiusSum;
+    if ( c <= 0.0f )
+    {
+        time = 0.0f;
+        return true;
+    }
+
+    // moving apart
+    float b = offset.Dot( velocity );
+    if ( b >= 0.0f )
+        return false;
+
+    // first root of |offset + t*velocity|^2 = radiusSum^2
+    float a = velocity.Dot( velocity );
+    float discriminant = b*b - a*c;
+    if ( discriminant < 0.0f )
+        return false;
+    float t = (-b - ::IvSqrt( discriminant ))/a;
+    if ( t > maxTime )
+        return false;
+
+    time = t;
+    return true;
+
+}   // End of ::TimeOfImpact()
+
+
+//-------------------------------------------------------------------------------
+// @ ::TimeOfImpact()
+//-------------------------------------------------------------------------------
+// Conservative advancement.  The plane through the closest points separates
+// the capsules' segments by their distance, and no point of a segment can
+// approach it faster than its velocity along the normal, plus its angular
+// speed times the segment's farthest point from the center of rotation.
+//-------------------------------------------------------------------------------
+bool
+TimeOfImpact( float& time,
+              const IvCapsule& capsule0, const IvRigidMotion& motion0,
+              const IvCapsule& capsule1, const IvRigidMotion& motion1,
+              float maxTime, float tolerance )
+{
+    ASSERT( tolerance > 0.0f );
+
+    float radiusSum = capsule0.GetRadius() + capsule1.GetRadius();
+    float angularBound = motion0.angularVelocity.Length()*MaxOffset( capsule0, motion0 )
+                       + motion1.angularVelocity.Length()*MaxOffset( capsule1, motion1 );
+    IvVector3 relativeVelocity = motion0.velocity - motion1.velocity;
+    const IvLineSegment3& segment0 = capsule0.GetSegment();
+    const IvLineSegment3& segment1 = capsule1.GetSegment();
+
+    float t = 0.0f;
+    for ( unsigned int i = 0; i < kMaxIterations; ++i )
+    {
+        // segments at time t
+        IvLineSegment3 moved0( MovePoint( segment0.GetEndpoint0(), motion0, t ),
+                               MovePoint( segment0.GetEndpoint1(), motion0, t ) );
+        IvLineSegment3 moved1( MovePoint( segment1.GetEndpoint0(), motion1, t ),
+                               MovePoint( segment1.GetEndpoint1(), motion1, t ) );
+        float s, u;
+        float distanceSq = ::DistanceSquared( moved0, moved1, s, u );
+        float distance = ::IvSqrt( distanceSq );
+        if ( distance - radiusSum <= tolerance )
+        {
+            time = t;
+            return true;
+        }
+
+        // fastest the gap can close
+        IvVector3 normal = (moved1.GetOrigin() + u*moved1.GetDirection())
+                         - (moved0.GetOrigin() + s*moved0.GetDirection());
+        float closingSpeed = relativeVelocity.Dot( normal )/distance + angularBound;
+        if ( closingSpeed <= 0.0f )
+            return false;
+
+        t += (distance - radiusSum)/closingSpeed;
+        if ( t > maxTime )
+            return false;
+    }
+
+    time = t;
+    return true;
+
+}   // End of ::TimeOfImpact()
+
+
+//-------------------------------------------------------------------------------
+// @ ::EarliestTimeOfImpact()
+//-------------------------------------------------------------------------------
+// Earliest impact between pairs of spheres.  Each pair only has to beat the
+// earliest time so far.
+//-------------------------------------------------------------------------------
+unsigned int
+EarliestTimeOfImpact( float& time,
+                      const IvBoundingSphere* spheres, const IvVector3* velocities,
+                      const IvProxyPair* pairs, unsigned int count, float maxTime )
+{
+    unsigned int earliest = count;
+    time = maxTime;
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        int a = pairs[i].proxyA;
+        int b = pairs[i].proxyB;
+        float t;
+        if ( TimeOfImpact( t, spheres[a], velocities[a], spheres[b], velocities[b], time )
+             && (earliest == count || t < time) )
+        {
+            time = t;
+            earliest = i;
+            if ( t <= 0.0f )
+                break;
+        }
+    }
+
+    return earliest;
+
+}   // End of ::EarliestTimeOfImpact()
+
+
+//-------------------------------------------------------------------------------
+// @ ::EarliestTimeOfImpact()
+//-------------------------------------------------------------------------------
+// Earliest impact between pairs of capsules.  Spheres around each capsule's
+// sweep rule out most pairs before conservative advancement is needed.
+//-------------------------------------------------------------------------------
+unsigned int
+EarliestTimeOfImpact( float& time,
+                      const IvCapsule* capsules, const IvRigidMotion* motions,
+                      const IvProxyPair* pairs, unsigned int count,
+                      float maxTime, float tolerance )
+{
+    unsigned int earliest = count;
+    time = maxTime;
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        int a = pairs[i].proxyA;
+        int b = pairs[i].proxyB;
+
+        // spheres around each capsule, centered on its center of rotation
+        IvBoundingSphere sphereA( motions[a].center,
+                                  MaxOffset( capsules[a], motions[a] ) + capsules[a].GetRadius() );
+        IvBoundingSphere sphereB( motions[b].center,
+                                  MaxOffset( capsules[b], motions[b] ) + capsules[b].GetRadius() );
+        float t;
+        if ( !TimeOfImpact( t, sphereA, motions[a].velocity, sphereB, motions[b].velocity, time ) )
+            continue;
+
+        if ( TimeOfImpact( t, capsules[a], motions[a], capsules[b], motions[b], time, tolerance )
+             && (earliest == count || t < time) )
+        {
+            time = t;
+            earliest = i;
+            if ( t <= 0.0f )
+                break;
+        }
+    }
+
+    return earliest;
+
+}   // End of ::EarliestTimeOfImpact()
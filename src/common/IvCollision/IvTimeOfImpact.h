@@ -0,0 +1,79 @@
+//===============================================================================
+// @ IvTimeOfImpact.h
+//
+// Continuous collision detection for moving spheres and capsules
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Finds the first time in a step at which two moving objects touch, so a
+// simulation can stop there rather than let fast objects pass through
+// each other.  Velocities are taken as constant over the step.  Spheres
+// are solved directly.  Capsules use conservative advancement: the
+// distance between them is divided by a bound on how fast they can close
+// it, and time is advanced by that much until they are within tolerance.
+// The time found is never after the real time of impact.
+//
+//===============================================================================
+
+#ifndef __IvTimeOfImpact__h__
+#define __IvTimeOfImpact__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <IvVector3.h>
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvBoundingSphere;
+class IvCapsule;
+struct IvProxyPair;
+
+// rigid motion over a step: the object turns at angularVelocity (radians
+// per unit time, about its direction) around center, while center moves
+// at velocity
+struct IvRigidMotion
+{
+    IvVector3   center;
+    IvVector3   velocity;
+    IvVector3   angularVelocity;
+};
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// first time in [0, maxTime] the moving spheres touch.  Returns false if
+// they don't, and time 0 if they already overlap.
+bool TimeOfImpact( float& time,
+                   const IvBoundingSphere& sphere0, const IvVector3& velocity0,
+                   const IvBoundingSphere& sphere1, const IvVector3& velocity1,
+                   float maxTime );
+
+// first time in [0, maxTime] the moving capsules come within tolerance of
+// each other.  Returns false if they don't.
+bool TimeOfImpact( float& time,
+                   const IvCapsule& capsule0, const IvRigidMotion& motion0,
+                   const IvCapsule& capsule1, const IvRigidMotion& motion1,
+                   float maxTime, float tolerance );
+
+// earliest time of impact over count pairs from a broad phase.  Returns
+// the index of the pair, or count if none touch before maxTime, in which
+// case time is maxTime.
+unsigned int EarliestTimeOfImpact( float& time,
+                                   const IvBoundingSphere* spheres, const IvVector3* velocities,
+                                   const IvProxyPair* pairs, unsigned int count,
+                                   float maxTime );
+unsigned int EarliestTimeOfImpact( float& time,
+                                   const IvCapsule* capsules, const IvRigidMotion* motions,
+                                   const IvProxyPair* pairs, unsigned int count,
+                                   float maxTime, float tolerance );
+
+#endif
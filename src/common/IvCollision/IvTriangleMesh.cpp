@@ -0,0 +1,546 @@
+//===============================================================================
+// @ IvTriangleMesh.cpp
+//
+// Triangle mesh with a bounding volume hierarchy, for collision queries
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvTriangleMesh.h"
+#include "IvBoundingSphere.h"
+#include "IvCapsule.h"
+#include <IvAssert.h>
+#include <IvLineSegment3.h>
+#include <IvMath.h>
+#include <IvRay3.h>
+#include <IvTriangle.h>
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ ClosestPoint()
+//-------------------------------------------------------------------------------
+// Point on triangle P0P1P2 closest to point, found from the Voronoi region
+// of the triangle that the point lies in
+//-------------------------------------------------------------------------------
+static IvVector3
+ClosestPoint( const IvVector3& point, const IvVector3& P0, const IvVector3& P1,
+              const IvVector3& P2 )
+{
+    IvVector3 e1 = P1 - P0;
+    IvVector3 e2 = P2 - P0;
+
+    // vertex P0
+    IvVector3 w0 = point - P0;
+    float d1 = e1.Dot( w0 );
+    float d2 = e2.Dot( w0 );
+    if ( d1 <= 0.0f && d2 <= 0.0f )
+        return P0;
+
+    // vertex P1
+    IvVector3 w1 = point - P1;
+    float d3 = e1.Dot( w1 );
+    float d4 = e2.Dot( w1 );
+    if ( d3 >= 0.0f && d4 <= d3 )
+        return P1;
+
+    // edge P0P1
+    float vc = d1*d4 - d3*d2;
+    if ( vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f )
+        return P0 + (d1/(d1 - d3))*e1;
+
+    // vertex P2
+    IvVector3 w2 = point - P2;
+    float d5 = e1.Dot( w2 );
+    float d6 = e2.Dot( w2 );
+    if ( d6 >= 0.0f && d5 <= d6 )
+        return P2;
+
+    // edge P0P2
+    float vb = d5*d2 - d1*d6;
+    if ( vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f )
+        return P0 + (d2/(d2 - d6))*e2;
+
+    // edge P1P2
+    float va = d3*d6 - d5*d4;
+    if ( va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f )
+        return P1 + ((d4 - d3)/((d4 - d3) + (d5 - d6)))*(P2 - P1);
+
+    // inside the face
+    float denom = 1.0f/(va + vb + vc);
+    return P0 + (vb*denom)*e1 + (vc*denom)*e2;
+
+}   // End of ClosestPoint()
+
+
+//-------------------------------------------------------------------------------
+// @ ClosestPoints()
+//-------------------------------------------------------------------------------
+// Closest points between a segment and triangle P0P1P2.  Returns the
+// squared distance, which is 0 if the segment passes through the triangle.
+//-------------------------------------------------------------------------------
+static float
+ClosestPoints( IvVector3& onSegment, IvVector3& onTriangle, const IvLineSegment3& segment,
+               const IvVector3& P0, const IvVector3& P1, const IvVector3& P2 )
+{
+    const IvVector3 endpoint0 = segment.GetEndpoint0();
+    const IvVector3 endpoint1 = segment.GetEndpoint1();
+
+    // crossing the plane inside the triangle
+    IvVector3 normal = (P1 - P0).Cross( P2 - P0 );
+    float side0 = normal.Dot( endpoint0 - P0 );
+    float side1 = normal.Dot( endpoint1 - P0 );
+    if ( (side0 < 0.0f && side1 > 0.0f) || (side0 > 0.0f && side1 < 0.0f) )
+    {
+        IvVector3 crossing = endpoint0 + (side0/(side0 - side1))*segment.GetDirection();
+        if ( ::IsPointInTriangle( crossing, P0, P1, P2 ) )
+        {
+            onSegment = crossing;
+            onTriangle = crossing;
+            return 0.0f;
+        }
+    }
+
+    // otherwise the nearest is at an endpoint or against an edge
+    onSegment = endpoint0;
+    onTriangle = ClosestPoint( endpoint0, P0, P1, P2 );
+    float bestSq = ::DistanceSquared( onSegment, onTriangle );
+
+    IvVector3 candidate = ClosestPoint( endpoint1, P0, P1, P2 );
+    float distanceSq = ::DistanceSquared( endpoint1, candidate );
+    if ( distanceSq < bestSq )
+    {
+        bestSq = distanceSq;
+        onSegment = endpoint1;
+        onTriangle = candidate;
+    }
+
+    const IvVector3* vertices[4] = { &P0, &P1, &P2, &P0 };
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        IvLineSegment3 edge( *vertices[i], *vertices[i+1] );
+        IvVector3 point0, point1;
+        ClosestPoints( point0, point1, segment, edge );
+        distanceSq = ::DistanceSquared( point0, point1 );
+        if ( distanceSq < bestSq )
+        {
+            bestSq = distanceSq;
+            onSegment = point0;
+            onTriangle = point1;
+        }
+    }
+
+    return bestSq;
+
+}   // End of ClosestPoints()
+
+
+//-------------------------------------------------------------------------------
+// @ SetContact()
+//-------------------------------------------------------------------------------
+// Contact between the triangle and a sphere of radius around center, given
+// the closest point on the triangle.  Returns false if they don't touch.
+//-------------------------------------------------------------------------------
+static bool
+SetContact( IvMeshContact& contact, const IvVector3& onTriangle, const IvVector3& center,
+            float radius, const IvVector3& P0, const IvVector3& P1, const IvVector3& P2 )
+{
+    IvVector3 offset = center - onTriangle;
+    float distanceSq = offset.LengthSquared();
+    if ( distanceSq > radius*radius )
+        return false;
+
+    float distance = ::IvSqrt( distanceSq );
+    if ( ::IvIsZero( distance ) )
+    {
+        // center is on the triangle -- push out along the face normal
+        contact.normal = (P1 - P0).Cross( P2 - P0 );
+        contact.normal.Normalize();
+    }
+    else
+    {
+        contact.normal = (1.0f/distance)*offset;
+    }
+    contact.point = onTriangle;
+    contact.penetration = radius - distance;
+
+    return true;
+
+}   // End of SetContact()
+
+
+namespace
+{
+
+// sphere against the triangles
+struct IvMeshSphereQuery
+{
+    inline bool TestNode( const IvBVHNode& node ) const
+    {
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            if ( node.minima[i] > mMaxima[i] || node.maxima[i] < mMinima[i] )
+                return false;
+        }
+        return true;
+    }
+    inline bool Contact( IvMeshContact& contact, const IvVector3& P0, const IvVector3& P1,
+                         const IvVector3& P2 ) const
+    {
+        IvVector3 onTriangle = ClosestPoint( mSphere.GetCenter(), P0, P1, P2 );
+        return SetContact( contact, onTriangle, mSphere.GetCenter(), mSphere.GetRadius(),
+                           P0, P1, P2 );
+    }
+
+    const IvBoundingSphere& mSphere;
+    float                   mMinima[3];
+    float                   mMaxima[3];
+};
+
+// capsule against the triangles
+struct IvMeshCapsuleQuery
+{
+    inline bool TestNode( const IvBVHNode& node ) const
+    {
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            if ( node.minima[i] > mMaxima[i] || node.maxima[i] < mMinima[i] )
+                return false;
+        }
+        return true;
+    }
+    inline bool Contact( IvMeshContact& contact, const IvVector3& P0, const IvVector3& P1,
+                         const IvVector3& P2 ) const
+    {
+        const IvLineSegment3& segment = mCapsule.GetSegment();
+        IvVector3 onSegment, onTriangle;
+        if ( ClosestPoints( onSegment, onTriangle, segment, P0, P1, P2 ) > 0.0f )
+            return SetContact( contact, onTriangle, onSegment, mCapsule.GetRadius(), P0, P1, P2 );
+
+        // segment passes through -- push out along the face normal, towards
+        // the endpoint further from the plane, by enough to clear the other
+        IvVector3 normal = (P1 - P0).Cross( P2 - P0 );
+        normal.Normalize();
+        float side0 = normal.Dot( segment.GetEndpoint0() - P0 );
+        float side1 = normal.Dot( segment.GetEndpoint1() - P0 );
+        float depth = side0 < 0.0f ? -side0 : side0;
+        if ( ::IvAbs( side1 ) > depth )
+        {
+            contact.normal = side1 < 0.0f ? -normal : normal;
+        }
+        else
+        {
+            contact.normal = side0 < 0.0f ? -normal : normal;
+            depth = ::IvAbs( side1 );
+        }
+        contact.point = onTriangle;
+        contact.penetration = mCapsule.GetRadius() + depth;
+        return true;
+    }
+
+    const IvCapsule&    mCapsule;
+    float               mMinima[3];
+    float               mMaxima[3];
+};
+
+}
+
+//-------------------------------------------------------------------------------
+// @ Collide()
+//-------------------------------------------------------------------------------
+// Depth-first walk of the tree, writing a contact for each triangle touched
+//-------------------------------------------------------------------------------
+template <class Query>
+static unsigned int
+Collide( IvMeshContact* contacts, unsigned int maxContacts, const Query& query,
+         const IvBVH& bvh, const IvTriangleStream& triangles )
+{
+    ASSERT( contacts || maxContacts == 0 );
+
+    const IvBVHNode* nodes = bvh.GetNodes();
+    const unsigned int* indices = bvh.GetIndices();
+    if ( bvh.GetNodeCount() == 0 || !query.TestNode( nodes[0] ) )
+        return 0;
+
+    unsigned int stack[IvBVH::kMaxDepth];
+    unsigned int stackSize = 0;
+    unsigned int numContacts = 0;
+    unsigned int current = 0;
+    for ( ;; )
+    {
+        const IvBVHNode& node = nodes[current];
+        if ( node.IsLeaf() )
+        {
+            unsigned int last = node.offset + node.count;
+            for ( unsigned int i = node.offset; i < last; ++i )
+            {
+                if ( numContacts == maxContacts )
+                    return numContacts;
+
+                IvVector3 P0, P1, P2;
+                triangles.Get( indices[i], P0, P1, P2 );
+                if ( query.Contact( contacts[numContacts], P0, P1, P2 ) )
+                {
+                    contacts[numContacts].triangle = indices[i];
+                    ++numContacts;
+                }
+            }
+        }
+        else
+        {
+            unsigned int left = current + 1;
+            unsigned int right = node.offset;
+            bool hitLeft = query.TestNode( nodes[left] );
+            bool hitRight = query.TestNode( nodes[right] );
+            if ( hitLeft )
+            {
+                if ( hitRight )
+                    stack[stackSize++] = right;
+                current = left;
+                continue;
+            }
+            if ( hitRight )
+            {
+                current = right;
+                continue;
+            }
+        }
+
+        if ( stackSize == 0 )
+            break;
+        current = stack[--stackSize];
+    }
+
+    return numContacts;
+
+}   // End of Collide()
+
+
+//-------------------------------------------------------------------------------
+// @ RayTest()
+//-------------------------------------------------------------------------------
+// Nearest-hit test for IvBVH::Intersect(), userData is the triangle stream
+//-------------------------------------------------------------------------------
+static bool
+RayTest( float& t, unsigned int index, const IvRay3& ray, void* userData )
+{
+    const IvTriangleStream* triangles = static_cast<const IvTriangleStream*>( userData );
+    IvVector3 P0, P1, P2;
+    triangles->Get( index, P0, P1, P2 );
+
+    float hitT;
+    if ( !::TriangleIntersect( hitT, P0, P1, P2, ray ) || hitT >= t )
+        return false;
+
+    t = hitT;
+    return true;
+
+}   // End of RayTest()
+
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleMesh::IvTriangleMesh()
+//-------------------------------------------------------------------------------
+// Default constructor -- empty mesh
+//-------------------------------------------------------------------------------
+IvTriangleMesh::IvTriangleMesh() :
+    mIndices( 0 ),
+    mVertexCount( 0 ),
+    mBoxes( 0 )
+{
+}   // End of IvTriangleMesh::IvTriangleMesh()
+
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleMesh::~IvTriangleMesh()
+//-------------------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------------------
+IvTriangleMesh::~IvTriangleMesh()
+{
+    Clear();
+
+}   // End of IvTriangleMesh::~IvTriangleMesh()
+
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleMesh::Set()
+//-------------------------------------------------------------------------------
+// Copy in the triangles and build the tree over them
+//-------------------------------------------------------------------------------
+void
+IvTriangleMesh::Set( const IvVector3* positions, unsigned int numVertices,
+                     const UInt32* indices, unsigned int numIndices )
+{
+    ASSERT( numIndices % 3 == 0 );
+    Clear();
+    if ( numIndices == 0 )
+        return;
+    ASSERT( positions && indices );
+
+    mVertexCount = numVertices;
+    mIndices = new UInt32[numIndices];
+    for ( unsigned int i = 0; i < numIndices; ++i )
+    {
+        ASSERT( indices[i] < numVertices );
+        mIndices[i] = indices[i];
+    }
+
+    unsigned int numTriangles = numIndices/3;
+    mTriangles.Set( positions, mIndices, numTriangles );
+    mBoxes = new IvAABB[numTriangles];
+    ComputeBoxes();
+    mBVH.Build( mBoxes, numTriangles );
+
+}   // End of IvTriangleMesh::Set()
+
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleMesh::Clear()
+//-------------------------------------------------------------------------------
+// Release the triangles and tree
+//-------------------------------------------------------------------------------
+void
+IvTriangleMesh::Clear()
+{
+    mBVH.Clear();
+    mTriangles.Resize( 0 );
+
+    delete [] mIndices;
+    delete [] mBoxes;
+
+    mIndices = 0;
+    mVertexCount = 0;
+    mBoxes = 0;
+
+}   // End of IvTriangleMesh::Clear()
+
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleMesh::SetPositions()
+//-------------------------------------------------------------------------------
+// New vertex positions for the same triangles
+//-------------------------------------------------------------------------------
+void
+IvTriangleMesh::SetPositions( const IvVector3* positions )
+{
+    unsigned int numTriangles = mTriangles.GetCount();
+    if ( numTriangles == 0 )
+        return;
+    ASSERT( positions );
+
+    mTriangles.Set( positions, mIndices, numTriangles );
+    ComputeBoxes();
+    mBVH.Refit( mBoxes );
+
+}   // End of IvTriangleMesh::SetPositions()
+
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleMesh::ComputeBoxes()
+//-------------------------------------------------------------------------------
+// Box around each triangle
+//-------------------------------------------------------------------------------
+void
+IvTriangleMesh::ComputeBoxes()
+{
+    unsigned int numTriangles = mTriangles.GetCount();
+    for ( unsigned int i = 0; i < numTriangles; ++i )
+    {
+        IvVector3 points[3];
+        mTriangles.Get( i, points[0], points[1], points[2] );
+        mBoxes[i].Set( points, 3 );
+    }
+
+}   // End of IvTriangleMesh::ComputeBoxes()
+
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleMesh::ComputeCollision()
+//-------------------------------------------------------------------------------
+// Contacts with a sphere
+//-------------------------------------------------------------------------------
+unsigned int
+IvTriangleMesh::ComputeCollision( IvMeshContact* contacts, unsigned int maxContacts,
+                                  const IvBoundingSphere& sphere ) const
+{
+    const IvVector3& center = sphere.GetCenter();
+    float radius = sphere.GetRadius();
+    IvMeshSphereQuery query = { sphere,
+                                { center.x - radius, center.y - radius, center.z - radius },
+                                { center.x + radius, center.y + radius, center.z + radius } };
+
+    return Collide( contacts, maxContacts, query, mBVH, mTriangles );
+
+}   // End of IvTriangleMesh::ComputeCollision()
+
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleMesh::ComputeCollision()
+//-------------------------------------------------------------------------------
+// Contacts with a capsule
+//-------------------------------------------------------------------------------
+unsigned int
+IvTriangleMesh::ComputeCollision( IvMeshContact* contacts, unsigned int maxContacts,
+                                  const IvCapsule& capsule ) const
+{
+    // box around the segment, grown by the radius
+    IvVector3 endpoints[2] = { capsule.GetSegment().GetEndpoint0(),
+                               capsule.GetSegment().GetEndpoint1() };
+    IvAABB box;
+    box.Set( endpoints, 2 );
+    IvVector3 minima = box.GetMinima();
+    IvVector3 maxima = box.GetMaxima();
+    float radius = capsule.GetRadius();
+    IvMeshCapsuleQuery query = { capsule,
+                                 { minima.x - radius, minima.y - radius, minima.z - radius },
+                                 { maxima.x + radius, maxima.y + radius, maxima.z + radius } };
+
+    return Collide( contacts, maxContacts, query, mBVH, mTriangles );
+
+}   // End of IvTriangleMesh::ComputeCollision()
+
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleMesh::Intersect()
+//-------------------------------------------------------------------------------
+// Nearest hit along a ray
+//-------------------------------------------------------------------------------
+bool
+IvTriangleMesh::Intersect( IvTriangleHit& hit, const IvRay3& ray ) const
+{
+    float t = hit.t;
+    unsigned int index;
+    IvTriangleStream* triangles = const_cast<IvTriangleStream*>( &mTriangles );
+    if ( !mBVH.Intersect( t, index, ray, RayTest, triangles ) )
+        return false;
+
+    IvVector3 P0, P1, P2;
+    mTriangles.Get( index, P0, P1, P2 );
+    IvVector3 point = ray.GetOrigin() + t*ray.GetDirection();
+    ::BarycentricCoordinates( hit.r, hit.s, hit.u, point, P0, P1, P2 );
+    hit.t = t;
+    hit.index = (int) index;
+
+    return true;
+
+}   // End of IvTriangleMesh::Intersect()
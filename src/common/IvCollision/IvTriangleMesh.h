@@ -0,0 +1,109 @@
+//===============================================================================
+// @ IvTriangleMesh.h
+//
+// Triangle mesh with a bounding volume hierarchy, for collision queries
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Keeps a CPU-side copy of an indexed triangle list, with an IvBVH over the
+// triangles' boxes, so objects can collide against the mesh itself rather
+// than a bounding volume around it.  When the vertices move, the tree is
+// refit in place rather than rebuilt.
+//
+//===============================================================================
+
+#ifndef __IvTriangleMesh__h__
+#define __IvTriangleMesh__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <IvTriangleStream.h>
+#include <IvTypes.h>
+#include "IvBVH.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvBoundingSphere;
+class IvCapsule;
+class IvRay3;
+struct IvTriangleHit;
+
+// contact between a triangle of the mesh and another shape
+struct IvMeshContact
+{
+    IvVector3       point;          // closest point on the triangle
+    IvVector3       normal;         // from the mesh to the other shape
+    float           penetration;
+    unsigned int    triangle;
+};
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvTriangleMesh
+{
+public:
+    // constructor/destructor
+    IvTriangleMesh();
+    ~IvTriangleMesh();
+
+    // copy in an indexed triangle list and build the tree
+    void Set( const IvVector3* positions, unsigned int numVertices,
+              const UInt32* indices, unsigned int numIndices );
+    void Clear();
+
+    // move the vertices, e.g. when the mesh deforms, and refit the tree.
+    // positions must have as many vertices as the mesh was built with.
+    void SetPositions( const IvVector3* positions );
+
+    // accessors
+    inline unsigned int GetVertexCount() const      { return mVertexCount; }
+    inline unsigned int GetTriangleCount() const    { return mTriangles.GetCount(); }
+    inline const IvTriangleStream& GetTriangles() const { return mTriangles; }
+    inline const IvBVH& GetBVH() const              { return mBVH; }
+    inline void GetTriangle( unsigned int i, IvVector3& P0, IvVector3& P1, IvVector3& P2 ) const
+                                                    { mTriangles.Get( i, P0, P1, P2 ); }
+
+    // collision parameters -- write a contact for each triangle the shape
+    // touches to contacts, up to maxContacts, and return the number written
+    unsigned int ComputeCollision( IvMeshContact* contacts, unsigned int maxContacts,
+                                   const IvBoundingSphere& sphere ) const;
+    unsigned int ComputeCollision( IvMeshContact* contacts, unsigned int maxContacts,
+                                   const IvCapsule& capsule ) const;
+
+    // nearest triangle hit by the ray.  As with the batched TriangleIntersect(),
+    // hit is only replaced by a nearer one.
+    bool Intersect( IvTriangleHit& hit, const IvRay3& ray ) const;
+
+private:
+    // copy operations (unimplemented so we can't copy)
+    IvTriangleMesh( const IvTriangleMesh& other );
+    IvTriangleMesh& operator=( const IvTriangleMesh& other );
+
+    void ComputeBoxes();
+
+    IvTriangleStream    mTriangles;     // triangles, in index order
+    UInt32*             mIndices;       // three per triangle
+    unsigned int        mVertexCount;
+    IvAABB*             mBoxes;         // box around each triangle
+    IvBVH               mBVH;
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
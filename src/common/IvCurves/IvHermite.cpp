@@ -183,15 +183,29 @@ IvHermite::InitializeClamped( const IvVector3* positions,
     }
     A[n*n-1] = 1.0f;
     
-    // invert it
-    // we'd might get better accuracy if we solve the linear system 3 times,
-    // once each for x, y, and z, but this is more efficient
-    if (!::InvertMatrix( A, n ))
+    // factor it once, then solve for x, y, and z
+    unsigned int* pivots = new unsigned int[n];
+    if (!::LUFactor( A, pivots, n ))
     {
+        delete [] pivots;
         delete [] A;
         return false;
     }
 
+    // build b, one column per coordinate
+    float* b = new float[3*n];
+    for ( unsigned int k = 0; k < 3; ++k )
+    {
+        float* column = b + k*n;
+        column[0] = outTangent[k];
+        for ( i = 1; i < n-1; ++i )
+        {
+            column[i] = 3.0f*(positions[i+1][k]-positions[i-1][k]);
+        }
+        column[n-1] = inTangent[k];
+    }
+    ::LUSolve( b, A, pivots, n, 3 );
+
     // set up arrays
     mPositions = new IvVector3[count];
     mInTangents = new IvVector3[count-1];
@@ -214,13 +228,8 @@ IvHermite::InitializeClamped( const IvVector3* positions,
         mPositions[i] = positions[i];
         mTimes[i] = times[i];
 
-        // multiply b by inverse of A to get x
-        mOutTangents[i] = A[i]*outTangent + A[i + n*n-n]*inTangent;
-        for ( UInt32 j = 1; j < n-1; ++j )
-        {
-            IvVector3 b_j = 3.0f*(positions[j+1]-positions[j-1]);
-            mOutTangents[i] += A[i + n*j]*b_j;
-        }
+        // out tangent is the solution x
+        mOutTangents[i].Set( b[i], b[i + n], b[i + 2*n] );
 
         // in tangent is out tangent of next segment
         mInTangents[i-1] = mOutTangents[i];
@@ -235,6 +244,8 @@ IvHermite::InitializeClamped( const IvVector3* positions,
         mTotalLength += mLengths[i];
     }
 
+    delete [] b;
+    delete [] pivots;
     delete [] A;
 
     (void) RebuildVertexBuffers();
@@ -0,0 +1,318 @@
+//===============================================================================
+// @ IvAffine34.cpp
+//
+// 3x4 affine transform class
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvAffine34.h"
+#include "IvMath.h"
+#include "IvMatrix33.h"
+#include "IvMatrix44.h"
+#include "IvQuat.h"
+#include "IvVector3.h"
+
+#include "IvAssert.h"
+#include "IvDebugger.h"
+
+#if !defined(IV_INLINE_MATH)
+#include "IvAffine34.inl"
+#endif
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::IvAffine34()
+//-------------------------------------------------------------------------------
+// Scale, rotate, translate constructor
+//-------------------------------------------------------------------------------
+IvAffine34::IvAffine34( float scale, const IvQuat& rotate, const IvVector3& translate )
+{
+    (void) Set( scale, rotate, translate );
+
+}   // End of IvAffine34::IvAffine34()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::IvAffine34()
+//-------------------------------------------------------------------------------
+// IvMatrix44 conversion constructor; the bottom row is assumed to be 0 0 0 1
+//-------------------------------------------------------------------------------
+IvAffine34::IvAffine34( const IvMatrix44& matrix )
+{
+    for (unsigned int j = 0; j < 4; ++j)
+    {
+        mV[3*j] = matrix(0, j);
+        mV[3*j+1] = matrix(1, j);
+        mV[3*j+2] = matrix(2, j);
+    }
+
+}   // End of IvAffine34::IvAffine34()
+
+
+//-------------------------------------------------------------------------------
+// @ operator<<()
+//-------------------------------------------------------------------------------
+// Text output for debugging
+//-------------------------------------------------------------------------------
+IvWriter&
+operator<<(IvWriter& out, const IvAffine34& source)
+{
+    // row
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        out << "| ";
+        // column
+        for (unsigned int j = 0; j < 4; ++j )
+        {
+            out << source.mV[ j*3 + i ] << ' ';
+        }
+        out << '|' << eol;
+    }
+
+    return out;
+
+}   // End of operator<<()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::operator==()
+//-------------------------------------------------------------------------------
+// Comparison operator
+//-------------------------------------------------------------------------------
+bool
+IvAffine34::operator==( const IvAffine34& other ) const
+{
+    for (unsigned int i = 0; i < 12; ++i)
+    {
+        if ( !IvAreEqual(mV[i], other.mV[i]) )
+            return false;
+    }
+    return true;
+
+}   // End of IvAffine34::operator==()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::operator!=()
+//-------------------------------------------------------------------------------
+// Comparison operator
+//-------------------------------------------------------------------------------
+bool
+IvAffine34::operator!=( const IvAffine34& other ) const
+{
+    return !(*this == other);
+
+}   // End of IvAffine34::operator!=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::IsIdentity()
+//-------------------------------------------------------------------------------
+// Check for identity transform
+//-------------------------------------------------------------------------------
+bool
+IvAffine34::IsIdentity() const
+{
+    for (unsigned int i = 0; i < 12; ++i)
+    {
+        float expected = (i == 0 || i == 4 || i == 8) ? 1.0f : 0.0f;
+        if ( !IvAreEqual(mV[i], expected) )
+            return false;
+    }
+    return true;
+
+}   // End of IvAffine34::IsIdentity()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::Identity()
+//-------------------------------------------------------------------------------
+// Set to identity transform
+//-------------------------------------------------------------------------------
+void
+IvAffine34::Identity()
+{
+    mV[0] = 1.0f;
+    mV[1] = 0.0f;
+    mV[2] = 0.0f;
+    mV[3] = 0.0f;
+    mV[4] = 1.0f;
+    mV[5] = 0.0f;
+    mV[6] = 0.0f;
+    mV[7] = 0.0f;
+    mV[8] = 1.0f;
+    mV[9] = 0.0f;
+    mV[10] = 0.0f;
+    mV[11] = 0.0f;
+
+}   // End of IvAffine34::Identity()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::Set()
+//-------------------------------------------------------------------------------
+// Set to uniform scale, followed by rotation, followed by translation
+//-------------------------------------------------------------------------------
+IvAffine34&
+IvAffine34::Set( float scale, const IvQuat& rotate, const IvVector3& translate )
+{
+    ASSERT( rotate.IsUnit() );
+
+    float xs, ys, zs, wx, wy, wz, xx, xy, xz, yy, yz, zz;
+
+    xs = rotate.x+rotate.x;
+    ys = rotate.y+rotate.y;
+    zs = rotate.z+rotate.z;
+    wx = rotate.w*xs;
+    wy = rotate.w*ys;
+    wz = rotate.w*zs;
+    xx = rotate.x*xs;
+    xy = rotate.x*ys;
+    xz = rotate.x*zs;
+    yy = rotate.y*ys;
+    yz = rotate.y*zs;
+    zz = rotate.z*zs;
+
+    mV[0] = scale*(1.0f - (yy + zz));
+    mV[3] = scale*(xy - wz);
+    mV[6] = scale*(xz + wy);
+
+    mV[1] = scale*(xy + wz);
+    mV[4] = scale*(1.0f - (xx + zz));
+    mV[7] = scale*(yz - wx);
+
+    mV[2] = scale*(xz - wy);
+    mV[5] = scale*(yz + wx);
+    mV[8] = scale*(1.0f - (xx + yy));
+
+    mV[9] = translate.x;
+    mV[10] = translate.y;
+    mV[11] = translate.z;
+
+    return *this;
+
+}   // End of IvAffine34::Set()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::GetLinear()
+//-------------------------------------------------------------------------------
+// Get the upper 3x3 (rotation and scale) part
+//-------------------------------------------------------------------------------
+void
+IvAffine34::GetLinear( IvMatrix33& matrix ) const
+{
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+        matrix(0, j) = mV[3*j];
+        matrix(1, j) = mV[3*j+1];
+        matrix(2, j) = mV[3*j+2];
+    }
+
+}   // End of IvAffine34::GetLinear()
+
+
+//-----------------------------------------------------------------------------
+// @ IvAffine34::AffineInverse()
+//-----------------------------------------------------------------------------
+// Set self to inverse
+//-----------------------------------------------------------------------------
+IvAffine34&
+IvAffine34::AffineInverse()
+{
+    *this = ::AffineInverse( *this );
+
+    return *this;
+
+}   // End of IvAffine34::AffineInverse()
+
+
+//-----------------------------------------------------------------------------
+// @ AffineInverse()
+//-----------------------------------------------------------------------------
+// Compute inverse of affine transform
+//-----------------------------------------------------------------------------
+IvAffine34
+AffineInverse( const IvAffine34& affine )
+{
+    IvAffine34 result;
+    const float* m = affine.mV;
+
+    // compute determinant of linear part
+    float cofactor0 = m[4]*m[8] - m[5]*m[7];
+    float cofactor3 = m[2]*m[7] - m[1]*m[8];
+    float cofactor6 = m[1]*m[5] - m[2]*m[4];
+    float det = m[0]*cofactor0 + m[3]*cofactor3 + m[6]*cofactor6;
+    if (IvIsZero( det ))
+    {
+        ASSERT( false );
+        ERROR_OUT( "Affine34::AffineInverse() -- singular matrix\n" );
+        return result;
+    }
+
+    // create adjoint matrix and multiply by 1/det to get inverse
+    float invDet = 1.0f/det;
+    result.mV[0] = invDet*cofactor0;
+    result.mV[1] = invDet*cofactor3;
+    result.mV[2] = invDet*cofactor6;
+
+    result.mV[3] = invDet*(m[5]*m[6] - m[3]*m[8]);
+    result.mV[4] = invDet*(m[0]*m[8] - m[2]*m[6]);
+    result.mV[5] = invDet*(m[2]*m[3] - m[0]*m[5]);
+
+    result.mV[6] = invDet*(m[3]*m[7] - m[4]*m[6]);
+    result.mV[7] = invDet*(m[1]*m[6] - m[0]*m[7]);
+    result.mV[8] = invDet*(m[0]*m[4] - m[1]*m[3]);
+
+    // multiply -translation by inverted linear part to get translation
+    result.mV[9] = -(result.mV[0]*m[9] + result.mV[3]*m[10] + result.mV[6]*m[11]);
+    result.mV[10] = -(result.mV[1]*m[9] + result.mV[4]*m[10] + result.mV[7]*m[11]);
+    result.mV[11] = -(result.mV[2]*m[9] + result.mV[5]*m[10] + result.mV[8]*m[11]);
+
+    return result;
+
+}   // End of AffineInverse()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::TransformNormal()
+//-------------------------------------------------------------------------------
+// Transform a surface normal by the inverse transpose of the linear part.
+// The inverse transpose is proportional to the cofactor matrix, whose
+// columns are cross products of our columns, so no inverse is needed.
+//-------------------------------------------------------------------------------
+IvVector3
+IvAffine34::TransformNormal( const IvVector3& normal ) const
+{
+    IvVector3 col0( mV[0], mV[1], mV[2] );
+    IvVector3 col1( mV[3], mV[4], mV[5] );
+    IvVector3 col2( mV[6], mV[7], mV[8] );
+
+    IvVector3 result = normal.x*col1.Cross( col2 )
+                     + normal.y*col2.Cross( col0 )
+                     + normal.z*col0.Cross( col1 );
+
+    // a reflection flips the cofactors
+    if ( col0.Dot( col1.Cross( col2 ) ) < 0.0f )
+        result = -result;
+    result.Normalize();
+
+    return result;
+
+}   // End of IvAffine34::TransformNormal()
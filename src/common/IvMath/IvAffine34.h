@@ -0,0 +1,113 @@
+//===============================================================================
+// @ IvAffine34.h
+//
+// 3x4 affine transform class
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Stores the top three rows of an affine 4x4 matrix, whose last row is
+// always (0 0 0 1).  Composition and point transforms skip the multiplies
+// by that row, and the storage is 48 bytes rather than 64.  Convert with
+// IvMatrix44( affine ) to hand the transform to the renderer.
+//
+//===============================================================================
+
+#ifndef __IvAffine34__h__
+#define __IvAffine34__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvWriter.h"
+#include "IvVector3.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvMatrix33;
+class IvMatrix44;
+class IvQuat;
+
+class IvAffine34
+{
+public:
+    // constructor/destructor
+    inline IvAffine34() { Identity(); }
+    inline ~IvAffine34() {}
+    IvAffine34( float scale, const IvQuat& rotate, const IvVector3& translate );
+    explicit IvAffine34( const IvMatrix44& matrix );
+
+    // copy operations
+    IvAffine34(const IvAffine34& other);
+    IvAffine34& operator=(const IvAffine34& other);
+
+    // text output (for debugging)
+    friend IvWriter& operator<<(IvWriter& out, const IvAffine34& source);
+
+    // accessors -- row i in [0,2], column j in [0,3]
+    inline float &operator()(unsigned int i, unsigned int j) { return mV[i + 3*j]; }
+    inline float operator()(unsigned int i, unsigned int j) const { return mV[i + 3*j]; }
+    inline IvVector3 GetTranslation() const { return IvVector3( mV[9], mV[10], mV[11] ); }
+    void GetLinear( IvMatrix33& matrix ) const;
+
+    // comparison
+    bool operator==( const IvAffine34& other ) const;
+    bool operator!=( const IvAffine34& other ) const;
+    bool IsIdentity() const;
+
+    // manipulators
+    void Identity();
+    IvAffine34& Set( float scale, const IvQuat& rotate, const IvVector3& translate );
+    inline void SetTranslation( const IvVector3& xlate )
+    {
+        mV[9] = xlate.x; mV[10] = xlate.y; mV[11] = xlate.z;
+    }
+
+    IvAffine34& AffineInverse();
+    friend IvAffine34 AffineInverse( const IvAffine34& affine );
+
+    // composition -- (a*b) applies b first, then a
+    IvAffine34 operator*( const IvAffine34& other ) const;
+    IvAffine34& operator*=( const IvAffine34& other );
+
+    // vector ops
+    IvVector3 Transform( const IvVector3& vector ) const;
+    IvVector3 TransformPoint( const IvVector3& point ) const;
+    IvVector3 TransformNormal( const IvVector3& normal ) const;   // returns unit normal
+
+    // low-level data accessors - implementation-dependent
+    operator float*() { return mV; }
+    operator const float*() const { return mV; }
+
+protected:
+    // member variables -- column major, translation in mV[9..11]
+    float mV[12];
+
+private:
+};
+
+IvAffine34 AffineInverse( const IvAffine34& affine );
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#if defined(IV_INLINE_MATH)
+#include "IvAffine34.inl"
+#endif
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
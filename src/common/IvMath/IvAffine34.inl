@@ -0,0 +1,149 @@
+//===============================================================================
+// @ IvAffine34.inl
+//
+// 3x4 affine transform class inline operators
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// These definitions are compiled into IvMath by default.  If IV_INLINE_MATH
+// is defined they are instead included by IvAffine34.h and expanded inline.
+//===============================================================================
+
+#ifndef __IvAffine34__inl__
+#define __IvAffine34__inl__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvAffine34.h"
+#include "IvVector3.h"
+#include "IvMath.h"
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::IvAffine34()
+//-------------------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------------------
+IV_INLINE IvAffine34::IvAffine34(const IvAffine34& other)
+{
+    for (unsigned int i = 0; i < 12; ++i)
+    {
+        mV[i] = other.mV[i];
+    }
+
+}   // End of IvAffine34::IvAffine34()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::operator=()
+//-------------------------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------------------
+IV_INLINE IvAffine34&
+IvAffine34::operator=(const IvAffine34& other)
+{
+    // if same object
+    if ( this == &other )
+        return *this;
+
+    for (unsigned int i = 0; i < 12; ++i)
+    {
+        mV[i] = other.mV[i];
+    }
+
+    return *this;
+
+}   // End of IvAffine34::operator=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::operator*()
+//-------------------------------------------------------------------------------
+// Composition: the linear parts multiply as 3x3 matrices, and the
+// translation is this transform applied to the other's translation
+//-------------------------------------------------------------------------------
+IV_INLINE IvAffine34
+IvAffine34::operator*( const IvAffine34& other ) const
+{
+    IvAffine34 result;
+
+    for (unsigned int j = 0; j < 4; ++j)
+    {
+        float x = other.mV[3*j];
+        float y = other.mV[3*j+1];
+        float z = other.mV[3*j+2];
+        result.mV[3*j]   = mV[0]*x + mV[3]*y + mV[6]*z;
+        result.mV[3*j+1] = mV[1]*x + mV[4]*y + mV[7]*z;
+        result.mV[3*j+2] = mV[2]*x + mV[5]*y + mV[8]*z;
+    }
+    result.mV[9] += mV[9];
+    result.mV[10] += mV[10];
+    result.mV[11] += mV[11];
+
+    return result;
+
+}   // End of IvAffine34::operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::operator*=()
+//-------------------------------------------------------------------------------
+// Composition by self: this = this*other
+//-------------------------------------------------------------------------------
+IV_INLINE IvAffine34&
+IvAffine34::operator*=( const IvAffine34& other )
+{
+    *this = *this * other;
+
+    return *this;
+
+}   // End of IvAffine34::operator*=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::Transform()
+//-------------------------------------------------------------------------------
+// Transform a direction; translation is ignored
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvAffine34::Transform( const IvVector3& other ) const
+{
+    IvVector3 result;
+
+    result.x = mV[0]*other.x + mV[3]*other.y + mV[6]*other.z;
+    result.y = mV[1]*other.x + mV[4]*other.y + mV[7]*other.z;
+    result.z = mV[2]*other.x + mV[5]*other.y + mV[8]*other.z;
+
+    return result;
+
+}   // End of IvAffine34::Transform()
+
+
+//-------------------------------------------------------------------------------
+// @ IvAffine34::TransformPoint()
+//-------------------------------------------------------------------------------
+// Transform a point
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvAffine34::TransformPoint( const IvVector3& other ) const
+{
+    IvVector3 result;
+
+    result.x = mV[0]*other.x + mV[3]*other.y + mV[6]*other.z + mV[9];
+    result.y = mV[1]*other.x + mV[4]*other.y + mV[7]*other.z + mV[10];
+    result.z = mV[2]*other.x + mV[5]*other.y + mV[8]*other.z + mV[11];
+
+    return result;
+
+}   // End of IvAffine34::TransformPoint()
+
+#endif
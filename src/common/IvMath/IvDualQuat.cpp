@@ -0,0 +1,271 @@
+//===============================================================================
+// @ IvDualQuat.cpp
+//
+// Dual quaternion class
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvDualQuat.h"
+#include "IvMath.h"
+#include "IvQuat.h"
+#include "IvVector3.h"
+
+#include "IvAssert.h"
+
+#if !defined(IV_INLINE_MATH)
+#include "IvDualQuat.inl"
+#endif
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::IvDualQuat()
+//-------------------------------------------------------------------------------
+// Rotation and translation constructor
+//-------------------------------------------------------------------------------
+IvDualQuat::IvDualQuat( const IvQuat& rotate, const IvVector3& translate )
+{
+    Set( rotate, translate );
+
+}   // End of IvDualQuat::IvDualQuat()
+
+
+//-------------------------------------------------------------------------------
+// @ operator<<()
+//-------------------------------------------------------------------------------
+// Text output for debugging
+//-------------------------------------------------------------------------------
+IvWriter&
+operator<<(IvWriter& out, const IvDualQuat& source)
+{
+    out << source.mReal << " + e" << source.mDual;
+
+    return out;
+
+}   // End of operator<<()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::operator==()
+//-------------------------------------------------------------------------------
+// Comparison operator
+//-------------------------------------------------------------------------------
+bool
+IvDualQuat::operator==( const IvDualQuat& other ) const
+{
+    return mReal == other.mReal && mDual == other.mDual;
+
+}   // End of IvDualQuat::operator==()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::operator!=()
+//-------------------------------------------------------------------------------
+// Comparison operator
+//-------------------------------------------------------------------------------
+bool
+IvDualQuat::operator!=( const IvDualQuat& other ) const
+{
+    return !(*this == other);
+
+}   // End of IvDualQuat::operator!=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::IsUnit()
+//-------------------------------------------------------------------------------
+// Check for unit dual quaternion: unit real part, orthogonal to dual part
+//-------------------------------------------------------------------------------
+bool
+IvDualQuat::IsUnit() const
+{
+    return mReal.IsUnit() && IvIsZero( Dot( mReal, mDual ) );
+
+}   // End of IvDualQuat::IsUnit()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::IsIdentity()
+//-------------------------------------------------------------------------------
+// Check for identity dual quaternion
+//-------------------------------------------------------------------------------
+bool
+IvDualQuat::IsIdentity() const
+{
+    return mReal.IsIdentity() && mDual.IsZero();
+
+}   // End of IvDualQuat::IsIdentity()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::Set()
+//-------------------------------------------------------------------------------
+// Set to rotation followed by translation
+//-------------------------------------------------------------------------------
+void
+IvDualQuat::Set( const IvQuat& rotate, const IvVector3& translate )
+{
+    ASSERT( rotate.IsUnit() );
+
+    mReal = rotate;
+    mDual = 0.5f*(IvQuat( 0.0f, translate.x, translate.y, translate.z )*rotate);
+
+}   // End of IvDualQuat::Set()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::Identity()
+//-------------------------------------------------------------------------------
+// Set to identity dual quaternion
+//-------------------------------------------------------------------------------
+void
+IvDualQuat::Identity()
+{
+    mReal.Identity();
+    mDual.Zero();
+
+}   // End of IvDualQuat::Identity()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::Normalize()
+//-------------------------------------------------------------------------------
+// Set to unit dual quaternion
+//-------------------------------------------------------------------------------
+void
+IvDualQuat::Normalize()
+{
+    float lengthsq = Dot( mReal, mReal );
+
+    if ( IvIsZero( lengthsq ) )
+    {
+        mReal.Zero();
+        mDual.Zero();
+    }
+    else
+    {
+        float factor = IvRecipSqrt( lengthsq );
+        mReal *= factor;
+        mDual *= factor;
+
+        // remove any part of the dual that isn't orthogonal to the real
+        mDual -= Dot( mReal, mDual )*mReal;
+    }
+
+}   // End of IvDualQuat::Normalize()
+
+
+//-------------------------------------------------------------------------------
+// @ ::Conjugate()
+//-------------------------------------------------------------------------------
+// Compute quaternion conjugate of both parts
+//-------------------------------------------------------------------------------
+IvDualQuat
+Conjugate( const IvDualQuat& dualQuat )
+{
+    return IvDualQuat( Conjugate( dualQuat.mReal ), Conjugate( dualQuat.mDual ) );
+
+}   // End of Conjugate()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::Conjugate()
+//-------------------------------------------------------------------------------
+// Set self to conjugate
+//-------------------------------------------------------------------------------
+const IvDualQuat&
+IvDualQuat::Conjugate()
+{
+    mReal.Conjugate();
+    mDual.Conjugate();
+
+    return *this;
+
+}   // End of IvDualQuat::Conjugate()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::operator+()
+//-------------------------------------------------------------------------------
+// Addition operator
+//-------------------------------------------------------------------------------
+IvDualQuat
+IvDualQuat::operator+( const IvDualQuat& other ) const
+{
+    return IvDualQuat( mReal + other.mReal, mDual + other.mDual );
+
+}   // End of IvDualQuat::operator+()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::operator+=()
+//-------------------------------------------------------------------------------
+// Addition by self
+//-------------------------------------------------------------------------------
+IvDualQuat&
+IvDualQuat::operator+=( const IvDualQuat& other )
+{
+    mReal += other.mReal;
+    mDual += other.mDual;
+
+    return *this;
+
+}   // End of IvDualQuat::operator+=()
+
+
+//-------------------------------------------------------------------------------
+// @ operator*()
+//-------------------------------------------------------------------------------
+// Scalar multiplication
+//-------------------------------------------------------------------------------
+IvDualQuat
+operator*( float scalar, const IvDualQuat& dualQuat )
+{
+    return IvDualQuat( scalar*dualQuat.mReal, scalar*dualQuat.mDual );
+
+}   // End of operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ Blend()
+//-------------------------------------------------------------------------------
+// Dual quaternion linear blend of count transforms
+//-------------------------------------------------------------------------------
+void
+Blend( IvDualQuat& result, const IvDualQuat* dualQuats, const float* weights,
+       unsigned int count )
+{
+    ASSERT( count > 0 );
+
+    result.mReal.Zero();
+    result.mDual.Zero();
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        // q and -q are the same transform; take the one nearest the first
+        float weight = weights[i];
+        if ( Dot( dualQuats[0].mReal, dualQuats[i].mReal ) < 0.0f )
+            weight = -weight;
+
+        result.mReal += weight*dualQuats[i].mReal;
+        result.mDual += weight*dualQuats[i].mDual;
+    }
+
+    result.Normalize();
+
+}   // End of Blend()
@@ -0,0 +1,123 @@
+//===============================================================================
+// @ IvDualQuat.h
+//
+// Dual quaternion class
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// A unit dual quaternion real + e*dual represents a rigid transform: the
+// real part is the rotation and the dual part is (1/2)*translation*real.
+// Blends of unit dual quaternions stay rigid once normalized, which is what
+// makes them useful for skinning.
+//
+//===============================================================================
+
+#ifndef __IvDualQuat__h__
+#define __IvDualQuat__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvQuat.h"
+#include "IvVector3.h"
+#include "IvWriter.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvDualQuat
+{
+public:
+    // constructor/destructor
+    inline IvDualQuat() : mReal( 1.0f, 0.0f, 0.0f, 0.0f ), mDual( 0.0f, 0.0f, 0.0f, 0.0f )
+    {}
+    inline IvDualQuat( const IvQuat& real, const IvQuat& dual ) : mReal( real ), mDual( dual )
+    {}
+    IvDualQuat( const IvQuat& rotate, const IvVector3& translate );
+    inline ~IvDualQuat() {}
+
+    // copy operations
+    IvDualQuat(const IvDualQuat& other);
+    IvDualQuat& operator=(const IvDualQuat& other);
+
+    // text output (for debugging)
+    friend IvWriter& operator<<(IvWriter& out, const IvDualQuat& source);
+
+    // accessors
+    inline const IvQuat& GetReal() const { return mReal; }
+    inline const IvQuat& GetDual() const { return mDual; }
+    inline const IvQuat& GetRotation() const { return mReal; }
+    IvVector3 GetTranslation() const;
+
+    // comparison
+    bool operator==( const IvDualQuat& other ) const;
+    bool operator!=( const IvDualQuat& other ) const;
+    bool IsUnit() const;
+    bool IsIdentity() const;
+
+    // manipulators
+    inline void Set( const IvQuat& real, const IvQuat& dual ) { mReal = real; mDual = dual; }
+    void Set( const IvQuat& rotate, const IvVector3& translate );
+    void Identity();
+    void Normalize();   // sets to unit dual quaternion
+
+    // conjugate of both parts; this is the inverse of a unit dual quaternion
+    friend IvDualQuat Conjugate( const IvDualQuat& dualQuat );
+    const IvDualQuat& Conjugate();
+
+    // operators
+
+    // addition and scalar multiplication, for blending
+    IvDualQuat operator+( const IvDualQuat& other ) const;
+    IvDualQuat& operator+=( const IvDualQuat& other );
+    friend IvDualQuat operator*( float scalar, const IvDualQuat& dualQuat );
+
+    // composition -- (a*b) applies b first, then a
+    IvDualQuat operator*( const IvDualQuat& other ) const;
+    IvDualQuat& operator*=( const IvDualQuat& other );
+
+    // vector ops -- assume dual quaternion is normalized
+    IvVector3 Transform( const IvVector3& vector ) const;   // rotation only
+    IvVector3 TransformPoint( const IvVector3& point ) const;
+
+    // dual quaternion linear blend: weighted sum, kept on the same hemisphere
+    // as the first transform, then normalized
+    friend void Blend( IvDualQuat& result, const IvDualQuat* dualQuats, const float* weights,
+                       unsigned int count );
+
+    // low-level data accessors - implementation-dependent
+    // real w,x,y,z followed by dual w,x,y,z
+    operator float*() { return reinterpret_cast<float*>( this ); }
+    operator const float*() const { return reinterpret_cast<const float*>( this ); }
+
+protected:
+    // member variables
+    IvQuat mReal;
+    IvQuat mDual;
+
+private:
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#if defined(IV_INLINE_MATH)
+#include "IvDualQuat.inl"
+#endif
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
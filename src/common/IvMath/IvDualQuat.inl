@@ -0,0 +1,137 @@
+//===============================================================================
+// @ IvDualQuat.inl
+//
+// Dual quaternion class inline operators
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// These definitions are compiled into IvMath by default.  If IV_INLINE_MATH
+// is defined they are instead included by IvDualQuat.h and expanded inline.
+//===============================================================================
+
+#ifndef __IvDualQuat__inl__
+#define __IvDualQuat__inl__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvDualQuat.h"
+#include "IvQuat.h"
+#include "IvVector3.h"
+#include "IvMath.h"
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::IvDualQuat()
+//-------------------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------------------
+IV_INLINE IvDualQuat::IvDualQuat(const IvDualQuat& other) :
+    mReal( other.mReal ),
+    mDual( other.mDual )
+{
+
+}   // End of IvDualQuat::IvDualQuat()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::operator=()
+//-------------------------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------------------
+IV_INLINE IvDualQuat&
+IvDualQuat::operator=(const IvDualQuat& other)
+{
+    // if same object
+    if ( this == &other )
+        return *this;
+
+    mReal = other.mReal;
+    mDual = other.mDual;
+
+    return *this;
+
+}   // End of IvDualQuat::operator=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::GetTranslation()
+//-------------------------------------------------------------------------------
+// Vector part of 2*dual*conjugate(real)
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvDualQuat::GetTranslation() const
+{
+    const IvQuat& r = mReal;
+    const IvQuat& d = mDual;
+
+    return IvVector3( 2.0f*(r.w*d.x - d.w*r.x + r.y*d.z - r.z*d.y),
+                      2.0f*(r.w*d.y - d.w*r.y + r.z*d.x - r.x*d.z),
+                      2.0f*(r.w*d.z - d.w*r.z + r.x*d.y - r.y*d.x) );
+
+}   // End of IvDualQuat::GetTranslation()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::operator*()
+//-------------------------------------------------------------------------------
+// Dual quaternion multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvDualQuat
+IvDualQuat::operator*( const IvDualQuat& other ) const
+{
+    return IvDualQuat( mReal*other.mReal, mReal*other.mDual + mDual*other.mReal );
+
+}   // End of IvDualQuat::operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::operator*=()
+//-------------------------------------------------------------------------------
+// Dual quaternion multiplication by self
+//-------------------------------------------------------------------------------
+IV_INLINE IvDualQuat&
+IvDualQuat::operator*=( const IvDualQuat& other )
+{
+    mDual = mReal*other.mDual + mDual*other.mReal;
+    mReal *= other.mReal;
+
+    return *this;
+
+}   // End of IvDualQuat::operator*=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::Transform()
+//-------------------------------------------------------------------------------
+// Rotate vector; translation is ignored
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvDualQuat::Transform( const IvVector3& vector ) const
+{
+    return mReal.Rotate( vector );
+
+}   // End of IvDualQuat::Transform()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDualQuat::TransformPoint()
+//-------------------------------------------------------------------------------
+// Rotate point, then translate
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvDualQuat::TransformPoint( const IvVector3& point ) const
+{
+    return mReal.Rotate( point ) + GetTranslation();
+
+}   // End of IvDualQuat::TransformPoint()
+
+#endif
@@ -0,0 +1,472 @@
+//===============================================================================
+// @ IvFixed.cpp
+//
+// Fixed-point scalar helpers and batch kernels
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvFixed.h"
+#include "IvFixedVector3.h"
+
+#include <math.h>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#include "IvAssert.h"
+#include "IvSIMD.h"
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvMulU128()
+//-------------------------------------------------------------------------------
+// Full 128-bit product of two unsigned 64-bit values, from 32-bit halves
+// so it is the same on every compiler
+//-------------------------------------------------------------------------------
+static inline void
+IvMulU128( UInt64 a, UInt64 b, UInt64& hi, UInt64& lo )
+{
+    UInt64 a0 = a & 0xffffffff, a1 = a >> 32;
+    UInt64 b0 = b & 0xffffffff, b1 = b >> 32;
+    UInt64 p00 = a0*b0;
+    UInt64 p01 = a0*b1;
+    UInt64 p10 = a1*b0;
+    UInt64 p11 = a1*b1;
+
+    UInt64 middle = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+    lo = (middle << 32) | (p00 & 0xffffffff);
+    hi = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+
+}   // End of IvMulU128()
+
+
+//-------------------------------------------------------------------------------
+// @ IvLessEqualU128()
+//-------------------------------------------------------------------------------
+// Compare two unsigned 128-bit values given as high and low halves
+//-------------------------------------------------------------------------------
+static inline bool
+IvLessEqualU128( UInt64 aHi, UInt64 aLo, UInt64 bHi, UInt64 bLo )
+{
+    return aHi < bHi || (aHi == bHi && aLo <= bLo);
+
+}   // End of IvLessEqualU128()
+
+
+//-------------------------------------------------------------------------------
+// @ IvDivU128()
+//-------------------------------------------------------------------------------
+// Divide the unsigned 128-bit value hi:lo by divisor, truncating.  hi must
+// be less than divisor, so the quotient fits in 64 bits.  Uses the
+// compiler's 128-bit type or intrinsic where there is one, otherwise a
+// long division with 32-bit digits (Knuth, TAOCP vol. 2, algorithm D).
+//-------------------------------------------------------------------------------
+static inline UInt64
+IvDivU128( UInt64 hi, UInt64 lo, UInt64 divisor )
+{
+    ASSERT( hi < divisor );
+
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 dividend = ((unsigned __int128)hi << 64) | lo;
+    return (UInt64)(dividend/divisor);
+#elif defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1920
+    unsigned __int64 remainder;
+    return _udiv128( hi, lo, divisor, &remainder );
+#else
+    const UInt64 base = (UInt64)1 << 32;
+
+    // normalize so the divisor's top bit is set, which keeps each
+    // estimated digit within 2 of the true one
+    int shift = 0;
+    for (int step = 32; step > 0; step >>= 1)
+    {
+        if ( (divisor >> (64-shift-step)) == 0 )
+            shift += step;
+    }
+    divisor <<= shift;
+    UInt64 d1 = divisor >> 32;
+    UInt64 d0 = divisor & 0xffffffff;
+    UInt64 n32 = shift == 0 ? hi : (hi << shift) | (lo >> (64-shift));
+    UInt64 n10 = lo << shift;
+    UInt64 n1 = n10 >> 32;
+    UInt64 n0 = n10 & 0xffffffff;
+
+    // high digit
+    UInt64 q1 = n32/d1;
+    UInt64 rhat = n32 - q1*d1;
+    while ( q1 >= base || q1*d0 > ((rhat << 32) | n1) )
+    {
+        --q1;
+        rhat += d1;
+        if ( rhat >= base )
+            break;
+    }
+
+    // low digit, from the remainder (which fits in 64 bits)
+    UInt64 n21 = (n32 << 32) + n1 - q1*divisor;
+    UInt64 q0 = n21/d1;
+    rhat = n21 - q0*d1;
+    while ( q0 >= base || q0*d0 > ((rhat << 32) | n0) )
+    {
+        --q0;
+        rhat += d1;
+        if ( rhat >= base )
+            break;
+    }
+
+    return (q1 << 32) | q0;
+#endif
+
+}   // End of IvDivU128()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedMul()
+//-------------------------------------------------------------------------------
+// Multiply two 64-bit raw values, rounding to nearest
+//-------------------------------------------------------------------------------
+Int64
+IvFixedMul( Int64 a, Int64 b, int fracBits )
+{
+    ASSERT( fracBits > 0 && fracBits < 64 );
+
+    // unsigned product of the bit patterns, corrected to a signed product
+    UInt64 hi, lo;
+    IvMulU128( (UInt64)a, (UInt64)b, hi, lo );
+    if ( a < 0 )
+        hi -= (UInt64)b;
+    if ( b < 0 )
+        hi -= (UInt64)a;
+
+    // round and shift down; only the low 64 bits are kept
+    UInt64 round = (UInt64)1 << (fracBits-1);
+    lo += round;
+    if ( lo < round )
+        ++hi;
+
+    return (Int64)((lo >> fracBits) | (hi << (64-fracBits)));
+
+}   // End of IvFixedMul()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedDivideByZero()
+//-------------------------------------------------------------------------------
+// Report division by zero, and return the largest value of the right sign
+//-------------------------------------------------------------------------------
+static UInt64
+IvFixedDivideByZero( bool negative, UInt64 largest )
+{
+    ASSERT( false );
+    ERROR_OUT( "IvFixed -- divide by zero\n" );
+
+    return negative ? ~largest : largest;
+
+}   // End of IvFixedDivideByZero()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedDiv()
+//-------------------------------------------------------------------------------
+// Divide two 32-bit raw values, truncating towards zero
+//-------------------------------------------------------------------------------
+Int32
+IvFixedDiv( Int32 a, Int32 b, int fracBits )
+{
+    if ( b == 0 )
+        return (Int32)IvFixedDivideByZero( a < 0, 0x7fffffff );
+
+    return (Int32)(((Int64)a*((Int64)1 << fracBits))/b);
+
+}   // End of IvFixedDiv()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedDiv()
+//-------------------------------------------------------------------------------
+// Divide two 64-bit raw values, truncating towards zero.  The shifted
+// dividend needs 128 bits.
+//-------------------------------------------------------------------------------
+Int64
+IvFixedDiv( Int64 a, Int64 b, int fracBits )
+{
+    ASSERT( fracBits > 0 && fracBits < 64 );
+
+    bool negative = (a < 0) != (b < 0);
+    if ( b == 0 )
+        return (Int64)IvFixedDivideByZero( a < 0, 0x7fffffffffffffffULL );
+
+    UInt64 dividend = a < 0 ? 0 - (UInt64)a : (UInt64)a;
+    UInt64 divisor = b < 0 ? 0 - (UInt64)b : (UInt64)b;
+
+    // dividend << fracBits as 128 bits
+    UInt64 hi = dividend >> (64-fracBits);
+    UInt64 lo = dividend << fracBits;
+
+    // quotient bits above 63 are lost, as in the 32-bit version; reducing
+    // the high half drops exactly those
+    hi %= divisor;
+    UInt64 quotient = IvDivU128( hi, lo, divisor );
+
+    return negative ? (Int64)(0 - quotient) : (Int64)quotient;
+
+}   // End of IvFixedDiv()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedSqrt()
+//-------------------------------------------------------------------------------
+// Square root of a 32-bit raw value: the largest r with r*r <= a << fracBits
+//-------------------------------------------------------------------------------
+Int32
+IvFixedSqrt( Int32 a, int fracBits )
+{
+    ASSERT( a >= 0 );
+    if ( a <= 0 )
+        return 0;
+
+    // target < 2^62, so the double root is within one of the answer
+    UInt64 target = (UInt64)a << fracBits;
+    UInt64 root = (UInt64)sqrt( (double)target );
+    while ( root*root > target )
+        --root;
+    while ( (root+1)*(root+1) <= target )
+        ++root;
+
+    return (Int32)root;
+
+}   // End of IvFixedSqrt()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedSqrt()
+//-------------------------------------------------------------------------------
+// Square root of a 64-bit raw value: the largest r with r*r <= a << fracBits
+//-------------------------------------------------------------------------------
+Int64
+IvFixedSqrt( Int64 a, int fracBits )
+{
+    ASSERT( fracBits > 0 && fracBits < 64 );
+    ASSERT( a >= 0 );
+    if ( a <= 0 )
+        return 0;
+
+    UInt64 targetHi = (UInt64)a >> (64-fracBits);
+    UInt64 targetLo = (UInt64)a << fracBits;
+
+    // the double root has 53 good bits; target < 2^127, so root < 2^64
+    UInt64 root = (UInt64)sqrt( ldexp( (double)a, fracBits ) );
+
+    // one Newton step, floor((root + target/root)/2), doubles that
+    if ( root > targetHi )
+    {
+        UInt64 quotient = IvDivU128( targetHi, targetLo, root );
+        root = (root >> 1) + (quotient >> 1) + (root & quotient & 1);
+    }
+
+    // then correct the last bit
+    UInt64 hi, lo;
+    IvMulU128( root, root, hi, lo );
+    while ( !IvLessEqualU128( hi, lo, targetHi, targetLo ) )
+    {
+        --root;
+        IvMulU128( root, root, hi, lo );
+    }
+    IvMulU128( root+1, root+1, hi, lo );
+    while ( IvLessEqualU128( hi, lo, targetHi, targetLo ) )
+    {
+        ++root;
+        IvMulU128( root+1, root+1, hi, lo );
+    }
+
+    return (Int64)root;
+
+}   // End of IvFixedSqrt()
+
+
+#if defined(IV_SSE2)
+//-------------------------------------------------------------------------------
+// @ IvFixedMul4()
+//-------------------------------------------------------------------------------
+// Multiply four 16.16 values.  SSE2 only has an unsigned 32x32->64 multiply,
+// so the signed product is recovered by subtracting (a<0 ? b : 0) and
+// (b<0 ? a : 0) from the high half.  This gives the same bits as IvFixedMul().
+//-------------------------------------------------------------------------------
+static inline __m128i
+IvFixedMul4( __m128i a, __m128i b )
+{
+    const __m128i round = _mm_set_epi32( 0, 0x8000, 0, 0x8000 );
+    const __m128i lowMask = _mm_set_epi32( 0, -1, 0, -1 );
+
+    // lanes 0 and 2, then lanes 1 and 3
+    __m128i even = _mm_mul_epu32( a, b );
+    __m128i odd = _mm_mul_epu32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) );
+    even = _mm_srli_epi64( _mm_add_epi64( even, round ), 16 );
+    odd = _mm_srli_epi64( _mm_add_epi64( odd, round ), 16 );
+    __m128i result = _mm_or_si128( _mm_and_si128( even, lowMask ), _mm_slli_epi64( odd, 32 ) );
+
+    __m128i correction = _mm_add_epi32( _mm_and_si128( _mm_srai_epi32( a, 31 ), b ),
+                                        _mm_and_si128( _mm_srai_epi32( b, 31 ), a ) );
+    return _mm_sub_epi32( result, _mm_slli_epi32( correction, 16 ) );
+
+}   // End of IvFixedMul4()
+#endif
+
+
+//-------------------------------------------------------------------------------
+// @ Add()
+//-------------------------------------------------------------------------------
+// Add count pairs of 16.16 values
+//-------------------------------------------------------------------------------
+void
+Add( IvFixed16* result, const IvFixed16* a, const IvFixed16* b, unsigned int count )
+{
+    unsigned int i = 0;
+#if defined(IV_SSE2)
+    for ( ; i + 4 <= count; i += 4)
+    {
+        __m128i sum = _mm_add_epi32( _mm_loadu_si128( (const __m128i*)(a + i) ),
+                                     _mm_loadu_si128( (const __m128i*)(b + i) ) );
+        _mm_storeu_si128( (__m128i*)(result + i), sum );
+    }
+#endif
+    for ( ; i < count; ++i)
+    {
+        result[i] = a[i] + b[i];
+    }
+
+}   // End of Add()
+
+
+//-------------------------------------------------------------------------------
+// @ Add()
+//-------------------------------------------------------------------------------
+// Add count pairs of 32.32 values
+//-------------------------------------------------------------------------------
+void
+Add( IvFixed32* result, const IvFixed32* a, const IvFixed32* b, unsigned int count )
+{
+    unsigned int i = 0;
+#if defined(IV_SSE2)
+    for ( ; i + 2 <= count; i += 2)
+    {
+        __m128i sum = _mm_add_epi64( _mm_loadu_si128( (const __m128i*)(a + i) ),
+                                     _mm_loadu_si128( (const __m128i*)(b + i) ) );
+        _mm_storeu_si128( (__m128i*)(result + i), sum );
+    }
+#endif
+    for ( ; i < count; ++i)
+    {
+        result[i] = a[i] + b[i];
+    }
+
+}   // End of Add()
+
+
+//-------------------------------------------------------------------------------
+// @ Multiply()
+//-------------------------------------------------------------------------------
+// Multiply count pairs of 16.16 values
+//-------------------------------------------------------------------------------
+void
+Multiply( IvFixed16* result, const IvFixed16* a, const IvFixed16* b, unsigned int count )
+{
+    unsigned int i = 0;
+#if defined(IV_SSE2)
+    for ( ; i + 4 <= count; i += 4)
+    {
+        __m128i product = IvFixedMul4( _mm_loadu_si128( (const __m128i*)(a + i) ),
+                                       _mm_loadu_si128( (const __m128i*)(b + i) ) );
+        _mm_storeu_si128( (__m128i*)(result + i), product );
+    }
+#endif
+    for ( ; i < count; ++i)
+    {
+        result[i] = a[i]*b[i];
+    }
+
+}   // End of Multiply()
+
+
+//-------------------------------------------------------------------------------
+// @ Multiply()
+//-------------------------------------------------------------------------------
+// Multiply count pairs of 32.32 values.  There is no 64-bit SIMD multiply
+// before AVX-512, so this is scalar.
+//-------------------------------------------------------------------------------
+void
+Multiply( IvFixed32* result, const IvFixed32* a, const IvFixed32* b, unsigned int count )
+{
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        result[i] = a[i]*b[i];
+    }
+
+}   // End of Multiply()
+
+
+//-------------------------------------------------------------------------------
+// @ Dot()
+//-------------------------------------------------------------------------------
+// Dot products of count pairs of 16.16 vectors
+//-------------------------------------------------------------------------------
+void
+Dot( IvFixed16* result, const IvFixedVector3<IvFixed16>* a,
+     const IvFixedVector3<IvFixed16>* b, unsigned int count )
+{
+    unsigned int i = 0;
+#if defined(IV_SSE2)
+    for ( ; i + 4 <= count; i += 4)
+    {
+        // the float shuffles only move bits, so they work for integers too
+        __m128 ax, ay, az, bx, by, bz;
+        IvLoadXYZ4( (const float*)(a + i), ax, ay, az );
+        IvLoadXYZ4( (const float*)(b + i), bx, by, bz );
+
+        __m128i dot = _mm_add_epi32(
+            _mm_add_epi32( IvFixedMul4( _mm_castps_si128( ax ), _mm_castps_si128( bx ) ),
+                           IvFixedMul4( _mm_castps_si128( ay ), _mm_castps_si128( by ) ) ),
+            IvFixedMul4( _mm_castps_si128( az ), _mm_castps_si128( bz ) ) );
+        _mm_storeu_si128( (__m128i*)(result + i), dot );
+    }
+#endif
+    for ( ; i < count; ++i)
+    {
+        result[i] = a[i].Dot( b[i] );
+    }
+
+}   // End of Dot()
+
+
+//-------------------------------------------------------------------------------
+// @ Dot()
+//-------------------------------------------------------------------------------
+// Dot products of count pairs of 32.32 vectors
+//-------------------------------------------------------------------------------
+void
+Dot( IvFixed32* result, const IvFixedVector3<IvFixed32>* a,
+     const IvFixedVector3<IvFixed32>* b, unsigned int count )
+{
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        result[i] = a[i].Dot( b[i] );
+    }
+
+}   // End of Dot()
@@ -0,0 +1,178 @@
+//===============================================================================
+// @ IvFixed.h
+//
+// Fixed-point scalar class
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// IvFixed<T, F> stores a value as an integer of type T with F fractional
+// bits, as described in Appendix C.  Two formats are provided:
+//
+//   IvFixed16 - 16.16 in 32 bits, range about +/-32768, step 1.5e-5
+//   IvFixed32 - 32.32 in 64 bits, range about +/-2.1e9, step 2.3e-10
+//
+// All arithmetic is done on integers, so results are bit-identical on every
+// machine and compiler, and with or without SIMD.  This makes the types
+// suitable for lockstep simulation.  Products are rounded to nearest (ties
+// towards +infinity), quotients and square roots are truncated, and results
+// that leave the range wrap around.  Only the float conversions use floating
+// point.
+//
+//===============================================================================
+
+#ifndef __IvFixed__h__
+#define __IvFixed__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include <math.h>
+#include <type_traits>
+#include "IvTypes.h"
+#include "IvWriter.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// raw operations on values with fracBits fractional bits
+inline Int32 IvFixedMul( Int32 a, Int32 b, int fracBits )
+{
+    return (Int32)(((Int64)a*b + ((Int64)1 << (fracBits-1))) >> fracBits);
+}
+Int64 IvFixedMul( Int64 a, Int64 b, int fracBits );
+Int32 IvFixedDiv( Int32 a, Int32 b, int fracBits );
+Int64 IvFixedDiv( Int64 a, Int64 b, int fracBits );
+Int32 IvFixedSqrt( Int32 a, int fracBits );
+Int64 IvFixedSqrt( Int64 a, int fracBits );
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+template <class T, int F>
+class IvFixed
+{
+public:
+    enum { kFracBits = F };
+
+    // adds, subtracts and shifts are done on the unsigned type, where
+    // wrapping around is defined, and converted back
+    typedef typename std::make_unsigned<T>::type U;
+
+    // constructor/destructor
+    inline IvFixed() : mValue(0) {}
+    inline explicit IvFixed( int i ) : mValue( (T)((U)(T)i << F) ) {}
+    inline explicit IvFixed( float f ) :
+        mValue( (T)floor( (double)f*(double)((T)1 << F) + 0.5 ) ) {}
+    inline ~IvFixed() {}
+
+    // raw access
+    static inline IvFixed FromRaw( T raw ) { IvFixed result; result.mValue = raw; return result; }
+    inline T GetRaw() const { return mValue; }
+
+    // conversion
+    inline float ToFloat() const { return (float)((double)mValue/(double)((T)1 << F)); }
+    inline int ToInt() const { return (int)(mValue >> F); }      // rounds towards -infinity
+
+    // text output (for debugging)
+    friend IvWriter& operator<<(IvWriter& out, const IvFixed& source)
+    {
+        return out << source.ToFloat();
+    }
+
+    // comparison
+    inline bool operator==( const IvFixed& other ) const { return mValue == other.mValue; }
+    inline bool operator!=( const IvFixed& other ) const { return mValue != other.mValue; }
+    inline bool operator<( const IvFixed& other ) const  { return mValue < other.mValue; }
+    inline bool operator<=( const IvFixed& other ) const { return mValue <= other.mValue; }
+    inline bool operator>( const IvFixed& other ) const  { return mValue > other.mValue; }
+    inline bool operator>=( const IvFixed& other ) const { return mValue >= other.mValue; }
+    inline bool IsZero() const { return mValue == 0; }
+
+    // operators
+    inline IvFixed operator+( const IvFixed& other ) const
+    {
+        return FromRaw( (T)((U)mValue + (U)other.mValue) );
+    }
+    inline IvFixed operator-( const IvFixed& other ) const
+    {
+        return FromRaw( (T)((U)mValue - (U)other.mValue) );
+    }
+    inline IvFixed operator-() const { return FromRaw( (T)(U(0) - (U)mValue) ); }
+    inline IvFixed operator*( const IvFixed& other ) const
+    {
+        return FromRaw( IvFixedMul( mValue, other.mValue, F ) );
+    }
+    inline IvFixed operator/( const IvFixed& other ) const
+    {
+        return FromRaw( IvFixedDiv( mValue, other.mValue, F ) );
+    }
+
+    inline IvFixed& operator+=( const IvFixed& other ) { return *this = *this + other; }
+    inline IvFixed& operator-=( const IvFixed& other ) { return *this = *this - other; }
+    inline IvFixed& operator*=( const IvFixed& other ) { return *this = *this*other; }
+    inline IvFixed& operator/=( const IvFixed& other ) { return *this = *this/other; }
+
+protected:
+    // member variables
+    T mValue;
+
+private:
+};
+
+typedef IvFixed<Int32, 16> IvFixed16;
+typedef IvFixed<Int64, 32> IvFixed32;
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvAbs()
+//-------------------------------------------------------------------------------
+// Absolute value
+//-------------------------------------------------------------------------------
+template <class T, int F>
+inline IvFixed<T, F> IvAbs( const IvFixed<T, F>& a )
+{
+    return a.GetRaw() < 0 ? -a : a;
+
+}   // End of IvAbs()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSqrt()
+//-------------------------------------------------------------------------------
+// Square root, truncated; returns 0 for negative values
+//-------------------------------------------------------------------------------
+template <class T, int F>
+inline IvFixed<T, F> IvSqrt( const IvFixed<T, F>& a )
+{
+    return IvFixed<T, F>::FromRaw( IvFixedSqrt( a.GetRaw(), F ) );
+
+}   // End of IvSqrt()
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// batch operations on count pairs; result may be the same array as a or b
+// IvFixed16 add and multiply use SSE2, IvFixed32 add uses SSE2
+extern void Add( IvFixed16* result, const IvFixed16* a, const IvFixed16* b, unsigned int count );
+extern void Add( IvFixed32* result, const IvFixed32* a, const IvFixed32* b, unsigned int count );
+extern void Multiply( IvFixed16* result, const IvFixed16* a, const IvFixed16* b,
+                      unsigned int count );
+extern void Multiply( IvFixed32* result, const IvFixed32* a, const IvFixed32* b,
+                      unsigned int count );
+
+#endif
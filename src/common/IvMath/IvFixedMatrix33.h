@@ -0,0 +1,323 @@
+//===============================================================================
+// @ IvFixedMatrix33.h
+//
+// Fixed-point 3x3 matrix class
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Mirrors IvMatrix33 for an IvFixed element type, with the same column-major
+// layout.  See IvFixed.h for the rounding rules.
+//
+//===============================================================================
+
+#ifndef __IvFixedMatrix33__h__
+#define __IvFixedMatrix33__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvFixed.h"
+#include "IvFixedQuat.h"
+#include "IvFixedVector3.h"
+#include "IvMatrix33.h"
+#include "IvWriter.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+template <class T>
+class IvFixedMatrix33
+{
+public:
+    // constructor/destructor
+    inline IvFixedMatrix33() { Identity(); }
+    explicit IvFixedMatrix33( const IvMatrix33& matrix );
+    inline explicit IvFixedMatrix33( const IvFixedQuat<T>& quat ) { Rotation( quat ); }
+    inline ~IvFixedMatrix33() {}
+
+    // conversion
+    IvMatrix33 ToFloat() const;
+
+    // text output (for debugging)
+    friend IvWriter& operator<<(IvWriter& out, const IvFixedMatrix33& source)
+    {
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            out << "| " << source(i,0) << ' ' << source(i,1) << ' ' << source(i,2) << " |" << eol;
+        }
+        return out;
+    }
+
+    // accessors
+    inline T& operator()(unsigned int i, unsigned int j) { return mV[i + 3*j]; }
+    inline T operator()(unsigned int i, unsigned int j) const { return mV[i + 3*j]; }
+
+    // comparison
+    bool operator==( const IvFixedMatrix33& other ) const;
+    inline bool operator!=( const IvFixedMatrix33& other ) const { return !(*this == other); }
+
+    // manipulators
+    void Identity();
+    IvFixedMatrix33& Rotation( const IvFixedQuat<T>& rotate );
+    IvFixedMatrix33& Transpose();
+
+    // operators
+    IvFixedMatrix33 operator+( const IvFixedMatrix33& other ) const;
+    IvFixedMatrix33 operator-( const IvFixedMatrix33& other ) const;
+    IvFixedMatrix33 operator*( const IvFixedMatrix33& other ) const;
+    inline IvFixedMatrix33& operator*=( const IvFixedMatrix33& other )
+    {
+        return *this = *this*other;
+    }
+
+    // column vector multiplier
+    IvFixedVector3<T> operator*( const IvFixedVector3<T>& vector ) const;
+
+    // member variables
+    T mV[9];
+
+protected:
+
+private:
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvFixedMatrix33::IvFixedMatrix33()
+//-------------------------------------------------------------------------------
+// IvMatrix33 conversion constructor
+//-------------------------------------------------------------------------------
+template <class T>
+inline
+IvFixedMatrix33<T>::IvFixedMatrix33( const IvMatrix33& matrix )
+{
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            mV[i + 3*j] = T( matrix(i,j) );
+        }
+    }
+
+}   // End of IvFixedMatrix33::IvFixedMatrix33()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedMatrix33::ToFloat()
+//-------------------------------------------------------------------------------
+// Convert to floating point matrix
+//-------------------------------------------------------------------------------
+template <class T>
+inline IvMatrix33
+IvFixedMatrix33<T>::ToFloat() const
+{
+    IvMatrix33 result;
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            result(i,j) = mV[i + 3*j].ToFloat();
+        }
+    }
+    return result;
+
+}   // End of IvFixedMatrix33::ToFloat()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedMatrix33::operator==()
+//-------------------------------------------------------------------------------
+// Comparison operator
+//-------------------------------------------------------------------------------
+template <class T>
+inline bool
+IvFixedMatrix33<T>::operator==( const IvFixedMatrix33& other ) const
+{
+    for (unsigned int i = 0; i < 9; ++i)
+    {
+        if ( mV[i] != other.mV[i] )
+            return false;
+    }
+    return true;
+
+}   // End of IvFixedMatrix33::operator==()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedMatrix33::Identity()
+//-------------------------------------------------------------------------------
+// Set to identity matrix
+//-------------------------------------------------------------------------------
+template <class T>
+inline void
+IvFixedMatrix33<T>::Identity()
+{
+    for (unsigned int i = 0; i < 9; ++i)
+    {
+        mV[i] = T();
+    }
+    mV[0] = mV[4] = mV[8] = T(1);
+
+}   // End of IvFixedMatrix33::Identity()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedMatrix33::Rotation()
+//-------------------------------------------------------------------------------
+// Set as rotation matrix based on quaternion
+//-------------------------------------------------------------------------------
+template <class T>
+inline IvFixedMatrix33<T>&
+IvFixedMatrix33<T>::Rotation( const IvFixedQuat<T>& rotate )
+{
+    T xs = rotate.x+rotate.x;
+    T ys = rotate.y+rotate.y;
+    T zs = rotate.z+rotate.z;
+    T wx = rotate.w*xs;
+    T wy = rotate.w*ys;
+    T wz = rotate.w*zs;
+    T xx = rotate.x*xs;
+    T xy = rotate.x*ys;
+    T xz = rotate.x*zs;
+    T yy = rotate.y*ys;
+    T yz = rotate.y*zs;
+    T zz = rotate.z*zs;
+    const T one(1);
+
+    mV[0] = one - (yy + zz);
+    mV[3] = xy - wz;
+    mV[6] = xz + wy;
+
+    mV[1] = xy + wz;
+    mV[4] = one - (xx + zz);
+    mV[7] = yz - wx;
+
+    mV[2] = xz - wy;
+    mV[5] = yz + wx;
+    mV[8] = one - (xx + yy);
+
+    return *this;
+
+}   // End of IvFixedMatrix33::Rotation()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedMatrix33::Transpose()
+//-------------------------------------------------------------------------------
+// Set self to transpose
+//-------------------------------------------------------------------------------
+template <class T>
+inline IvFixedMatrix33<T>&
+IvFixedMatrix33<T>::Transpose()
+{
+    T temp = mV[1];
+    mV[1] = mV[3];
+    mV[3] = temp;
+
+    temp = mV[2];
+    mV[2] = mV[6];
+    mV[6] = temp;
+
+    temp = mV[5];
+    mV[5] = mV[7];
+    mV[7] = temp;
+
+    return *this;
+
+}   // End of IvFixedMatrix33::Transpose()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedMatrix33::operator+()
+//-------------------------------------------------------------------------------
+// Matrix addition
+//-------------------------------------------------------------------------------
+template <class T>
+inline IvFixedMatrix33<T>
+IvFixedMatrix33<T>::operator+( const IvFixedMatrix33& other ) const
+{
+    IvFixedMatrix33 result;
+    for (unsigned int i = 0; i < 9; ++i)
+    {
+        result.mV[i] = mV[i] + other.mV[i];
+    }
+    return result;
+
+}   // End of IvFixedMatrix33::operator+()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedMatrix33::operator-()
+//-------------------------------------------------------------------------------
+// Matrix subtraction
+//-------------------------------------------------------------------------------
+template <class T>
+inline IvFixedMatrix33<T>
+IvFixedMatrix33<T>::operator-( const IvFixedMatrix33& other ) const
+{
+    IvFixedMatrix33 result;
+    for (unsigned int i = 0; i < 9; ++i)
+    {
+        result.mV[i] = mV[i] - other.mV[i];
+    }
+    return result;
+
+}   // End of IvFixedMatrix33::operator-()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedMatrix33::operator*()
+//-------------------------------------------------------------------------------
+// Matrix multiplication
+//-------------------------------------------------------------------------------
+template <class T>
+inline IvFixedMatrix33<T>
+IvFixedMatrix33<T>::operator*( const IvFixedMatrix33& other ) const
+{
+    IvFixedMatrix33 result;
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+        const T* column = &other.mV[3*j];
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            result.mV[i + 3*j] = mV[i]*column[0] + mV[i+3]*column[1] + mV[i+6]*column[2];
+        }
+    }
+    return result;
+
+}   // End of IvFixedMatrix33::operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedMatrix33::operator*()
+//-------------------------------------------------------------------------------
+// Matrix-column vector multiplication
+//-------------------------------------------------------------------------------
+template <class T>
+inline IvFixedVector3<T>
+IvFixedMatrix33<T>::operator*( const IvFixedVector3<T>& vector ) const
+{
+    return IvFixedVector3<T>( mV[0]*vector.x + mV[3]*vector.y + mV[6]*vector.z,
+                              mV[1]*vector.x + mV[4]*vector.y + mV[7]*vector.z,
+                              mV[2]*vector.x + mV[5]*vector.y + mV[8]*vector.z );
+
+}   // End of IvFixedMatrix33::operator*()
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
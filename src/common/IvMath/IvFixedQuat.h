@@ -0,0 +1,186 @@
+//===============================================================================
+// @ IvFixedQuat.h
+//
+// Fixed-point quaternion class
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Mirrors IvQuat for an IvFixed element type.  See IvFixed.h for the
+// rounding rules.
+//
+//===============================================================================
+
+#ifndef __IvFixedQuat__h__
+#define __IvFixedQuat__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvFixed.h"
+#include "IvFixedVector3.h"
+#include "IvQuat.h"
+#include "IvWriter.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+template <class T>
+class IvFixedQuat
+{
+public:
+    // constructor/destructor
+    inline IvFixedQuat() : w(1), x(), y(), z() {}
+    inline IvFixedQuat( const T& _w, const T& _x, const T& _y, const T& _z ) :
+        w(_w), x(_x), y(_y), z(_z)
+    {
+    }
+    inline explicit IvFixedQuat( const IvQuat& quat ) :
+        w(quat.w), x(quat.x), y(quat.y), z(quat.z)
+    {
+    }
+    inline ~IvFixedQuat() {}
+
+    // conversion
+    inline IvQuat ToFloat() const
+    {
+        return IvQuat( w.ToFloat(), x.ToFloat(), y.ToFloat(), z.ToFloat() );
+    }
+
+    // text output (for debugging)
+    friend IvWriter& operator<<(IvWriter& out, const IvFixedQuat& source)
+    {
+        return out << '[' << source.w << ',' << source.x << ','
+                   << source.y << ',' << source.z << ']';
+    }
+
+    inline T Norm() const { return w*w + x*x + y*y + z*z; }
+
+    // comparison
+    inline bool operator==( const IvFixedQuat& other ) const
+    {
+        return w == other.w && x == other.x && y == other.y && z == other.z;
+    }
+    inline bool operator!=( const IvFixedQuat& other ) const { return !(*this == other); }
+
+    // manipulators
+    inline void Set( const T& _w, const T& _x, const T& _y, const T& _z )
+    {
+        w = _w; x = _x; y = _y; z = _z;
+    }
+    inline void Identity() { w = T(1); x = y = z = T(); }
+    void Normalize();   // sets to unit quaternion
+
+    // complex conjugate
+    inline IvFixedQuat Conjugate() const { return IvFixedQuat( w, -x, -y, -z ); }
+
+    // operators
+
+    // addition/subtraction
+    inline IvFixedQuat operator+( const IvFixedQuat& other ) const
+    {
+        return IvFixedQuat( w + other.w, x + other.x, y + other.y, z + other.z );
+    }
+    inline IvFixedQuat operator-( const IvFixedQuat& other ) const
+    {
+        return IvFixedQuat( w - other.w, x - other.x, y - other.y, z - other.z );
+    }
+    inline IvFixedQuat operator-() const { return IvFixedQuat( -w, -x, -y, -z ); }
+
+    // scalar multiplication
+    friend inline IvFixedQuat operator*( const T& scalar, const IvFixedQuat& quat )
+    {
+        return IvFixedQuat( scalar*quat.w, scalar*quat.x, scalar*quat.y, scalar*quat.z );
+    }
+
+    // quaternion multiplication
+    inline IvFixedQuat operator*( const IvFixedQuat& other ) const
+    {
+        return IvFixedQuat( w*other.w - x*other.x - y*other.y - z*other.z,
+                            w*other.x + x*other.w + y*other.z - z*other.y,
+                            w*other.y + y*other.w + z*other.x - x*other.z,
+                            w*other.z + z*other.w + x*other.y - y*other.x );
+    }
+    inline IvFixedQuat& operator*=( const IvFixedQuat& other ) { return *this = *this*other; }
+
+    // dot product
+    inline T Dot( const IvFixedQuat& quat ) const
+    {
+        return w*quat.w + x*quat.x + y*quat.y + z*quat.z;
+    }
+
+    // vector rotation -- assumes quaternion is normalized
+    IvFixedVector3<T> Rotate( const IvFixedVector3<T>& vector ) const;
+
+    // member variables
+    T w, x, y, z;
+
+protected:
+
+private:
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvFixedQuat::Normalize()
+//-------------------------------------------------------------------------------
+// Set to unit quaternion
+//-------------------------------------------------------------------------------
+template <class T>
+inline void
+IvFixedQuat<T>::Normalize()
+{
+    T length = IvSqrt( Norm() );
+
+    if ( length.IsZero() )
+    {
+        w = x = y = z = T();
+    }
+    else
+    {
+        w /= length;
+        x /= length;
+        y /= length;
+        z /= length;
+    }
+
+}   // End of IvFixedQuat::Normalize()
+
+
+//-------------------------------------------------------------------------------
+// @ IvFixedQuat::Rotate()
+//-------------------------------------------------------------------------------
+// Rotate vector by quaternion
+//-------------------------------------------------------------------------------
+template <class T>
+inline IvFixedVector3<T>
+IvFixedQuat<T>::Rotate( const IvFixedVector3<T>& vector ) const
+{
+    const T two(2);
+    T vMult = two*(x*vector.x + y*vector.y + z*vector.z);
+    T crossMult = two*w;
+    T pMult = crossMult*w - T(1);
+
+    return IvFixedVector3<T>( pMult*vector.x + vMult*x + crossMult*(y*vector.z - z*vector.y),
+                              pMult*vector.y + vMult*y + crossMult*(z*vector.x - x*vector.z),
+                              pMult*vector.z + vMult*z + crossMult*(x*vector.y - y*vector.x) );
+
+}   // End of IvFixedQuat::Rotate()
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,183 @@
+//===============================================================================
+// @ IvFixedVector3.h
+//
+// Fixed-point 3D vector class
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Mirrors IvVector3 for an IvFixed element type.  See IvFixed.h for the
+// rounding rules.
+//
+//===============================================================================
+
+#ifndef __IvFixedVector3__h__
+#define __IvFixedVector3__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvFixed.h"
+#include "IvVector3.h"
+#include "IvWriter.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+template <class T>
+class IvFixedVector3
+{
+public:
+    // constructor/destructor
+    inline IvFixedVector3() {}
+    inline IvFixedVector3( const T& _x, const T& _y, const T& _z ) :
+        x(_x), y(_y), z(_z)
+    {
+    }
+    inline explicit IvFixedVector3( const IvVector3& vector ) :
+        x(vector.x), y(vector.y), z(vector.z)
+    {
+    }
+    inline ~IvFixedVector3() {}
+
+    // conversion
+    inline IvVector3 ToFloat() const { return IvVector3( x.ToFloat(), y.ToFloat(), z.ToFloat() ); }
+
+    // text output (for debugging)
+    friend IvWriter& operator<<(IvWriter& out, const IvFixedVector3& source)
+    {
+        return out << '<' << source.x << ',' << source.y << ',' << source.z << '>';
+    }
+
+    // accessors
+    inline T& operator[]( unsigned int i )          { return (&x)[i]; }
+    inline T operator[]( unsigned int i ) const     { return (&x)[i]; }
+
+    inline T LengthSquared() const { return x*x + y*y + z*z; }
+    inline T Length() const { return IvSqrt( LengthSquared() ); }
+
+    // comparison
+    inline bool operator==( const IvFixedVector3& other ) const
+    {
+        return x == other.x && y == other.y && z == other.z;
+    }
+    inline bool operator!=( const IvFixedVector3& other ) const { return !(*this == other); }
+    inline bool IsZero() const { return x.IsZero() && y.IsZero() && z.IsZero(); }
+
+    // manipulators
+    inline void Set( const T& _x, const T& _y, const T& _z ) { x = _x; y = _y; z = _z; }
+    inline void Zero() { x = y = z = T(); }
+    void Normalize();   // sets to unit vector
+
+    // operators
+
+    // addition/subtraction
+    inline IvFixedVector3 operator+( const IvFixedVector3& other ) const
+    {
+        return IvFixedVector3( x + other.x, y + other.y, z + other.z );
+    }
+    inline IvFixedVector3& operator+=( const IvFixedVector3& other )
+    {
+        x += other.x; y += other.y; z += other.z;
+        return *this;
+    }
+    inline IvFixedVector3 operator-( const IvFixedVector3& other ) const
+    {
+        return IvFixedVector3( x - other.x, y - other.y, z - other.z );
+    }
+    inline IvFixedVector3& operator-=( const IvFixedVector3& other )
+    {
+        x -= other.x; y -= other.y; z -= other.z;
+        return *this;
+    }
+
+    inline IvFixedVector3 operator-() const { return IvFixedVector3( -x, -y, -z ); }
+
+    // scalar multiplication
+    inline IvFixedVector3 operator*( const T& scalar ) const
+    {
+        return IvFixedVector3( scalar*x, scalar*y, scalar*z );
+    }
+    friend inline IvFixedVector3 operator*( const T& scalar, const IvFixedVector3& vector )
+    {
+        return vector*scalar;
+    }
+    inline IvFixedVector3& operator*=( const T& scalar )
+    {
+        x *= scalar; y *= scalar; z *= scalar;
+        return *this;
+    }
+
+    // dot product/cross product
+    inline T Dot( const IvFixedVector3& vector ) const
+    {
+        return x*vector.x + y*vector.y + z*vector.z;
+    }
+    friend inline T Dot( const IvFixedVector3& vector1, const IvFixedVector3& vector2 )
+    {
+        return vector1.Dot( vector2 );
+    }
+    inline IvFixedVector3 Cross( const IvFixedVector3& vector ) const
+    {
+        return IvFixedVector3( y*vector.z - z*vector.y,
+                               z*vector.x - x*vector.z,
+                               x*vector.y - y*vector.x );
+    }
+
+    // member variables
+    T x, y, z;
+
+protected:
+
+private:
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvFixedVector3::Normalize()
+//-------------------------------------------------------------------------------
+// Set to unit vector
+//-------------------------------------------------------------------------------
+template <class T>
+inline void
+IvFixedVector3<T>::Normalize()
+{
+    T length = Length();
+
+    if ( length.IsZero() )
+    {
+        Zero();
+    }
+    else
+    {
+        x /= length;
+        y /= length;
+        z /= length;
+    }
+
+}   // End of IvFixedVector3::Normalize()
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// batch dot products of count pairs
+// the IvFixed16 version uses SSE2 and matches Dot() bit for bit
+extern void Dot( IvFixed16* result, const IvFixedVector3<IvFixed16>* a,
+                 const IvFixedVector3<IvFixed16>* b, unsigned int count );
+extern void Dot( IvFixed32* result, const IvFixedVector3<IvFixed32>* a,
+                 const IvFixedVector3<IvFixed32>* b, unsigned int count );
+
+#endif
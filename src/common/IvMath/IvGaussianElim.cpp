@@ -1,6 +1,6 @@
 //----------------------------------------------------------------------------
 // @ IvGaussianElim.cpp
-// 
+//
 // Function to perform solve linear system using Gaussian elimination
 // ------------------------------------------------------------------------------
 // Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
@@ -11,6 +11,10 @@
 //
 // Implementation notes:
 //     Matrix must be stored in column major order
+//
+//     All the routines are built on an LU factorization with partial
+//     pivoting, which is Gaussian elimination with the multipliers kept
+//     around.  Inner loops run down columns, so they stay in contiguous memory.
 //===============================================================================
 
 //----------------------------------------------------------------------------
@@ -22,32 +26,66 @@
 #include "IvGaussianElim.h"
 #include "IvMath.h"
 #include "IvDebugger.h"
+#include "IvSIMD.h"
+
+//----------------------------------------------------------------------------
+//-- Static Members ----------------------------------------------------------
+//----------------------------------------------------------------------------
+
+// matrices larger than this are factored in blocks of kLUBlockSize columns;
+// the trailing update then works on kLURowBlock rows at a time, so the
+// block's multipliers stay in cache while they are reused across columns
+static const unsigned int kLUBlockedSize = 64;
+static const unsigned int kLUBlockSize = 32;
+static const unsigned int kLURowBlock = 128;
+
+// largest system solved in SIMD lanes by SolveBatch()
+static const unsigned int kBatchMaxSize = 16;
 
 //----------------------------------------------------------------------------
 //-- Functions ---------------------------------------------------------------
 //----------------------------------------------------------------------------
 
 //-------------------------------------------------------------------------------
-// @ ::Solve()
+// @ IvSwapRows()
 //-------------------------------------------------------------------------------
-// Perform Gaussian elimination to solve linear system
-// Will destroy original values of A and b
-// Result is returned in b
+// Exchange two rows within columns [begin, end)
 //-------------------------------------------------------------------------------
-bool 
-Solve( float* b, float* A, unsigned int n )
+static inline void
+IvSwapRows( float* A, unsigned int n, unsigned int row0, unsigned int row1,
+            unsigned int begin, unsigned int end )
+{
+    for ( unsigned int col = begin; col < end; ++col )
+    {
+        float temp = A[ row0 + n*col ];
+        A[ row0 + n*col ] = A[ row1 + n*col ];
+        A[ row1 + n*col ] = temp;
+    }
+
+}   // End of IvSwapRows()
+
+
+//-------------------------------------------------------------------------------
+// @ IvLUFactorPanel()
+//-------------------------------------------------------------------------------
+// Unblocked LU factorization of columns [k0, k0+width), all rows below k0.
+// Row exchanges are only applied within these columns.
+//-------------------------------------------------------------------------------
+static bool
+IvLUFactorPanel( float* A, unsigned int* pivots, unsigned int n, unsigned int k0,
+                 unsigned int width )
 {
-    // do one pass for each diagonal element
-    for ( unsigned int pivot = 0; pivot < n; ++pivot )
+    unsigned int end = k0 + width;
+    for ( unsigned int k = k0; k < end; ++k )
     {
-        unsigned int row, col;  // counters
+        float* column = A + n*k;
 
         // find the largest magnitude element in the current column
-        unsigned int maxrow = pivot;
-        float maxelem = ::IvAbs( A[ maxrow + n*pivot ] );
-        for ( row = pivot+1; row < n; ++row )
+        unsigned int maxrow = k;
+        float maxelem = IvAbs( column[k] );
+        for ( unsigned int row = k+1; row < n; ++row )
         {
-            float elem = ::IvAbs( A[ row + n*pivot ] );
+            float elem = IvAbs( column[row] );
             if ( elem > maxelem )
             {
                 maxelem = elem;
@@ -57,179 +95,246 @@ Solve( float* b, float* A, unsigned int n )
 
         // if max is zero, stop!
         if ( IvIsZero( maxelem ) )
-        {
-            ERROR_OUT( "::Solve() -- singular matrix\n" );
             return false;
-        }
 
         // if not in the current row, swap rows
-        if ( maxrow != pivot )
-        {
-            float temp;
-            // swap the row
-            for ( col = 0; col < n; ++col )
-            {
-                temp = A[ maxrow + n*col ];
-                A[ maxrow + n*col ] = A[ pivot + n*col ];
-                A[ pivot + n*col ] = temp;
-            }
-            // swap elements in solution vector
-            temp = b[ maxrow ];
-            b[ maxrow ] = b[ pivot ];
-            b[ pivot ] = temp;
-        }
-       
-        // multiply current row by 1/pivot to "set" pivot to 1
-        float pivotRecip = 1.0f/A[ n*pivot + pivot ];
-        for ( col = 0; col < n; ++col )
+        pivots[k] = maxrow;
+        if ( maxrow != k )
+            IvSwapRows( A, n, k, maxrow, k0, end );
+
+        // store multipliers below the pivot
+        float pivotRecip = 1.0f/column[k];
+        for ( unsigned int row = k+1; row < n; ++row )
         {
-            A[ pivot + n*col ] *= pivotRecip;
+            column[row] *= pivotRecip;
         }
-        b[ pivot ] *= pivotRecip;
-
-        // Set pivot to exactly 1, to be sure
-        A[pivot + n*pivot] = 1.0f;
 
-        // now zero out pivot column in other rows 
-        for ( row = pivot+1; row < n; ++row )
+        // subtract multiples of the pivot row from the rest of the panel
+        for ( unsigned int col = k+1; col < end; ++col )
         {
-            // subtract multiple of pivot row from current row,
-            // such that pivot column element becomes 0
-            float factor = A[ row + n*pivot ];
-
-            // subtract multiple of row
-            for ( col = 0; col < n; ++col )
+            float* target = A + n*col;
+            float factor = target[k];
+            for ( unsigned int row = k+1; row < n; ++row )
             {
-                A[ row + n*col ] -= factor*A[ pivot + n*col ];   
+                target[row] -= factor*column[row];
             }
-            b[ row ] -= factor*b[ pivot ];
         }
     }
 
-    // done, do backwards substitution 
-    unsigned int p = n-1;
-    do
-    {
-        --p;
-        // subtract multiples of other known entities
-        for ( unsigned int col = p+1; col < n; ++col )
-        {
-            b[p] -= A[ p + n*col ]*b[col];
-        }
-    }
-    while (p > 0); 
-
     return true;
-}
+
+}   // End of IvLUFactorPanel()
 
 
 //-------------------------------------------------------------------------------
-// @ ::InvertMatrix()
+// @ ::LUFactor()
 //-------------------------------------------------------------------------------
-// Invert matrix using Gaussian elimination
+// Factor matrix into lower and upper triangular parts, with row exchanges
 //-------------------------------------------------------------------------------
 bool
-InvertMatrix( float* A, unsigned int n )
+LUFactor( float* A, unsigned int* pivots, unsigned int n )
 {
-    unsigned int* swap;       // which row have we swapped with the current one?
-    swap = new unsigned int[n];
+    if ( n <= kLUBlockedSize )
+        return IvLUFactorPanel( A, pivots, n, 0, n );
 
-    // do one pass for each diagonal element
-    for ( unsigned int pivot = 0; pivot < n; ++pivot )
+    for ( unsigned int k0 = 0; k0 < n; k0 += kLUBlockSize )
     {
-        unsigned int row, col;  // counters
+        unsigned int width = (n - k0 < kLUBlockSize) ? n - k0 : kLUBlockSize;
+        unsigned int end = k0 + width;
 
-        // find the largest magnitude element in the current column
-        unsigned int maxrow = pivot;
-        float maxelem = IvAbs( A[ maxrow + n*pivot ] );
-        for ( row = pivot+1; row < n; ++row )
+        // factor this block of columns
+        if ( !IvLUFactorPanel( A, pivots, n, k0, width ) )
+            return false;
+
+        // apply its row exchanges to the columns on either side
+        for ( unsigned int k = k0; k < end; ++k )
         {
-            float elem = IvAbs( A[ row + n*pivot ] );
-            if ( elem > maxelem )
+            if ( pivots[k] != k )
             {
-                maxelem = elem;
-                maxrow = row;
+                IvSwapRows( A, n, k, pivots[k], 0, k0 );
+                IvSwapRows( A, n, k, pivots[k], end, n );
             }
         }
 
-        // if max is zero, stop!
-        if ( IvIsZero( maxelem ) )
+        if ( end == n )
+            break;
+
+        // compute the block row of U to the right, by forward substitution
+        for ( unsigned int col = end; col < n; ++col )
         {
-            ERROR_OUT( "::Inverse() -- singular matrix\n" );
-            delete [] swap;
-            return false;
+            float* target = A + n*col;
+            for ( unsigned int k = k0; k < end; ++k )
+            {
+                const float* column = A + n*k;
+                float factor = target[k];
+                for ( unsigned int row = k+1; row < end; ++row )
+                {
+                    target[row] -= factor*column[row];
+                }
+            }
         }
 
-        // if not in the current row, swap rows
-        swap[pivot] = maxrow;
-        if ( maxrow != pivot )
+        // update the trailing matrix with the product of the block
+        // column of L and the block row of U
+        for ( unsigned int row0 = end; row0 < n; row0 += kLURowBlock )
         {
-            // swap the row
-            for ( col = 0; col < n; ++col )
+            unsigned int rowEnd = (n - row0 < kLURowBlock) ? n : row0 + kLURowBlock;
+            for ( unsigned int col = end; col < n; ++col )
             {
-                float temp = A[ maxrow + n*col ];
-                A[ maxrow + n*col ] = A[ pivot + n*col ];
-                A[ pivot + n*col ] = temp;
+                float* target = A + n*col;
+                for ( unsigned int k = k0; k < end; ++k )
+                {
+                    const float* column = A + n*k;
+                    float factor = target[k];
+                    for ( unsigned int row = row0; row < rowEnd; ++row )
+                    {
+                        target[row] -= factor*column[row];
+                    }
+                }
             }
         }
-       
-        // multiply current row by 1/pivot to "set" pivot to 1
-        float pivotRecip = 1.0f/A[ n*pivot + pivot ];
-        for ( col = 0; col < n; ++col )
+    }
+
+    return true;
+
+}   // End of ::LUFactor()
+
+
+//-------------------------------------------------------------------------------
+// @ ::LUSolve()
+//-------------------------------------------------------------------------------
+// Solve for one or more right-hand sides by forward and back substitution
+// Result is returned in b
+//-------------------------------------------------------------------------------
+void
+LUSolve( float* b, const float* LU, const unsigned int* pivots, unsigned int n,
+         unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        float* x = b + n*i;
+
+        // apply row exchanges
+        for ( unsigned int k = 0; k < n; ++k )
         {
-            A[ pivot + n*col ] *= pivotRecip;
+            if ( pivots[k] != k )
+            {
+                float temp = x[ pivots[k] ];
+                x[ pivots[k] ] = x[k];
+                x[k] = temp;
+            }
         }
 
-        // copy 1/pivot to pivot point (doing inverse in place)
-        A[pivot + n*pivot] = pivotRecip;
-
-        // now zero out pivot column in other rows 
-        for ( row = 0; row < n; ++row )
+        // solve Ly = Pb
+        for ( unsigned int k = 0; k < n; ++k )
         {
-            // don't subtract from pivot row
-            if ( row == pivot )
-                continue;
-               
-            // subtract multiple of pivot row from current row,
-            // such that pivot column element becomes 0
-            float factor = A[ row + n*pivot ];
-
-            // clear pivot column element (doing inverse in place)
-            // will end up setting this element to -factor*pivotInverse
-            A[ row + n*pivot ] = 0.0f;
-            
-            // subtract multiple of row
-            for ( col = 0; col < n; ++col )
+            const float* column = LU + n*k;
+            float factor = x[k];
+            for ( unsigned int row = k+1; row < n; ++row )
             {
-                A[ row + n*col ] -= factor*A[ pivot + n*col ];   
+                x[row] -= factor*column[row];
             }
         }
-    }
 
-    // done, undo swaps in column direction, in reverse order
-    unsigned int p = n;
-    do
-    {
-        --p;
-        // if row has been swapped
-        if (swap[p] != p)
+        // solve Ux = y
+        unsigned int k = n;
+        while ( k > 0 )
         {
-            // swap the corresponding column
-            for ( unsigned int row = 0; row < n; ++row )
+            --k;
+            const float* column = LU + n*k;
+            x[k] /= column[k];
+            float factor = x[k];
+            for ( unsigned int row = 0; row < k; ++row )
             {
-                float temp = A[ row + n*swap[p] ];
-                A[ row + n*swap[p] ] = A[ row + n*p ];
-                A[ row + n*p ] = temp;
+                x[row] -= factor*column[row];
             }
         }
     }
-    while (p > 0);
 
-    delete [] swap;
+}   // End of ::LUSolve()
+
+
+//-------------------------------------------------------------------------------
+// @ ::LUDeterminant()
+//-------------------------------------------------------------------------------
+// Product of the diagonal of U, negated for each row exchange
+//-------------------------------------------------------------------------------
+float
+LUDeterminant( const float* LU, const unsigned int* pivots, unsigned int n )
+{
+    float det = 1.0f;
+    for ( unsigned int k = 0; k < n; ++k )
+    {
+        det *= LU[ k + n*k ];
+        if ( pivots[k] != k )
+            det = -det;
+    }
+
+    return det;
+
+}   // End of ::LUDeterminant()
+
+
+//-------------------------------------------------------------------------------
+// @ ::Solve()
+//-------------------------------------------------------------------------------
+// Perform Gaussian elimination to solve linear system
+// Will destroy original values of A and b
+// Result is returned in b
+//-------------------------------------------------------------------------------
+bool
+Solve( float* b, float* A, unsigned int n )
+{
+    unsigned int* pivots = new unsigned int[n];
+
+    if ( !LUFactor( A, pivots, n ) )
+    {
+        ERROR_OUT( "::Solve() -- singular matrix\n" );
+        delete [] pivots;
+        return false;
+    }
+    LUSolve( b, A, pivots, n );
+
+    delete [] pivots;
 
     return true;
 
-}   // End of IvMatrix33::Inverse()
+}   // End of ::Solve()
+
+
+//-------------------------------------------------------------------------------
+// @ ::InvertMatrix()
+//-------------------------------------------------------------------------------
+// Invert matrix by factoring it, then solving for each column of the identity
+//-------------------------------------------------------------------------------
+bool
+InvertMatrix( float* A, unsigned int n )
+{
+    float* LU = new float[n*n];
+    unsigned int* pivots = new unsigned int[n];
+    memcpy( LU, A, sizeof(float)*n*n );
+
+    if ( !LUFactor( LU, pivots, n ) )
+    {
+        ERROR_OUT( "::Inverse() -- singular matrix\n" );
+        delete [] pivots;
+        delete [] LU;
+        return false;
+    }
+
+    memset( A, 0, sizeof(float)*n*n );
+    for ( unsigned int i = 0; i < n; ++i )
+    {
+        A[ i + n*i ] = 1.0f;
+    }
+    LUSolve( A, LU, pivots, n, n );
+
+    delete [] pivots;
+    delete [] LU;
+
+    return true;
+
+}   // End of ::InvertMatrix()
 
 
 //-------------------------------------------------------------------------------
@@ -237,89 +342,213 @@ InvertMatrix( float* A, unsigned int n )
 //-------------------------------------------------------------------------------
 // Get determinant of matrix
 // Uses Gaussian elimination to create an upper triangular matrix,
-// multiplies diagonal to get intermediate value, then adjusts by row operations
+// then multiplies diagonal, adjusted for row exchanges
 // Will not destroy A
 //-------------------------------------------------------------------------------
-float 
+float
 Determinant( float* A, unsigned int n )
 {
     // copy the original matrix
     float* copy = new float[n*n];
+    unsigned int* pivots = new unsigned int[n];
     memcpy( copy, A, sizeof(float)*n*n );
 
-    // initial value for determinant
-    float det = 1.0f;
+    // singular matrix, determinant is 0
+    float det = 0.0f;
+    if ( LUFactor( copy, pivots, n ) )
+        det = LUDeterminant( copy, pivots, n );
 
-    // do one pass for each diagonal element
-    for ( unsigned int pivot = 0; pivot < n; ++pivot )
-    {
-        unsigned int row, col;  // counters
+    delete [] pivots;
+    delete [] copy;
+
+    return det;
+
+}   // End of ::Determinant()
+
+
+#if defined(IV_SSE2)
+#if defined(IV_AVX)
+typedef __m256 IvLanes;
+static const unsigned int kWidth = 8;
+#else
+typedef __m128 IvLanes;
+static const unsigned int kWidth = 4;
+#endif
 
+//-------------------------------------------------------------------------------
+// @ IvSolveLanes()
+//-------------------------------------------------------------------------------
+// Solve kWidth systems at once, one per lane, using the same elimination
+// and pivoting as LUFactor() and LUSolve().  Since lanes may choose
+// different pivot rows, row exchanges are done with selects.  Lanes that
+// turn out to be singular carry on with a unit pivot, and are masked out
+// of the result.
+//-------------------------------------------------------------------------------
+static IvLanes
+IvSolveLanes( IvLanes* a, IvLanes* x, unsigned int n )
+{
+    const IvLanes zero = IvBroadcast<IvLanes>( 0.0f );
+    const IvLanes one = IvBroadcast<IvLanes>( 1.0f );
+    const IvLanes signMask = IvBroadcast<IvLanes>( -0.0f );
+    const IvLanes epsilon = IvBroadcast<IvLanes>( kEpsilon );
+    IvLanes solved = IvCmpEq( zero, zero );
+
+    IvLanes pivotRecip[kBatchMaxSize];
+    for ( unsigned int k = 0; k < n; ++k )
+    {
         // find the largest magnitude element in the current column
-        unsigned int maxrow = pivot;
-        float maxelem = IvAbs( copy[ maxrow + n*pivot ] );
-        for ( row = pivot+1; row < n; ++row )
+        IvLanes maxelem = IvAndNot( signMask, a[ k + n*k ] );
+        IvLanes maxrow = IvBroadcast<IvLanes>( (float)k );
+        for ( unsigned int row = k+1; row < n; ++row )
         {
-            float elem = IvAbs( copy[ row + n*pivot ] );
-            if ( elem > maxelem )
-            {
-                maxelem = elem;
-                maxrow = row;
-            }
+            IvLanes elem = IvAndNot( signMask, a[ row + n*k ] );
+            IvLanes larger = IvCmpLt( maxelem, elem );
+            maxelem = IvSelect( larger, elem, maxelem );
+            maxrow = IvSelect( larger, IvBroadcast<IvLanes>( (float)row ), maxrow );
         }
+        IvLanes nonsingular = IvCmpLt( epsilon, maxelem );
+        solved = IvAnd( solved, nonsingular );
 
-        // if max is zero, stop!
-        if ( IvIsZero( maxelem ) )
+        // swap rows where needed
+        for ( unsigned int row = k+1; row < n; ++row )
         {
-            // singular matrix, determinant is 0
-            delete [] copy;
-            return 0.0f;
+            IvLanes swap = IvCmpEq( maxrow, IvBroadcast<IvLanes>( (float)row ) );
+            if ( !IvMoveMask( swap ) )
+                continue;
+            for ( unsigned int col = k; col < n; ++col )
+            {
+                IvLanes temp = a[ k + n*col ];
+                a[ k + n*col ] = IvSelect( swap, a[ row + n*col ], temp );
+                a[ row + n*col ] = IvSelect( swap, temp, a[ row + n*col ] );
+            }
+            IvLanes temp = x[k];
+            x[k] = IvSelect( swap, x[row], temp );
+            x[row] = IvSelect( swap, temp, x[row] );
         }
 
-        // if not in the current row, swap rows
-        if ( maxrow != pivot )
+        // eliminate below the pivot
+        pivotRecip[k] = IvDiv( one, IvSelect( nonsingular, a[ k + n*k ], one ) );
+        for ( unsigned int row = k+1; row < n; ++row )
         {
-            float temp;
-            // swap the row
-            for ( col = 0; col < n; ++col )
+            IvLanes factor = IvSub( zero, IvMul( a[ row + n*k ], pivotRecip[k] ) );
+            for ( unsigned int col = k+1; col < n; ++col )
             {
-                temp = copy[ maxrow + n*col ];
-                copy[ maxrow + n*col ] = copy[ pivot + n*col ];
-                copy[ pivot + n*col ] = temp;
+                a[ row + n*col ] = IvMulAdd( factor, a[ k + n*col ], a[ row + n*col ] );
             }
-            // negate determinant
-            det = -det;
+            x[row] = IvMulAdd( factor, x[k], x[row] );
         }
-       
-        // multiply current row by 1/pivot to "set" pivot to 1
-        float pivotRecip = 1.0f/copy[ pivot + n*pivot ];
-        for ( col = 0; col < n; ++col )
+    }
+
+    // back substitution
+    unsigned int k = n;
+    while ( k > 0 )
+    {
+        --k;
+        IvLanes sum = x[k];
+        for ( unsigned int col = k+1; col < n; ++col )
         {
-            copy[ pivot + n*col ] *= pivotRecip;
+            sum = IvSub( sum, IvMul( a[ k + n*col ], x[col] ) );
         }
-        det *= pivotRecip;
+        x[k] = IvMul( sum, pivotRecip[k] );
+    }
 
-        // Set pivot to exactly 1, to be sure
-        copy[ pivot + n*pivot] = 1.0f;
+    return solved;
 
-        // now zero out pivot column in other rows 
-        for ( row = pivot+1; row < n; ++row )
+}   // End of IvSolveLanes()
+#endif
+
+
+//-------------------------------------------------------------------------------
+// @ ::SolveBatch()
+//-------------------------------------------------------------------------------
+// Solve many independent linear systems
+//-------------------------------------------------------------------------------
+bool
+SolveBatch( float* b, const float* A, unsigned int n, unsigned int count, bool* solved )
+{
+    bool allSolved = true;
+    unsigned int i = 0;
+
+#if defined(IV_SSE2)
+    if ( n <= kBatchMaxSize )
+    {
+        IvLanes a[kBatchMaxSize*kBatchMaxSize];
+        IvLanes x[kBatchMaxSize];
+        IvLanes original[kBatchMaxSize];
+        IV_ALIGN(32) float lanes[kWidth];
+
+        for ( ; i < count; i += kWidth )
         {
-            // subtract multiple of pivot row from current row,
-            // such that pivot column element becomes 0
-            float factor = copy[ row + n*pivot ];
+            // gather one system per lane; pad the last group with identity systems
+            unsigned int groupCount = (count - i < kWidth) ? count - i : kWidth;
+            for ( unsigned int e = 0; e < n*n; ++e )
+            {
+                const float* element = A + i*n*n + e;
+                for ( unsigned int lane = 0; lane < groupCount; ++lane )
+                {
+                    lanes[lane] = element[ lane*n*n ];
+                }
+                for ( unsigned int lane = groupCount; lane < kWidth; ++lane )
+                {
+                    lanes[lane] = (e % (n+1) == 0) ? 1.0f : 0.0f;
+                }
+                a[e] = IvLoad<IvLanes>( lanes );
+            }
+            for ( unsigned int e = 0; e < n; ++e )
+            {
+                const float* element = b + i*n + e;
+                for ( unsigned int lane = 0; lane < groupCount; ++lane )
+                {
+                    lanes[lane] = element[ lane*n ];
+                }
+                for ( unsigned int lane = groupCount; lane < kWidth; ++lane )
+                {
+                    lanes[lane] = 0.0f;
+                }
+                x[e] = original[e] = IvLoad<IvLanes>( lanes );
+            }
+
+            IvLanes mask = IvSolveLanes( a, x, n );
 
-            // subtract multiple of row
-            for ( col = 0; col < n; ++col )
+            // scatter results, keeping the original b for singular systems
+            for ( unsigned int e = 0; e < n; ++e )
             {
-                copy[ row + n*col ] -= factor*copy[ pivot + n*col ];   
+                IvStore( lanes, IvSelect( mask, x[e], original[e] ) );
+                for ( unsigned int lane = 0; lane < groupCount; ++lane )
+                {
+                    b[ (i + lane)*n + e ] = lanes[lane];
+                }
+            }
+            IvStore( lanes, IvAnd( mask, IvBroadcast<IvLanes>( 1.0f ) ) );
+            for ( unsigned int lane = 0; lane < groupCount; ++lane )
+            {
+                bool laneSolved = (lanes[lane] != 0.0f);
+                allSolved = allSolved && laneSolved;
+                if ( solved )
+                    solved[i + lane] = laneSolved;
             }
         }
+        return allSolved;
     }
+#endif
 
-    delete [] copy;
+    // one system at a time
+    float* LU = new float[n*n];
+    unsigned int* pivots = new unsigned int[n];
+    for ( ; i < count; ++i )
+    {
+        memcpy( LU, A + i*n*n, sizeof(float)*n*n );
+        bool systemSolved = LUFactor( LU, pivots, n );
+        if ( systemSolved )
+            LUSolve( b + i*n, LU, pivots, n );
+
+        allSolved = allSolved && systemSolved;
+        if ( solved )
+            solved[i] = systemSolved;
+    }
+    delete [] pivots;
+    delete [] LU;
 
-    // invert to get final determinant
-    return 1.0f/det;
+    return allSolved;
 
-}   // End of IvMatrix33::Determinant()
+}   // End of ::SolveBatch()
@@ -37,4 +37,29 @@ bool InvertMatrix( float* A, unsigned int n );
 // Will not destroy A
 float Determinant( float* A, unsigned int n );
 
+// factor n by n matrix A into PA = LU, using partial pivoting
+// will store L (with implicit unit diagonal) and U in A, and the row
+// exchanged with each row k in pivots[k]
+// large matrices are factored in cache-sized blocks
+bool LUFactor( float* A, unsigned int* pivots, unsigned int n );
+
+// solve Ax = b for count right-hand sides, using the results of LUFactor()
+// b holds the right-hand sides one after another (an n by count matrix)
+// and will be replaced with the solutions
+void LUSolve( float* b, const float* LU, const unsigned int* pivots, unsigned int n,
+              unsigned int count = 1 );
+
+// get determinant from the results of LUFactor()
+float LUDeterminant( const float* LU, const unsigned int* pivots, unsigned int n );
+
+// solve count independent n by n systems A_i x_i = b_i
+// A holds the matrices one after another (n*n floats each), b the
+// right-hand sides (n floats each); results are returned in b
+// will not destroy A; b is left unchanged for singular systems
+// if solved is non-null, solved[i] is set to whether system i was solved
+// returns true if all systems were solved
+// small systems are solved several at a time using SIMD
+bool SolveBatch( float* b, const float* A, unsigned int n, unsigned int count,
+                 bool* solved = 0 );
+
 #endif
@@ -22,6 +22,7 @@
 #include "IvMatrix33.h"
 #include "IvQuat.h"
 #include "IvVector3.h"
+#include "IvSIMD.h"
 
 //----------------------------------------------------------------------------
 //-- Static Variables --------------------------------------------------------
@@ -31,6 +32,17 @@
 //-- Functions ---------------------------------------------------------------
 //----------------------------------------------------------------------------
 
+// Register type for the batched distance
+#if defined(IV_AVX)
+#define IV_SEGMENT_SIMD
+typedef __m256 IvLanes;
+static const unsigned int kWidth = 8;
+#elif defined(IV_SSE2)
+#define IV_SEGMENT_SIMD
+typedef __m128 IvLanes;
+static const unsigned int kWidth = 4;
+#endif
+
 //----------------------------------------------------------------------------
 // @ IvLineSegment3::IvLineSegment3()
 // ---------------------------------------------------------------------------
@@ -335,6 +347,152 @@ DistanceSquared( const IvLineSegment3& segment0, const IvLineSegment3& segment1,
 }   // End of DistanceSquared()
 
 
+#if defined(IV_SEGMENT_SIMD)
+//----------------------------------------------------------------------------
+// @ DistanceSquaredLanes()
+// ---------------------------------------------------------------------------
+// Segment-segment distance for kWidth pairs, following the scalar version
+// with each clamp done as a select.  Degenerate segments give a parameter
+// of 0 rather than dividing by zero.
+//-----------------------------------------------------------------------------
+static inline IvLanes
+DistanceSquaredLanes( IvLanes& s_c, IvLanes& t_c, const IvLanes* p )
+{
+    const IvLanes zero = IvBroadcast<IvLanes>( 0.0f );
+    const IvLanes one = IvBroadcast<IvLanes>( 1.0f );
+    const IvLanes epsilon = IvBroadcast<IvLanes>( kEpsilon );
+
+    // p holds origin0, direction0, origin1, direction1, x/y/z each
+    IvLanes w0x = IvSub( p[0], p[6] ), w0y = IvSub( p[1], p[7] ), w0z = IvSub( p[2], p[8] );
+    IvLanes a = IvMulAdd( p[5], p[5], IvMulAdd( p[4], p[4], IvMul( p[3], p[3] ) ) );
+    IvLanes b = IvMulAdd( p[5], p[11], IvMulAdd( p[4], p[10], IvMul( p[3], p[9] ) ) );
+    IvLanes c = IvMulAdd( p[11], p[11], IvMulAdd( p[10], p[10], IvMul( p[9], p[9] ) ) );
+    IvLanes d = IvMulAdd( p[5], w0z, IvMulAdd( p[4], w0y, IvMul( p[3], w0x ) ) );
+    IvLanes e = IvMulAdd( p[11], w0z, IvMulAdd( p[10], w0y, IvMul( p[9], w0x ) ) );
+
+    // if denom is zero, use closest point on segment1 to origin0
+    IvLanes denom = IvSub( IvMul( a, c ), IvMul( b, b ) );
+    IvLanes parallel = IvAnd( IvCmpLt( denom, epsilon ), IvCmpLt( IvSub( zero, epsilon ), denom ) );
+    IvLanes sn = IvSelect( parallel, zero, IvSub( IvMul( b, e ), IvMul( c, d ) ) );
+    IvLanes tn = IvSelect( parallel, e, IvSub( IvMul( a, e ), IvMul( b, d ) ) );
+    IvLanes sd = IvSelect( parallel, c, denom );
+    IvLanes td = sd;
+
+    // clamp s_c to 0
+    IvLanes clamp = IvCmpLt( sn, zero );
+    sn = IvSelect( clamp, zero, sn );
+    tn = IvSelect( clamp, e, tn );
+    td = IvSelect( clamp, c, td );
+    // clamp s_c to 1
+    clamp = IvCmpLt( sd, sn );
+    sn = IvSelect( clamp, sd, sn );
+    tn = IvSelect( clamp, IvAdd( e, b ), tn );
+    td = IvSelect( clamp, c, td );
+
+    // s_c for t_c clamped to 0 or 1, clamped in turn to [0,1]
+    IvLanes tLow = IvCmpLt( tn, zero );
+    IvLanes tHigh = IvAndNot( tLow, IvCmpLt( td, tn ) );
+    IvLanes sNum = IvSelect( tHigh, IvSub( b, d ), IvSub( zero, d ) );
+    IvLanes aPositive = IvCmpLt( zero, a );
+    IvLanes sClamped = IvDiv( sNum, IvSelect( aPositive, a, one ) );
+    sClamped = IvAnd( aPositive, IvMin( IvMax( sClamped, zero ), one ) );
+
+    // otherwise the unclamped ratios
+    IvLanes sRatio = IvAnd( IvCmpLt( zero, sd ), IvDiv( sn, IvSelect( IvCmpLt( zero, sd ), sd, one ) ) );
+    IvLanes tRatio = IvAnd( IvCmpLt( zero, td ), IvDiv( tn, IvSelect( IvCmpLt( zero, td ), td, one ) ) );
+
+    IvLanes tClamped = IvOr( tLow, tHigh );
+    s_c = IvSelect( tClamped, sClamped, sRatio );
+    t_c = IvSelect( tLow, zero, IvSelect( tHigh, one, tRatio ) );
+
+    // compute difference vector and distance squared
+    IvLanes wcx = IvSub( IvMulAdd( s_c, p[3], w0x ), IvMul( t_c, p[9] ) );
+    IvLanes wcy = IvSub( IvMulAdd( s_c, p[4], w0y ), IvMul( t_c, p[10] ) );
+    IvLanes wcz = IvSub( IvMulAdd( s_c, p[5], w0z ), IvMul( t_c, p[11] ) );
+    return IvMulAdd( wcz, wcz, IvMulAdd( wcy, wcy, IvMul( wcx, wcx ) ) );
+
+}   // End of DistanceSquaredLanes()
+#endif
+
+
+//----------------------------------------------------------------------------
+// @ DistanceSquared()
+// ---------------------------------------------------------------------------
+// Returns the distance squared between count pairs of line segments, and
+// optionally the parameters of the closest points.
+//-----------------------------------------------------------------------------
+void
+DistanceSquared( float* result, float* s_c, float* t_c,
+                 const IvLineSegment3* segments0, const IvLineSegment3* segments1,
+                 unsigned int count )
+{
+    unsigned int i = 0;
+#if defined(IV_SEGMENT_SIMD)
+    IV_ALIGN(32) float lanes[12][kWidth];
+    IV_ALIGN(32) float out[3][kWidth];
+    IvLanes p[12];
+    for ( ; i < count; i += kWidth )
+    {
+        // gather, padding the last group with copies of the first pair
+        unsigned int groupCount = (count - i < kWidth) ? count - i : kWidth;
+        for ( unsigned int lane = 0; lane < kWidth; ++lane )
+        {
+            unsigned int j = (lane < groupCount) ? i + lane : i;
+            const IvLineSegment3& segment0 = segments0[j];
+            const IvLineSegment3& segment1 = segments1[j];
+            for ( unsigned int k = 0; k < 3; ++k )
+            {
+                lanes[k][lane] = segment0.mOrigin[k];
+                lanes[k+3][lane] = segment0.mDirection[k];
+                lanes[k+6][lane] = segment1.mOrigin[k];
+                lanes[k+9][lane] = segment1.mDirection[k];
+            }
+        }
+        for ( unsigned int k = 0; k < 12; ++k )
+        {
+            p[k] = IvLoad<IvLanes>( lanes[k] );
+        }
+
+        IvLanes s, t;
+        IvLanes distance = DistanceSquaredLanes( s, t, p );
+        if ( groupCount == kWidth )
+        {
+            IvStoreU( result + i, distance );
+            if ( s_c )
+                IvStoreU( s_c + i, s );
+            if ( t_c )
+                IvStoreU( t_c + i, t );
+        }
+        else
+        {
+            IvStore( out[0], distance );
+            IvStore( out[1], s );
+            IvStore( out[2], t );
+            for ( unsigned int lane = 0; lane < groupCount; ++lane )
+            {
+                result[i + lane] = out[0][lane];
+                if ( s_c )
+                    s_c[i + lane] = out[1][lane];
+                if ( t_c )
+                    t_c[i + lane] = out[2][lane];
+            }
+        }
+    }
+#else
+    float s, t;
+    for ( ; i < count; ++i )
+    {
+        result[i] = DistanceSquared( segments0[i], segments1[i], s, t );
+        if ( s_c )
+            s_c[i] = s;
+        if ( t_c )
+            t_c[i] = t;
+    }
+#endif
+
+}   // End of DistanceSquared()
+
+
 //----------------------------------------------------------------------------
 // @ DistanceSquared()
 // ---------------------------------------------------------------------------
@@ -36,6 +36,9 @@ class IvLineSegment3;
 
 float DistanceSquared( const IvLineSegment3& seg0, const IvLineSegment3& seg1,
                       float& s_c, float& t_c );
+void DistanceSquared( float* result, float* s_c, float* t_c,
+                      const IvLineSegment3* segments0, const IvLineSegment3* segments1,
+                      unsigned int count );
 float DistanceSquared( const IvLineSegment3& segment, const IvRay3& ray,
                        float& s_c, float& t_c );
 float DistanceSquared( const IvLineSegment3& segment, const IvLine3& line, 
@@ -92,6 +95,11 @@ public:
     friend float DistanceSquared( const IvLineSegment3& segment0, 
                                   const IvLineSegment3& segment1, 
                                   float& s_c, float& t_c );
+    // batch version for count pairs -- s_c and t_c may be null
+    friend void DistanceSquared( float* result, float* s_c, float* t_c,
+                                 const IvLineSegment3* segments0,
+                                 const IvLineSegment3* segments1,
+                                 unsigned int count );
     friend float DistanceSquared( const IvLineSegment3& segment, 
                                   const IvRay3& ray, 
                                   float& s_c, float& t_c );
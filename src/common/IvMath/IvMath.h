@@ -32,7 +32,31 @@
 #define kHalfPI     1.5707963267948966192313216916398f
 #define kTwoPI      2.0f*kPI
 
-#undef IV_APPROXIMATION   // commented out for the moment
+// Fast approximations are selected at build time, per category of call:
+//   IV_APPROX_SQRT - IvSqrt(), IvRecipSqrt() and the SIMD IvRecipSqrt()
+//   IV_APPROX_TRIG - IvSinCos() and the SIMD sin, cos, acos and atan2
+//   IV_APPROX_EXP  - the SIMD IvExp()
+// Defining IV_APPROXIMATION selects all of them.
+#if defined(IV_APPROXIMATION)
+#if !defined(IV_APPROX_SQRT)
+#define IV_APPROX_SQRT
+#endif
+#if !defined(IV_APPROX_TRIG)
+#define IV_APPROX_TRIG
+#endif
+#if !defined(IV_APPROX_EXP)
+#define IV_APPROX_EXP
+#endif
+#endif
+
+// Define IV_INLINE_MATH (for both the libraries and the application) to
+// move the vector, matrix and quaternion operators from IvMath into the
+// headers, so the compiler can inline them at the call site
+#if defined(IV_INLINE_MATH)
+#define IV_INLINE inline
+#else
+#define IV_INLINE
+#endif
 
 //-------------------------------------------------------------------------------
 //-- Classes --------------------------------------------------------------------
@@ -59,7 +83,7 @@ typedef union {float f; int i;} IntOrFloat;
 //-------------------------------------------------------------------------------
 inline float IvSqrt( float val )
 {
-#if defined(IV_APPROXIMATION)
+#if defined(IV_APPROX_SQRT)
     assert(val >= 0);
     IntOrFloat workval;
     workval.f = val;
@@ -85,7 +109,7 @@ inline float IvSqrt( float val )
 //-------------------------------------------------------------------------------
 inline float IvRecipSqrt( float val )
 {
-#if defined(IV_APPROXIMATION)
+#if defined(IV_APPROX_SQRT)
     IntOrFloat workval;
     workval.f = val;
     // initial guess y0 with magic number
@@ -174,7 +198,7 @@ inline float IvTan( float a )
 //-------------------------------------------------------------------------------
 inline void IvSinCos( float a, float& sina, float& cosa )
 {
-#if defined(IV_APPROXIMATION)
+#if defined(IV_APPROX_TRIG)
     IvFastSinCos(a, sina, cosa);
 #else
     sina = sinf(a);
@@ -16,12 +16,17 @@
 //-------------------------------------------------------------------------------
 
 #include "IvMatrix33.h"
+#include "IvMatrix44.h"
 #include "IvMath.h"
 #include "IvQuat.h"
 #include "IvVector3.h"
 
 #include "IvAssert.h"
 
+#if !defined(IV_INLINE_MATH)
+#include "IvMatrix33.inl"
+#endif
+
 //-------------------------------------------------------------------------------
 //-- Static Members -------------------------------------------------------------
 //-------------------------------------------------------------------------------
@@ -42,53 +47,6 @@ IvMatrix33::IvMatrix33( const IvQuat& quat )
 }   // End of IvMatrix33::IvMatrix33()
 
 
-//-------------------------------------------------------------------------------
-// @ IvMatrix33::IvMatrix33()
-//-------------------------------------------------------------------------------
-// Copy constructor
-//-------------------------------------------------------------------------------
-IvMatrix33::IvMatrix33(const IvMatrix33& other)
-{
-    mV[0] = other.mV[0];
-    mV[1] = other.mV[1];
-    mV[2] = other.mV[2];
-    mV[3] = other.mV[3];
-    mV[4] = other.mV[4];
-    mV[5] = other.mV[5];
-    mV[6] = other.mV[6];
-    mV[7] = other.mV[7];
-    mV[8] = other.mV[8];
-
-}   // End of IvMatrix33::IvMatrix33()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix33::operator=()
-//-------------------------------------------------------------------------------
-// Assignment operator
-//-------------------------------------------------------------------------------
-IvMatrix33&
-IvMatrix33::operator=(const IvMatrix33& other)
-{
-    // if same object
-    if ( this == &other )
-        return *this;
-        
-    mV[0] = other.mV[0];
-    mV[1] = other.mV[1];
-    mV[2] = other.mV[2];
-    mV[3] = other.mV[3];
-    mV[4] = other.mV[4];
-    mV[5] = other.mV[5];
-    mV[6] = other.mV[6];
-    mV[7] = other.mV[7];
-    mV[8] = other.mV[8];
-    
-    return *this;
-
-}   // End of IvMatrix33::operator=()
-
-
 //-------------------------------------------------------------------------------
 // @ operator<<()
 //-------------------------------------------------------------------------------
@@ -807,256 +765,31 @@ IvMatrix33::GetAxisAngle( IvVector3& axis, float& angle )
 
 
 //-------------------------------------------------------------------------------
-// @ IvMatrix33::operator+()
-//-------------------------------------------------------------------------------
-// Matrix addition 
-//-------------------------------------------------------------------------------
-IvMatrix33
-IvMatrix33::operator+( const IvMatrix33& other ) const
-{
-    IvMatrix33 result;
-
-    for (unsigned int i = 0; i < 9; ++i)
-    {
-        result.mV[i] = mV[i] + other.mV[i];
-    }
-
-    return result;
-
-}   // End of IvMatrix33::operator-()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix33::operator+=()
-//-------------------------------------------------------------------------------
-// Matrix addition by self
-//-------------------------------------------------------------------------------
-IvMatrix33&
-IvMatrix33::operator+=( const IvMatrix33& other )
-{
-    for (unsigned int i = 0; i < 9; ++i)
-    {
-        mV[i] += other.mV[i];
-    }
-
-    return *this;
-
-}   // End of IvMatrix33::operator+=()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix33::operator-()
+// @ IvMatrix33::TransformVectors()
 //-------------------------------------------------------------------------------
-// Matrix subtraction 
+// Batch matrix-vector multiplication over an array of vectors.  The work is
+// done by the 4x4 batch kernel, which handles the padded column layout.
 //-------------------------------------------------------------------------------
-IvMatrix33
-IvMatrix33::operator-( const IvMatrix33& other ) const
-{
-    IvMatrix33 result;
-
-    for (unsigned int i = 0; i < 9; ++i)
-    {
-        result.mV[i] = mV[i] - other.mV[i];
-    }
-
-    return result;
-
-}   // End of IvMatrix33::operator-()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix33::operator-=()
-//-------------------------------------------------------------------------------
-// Matrix subtraction by self
-//-------------------------------------------------------------------------------
-IvMatrix33&
-IvMatrix33::operator-=( const IvMatrix33& other )
-{
-    for (unsigned int i = 0; i < 9; ++i)
-    {
-        mV[i] -= other.mV[i];
-    }
-
-    return *this;
-
-}   // End of IvMatrix33::operator-=()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix33::operator-=() (unary)
-//-------------------------------------------------------------------------------
-// Negate self and return
-//-------------------------------------------------------------------------------
-IvMatrix33
-IvMatrix33::operator-() const
-{
-    IvMatrix33 result;
-
-    for (unsigned int i = 0; i < 9; ++i)
-    {
-        result.mV[i] = -mV[i];
-    }
-
-    return result;
-
-}    // End of IvQuat::operator-()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix33::operator*()
-//-------------------------------------------------------------------------------
-// Matrix multiplication
-//-------------------------------------------------------------------------------
-IvMatrix33  
-IvMatrix33::operator*( const IvMatrix33& other ) const
-{
-    IvMatrix33 result;
-
-    result.mV[0] = mV[0]*other.mV[0] + mV[3]*other.mV[1] + mV[6]*other.mV[2];
-    result.mV[1] = mV[1]*other.mV[0] + mV[4]*other.mV[1] + mV[7]*other.mV[2];
-    result.mV[2] = mV[2]*other.mV[0] + mV[5]*other.mV[1] + mV[8]*other.mV[2];
-    result.mV[3] = mV[0]*other.mV[3] + mV[3]*other.mV[4] + mV[6]*other.mV[5];
-    result.mV[4] = mV[1]*other.mV[3] + mV[4]*other.mV[4] + mV[7]*other.mV[5];
-    result.mV[5] = mV[2]*other.mV[3] + mV[5]*other.mV[4] + mV[8]*other.mV[5];
-    result.mV[6] = mV[0]*other.mV[6] + mV[3]*other.mV[7] + mV[6]*other.mV[8];
-    result.mV[7] = mV[1]*other.mV[6] + mV[4]*other.mV[7] + mV[7]*other.mV[8];
-    result.mV[8] = mV[2]*other.mV[6] + mV[5]*other.mV[7] + mV[8]*other.mV[8];
-
-    return result;
-
-}   // End of IvMatrix33::operator*()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix33::operator*=()
-//-------------------------------------------------------------------------------
-// Matrix multiplication by self
-//-------------------------------------------------------------------------------
-IvMatrix33&
-IvMatrix33::operator*=( const IvMatrix33& other )
-{
-    IvMatrix33 result;
-
-    result.mV[0] = mV[0]*other.mV[0] + mV[3]*other.mV[1] + mV[6]*other.mV[2];
-    result.mV[1] = mV[1]*other.mV[0] + mV[4]*other.mV[1] + mV[7]*other.mV[2];
-    result.mV[2] = mV[2]*other.mV[0] + mV[5]*other.mV[1] + mV[8]*other.mV[2];
-    result.mV[3] = mV[0]*other.mV[3] + mV[3]*other.mV[4] + mV[6]*other.mV[5];
-    result.mV[4] = mV[1]*other.mV[3] + mV[4]*other.mV[4] + mV[7]*other.mV[5];
-    result.mV[5] = mV[2]*other.mV[3] + mV[5]*other.mV[4] + mV[8]*other.mV[5];
-    result.mV[6] = mV[0]*other.mV[6] + mV[3]*other.mV[7] + mV[6]*other.mV[8];
-    result.mV[7] = mV[1]*other.mV[6] + mV[4]*other.mV[7] + mV[7]*other.mV[8];
-    result.mV[8] = mV[2]*other.mV[6] + mV[5]*other.mV[7] + mV[8]*other.mV[8];
-
-    for (unsigned int i = 0; i < 9; ++i)
-    {
-        mV[i] = result.mV[i];
-    }
-
-    return *this;
-
-}   // End of IvMatrix33::operator*=()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix33::operator*()
-//-------------------------------------------------------------------------------
-// Matrix-column vector multiplication
-//-------------------------------------------------------------------------------
-IvVector3   
-IvMatrix33::operator*( const IvVector3& other ) const
-{
-    IvVector3 result;
-
-    result.x = mV[0]*other.x + mV[3]*other.y + mV[6]*other.z;
-    result.y = mV[1]*other.x + mV[4]*other.y + mV[7]*other.z;
-    result.z = mV[2]*other.x + mV[5]*other.y + mV[8]*other.z;
-
-    return result;
-
-}   // End of IvMatrix33::operator*()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix33::operator*()
-//-------------------------------------------------------------------------------
-// Row vector-matrix multiplication
-//-------------------------------------------------------------------------------
-IvVector3   
-operator*( const IvVector3& vector, const IvMatrix33& mat )
-{
-    IvVector3 result;
-
-    result.x = mat.mV[0]*vector.x + mat.mV[1]*vector.y + mat.mV[2]*vector.z;
-    result.y = mat.mV[3]*vector.x + mat.mV[4]*vector.y + mat.mV[5]*vector.z;
-    result.z = mat.mV[6]*vector.x + mat.mV[7]*vector.y + mat.mV[8]*vector.z;
-
-    return result;
-
-}   // End of IvMatrix33::operator*()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix33::*=()
-//-------------------------------------------------------------------------------
-// Matrix-scalar multiplication
-//-------------------------------------------------------------------------------
-IvMatrix33& IvMatrix33::operator*=( float scalar )
-{
-    mV[0] *= scalar;
-    mV[1] *= scalar;
-    mV[2] *= scalar;
-    mV[3] *= scalar;
-    mV[4] *= scalar;
-    mV[5] *= scalar;
-    mV[6] *= scalar;
-    mV[7] *= scalar;
-    mV[8] *= scalar;
-
-    return *this;
-}  // End of IvMatrix33::operator*=()
-
-
-//-------------------------------------------------------------------------------
-// @ friend IvMatrix33 *()
-//-------------------------------------------------------------------------------
-// Matrix-scalar multiplication
-//-------------------------------------------------------------------------------
-IvMatrix33 operator*( float scalar, const IvMatrix33& matrix )
+void
+IvMatrix33::TransformVectors( IvVector3* out, const IvVector3* in, unsigned int count ) const
 {
-    IvMatrix33 result;
-    result.mV[0] = matrix.mV[0] * scalar;
-    result.mV[1] = matrix.mV[1] * scalar;
-    result.mV[2] = matrix.mV[2] * scalar;
-    result.mV[3] = matrix.mV[3] * scalar;
-    result.mV[4] = matrix.mV[4] * scalar;
-    result.mV[5] = matrix.mV[5] * scalar;
-    result.mV[6] = matrix.mV[6] * scalar;
-    result.mV[7] = matrix.mV[7] * scalar;
-    result.mV[8] = matrix.mV[8] * scalar;
+    IvMatrix44 matrix( *this );
+    matrix.TransformVectors( out, in, count );
 
-    return result;
-}  // End of friend IvMatrix33 operator*()
+}   // End of IvMatrix33::TransformVectors()
 
 
 //-------------------------------------------------------------------------------
-// @ IvMatrix33::*()
+// @ IvMatrix33::TransformVectors()
 //-------------------------------------------------------------------------------
-// Matrix-scalar multiplication
+// Batch matrix-vector multiplication over separate x, y and z arrays
 //-------------------------------------------------------------------------------
-IvMatrix33 IvMatrix33::operator*( float scalar ) const
+void
+IvMatrix33::TransformVectors( float* outX, float* outY, float* outZ,
+                              const float* inX, const float* inY, const float* inZ,
+                              unsigned int count ) const
 {
-    IvMatrix33 result;
-    result.mV[0] = mV[0] * scalar;
-    result.mV[1] = mV[1] * scalar;
-    result.mV[2] = mV[2] * scalar;
-    result.mV[3] = mV[3] * scalar;
-    result.mV[4] = mV[4] * scalar;
-    result.mV[5] = mV[5] * scalar;
-    result.mV[6] = mV[6] * scalar;
-    result.mV[7] = mV[7] * scalar;
-    result.mV[8] = mV[8] * scalar;
-
-    return result;
-}  // End of IvMatrix33::operator*=()
-
+    IvMatrix44 matrix( *this );
+    matrix.TransformVectors( outX, outY, outZ, inX, inY, inZ, count );
 
+}   // End of IvMatrix33::TransformVectors()
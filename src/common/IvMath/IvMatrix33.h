@@ -112,6 +112,12 @@ public:
     // row vector multiplier
     friend IvVector3 operator*( const IvVector3& vector, const IvMatrix33& matrix );
 
+    // batch column vector multipliers -- out may be the same array as in
+    void TransformVectors( IvVector3* out, const IvVector3* in, unsigned int count ) const;
+    void TransformVectors( float* outX, float* outY, float* outZ,
+                           const float* inX, const float* inY, const float* inZ,
+                           unsigned int count ) const;
+
     IvMatrix33& operator*=( float scalar );
     friend IvMatrix33 operator*( float scalar, const IvMatrix33& matrix );
     IvMatrix33 operator*( float scalar ) const;
@@ -158,6 +164,10 @@ IvMatrix33::operator()(unsigned int i, unsigned int j) const
 
 }   // End of IvMatrix33::operator()()
 
+#if defined(IV_INLINE_MATH)
+#include "IvMatrix33.inl"
+#endif
+
 //-------------------------------------------------------------------------------
 //-- Externs --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
@@ -15,6 +15,7 @@
 //-- Dependencies ---------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+#include "IvAffine34.h"
 #include "IvMatrix33.h"
 #include "IvMatrix44.h"
 #include "IvMath.h"
@@ -23,53 +24,148 @@
 #include "IvVector4.h"
 
 #include "IvAssert.h"
+#include "IvSIMD.h"
+
+#if !defined(IV_INLINE_MATH)
+#include "IvMatrix44.inl"
+#endif
 
 //-------------------------------------------------------------------------------
 //-- Static Members -------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
 //-------------------------------------------------------------------------------
-//-- Methods --------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+#if defined(IV_SSE2)
 //-------------------------------------------------------------------------------
-// @ IvMatrix44::IvMatrix44()
+// @ IvCross3()
 //-------------------------------------------------------------------------------
-// Axis-angle constructor
+// Cross product of the xyz lanes; w is set to 0
 //-------------------------------------------------------------------------------
-IvMatrix44::IvMatrix44( const IvQuat& quat )
+static inline __m128 IvCross3( __m128 a, __m128 b )
 {
-    (void) Rotation( quat );
+    __m128 aYZX = _mm_shuffle_ps( a, a, _MM_SHUFFLE(3,0,2,1) );
+    __m128 bYZX = _mm_shuffle_ps( b, b, _MM_SHUFFLE(3,0,2,1) );
+    __m128 c = _mm_sub_ps( _mm_mul_ps( a, bYZX ), _mm_mul_ps( aYZX, b ) );
+    return _mm_shuffle_ps( c, c, _MM_SHUFFLE(3,0,2,1) );
 
-}   // End of IvMatrix44::IvMatrix44()
+}   // End of IvCross3()
+#endif
 
+//-------------------------------------------------------------------------------
+// @ IvTransformBatch()
+//-------------------------------------------------------------------------------
+// Shared kernel for the batch transforms.  Multiplies count packed xyz
+// triples by the upper 3x3 of the column-major matrix m and adds the
+// translation (tx, ty, tz).  out may alias in.
+//-------------------------------------------------------------------------------
+static void
+IvTransformBatch( const float* m, float tx, float ty, float tz,
+                  float* out, const float* in, unsigned int count )
+{
+    unsigned int i = 0;
+#if defined(IV_SSE2)
+    const __m128 m0 = _mm_set1_ps( m[0] ), m1 = _mm_set1_ps( m[1] ), m2 = _mm_set1_ps( m[2] );
+    const __m128 m4 = _mm_set1_ps( m[4] ), m5 = _mm_set1_ps( m[5] ), m6 = _mm_set1_ps( m[6] );
+    const __m128 m8 = _mm_set1_ps( m[8] ), m9 = _mm_set1_ps( m[9] ), m10 = _mm_set1_ps( m[10] );
+    const __m128 t0 = _mm_set1_ps( tx ), t1 = _mm_set1_ps( ty ), t2 = _mm_set1_ps( tz );
+
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        __m128 x, y, z;
+        IvLoadXYZ4( in + 3*i, x, y, z );
+        __m128 rx = IvMulAdd( m8, z, IvMulAdd( m4, y, IvMulAdd( m0, x, t0 ) ) );
+        __m128 ry = IvMulAdd( m9, z, IvMulAdd( m5, y, IvMulAdd( m1, x, t1 ) ) );
+        __m128 rz = IvMulAdd( m10, z, IvMulAdd( m6, y, IvMulAdd( m2, x, t2 ) ) );
+        IvStoreXYZ4( out + 3*i, rx, ry, rz );
+    }
+#endif
+    for ( ; i < count; ++i )
+    {
+        float x = in[3*i], y = in[3*i+1], z = in[3*i+2];
+        out[3*i]   = m[0]*x + m[4]*y + m[8]*z + tx;
+        out[3*i+1] = m[1]*x + m[5]*y + m[9]*z + ty;
+        out[3*i+2] = m[2]*x + m[6]*y + m[10]*z + tz;
+    }
+
+}   // End of IvTransformBatch()
+
+//-------------------------------------------------------------------------------
+// @ IvTransformBatchSoA()
+//-------------------------------------------------------------------------------
+// As IvTransformBatch(), but with x, y and z held in separate arrays
+//-------------------------------------------------------------------------------
+static void
+IvTransformBatchSoA( const float* m, float tx, float ty, float tz,
+                     float* outX, float* outY, float* outZ,
+                     const float* inX, const float* inY, const float* inZ,
+                     unsigned int count )
+{
+    unsigned int i = 0;
+#if defined(IV_AVX)
+    {
+        const __m256 m0 = _mm256_set1_ps( m[0] ), m1 = _mm256_set1_ps( m[1] ), m2 = _mm256_set1_ps( m[2] );
+        const __m256 m4 = _mm256_set1_ps( m[4] ), m5 = _mm256_set1_ps( m[5] ), m6 = _mm256_set1_ps( m[6] );
+        const __m256 m8 = _mm256_set1_ps( m[8] ), m9 = _mm256_set1_ps( m[9] ), m10 = _mm256_set1_ps( m[10] );
+        const __m256 t0 = _mm256_set1_ps( tx ), t1 = _mm256_set1_ps( ty ), t2 = _mm256_set1_ps( tz );
+
+        for ( ; i + 8 <= count; i += 8 )
+        {
+            __m256 x = _mm256_loadu_ps( inX + i );
+            __m256 y = _mm256_loadu_ps( inY + i );
+            __m256 z = _mm256_loadu_ps( inZ + i );
+            _mm256_storeu_ps( outX + i, IvMulAdd( m8, z, IvMulAdd( m4, y, IvMulAdd( m0, x, t0 ) ) ) );
+            _mm256_storeu_ps( outY + i, IvMulAdd( m9, z, IvMulAdd( m5, y, IvMulAdd( m1, x, t1 ) ) ) );
+            _mm256_storeu_ps( outZ + i, IvMulAdd( m10, z, IvMulAdd( m6, y, IvMulAdd( m2, x, t2 ) ) ) );
+        }
+    }
+#endif
+#if defined(IV_SSE2)
+    {
+        const __m128 m0 = _mm_set1_ps( m[0] ), m1 = _mm_set1_ps( m[1] ), m2 = _mm_set1_ps( m[2] );
+        const __m128 m4 = _mm_set1_ps( m[4] ), m5 = _mm_set1_ps( m[5] ), m6 = _mm_set1_ps( m[6] );
+        const __m128 m8 = _mm_set1_ps( m[8] ), m9 = _mm_set1_ps( m[9] ), m10 = _mm_set1_ps( m[10] );
+        const __m128 t0 = _mm_set1_ps( tx ), t1 = _mm_set1_ps( ty ), t2 = _mm_set1_ps( tz );
+
+        for ( ; i + 4 <= count; i += 4 )
+        {
+            __m128 x = _mm_loadu_ps( inX + i );
+            __m128 y = _mm_loadu_ps( inY + i );
+            __m128 z = _mm_loadu_ps( inZ + i );
+            _mm_storeu_ps( outX + i, IvMulAdd( m8, z, IvMulAdd( m4, y, IvMulAdd( m0, x, t0 ) ) ) );
+            _mm_storeu_ps( outY + i, IvMulAdd( m9, z, IvMulAdd( m5, y, IvMulAdd( m1, x, t1 ) ) ) );
+            _mm_storeu_ps( outZ + i, IvMulAdd( m10, z, IvMulAdd( m6, y, IvMulAdd( m2, x, t2 ) ) ) );
+        }
+    }
+#endif
+    for ( ; i < count; ++i )
+    {
+        float x = inX[i], y = inY[i], z = inZ[i];
+        outX[i] = m[0]*x + m[4]*y + m[8]*z + tx;
+        outY[i] = m[1]*x + m[5]*y + m[9]*z + ty;
+        outZ[i] = m[2]*x + m[6]*y + m[10]*z + tz;
+    }
+
+}   // End of IvTransformBatchSoA()
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
 
 //-------------------------------------------------------------------------------
 // @ IvMatrix44::IvMatrix44()
 //-------------------------------------------------------------------------------
-// Copy constructor
+// Axis-angle constructor
 //-------------------------------------------------------------------------------
-IvMatrix44::IvMatrix44(const IvMatrix44& other)
+IvMatrix44::IvMatrix44( const IvQuat& quat )
 {
-    mV[0] = other.mV[0];
-    mV[1] = other.mV[1];
-    mV[2] = other.mV[2];
-    mV[3] = other.mV[3];
-    mV[4] = other.mV[4];
-    mV[5] = other.mV[5];
-    mV[6] = other.mV[6];
-    mV[7] = other.mV[7];
-    mV[8] = other.mV[8];
-    mV[9] = other.mV[9];
-    mV[10] = other.mV[10];
-    mV[11] = other.mV[11];
-    mV[12] = other.mV[12];
-    mV[13] = other.mV[13];
-    mV[14] = other.mV[14];
-    mV[15] = other.mV[15];
+    (void) Rotation( quat );
 
 }   // End of IvMatrix44::IvMatrix44()
 
+
 //-------------------------------------------------------------------------------
 // @ IvMatrix44::IvMatrix44()
 //-------------------------------------------------------------------------------
@@ -83,37 +179,22 @@ IvMatrix44::IvMatrix44(const IvMatrix33& other)
 
 
 //-------------------------------------------------------------------------------
-// @ IvMatrix44::operator=()
+// @ IvMatrix44::IvMatrix44()
 //-------------------------------------------------------------------------------
-// Assignment operator
+// IvAffine34 conversion constructor
 //-------------------------------------------------------------------------------
-IvMatrix44&
-IvMatrix44::operator=(const IvMatrix44& other)
+IvMatrix44::IvMatrix44(const IvAffine34& other)
 {
-    // if same object
-    if ( this == &other )
-        return *this;
-        
-    mV[0] = other.mV[0];
-    mV[1] = other.mV[1];
-    mV[2] = other.mV[2];
-    mV[3] = other.mV[3];
-    mV[4] = other.mV[4];
-    mV[5] = other.mV[5];
-    mV[6] = other.mV[6];
-    mV[7] = other.mV[7];
-    mV[8] = other.mV[8];
-    mV[9] = other.mV[9];
-    mV[10] = other.mV[10];
-    mV[11] = other.mV[11];
-    mV[12] = other.mV[12];
-    mV[13] = other.mV[13];
-    mV[14] = other.mV[14];
-    mV[15] = other.mV[15];
-    
-    return *this;
+    for (unsigned int j = 0; j < 4; ++j)
+    {
+        mV[4*j] = other(0, j);
+        mV[4*j+1] = other(1, j);
+        mV[4*j+2] = other(2, j);
+        mV[4*j+3] = 0.0f;
+    }
+    mV[15] = 1.0f;
 
-}   // End of IvMatrix44::operator=()
+}   // End of IvMatrix44::IvMatrix44()
 
 
 //-------------------------------------------------------------------------------
@@ -240,34 +321,6 @@ IvMatrix44::Clean()
 }   // End of IvMatrix44::Clean()
 
 
-//-------------------------------------------------------------------------------
-// @ IvMatrix44::Identity()
-//-------------------------------------------------------------------------------
-// Set to identity matrix
-//-------------------------------------------------------------------------------
-void
-IvMatrix44::Identity()
-{
-    mV[0] = 1.0f;
-    mV[1] = 0.0f;
-    mV[2] = 0.0f;
-    mV[3] = 0.0f;
-    mV[4] = 0.0f;
-    mV[5] = 1.0f;
-    mV[6] = 0.0f;
-    mV[7] = 0.0f;
-    mV[8] = 0.0f;
-    mV[9] = 0.0f;
-    mV[10] = 1.0f;
-    mV[11] = 0.0f;
-    mV[12] = 0.0f;
-    mV[13] = 0.0f;
-    mV[14] = 0.0f;
-    mV[15] = 1.0f;
-
-}   // End of IvMatrix44::Identity()
-
-
 //-----------------------------------------------------------------------------
 // @ IvMatrix44::AffineInverse()
 //-----------------------------------------------------------------------------
@@ -295,6 +348,47 @@ AffineInverse( const IvMatrix44& mat )
 {
     IvMatrix44 result;
     
+#if defined(IV_SSE2)
+    __m128 col0 = _mm_loadu_ps( &mat.mV[0] );
+    __m128 col1 = _mm_loadu_ps( &mat.mV[4] );
+    __m128 col2 = _mm_loadu_ps( &mat.mV[8] );
+
+    // rows of the adjoint of the upper 3x3 are cross products of its columns
+    __m128 row0 = IvCross3( col1, col2 );
+    __m128 row1 = IvCross3( col2, col0 );
+    __m128 row2 = IvCross3( col0, col1 );
+
+    // compute upper left 3x3 matrix determinant
+    __m128 dot = _mm_mul_ps( col0, row0 );
+    dot = _mm_add_ps( dot, _mm_shuffle_ps( dot, dot, _MM_SHUFFLE(2,3,0,1) ) );
+    dot = _mm_add_ps( dot, _mm_shuffle_ps( dot, dot, _MM_SHUFFLE(1,0,3,2) ) );
+    float det = _mm_cvtss_f32( dot );
+    if (IvIsZero( det ))
+    {
+        ASSERT( false );
+        ERROR_OUT( "Matrix44::Inverse() -- singular matrix\n" );
+        return result;
+    }
+
+    // multiply by 1/det and transpose to get the inverse 3x3 columns
+    __m128 invDet = _mm_set1_ps( 1.0f/det );
+    row0 = _mm_mul_ps( row0, invDet );
+    row1 = _mm_mul_ps( row1, invDet );
+    row2 = _mm_mul_ps( row2, invDet );
+    __m128 row3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS( row0, row1, row2, row3 );
+
+    // multiply -translation by inverted 3x3 to get its inverse
+    __m128 xlate = _mm_mul_ps( row0, _mm_set1_ps( mat.mV[12] ) );
+    xlate = IvMulAdd( row1, _mm_set1_ps( mat.mV[13] ), xlate );
+    xlate = IvMulAdd( row2, _mm_set1_ps( mat.mV[14] ), xlate );
+    xlate = _mm_sub_ps( _mm_set_ps( 1.0f, 0.0f, 0.0f, 0.0f ), xlate );
+
+    _mm_storeu_ps( &result.mV[0], row0 );
+    _mm_storeu_ps( &result.mV[4], row1 );
+    _mm_storeu_ps( &result.mV[8], row2 );
+    _mm_storeu_ps( &result.mV[12], xlate );
+#else
     // compute upper left 3x3 matrix determinant
     float cofactor0 = mat.mV[5]*mat.mV[10] - mat.mV[6]*mat.mV[9];
     float cofactor4 = mat.mV[2]*mat.mV[9] - mat.mV[1]*mat.mV[10];
@@ -326,6 +420,7 @@ AffineInverse( const IvMatrix44& mat )
     result.mV[12] = -result.mV[0]*mat.mV[12] - result.mV[4]*mat.mV[13] - result.mV[8]*mat.mV[14];
     result.mV[13] = -result.mV[1]*mat.mV[12] - result.mV[5]*mat.mV[13] - result.mV[9]*mat.mV[14];
     result.mV[14] = -result.mV[2]*mat.mV[12] - result.mV[6]*mat.mV[13] - result.mV[10]*mat.mV[14];
+#endif
 
     return result;
 
@@ -340,6 +435,17 @@ AffineInverse( const IvMatrix44& mat )
 IvMatrix44& 
 IvMatrix44::Transpose()
 {
+#if defined(IV_SSE2)
+    __m128 col0 = _mm_loadu_ps( &mV[0] );
+    __m128 col1 = _mm_loadu_ps( &mV[4] );
+    __m128 col2 = _mm_loadu_ps( &mV[8] );
+    __m128 col3 = _mm_loadu_ps( &mV[12] );
+    _MM_TRANSPOSE4_PS( col0, col1, col2, col3 );
+    _mm_storeu_ps( &mV[0], col0 );
+    _mm_storeu_ps( &mV[4], col1 );
+    _mm_storeu_ps( &mV[8], col2 );
+    _mm_storeu_ps( &mV[12], col3 );
+#else
     float temp = mV[1];
     mV[1] = mV[4];
     mV[4] = temp;
@@ -363,6 +469,7 @@ IvMatrix44::Transpose()
     temp = mV[11];
     mV[11] = mV[14];
     mV[14] = temp;
+#endif
 
     return *this;
 
@@ -379,6 +486,17 @@ Transpose( const IvMatrix44& mat )
 {
     IvMatrix44 result;
 
+#if defined(IV_SSE2)
+    __m128 col0 = _mm_loadu_ps( &mat.mV[0] );
+    __m128 col1 = _mm_loadu_ps( &mat.mV[4] );
+    __m128 col2 = _mm_loadu_ps( &mat.mV[8] );
+    __m128 col3 = _mm_loadu_ps( &mat.mV[12] );
+    _MM_TRANSPOSE4_PS( col0, col1, col2, col3 );
+    _mm_storeu_ps( &result.mV[0], col0 );
+    _mm_storeu_ps( &result.mV[4], col1 );
+    _mm_storeu_ps( &result.mV[8], col2 );
+    _mm_storeu_ps( &result.mV[12], col3 );
+#else
     result.mV[0] = mat.mV[0];
     result.mV[1] = mat.mV[4];
     result.mV[2] = mat.mV[8];
@@ -395,6 +513,7 @@ Transpose( const IvMatrix44& mat )
     result.mV[13] = mat.mV[7];
     result.mV[14] = mat.mV[11];
     result.mV[15] = mat.mV[15];
+#endif
 
     return result;
 
@@ -814,371 +933,58 @@ IvMatrix44::GetAxisAngle( IvVector3& axis, float& angle )
 
 
 //-------------------------------------------------------------------------------
-// @ IvMatrix44::operator+()
-//-------------------------------------------------------------------------------
-// Matrix addition 
-//-------------------------------------------------------------------------------
-IvMatrix44
-IvMatrix44::operator+( const IvMatrix44& other ) const
-{
-    IvMatrix44 result;
-
-    for (unsigned int i = 0; i < 16; ++i)
-    {
-        result.mV[i] = mV[i] + other.mV[i];
-    }
-
-    return result;
-
-}   // End of IvMatrix44::operator-()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix44::operator+=()
-//-------------------------------------------------------------------------------
-// Matrix addition by self
-//-------------------------------------------------------------------------------
-IvMatrix44&
-IvMatrix44::operator+=( const IvMatrix44& other )
-{
-    for (unsigned int i = 0; i < 16; ++i)
-    {
-        mV[i] += other.mV[i];
-    }
-
-    return *this;
-
-}   // End of IvMatrix44::operator+=()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix44::operator-()
-//-------------------------------------------------------------------------------
-// Matrix subtraction 
-//-------------------------------------------------------------------------------
-IvMatrix44
-IvMatrix44::operator-( const IvMatrix44& other ) const
-{
-    IvMatrix44 result;
-
-    for (unsigned int i = 0; i < 16; ++i)
-    {
-        result.mV[i] = mV[i] - other.mV[i];
-    }
-
-    return result;
-
-}   // End of IvMatrix44::operator-()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix44::operator-=()
-//-------------------------------------------------------------------------------
-// Matrix subtraction by self
-//-------------------------------------------------------------------------------
-IvMatrix44&
-IvMatrix44::operator-=( const IvMatrix44& other )
-{
-    for (unsigned int i = 0; i < 16; ++i)
-    {
-        mV[i] -= other.mV[i];
-    }
-
-    return *this;
-
-}   // End of IvMatrix44::operator-=()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix44::operator-=() (unary)
-//-------------------------------------------------------------------------------
-// Negate self and return
-//-------------------------------------------------------------------------------
-IvMatrix44
-IvMatrix44::operator-() const
-{
-    IvMatrix44 result;
-
-    for (unsigned int i = 0; i < 16; ++i)
-    {
-        result.mV[i] = -mV[i];
-    }
-
-    return result;
-
-}    // End of IvQuat::operator-()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix44::operator*()
-//-------------------------------------------------------------------------------
-// Matrix multiplication
-//-------------------------------------------------------------------------------
-IvMatrix44  
-IvMatrix44::operator*( const IvMatrix44& other ) const
-{
-    IvMatrix44 result;
-
-    result.mV[0] = mV[0]*other.mV[0] + mV[4]*other.mV[1] + mV[8]*other.mV[2] 
-                    + mV[12]*other.mV[3];
-    result.mV[1] = mV[1]*other.mV[0] + mV[5]*other.mV[1] + mV[9]*other.mV[2] 
-                    + mV[13]*other.mV[3];
-    result.mV[2] = mV[2]*other.mV[0] + mV[6]*other.mV[1] + mV[10]*other.mV[2] 
-                    + mV[14]*other.mV[3];
-    result.mV[3] = mV[3]*other.mV[0] + mV[7]*other.mV[1] + mV[11]*other.mV[2] 
-                    + mV[15]*other.mV[3];
-
-    result.mV[4] = mV[0]*other.mV[4] + mV[4]*other.mV[5] + mV[8]*other.mV[6] 
-                    + mV[12]*other.mV[7];
-    result.mV[5] = mV[1]*other.mV[4] + mV[5]*other.mV[5] + mV[9]*other.mV[6] 
-                    + mV[13]*other.mV[7];
-    result.mV[6] = mV[2]*other.mV[4] + mV[6]*other.mV[5] + mV[10]*other.mV[6] 
-                    + mV[14]*other.mV[7];
-    result.mV[7] = mV[3]*other.mV[4] + mV[7]*other.mV[5] + mV[11]*other.mV[6] 
-                    + mV[15]*other.mV[7];
-
-    result.mV[8] = mV[0]*other.mV[8] + mV[4]*other.mV[9] + mV[8]*other.mV[10] 
-                    + mV[12]*other.mV[11];
-    result.mV[9] = mV[1]*other.mV[8] + mV[5]*other.mV[9] + mV[9]*other.mV[10] 
-                    + mV[13]*other.mV[11];
-    result.mV[10] = mV[2]*other.mV[8] + mV[6]*other.mV[9] + mV[10]*other.mV[10] 
-                    + mV[14]*other.mV[11];
-    result.mV[11] = mV[3]*other.mV[8] + mV[7]*other.mV[9] + mV[11]*other.mV[10] 
-                    + mV[15]*other.mV[11];
-
-    result.mV[12] = mV[0]*other.mV[12] + mV[4]*other.mV[13] + mV[8]*other.mV[14] 
-                    + mV[12]*other.mV[15];
-    result.mV[13] = mV[1]*other.mV[12] + mV[5]*other.mV[13] + mV[9]*other.mV[14] 
-                    + mV[13]*other.mV[15];
-    result.mV[14] = mV[2]*other.mV[12] + mV[6]*other.mV[13] + mV[10]*other.mV[14] 
-                    + mV[14]*other.mV[15];
-    result.mV[15] = mV[3]*other.mV[12] + mV[7]*other.mV[13] + mV[11]*other.mV[14] 
-                    + mV[15]*other.mV[15];
-
-    return result;
-
-}   // End of IvMatrix44::operator*()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix44::operator*=()
-//-------------------------------------------------------------------------------
-// Matrix multiplication by self
+// @ IvMatrix44::TransformVectors()
 //-------------------------------------------------------------------------------
-IvMatrix44&
-IvMatrix44::operator*=( const IvMatrix44& other )
-{
-    IvMatrix44 result;
-
-    result.mV[0] = mV[0]*other.mV[0] + mV[4]*other.mV[1] + mV[8]*other.mV[2] 
-                    + mV[12]*other.mV[3];
-    result.mV[1] = mV[1]*other.mV[0] + mV[5]*other.mV[1] + mV[9]*other.mV[2] 
-                    + mV[13]*other.mV[3];
-    result.mV[2] = mV[2]*other.mV[0] + mV[6]*other.mV[1] + mV[10]*other.mV[2] 
-                    + mV[14]*other.mV[3];
-    result.mV[3] = mV[3]*other.mV[0] + mV[7]*other.mV[1] + mV[11]*other.mV[2] 
-                    + mV[15]*other.mV[3];
-
-    result.mV[4] = mV[0]*other.mV[4] + mV[4]*other.mV[5] + mV[8]*other.mV[6] 
-                    + mV[12]*other.mV[7];
-    result.mV[5] = mV[1]*other.mV[4] + mV[5]*other.mV[5] + mV[9]*other.mV[6] 
-                    + mV[13]*other.mV[7];
-    result.mV[6] = mV[2]*other.mV[4] + mV[6]*other.mV[5] + mV[10]*other.mV[6] 
-                    + mV[14]*other.mV[7];
-    result.mV[7] = mV[3]*other.mV[4] + mV[7]*other.mV[5] + mV[11]*other.mV[6] 
-                    + mV[15]*other.mV[7];
-
-    result.mV[8] = mV[0]*other.mV[8] + mV[4]*other.mV[9] + mV[8]*other.mV[10] 
-                    + mV[12]*other.mV[11];
-    result.mV[9] = mV[1]*other.mV[8] + mV[5]*other.mV[9] + mV[9]*other.mV[10] 
-                    + mV[13]*other.mV[11];
-    result.mV[10] = mV[2]*other.mV[8] + mV[6]*other.mV[9] + mV[10]*other.mV[10] 
-                    + mV[14]*other.mV[11];
-    result.mV[11] = mV[3]*other.mV[8] + mV[7]*other.mV[9] + mV[11]*other.mV[10] 
-                    + mV[15]*other.mV[11];
-
-    result.mV[12] = mV[0]*other.mV[12] + mV[4]*other.mV[13] + mV[8]*other.mV[14] 
-                    + mV[12]*other.mV[15];
-    result.mV[13] = mV[1]*other.mV[12] + mV[5]*other.mV[13] + mV[9]*other.mV[14] 
-                    + mV[13]*other.mV[15];
-    result.mV[14] = mV[2]*other.mV[12] + mV[6]*other.mV[13] + mV[10]*other.mV[14] 
-                    + mV[14]*other.mV[15];
-    result.mV[15] = mV[3]*other.mV[12] + mV[7]*other.mV[13] + mV[11]*other.mV[14] 
-                    + mV[15]*other.mV[15];
-
-    for (unsigned int i = 0; i < 16; ++i)
-    {
-        mV[i] = result.mV[i];
-    }
-
-    return *this;
-
-}   // End of IvMatrix44::operator*=()
-
-
+// Batch matrix-vector multiplication over an array of vectors
 //-------------------------------------------------------------------------------
-// @ IvMatrix44::operator*()
-//-------------------------------------------------------------------------------
-// Matrix-column vector multiplication
-//-------------------------------------------------------------------------------
-IvVector4   
-IvMatrix44::operator*( const IvVector4& other ) const
-{
-    IvVector4 result;
-
-    result.x = mV[0]*other.x + mV[4]*other.y + mV[8]*other.z + mV[12]*other.w;
-    result.y = mV[1]*other.x + mV[5]*other.y + mV[9]*other.z + mV[13]*other.w;
-    result.z = mV[2]*other.x + mV[6]*other.y + mV[10]*other.z + mV[14]*other.w;
-    result.w = mV[3]*other.x + mV[7]*other.y + mV[11]*other.z + mV[15]*other.w;
-
-    return result;
-
-}   // End of IvMatrix44::operator*()
-
-
-//-------------------------------------------------------------------------------
-// @ ::operator*()
-//-------------------------------------------------------------------------------
-// Matrix-row vector multiplication
-//-------------------------------------------------------------------------------
-IvVector4 
-operator*( const IvVector4& vector, const IvMatrix44& matrix )
-{
-    IvVector4 result;
-
-    result.x = matrix.mV[0]*vector.x + matrix.mV[1]*vector.y 
-             + matrix.mV[2]*vector.z + matrix.mV[3]*vector.w;
-    result.y = matrix.mV[4]*vector.x + matrix.mV[5]*vector.y 
-             + matrix.mV[6]*vector.z + matrix.mV[7]*vector.w;
-    result.z = matrix.mV[8]*vector.x + matrix.mV[9]*vector.y 
-             + matrix.mV[10]*vector.z + matrix.mV[11]*vector.w;
-    result.w = matrix.mV[12]*vector.x + matrix.mV[13]*vector.y 
-             + matrix.mV[14]*vector.z + matrix.mV[15]*vector.w;
-
-    return result;
-
-}   // End of IvMatrix44::operator*()
-
-
-//-------------------------------------------------------------------------------
-// @ IvMatrix44::*=()
-//-------------------------------------------------------------------------------
-// Matrix-scalar multiplication
-//-------------------------------------------------------------------------------
-IvMatrix44& IvMatrix44::operator*=( float scalar )
-{
-    mV[0] *= scalar;
-    mV[1] *= scalar;
-    mV[2] *= scalar;
-    mV[3] *= scalar;
-    mV[4] *= scalar;
-    mV[5] *= scalar;
-    mV[6] *= scalar;
-    mV[7] *= scalar;
-    mV[8] *= scalar;
-    mV[9] *= scalar;
-    mV[10] *= scalar;
-    mV[11] *= scalar;
-    mV[12] *= scalar;
-    mV[13] *= scalar;
-    mV[14] *= scalar;
-    mV[15] *= scalar;
-
-    return *this;
-}  // End of IvMatrix44::operator*=()
-
-
-//-------------------------------------------------------------------------------
-// @ friend IvMatrix44 *()
-//-------------------------------------------------------------------------------
-// Matrix-scalar multiplication
-//-------------------------------------------------------------------------------
-IvMatrix44 operator*( float scalar, const IvMatrix44& matrix )
+void
+IvMatrix44::TransformVectors( IvVector3* out, const IvVector3* in, unsigned int count ) const
 {
-    IvMatrix44 result;
-    result.mV[0] = matrix.mV[0] * scalar;
-    result.mV[1] = matrix.mV[1] * scalar;
-    result.mV[2] = matrix.mV[2] * scalar;
-    result.mV[3] = matrix.mV[3] * scalar;
-    result.mV[4] = matrix.mV[4] * scalar;
-    result.mV[5] = matrix.mV[5] * scalar;
-    result.mV[6] = matrix.mV[6] * scalar;
-    result.mV[7] = matrix.mV[7] * scalar;
-    result.mV[8] = matrix.mV[8] * scalar;
-    result.mV[9] = matrix.mV[9] * scalar;
-    result.mV[10] = matrix.mV[10] * scalar;
-    result.mV[11] = matrix.mV[11] * scalar;
-    result.mV[12] = matrix.mV[12] * scalar;
-    result.mV[13] = matrix.mV[13] * scalar;
-    result.mV[14] = matrix.mV[14] * scalar;
-    result.mV[15] = matrix.mV[15] * scalar;
+    ASSERT( sizeof(IvVector3) == 3*sizeof(float) );
+    IvTransformBatch( mV, 0.0f, 0.0f, 0.0f, &out->x, &in->x, count );
 
-    return result;
-}  // End of friend IvMatrix44 operator*()
+}   // End of IvMatrix44::TransformVectors()
 
 
 //-------------------------------------------------------------------------------
-// @ IvMatrix44::*()
+// @ IvMatrix44::TransformVectors()
 //-------------------------------------------------------------------------------
-// Matrix-scalar multiplication
+// Batch matrix-vector multiplication over separate x, y and z arrays
 //-------------------------------------------------------------------------------
-IvMatrix44 IvMatrix44::operator*( float scalar ) const
+void
+IvMatrix44::TransformVectors( float* outX, float* outY, float* outZ,
+                              const float* inX, const float* inY, const float* inZ,
+                              unsigned int count ) const
 {
-    IvMatrix44 result;
-    result.mV[0] = mV[0] * scalar;
-    result.mV[1] = mV[1] * scalar;
-    result.mV[2] = mV[2] * scalar;
-    result.mV[3] = mV[3] * scalar;
-    result.mV[4] = mV[4] * scalar;
-    result.mV[5] = mV[5] * scalar;
-    result.mV[6] = mV[6] * scalar;
-    result.mV[7] = mV[7] * scalar;
-    result.mV[8] = mV[8] * scalar;
-    result.mV[9] = mV[9] * scalar;
-    result.mV[10] = mV[10] * scalar;
-    result.mV[11] = mV[11] * scalar;
-    result.mV[12] = mV[12] * scalar;
-    result.mV[13] = mV[13] * scalar;
-    result.mV[14] = mV[14] * scalar;
-    result.mV[15] = mV[15] * scalar;
+    IvTransformBatchSoA( mV, 0.0f, 0.0f, 0.0f, outX, outY, outZ, inX, inY, inZ, count );
 
-    return result;
-}  // End of IvMatrix44::operator*=()
+}   // End of IvMatrix44::TransformVectors()
 
 
 //-------------------------------------------------------------------------------
-// @ IvMatrix44::Transform()
+// @ IvMatrix44::TransformPoints()
 //-------------------------------------------------------------------------------
-// Matrix-vector multiplication
+// Batch matrix-point multiplication over an array of points
 //-------------------------------------------------------------------------------
-IvVector3   
-IvMatrix44::Transform( const IvVector3& other ) const
+void
+IvMatrix44::TransformPoints( IvVector3* out, const IvVector3* in, unsigned int count ) const
 {
-    IvVector3 result;
-
-    result.x = mV[0]*other.x + mV[4]*other.y + mV[8]*other.z;
-    result.y = mV[1]*other.x + mV[5]*other.y + mV[9]*other.z;
-    result.z = mV[2]*other.x + mV[6]*other.y + mV[10]*other.z;
- 
-    return result;
+    ASSERT( sizeof(IvVector3) == 3*sizeof(float) );
+    IvTransformBatch( mV, mV[12], mV[13], mV[14], &out->x, &in->x, count );
 
-}   // End of IvMatrix44::Transform()
+}   // End of IvMatrix44::TransformPoints()
 
 
 //-------------------------------------------------------------------------------
-// @ IvMatrix44::TransformPoint()
+// @ IvMatrix44::TransformPoints()
 //-------------------------------------------------------------------------------
-// Matrix-point multiplication
+// Batch matrix-point multiplication over separate x, y and z arrays
 //-------------------------------------------------------------------------------
-IvVector3   
-IvMatrix44::TransformPoint( const IvVector3& other ) const
+void
+IvMatrix44::TransformPoints( float* outX, float* outY, float* outZ,
+                             const float* inX, const float* inY, const float* inZ,
+                             unsigned int count ) const
 {
-    IvVector3 result;
-
-    result.x = mV[0]*other.x + mV[4]*other.y + mV[8]*other.z + mV[12];
-    result.y = mV[1]*other.x + mV[5]*other.y + mV[9]*other.z + mV[13];
-    result.z = mV[2]*other.x + mV[6]*other.y + mV[10]*other.z + mV[14];
- 
-    return result;
+    IvTransformBatchSoA( mV, mV[12], mV[13], mV[14], outX, outY, outZ, inX, inY, inZ, count );
 
-}   // End of IvMatrix44::TransformPoint()
+}   // End of IvMatrix44::TransformPoints()
@@ -18,6 +18,7 @@
 //-------------------------------------------------------------------------------
 
 #include "IvWriter.h"
+#include "IvSIMD.h"
 
 #include "IvVector3.h"
 #include "IvVector4.h"
@@ -30,6 +31,7 @@
 //-- Classes --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+class IvAffine34;
 class IvQuat;
 class IvMatrix33;
 class IvVector3;
@@ -42,6 +44,7 @@ public:
     inline ~IvMatrix44() {}
     explicit IvMatrix44( const IvQuat& quat );
     explicit IvMatrix44( const IvMatrix33& matrix );
+    explicit IvMatrix44( const IvAffine34& affine );
     
     // copy operations
     IvMatrix44(const IvMatrix44& other);
@@ -125,13 +128,24 @@ public:
     // point ops
     IvVector3 TransformPoint( const IvVector3& point ) const;
 
+    // batch ops -- out may be the same array as in
+    // (to transform normals, use the inverse transpose)
+    void TransformVectors( IvVector3* out, const IvVector3* in, unsigned int count ) const;
+    void TransformVectors( float* outX, float* outY, float* outZ,
+                           const float* inX, const float* inY, const float* inZ,
+                           unsigned int count ) const;
+    void TransformPoints( IvVector3* out, const IvVector3* in, unsigned int count ) const;
+    void TransformPoints( float* outX, float* outY, float* outZ,
+                          const float* inX, const float* inY, const float* inZ,
+                          unsigned int count ) const;
+
     // low-level data accessors - implementation-dependent
     operator float*() { return mV; }
     operator const float*() const { return mV; }
 
 protected:
-    // member variables
-    float mV[16];
+    // member variables -- aligned so columns can be loaded into SIMD registers
+    IV_ALIGN(16) float mV[16];
 
 private:
 };
@@ -167,6 +181,10 @@ IvMatrix44::operator()(unsigned int i, unsigned int j) const
 
 }   // End of IvMatrix44::operator()()
 
+#if defined(IV_INLINE_MATH)
+#include "IvMatrix44.inl"
+#endif
+
 //-------------------------------------------------------------------------------
 //-- Externs --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
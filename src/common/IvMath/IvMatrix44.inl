@@ -0,0 +1,566 @@
+//===============================================================================
+// @ IvMatrix44.inl
+// 
+// 4x4 matrix class inline operators
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// These definitions are compiled into IvMath by default.  If IV_INLINE_MATH
+// is defined they are instead included by IvMatrix44.h and expanded inline.
+//===============================================================================
+
+#ifndef __IvMatrix44__inl__
+#define __IvMatrix44__inl__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvMatrix44.h"
+#include "IvVector3.h"
+#include "IvVector4.h"
+#include "IvMath.h"
+#include "IvSIMD.h"
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::IvMatrix44()
+//-------------------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------------------
+IV_INLINE IvMatrix44::IvMatrix44(const IvMatrix44& other)
+{
+    mV[0] = other.mV[0];
+    mV[1] = other.mV[1];
+    mV[2] = other.mV[2];
+    mV[3] = other.mV[3];
+    mV[4] = other.mV[4];
+    mV[5] = other.mV[5];
+    mV[6] = other.mV[6];
+    mV[7] = other.mV[7];
+    mV[8] = other.mV[8];
+    mV[9] = other.mV[9];
+    mV[10] = other.mV[10];
+    mV[11] = other.mV[11];
+    mV[12] = other.mV[12];
+    mV[13] = other.mV[13];
+    mV[14] = other.mV[14];
+    mV[15] = other.mV[15];
+
+}   // End of IvMatrix44::IvMatrix44()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::operator=()
+//-------------------------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------------------
+IV_INLINE IvMatrix44&
+IvMatrix44::operator=(const IvMatrix44& other)
+{
+    // if same object
+    if ( this == &other )
+        return *this;
+        
+    mV[0] = other.mV[0];
+    mV[1] = other.mV[1];
+    mV[2] = other.mV[2];
+    mV[3] = other.mV[3];
+    mV[4] = other.mV[4];
+    mV[5] = other.mV[5];
+    mV[6] = other.mV[6];
+    mV[7] = other.mV[7];
+    mV[8] = other.mV[8];
+    mV[9] = other.mV[9];
+    mV[10] = other.mV[10];
+    mV[11] = other.mV[11];
+    mV[12] = other.mV[12];
+    mV[13] = other.mV[13];
+    mV[14] = other.mV[14];
+    mV[15] = other.mV[15];
+    
+    return *this;
+
+}   // End of IvMatrix44::operator=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::Identity()
+//-------------------------------------------------------------------------------
+// Set to identity matrix
+//-------------------------------------------------------------------------------
+IV_INLINE void
+IvMatrix44::Identity()
+{
+    mV[0] = 1.0f;
+    mV[1] = 0.0f;
+    mV[2] = 0.0f;
+    mV[3] = 0.0f;
+    mV[4] = 0.0f;
+    mV[5] = 1.0f;
+    mV[6] = 0.0f;
+    mV[7] = 0.0f;
+    mV[8] = 0.0f;
+    mV[9] = 0.0f;
+    mV[10] = 1.0f;
+    mV[11] = 0.0f;
+    mV[12] = 0.0f;
+    mV[13] = 0.0f;
+    mV[14] = 0.0f;
+    mV[15] = 1.0f;
+
+}   // End of IvMatrix44::Identity()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::operator+()
+//-------------------------------------------------------------------------------
+// Matrix addition 
+//-------------------------------------------------------------------------------
+IV_INLINE IvMatrix44
+IvMatrix44::operator+( const IvMatrix44& other ) const
+{
+    IvMatrix44 result;
+
+    for (unsigned int i = 0; i < 16; ++i)
+    {
+        result.mV[i] = mV[i] + other.mV[i];
+    }
+
+    return result;
+
+}   // End of IvMatrix44::operator-()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::operator+=()
+//-------------------------------------------------------------------------------
+// Matrix addition by self
+//-------------------------------------------------------------------------------
+IV_INLINE IvMatrix44&
+IvMatrix44::operator+=( const IvMatrix44& other )
+{
+    for (unsigned int i = 0; i < 16; ++i)
+    {
+        mV[i] += other.mV[i];
+    }
+
+    return *this;
+
+}   // End of IvMatrix44::operator+=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::operator-()
+//-------------------------------------------------------------------------------
+// Matrix subtraction 
+//-------------------------------------------------------------------------------
+IV_INLINE IvMatrix44
+IvMatrix44::operator-( const IvMatrix44& other ) const
+{
+    IvMatrix44 result;
+
+    for (unsigned int i = 0; i < 16; ++i)
+    {
+        result.mV[i] = mV[i] - other.mV[i];
+    }
+
+    return result;
+
+}   // End of IvMatrix44::operator-()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::operator-=()
+//-------------------------------------------------------------------------------
+// Matrix subtraction by self
+//-------------------------------------------------------------------------------
+IV_INLINE IvMatrix44&
+IvMatrix44::operator-=( const IvMatrix44& other )
+{
+    for (unsigned int i = 0; i < 16; ++i)
+    {
+        mV[i] -= other.mV[i];
+    }
+
+    return *this;
+
+}   // End of IvMatrix44::operator-=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::operator-=() (unary)
+//-------------------------------------------------------------------------------
+// Negate self and return
+//-------------------------------------------------------------------------------
+IV_INLINE IvMatrix44
+IvMatrix44::operator-() const
+{
+    IvMatrix44 result;
+
+    for (unsigned int i = 0; i < 16; ++i)
+    {
+        result.mV[i] = -mV[i];
+    }
+
+    return result;
+
+}    // End of IvQuat::operator-()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::operator*()
+//-------------------------------------------------------------------------------
+// Matrix multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvMatrix44
+IvMatrix44::operator*( const IvMatrix44& other ) const
+{
+    IvMatrix44 result;
+
+#if defined(IV_AVX)
+    // compute two result columns at a time -- each 128-bit half of the
+    // broadcast registers holds a full column of this matrix, and the
+    // in-lane shuffles splat the matching elements of two columns of other
+    __m256 col0 = _mm256_broadcast_ps( (const __m128*) &mV[0] );
+    __m256 col1 = _mm256_broadcast_ps( (const __m128*) &mV[4] );
+    __m256 col2 = _mm256_broadcast_ps( (const __m128*) &mV[8] );
+    __m256 col3 = _mm256_broadcast_ps( (const __m128*) &mV[12] );
+    for ( unsigned int j = 0; j < 16; j += 8 )
+    {
+        __m256 b = _mm256_loadu_ps( &other.mV[j] );
+        __m256 r = _mm256_mul_ps( col0, _mm256_shuffle_ps( b, b, _MM_SHUFFLE(0,0,0,0) ) );
+        r = IvMulAdd( col1, _mm256_shuffle_ps( b, b, _MM_SHUFFLE(1,1,1,1) ), r );
+        r = IvMulAdd( col2, _mm256_shuffle_ps( b, b, _MM_SHUFFLE(2,2,2,2) ), r );
+        r = IvMulAdd( col3, _mm256_shuffle_ps( b, b, _MM_SHUFFLE(3,3,3,3) ), r );
+        _mm256_storeu_ps( &result.mV[j], r );
+    }
+#elif defined(IV_SSE2)
+    // each result column is a linear combination of the columns of this matrix
+    __m128 col0 = _mm_loadu_ps( &mV[0] );
+    __m128 col1 = _mm_loadu_ps( &mV[4] );
+    __m128 col2 = _mm_loadu_ps( &mV[8] );
+    __m128 col3 = _mm_loadu_ps( &mV[12] );
+    for ( unsigned int j = 0; j < 16; j += 4 )
+    {
+        __m128 b = _mm_loadu_ps( &other.mV[j] );
+        __m128 r = _mm_mul_ps( col0, IvSplat( b, 0 ) );
+        r = IvMulAdd( col1, IvSplat( b, 1 ), r );
+        r = IvMulAdd( col2, IvSplat( b, 2 ), r );
+        r = IvMulAdd( col3, IvSplat( b, 3 ), r );
+        _mm_storeu_ps( &result.mV[j], r );
+    }
+#else
+    result.mV[0] = mV[0]*other.mV[0] + mV[4]*other.mV[1] + mV[8]*other.mV[2] 
+                    + mV[12]*other.mV[3];
+    result.mV[1] = mV[1]*other.mV[0] + mV[5]*other.mV[1] + mV[9]*other.mV[2] 
+                    + mV[13]*other.mV[3];
+    result.mV[2] = mV[2]*other.mV[0] + mV[6]*other.mV[1] + mV[10]*other.mV[2] 
+                    + mV[14]*other.mV[3];
+    result.mV[3] = mV[3]*other.mV[0] + mV[7]*other.mV[1] + mV[11]*other.mV[2] 
+                    + mV[15]*other.mV[3];
+
+    result.mV[4] = mV[0]*other.mV[4] + mV[4]*other.mV[5] + mV[8]*other.mV[6] 
+                    + mV[12]*other.mV[7];
+    result.mV[5] = mV[1]*other.mV[4] + mV[5]*other.mV[5] + mV[9]*other.mV[6] 
+                    + mV[13]*other.mV[7];
+    result.mV[6] = mV[2]*other.mV[4] + mV[6]*other.mV[5] + mV[10]*other.mV[6] 
+                    + mV[14]*other.mV[7];
+    result.mV[7] = mV[3]*other.mV[4] + mV[7]*other.mV[5] + mV[11]*other.mV[6] 
+                    + mV[15]*other.mV[7];
+
+    result.mV[8] = mV[0]*other.mV[8] + mV[4]*other.mV[9] + mV[8]*other.mV[10] 
+                    + mV[12]*other.mV[11];
+    result.mV[9] = mV[1]*other.mV[8] + mV[5]*other.mV[9] + mV[9]*other.mV[10] 
+                    + mV[13]*other.mV[11];
+    result.mV[10] = mV[2]*other.mV[8] + mV[6]*other.mV[9] + mV[10]*other.mV[10] 
+                    + mV[14]*other.mV[11];
+    result.mV[11] = mV[3]*other.mV[8] + mV[7]*other.mV[9] + mV[11]*other.mV[10] 
+                    + mV[15]*other.mV[11];
+
+    result.mV[12] = mV[0]*other.mV[12] + mV[4]*other.mV[13] + mV[8]*other.mV[14] 
+                    + mV[12]*other.mV[15];
+    result.mV[13] = mV[1]*other.mV[12] + mV[5]*other.mV[13] + mV[9]*other.mV[14] 
+                    + mV[13]*other.mV[15];
+    result.mV[14] = mV[2]*other.mV[12] + mV[6]*other.mV[13] + mV[10]*other.mV[14] 
+                    + mV[14]*other.mV[15];
+    result.mV[15] = mV[3]*other.mV[12] + mV[7]*other.mV[13] + mV[11]*other.mV[14] 
+                    + mV[15]*other.mV[15];
+#endif
+
+    return result;
+
+}   // End of IvMatrix44::operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::operator*=()
+//-------------------------------------------------------------------------------
+// Matrix multiplication by self
+//-------------------------------------------------------------------------------
+IV_INLINE IvMatrix44&
+IvMatrix44::operator*=( const IvMatrix44& other )
+{
+#if defined(IV_SSE2)
+    *this = *this * other;
+#else
+    IvMatrix44 result;
+
+    result.mV[0] = mV[0]*other.mV[0] + mV[4]*other.mV[1] + mV[8]*other.mV[2] 
+                    + mV[12]*other.mV[3];
+    result.mV[1] = mV[1]*other.mV[0] + mV[5]*other.mV[1] + mV[9]*other.mV[2] 
+                    + mV[13]*other.mV[3];
+    result.mV[2] = mV[2]*other.mV[0] + mV[6]*other.mV[1] + mV[10]*other.mV[2] 
+                    + mV[14]*other.mV[3];
+    result.mV[3] = mV[3]*other.mV[0] + mV[7]*other.mV[1] + mV[11]*other.mV[2] 
+                    + mV[15]*other.mV[3];
+
+    result.mV[4] = mV[0]*other.mV[4] + mV[4]*other.mV[5] + mV[8]*other.mV[6] 
+                    + mV[12]*other.mV[7];
+    result.mV[5] = mV[1]*other.mV[4] + mV[5]*other.mV[5] + mV[9]*other.mV[6] 
+                    + mV[13]*other.mV[7];
+    result.mV[6] = mV[2]*other.mV[4] + mV[6]*other.mV[5] + mV[10]*other.mV[6] 
+                    + mV[14]*other.mV[7];
+    result.mV[7] = mV[3]*other.mV[4] + mV[7]*other.mV[5] + mV[11]*other.mV[6] 
+                    + mV[15]*other.mV[7];
+
+    result.mV[8] = mV[0]*other.mV[8] + mV[4]*other.mV[9] + mV[8]*other.mV[10] 
+                    + mV[12]*other.mV[11];
+    result.mV[9] = mV[1]*other.mV[8] + mV[5]*other.mV[9] + mV[9]*other.mV[10] 
+                    + mV[13]*other.mV[11];
+    result.mV[10] = mV[2]*other.mV[8] + mV[6]*other.mV[9] + mV[10]*other.mV[10] 
+                    + mV[14]*other.mV[11];
+    result.mV[11] = mV[3]*other.mV[8] + mV[7]*other.mV[9] + mV[11]*other.mV[10] 
+                    + mV[15]*other.mV[11];
+
+    result.mV[12] = mV[0]*other.mV[12] + mV[4]*other.mV[13] + mV[8]*other.mV[14] 
+                    + mV[12]*other.mV[15];
+    result.mV[13] = mV[1]*other.mV[12] + mV[5]*other.mV[13] + mV[9]*other.mV[14] 
+                    + mV[13]*other.mV[15];
+    result.mV[14] = mV[2]*other.mV[12] + mV[6]*other.mV[13] + mV[10]*other.mV[14] 
+                    + mV[14]*other.mV[15];
+    result.mV[15] = mV[3]*other.mV[12] + mV[7]*other.mV[13] + mV[11]*other.mV[14] 
+                    + mV[15]*other.mV[15];
+
+    for (unsigned int i = 0; i < 16; ++i)
+    {
+        mV[i] = result.mV[i];
+    }
+#endif
+
+    return *this;
+
+}   // End of IvMatrix44::operator*=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::operator*()
+//-------------------------------------------------------------------------------
+// Matrix-column vector multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector4
+IvMatrix44::operator*( const IvVector4& other ) const
+{
+    IvVector4 result;
+
+#if defined(IV_SSE2)
+    __m128 v = _mm_loadu_ps( &other.x );
+    __m128 r = _mm_mul_ps( _mm_loadu_ps( &mV[0] ), IvSplat( v, 0 ) );
+    r = IvMulAdd( _mm_loadu_ps( &mV[4] ), IvSplat( v, 1 ), r );
+    r = IvMulAdd( _mm_loadu_ps( &mV[8] ), IvSplat( v, 2 ), r );
+    r = IvMulAdd( _mm_loadu_ps( &mV[12] ), IvSplat( v, 3 ), r );
+    _mm_storeu_ps( &result.x, r );
+#else
+    result.x = mV[0]*other.x + mV[4]*other.y + mV[8]*other.z + mV[12]*other.w;
+    result.y = mV[1]*other.x + mV[5]*other.y + mV[9]*other.z + mV[13]*other.w;
+    result.z = mV[2]*other.x + mV[6]*other.y + mV[10]*other.z + mV[14]*other.w;
+    result.w = mV[3]*other.x + mV[7]*other.y + mV[11]*other.z + mV[15]*other.w;
+#endif
+
+    return result;
+
+}   // End of IvMatrix44::operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ ::operator*()
+//-------------------------------------------------------------------------------
+// Matrix-row vector multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector4
+operator*( const IvVector4& vector, const IvMatrix44& matrix )
+{
+    IvVector4 result;
+
+#if defined(IV_SSE2)
+    // transpose, then treat as a column vector product
+    __m128 row0 = _mm_loadu_ps( &matrix.mV[0] );
+    __m128 row1 = _mm_loadu_ps( &matrix.mV[4] );
+    __m128 row2 = _mm_loadu_ps( &matrix.mV[8] );
+    __m128 row3 = _mm_loadu_ps( &matrix.mV[12] );
+    _MM_TRANSPOSE4_PS( row0, row1, row2, row3 );
+
+    __m128 v = _mm_loadu_ps( &vector.x );
+    __m128 r = _mm_mul_ps( row0, IvSplat( v, 0 ) );
+    r = IvMulAdd( row1, IvSplat( v, 1 ), r );
+    r = IvMulAdd( row2, IvSplat( v, 2 ), r );
+    r = IvMulAdd( row3, IvSplat( v, 3 ), r );
+    _mm_storeu_ps( &result.x, r );
+#else
+    result.x = matrix.mV[0]*vector.x + matrix.mV[1]*vector.y 
+             + matrix.mV[2]*vector.z + matrix.mV[3]*vector.w;
+    result.y = matrix.mV[4]*vector.x + matrix.mV[5]*vector.y 
+             + matrix.mV[6]*vector.z + matrix.mV[7]*vector.w;
+    result.z = matrix.mV[8]*vector.x + matrix.mV[9]*vector.y 
+             + matrix.mV[10]*vector.z + matrix.mV[11]*vector.w;
+    result.w = matrix.mV[12]*vector.x + matrix.mV[13]*vector.y 
+             + matrix.mV[14]*vector.z + matrix.mV[15]*vector.w;
+#endif
+
+    return result;
+
+}   // End of IvMatrix44::operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::*=()
+//-------------------------------------------------------------------------------
+// Matrix-scalar multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvMatrix44& IvMatrix44::operator*=( float scalar )
+{
+    mV[0] *= scalar;
+    mV[1] *= scalar;
+    mV[2] *= scalar;
+    mV[3] *= scalar;
+    mV[4] *= scalar;
+    mV[5] *= scalar;
+    mV[6] *= scalar;
+    mV[7] *= scalar;
+    mV[8] *= scalar;
+    mV[9] *= scalar;
+    mV[10] *= scalar;
+    mV[11] *= scalar;
+    mV[12] *= scalar;
+    mV[13] *= scalar;
+    mV[14] *= scalar;
+    mV[15] *= scalar;
+
+    return *this;
+}  // End of IvMatrix44::operator*=()
+
+
+//-------------------------------------------------------------------------------
+// @ friend IvMatrix44 *()
+//-------------------------------------------------------------------------------
+// Matrix-scalar multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvMatrix44 operator*( float scalar, const IvMatrix44& matrix )
+{
+    IvMatrix44 result;
+    result.mV[0] = matrix.mV[0] * scalar;
+    result.mV[1] = matrix.mV[1] * scalar;
+    result.mV[2] = matrix.mV[2] * scalar;
+    result.mV[3] = matrix.mV[3] * scalar;
+    result.mV[4] = matrix.mV[4] * scalar;
+    result.mV[5] = matrix.mV[5] * scalar;
+    result.mV[6] = matrix.mV[6] * scalar;
+    result.mV[7] = matrix.mV[7] * scalar;
+    result.mV[8] = matrix.mV[8] * scalar;
+    result.mV[9] = matrix.mV[9] * scalar;
+    result.mV[10] = matrix.mV[10] * scalar;
+    result.mV[11] = matrix.mV[11] * scalar;
+    result.mV[12] = matrix.mV[12] * scalar;
+    result.mV[13] = matrix.mV[13] * scalar;
+    result.mV[14] = matrix.mV[14] * scalar;
+    result.mV[15] = matrix.mV[15] * scalar;
+
+    return result;
+}  // End of friend IvMatrix44 operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::*()
+//-------------------------------------------------------------------------------
+// Matrix-scalar multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvMatrix44 IvMatrix44::operator*( float scalar ) const
+{
+    IvMatrix44 result;
+    result.mV[0] = mV[0] * scalar;
+    result.mV[1] = mV[1] * scalar;
+    result.mV[2] = mV[2] * scalar;
+    result.mV[3] = mV[3] * scalar;
+    result.mV[4] = mV[4] * scalar;
+    result.mV[5] = mV[5] * scalar;
+    result.mV[6] = mV[6] * scalar;
+    result.mV[7] = mV[7] * scalar;
+    result.mV[8] = mV[8] * scalar;
+    result.mV[9] = mV[9] * scalar;
+    result.mV[10] = mV[10] * scalar;
+    result.mV[11] = mV[11] * scalar;
+    result.mV[12] = mV[12] * scalar;
+    result.mV[13] = mV[13] * scalar;
+    result.mV[14] = mV[14] * scalar;
+    result.mV[15] = mV[15] * scalar;
+
+    return result;
+}  // End of IvMatrix44::operator*=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::Transform()
+//-------------------------------------------------------------------------------
+// Matrix-vector multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvMatrix44::Transform( const IvVector3& other ) const
+{
+    IvVector3 result;
+
+    result.x = mV[0]*other.x + mV[4]*other.y + mV[8]*other.z;
+    result.y = mV[1]*other.x + mV[5]*other.y + mV[9]*other.z;
+    result.z = mV[2]*other.x + mV[6]*other.y + mV[10]*other.z;
+ 
+    return result;
+
+}   // End of IvMatrix44::Transform()
+
+
+//-------------------------------------------------------------------------------
+// @ IvMatrix44::TransformPoint()
+//-------------------------------------------------------------------------------
+// Matrix-point multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvMatrix44::TransformPoint( const IvVector3& other ) const
+{
+#if defined(IV_SSE2)
+    __m128 r = IvMulAdd( _mm_loadu_ps( &mV[0] ), _mm_set1_ps( other.x ), 
+                         _mm_loadu_ps( &mV[12] ) );
+    r = IvMulAdd( _mm_loadu_ps( &mV[4] ), _mm_set1_ps( other.y ), r );
+    r = IvMulAdd( _mm_loadu_ps( &mV[8] ), _mm_set1_ps( other.z ), r );
+
+    IV_ALIGN(16) float temp[4];
+    _mm_store_ps( temp, r );
+    return IvVector3( temp[0], temp[1], temp[2] );
+#else
+    IvVector3 result;
+
+    result.x = mV[0]*other.x + mV[4]*other.y + mV[8]*other.z + mV[12];
+    result.y = mV[1]*other.x + mV[5]*other.y + mV[9]*other.z + mV[13];
+    result.z = mV[2]*other.x + mV[6]*other.y + mV[10]*other.z + mV[14];
+ 
+    return result;
+#endif
+
+}   // End of IvMatrix44::TransformPoint()
+
+#endif
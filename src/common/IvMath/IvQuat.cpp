@@ -21,6 +21,11 @@
 #include "IvMatrix33.h"
 
 #include "IvAssert.h"
+#include "IvSIMDMath.h"
+
+#if !defined(IV_INLINE_MATH)
+#include "IvQuat.inl"
+#endif
 
 //-------------------------------------------------------------------------------
 //-- Static Members -------------------------------------------------------------
@@ -29,6 +34,178 @@
 IvQuat IvQuat::zero( 0.0f, 0.0f, 0.0f, 0.0f );
 IvQuat IvQuat::identity( 1.0f, 0.0f, 0.0f, 0.0f );
 
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// which interpolation the batch kernel computes
+enum IvQuatInterpolation
+{
+    kLerp,
+    kSlerp,
+    kApproxSlerp
+};
+
+#if defined(IV_SSE2)
+//-------------------------------------------------------------------------------
+// @ IvInterpolate4()
+//-------------------------------------------------------------------------------
+// Interpolate four quaternion pairs.  The lane math follows the scalar
+// routines, including the choice of the shorter path, but without branches.
+//-------------------------------------------------------------------------------
+static void
+IvInterpolate4( IvQuatInterpolation type, float* result, const float* start, const float* end,
+                __m128 t )
+{
+    __m128 s0 = _mm_loadu_ps( start );
+    __m128 s1 = _mm_loadu_ps( start + 4 );
+    __m128 s2 = _mm_loadu_ps( start + 8 );
+    __m128 s3 = _mm_loadu_ps( start + 12 );
+    __m128 e0 = _mm_loadu_ps( end );
+    __m128 e1 = _mm_loadu_ps( end + 4 );
+    __m128 e2 = _mm_loadu_ps( end + 8 );
+    __m128 e3 = _mm_loadu_ps( end + 12 );
+
+    // four dot products, one per lane
+    __m128 d0 = _mm_mul_ps( s0, e0 ), d1 = _mm_mul_ps( s1, e1 );
+    __m128 d2 = _mm_mul_ps( s2, e2 ), d3 = _mm_mul_ps( s3, e3 );
+    _MM_TRANSPOSE4_PS( d0, d1, d2, d3 );
+    __m128 cosTheta = _mm_add_ps( _mm_add_ps( d0, d1 ), _mm_add_ps( d2, d3 ) );
+
+    // flip the start quaternion where that gives the shorter path
+    const __m128 one = _mm_set1_ps( 1.0f );
+    const __m128 epsilon = _mm_set1_ps( kEpsilon );
+    __m128 flip = _mm_and_ps( _mm_cmplt_ps( cosTheta, epsilon ), _mm_set1_ps( -0.0f ) );
+    cosTheta = _mm_xor_ps( cosTheta, flip );
+
+    __m128 startInterp, endInterp;
+    if ( type == kSlerp )
+    {
+        __m128 c = _mm_min_ps( _mm_max_ps( cosTheta, _mm_setzero_ps() ), one );
+        __m128 theta = IvACos( c );
+        __m128 recipSinTheta = _mm_div_ps( one, 
+                    _mm_sqrt_ps( _mm_mul_ps( _mm_sub_ps( one, c ), _mm_add_ps( one, c ) ) ) );
+        startInterp = _mm_mul_ps( IvSin( _mm_mul_ps( _mm_sub_ps( one, t ), theta ) ),
+                                  recipSinTheta );
+        endInterp = _mm_mul_ps( IvSin( _mm_mul_ps( t, theta ) ), recipSinTheta );
+
+        // use linear interpolation where angle is close to zero
+        __m128 linear = _mm_cmple_ps( _mm_sub_ps( one, cosTheta ), epsilon );
+        startInterp = IvSelect( linear, _mm_sub_ps( one, t ), startInterp );
+        endInterp = IvSelect( linear, t, endInterp );
+    }
+    else
+    {
+        if ( type == kApproxSlerp )
+        {
+            // correct time by using cosine of angle between quaternions
+            __m128 factor = _mm_sub_ps( one, _mm_mul_ps( _mm_set1_ps( 0.7878088f ), cosTheta ) );
+            __m128 k = _mm_mul_ps( _mm_set1_ps( 0.5069269f ), _mm_mul_ps( factor, factor ) );
+            __m128 b = _mm_add_ps( k, k );
+            __m128 c = _mm_sub_ps( _mm_setzero_ps(), _mm_add_ps( b, k ) );
+            __m128 d = _mm_add_ps( one, k );
+            t = _mm_mul_ps( t, IvMulAdd( t, IvMulAdd( b, t, c ), d ) );
+        }
+        startInterp = _mm_sub_ps( one, t );
+        endInterp = t;
+    }
+    startInterp = _mm_xor_ps( startInterp, flip );
+
+    __m128 r0 = IvMulAdd( IvSplat( startInterp, 0 ), s0,
+                          _mm_mul_ps( IvSplat( endInterp, 0 ), e0 ) );
+    __m128 r1 = IvMulAdd( IvSplat( startInterp, 1 ), s1,
+                          _mm_mul_ps( IvSplat( endInterp, 1 ), e1 ) );
+    __m128 r2 = IvMulAdd( IvSplat( startInterp, 2 ), s2,
+                          _mm_mul_ps( IvSplat( endInterp, 2 ), e2 ) );
+    __m128 r3 = IvMulAdd( IvSplat( startInterp, 3 ), s3,
+                          _mm_mul_ps( IvSplat( endInterp, 3 ), e3 ) );
+
+    if ( type == kApproxSlerp )
+    {
+        // normalize
+        __m128 n0 = _mm_mul_ps( r0, r0 ), n1 = _mm_mul_ps( r1, r1 );
+        __m128 n2 = _mm_mul_ps( r2, r2 ), n3 = _mm_mul_ps( r3, r3 );
+        _MM_TRANSPOSE4_PS( n0, n1, n2, n3 );
+        __m128 recip = IvRecipSqrt( _mm_add_ps( _mm_add_ps( n0, n1 ), _mm_add_ps( n2, n3 ) ) );
+        r0 = _mm_mul_ps( r0, IvSplat( recip, 0 ) );
+        r1 = _mm_mul_ps( r1, IvSplat( recip, 1 ) );
+        r2 = _mm_mul_ps( r2, IvSplat( recip, 2 ) );
+        r3 = _mm_mul_ps( r3, IvSplat( recip, 3 ) );
+    }
+
+    _mm_storeu_ps( result, r0 );
+    _mm_storeu_ps( result + 4, r1 );
+    _mm_storeu_ps( result + 8, r2 );
+    _mm_storeu_ps( result + 12, r3 );
+
+}   // End of IvInterpolate4()
+#endif
+
+//-------------------------------------------------------------------------------
+// @ IvInterpolateBatch()
+//-------------------------------------------------------------------------------
+// Shared driver for the batch interpolation routines.  If times is null,
+// sharedTime is used for every pair.
+//-------------------------------------------------------------------------------
+static void
+IvInterpolateBatch( IvQuatInterpolation type, IvQuat* result, const IvQuat* start,
+                    const IvQuat* end, const float* times, float sharedTime, unsigned int count )
+{
+#if defined(IV_SSE2)
+    ASSERT( sizeof(IvQuat) == 4*sizeof(float) );
+
+    const float* startPtr = reinterpret_cast<const float*>( start );
+    const float* endPtr = reinterpret_cast<const float*>( end );
+    float* resultPtr = reinterpret_cast<float*>( result );
+
+    unsigned int i = 0;
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        __m128 t = times ? _mm_loadu_ps( times + i ) : _mm_set1_ps( sharedTime );
+        IvInterpolate4( type, resultPtr + 4*i, startPtr + 4*i, endPtr + 4*i, t );
+    }
+
+    // run the remainder through the same kernel, so every element gets
+    // the same approximation
+    if ( i < count )
+    {
+        float startTemp[16] = { 0.0f }, endTemp[16] = { 0.0f }, resultTemp[16];
+        float timeTemp[4] = { sharedTime, sharedTime, sharedTime, sharedTime };
+        unsigned int remaining = count - i;
+        for ( unsigned int j = 0; j < remaining; ++j )
+        {
+            for ( unsigned int k = 0; k < 4; ++k )
+            {
+                startTemp[4*j + k] = startPtr[4*(i+j) + k];
+                endTemp[4*j + k] = endPtr[4*(i+j) + k];
+            }
+            if ( times )
+                timeTemp[j] = times[i+j];
+        }
+        IvInterpolate4( type, resultTemp, startTemp, endTemp, _mm_loadu_ps( timeTemp ) );
+        for ( unsigned int j = 0; j < 4*remaining; ++j )
+        {
+            resultPtr[4*i + j] = resultTemp[j];
+        }
+    }
+#else
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        // the scalar routines don't allow result to alias start or end
+        float t = times ? times[i] : sharedTime;
+        IvQuat temp;
+        if ( type == kLerp )
+            Lerp( temp, start[i], end[i], t );
+        else if ( type == kSlerp )
+            Slerp( temp, start[i], end[i], t );
+        else
+            ApproxSlerp( temp, start[i], end[i], t );
+        result[i] = temp;
+    }
+#endif
+
+}   // End of IvInterpolateBatch()
+
 //-------------------------------------------------------------------------------
 //-- Methods --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
@@ -102,43 +279,6 @@ IvQuat::IvQuat( const IvMatrix33& rotation )
 }   // End of IvQuat::IvQuat()
 
 
-//-------------------------------------------------------------------------------
-// @ IvQuat::IvQuat()
-//-------------------------------------------------------------------------------
-// Copy constructor
-//-------------------------------------------------------------------------------
-IvQuat::IvQuat(const IvQuat& other) : 
-    w( other.w ),
-    x( other.x ),
-    y( other.y ),
-    z( other.z )
-{
-
-}   // End of IvQuat::IvQuat()
-
-
-//-------------------------------------------------------------------------------
-// @ IvQuat::operator=()
-//-------------------------------------------------------------------------------
-// Assignment operator
-//-------------------------------------------------------------------------------
-IvQuat&
-IvQuat::operator=(const IvQuat& other)
-{
-    // if same object
-    if ( this == &other )
-        return *this;
-        
-    w = other.w;
-    x = other.x;
-    y = other.y;
-    z = other.z;
-    
-    return *this;
-
-}   // End of IvQuat::operator=()
-
-
 //-------------------------------------------------------------------------------
 // @ operator<<()
 //-------------------------------------------------------------------------------
@@ -531,193 +671,6 @@ IvQuat::Inverse()
 }   // End of Inverse()
 
 
-//-------------------------------------------------------------------------------
-// @ IvQuat::operator+()
-//-------------------------------------------------------------------------------
-// Add quat to self and return
-//-------------------------------------------------------------------------------
-IvQuat 
-IvQuat::operator+( const IvQuat& other ) const
-{
-    return IvQuat( w + other.w, x + other.x, y + other.y, z + other.z );
-
-}   // End of IvQuat::operator+()
-
-
-//-------------------------------------------------------------------------------
-// @ IvQuat::operator+=()
-//-------------------------------------------------------------------------------
-// Add quat to self, store in self
-//-------------------------------------------------------------------------------
-IvQuat& 
-IvQuat::operator+=( const IvQuat& other )
-{
-    w += other.w;
-    x += other.x;
-    y += other.y;
-    z += other.z;
-
-    return *this;
-
-}   // End of IvQuat::operator+=()
-
-
-//-------------------------------------------------------------------------------
-// @ IvQuat::operator-()
-//-------------------------------------------------------------------------------
-// Subtract quat from self and return
-//-------------------------------------------------------------------------------
-IvQuat 
-IvQuat::operator-( const IvQuat& other ) const
-{
-    return IvQuat( w - other.w, x - other.x, y - other.y, z - other.z );
-
-}   // End of IvQuat::operator-()
-
-
-//-------------------------------------------------------------------------------
-// @ IvQuat::operator-=()
-//-------------------------------------------------------------------------------
-// Subtract quat from self, store in self
-//-------------------------------------------------------------------------------
-IvQuat& 
-IvQuat::operator-=( const IvQuat& other )
-{
-    w -= other.w;
-    x -= other.x;
-    y -= other.y;
-    z -= other.z;
-
-    return *this;
-
-}   // End of IvQuat::operator-=()
-
-
-//-------------------------------------------------------------------------------
-// @ IvQuat::operator-=() (unary)
-//-------------------------------------------------------------------------------
-// Negate self and return
-//-------------------------------------------------------------------------------
-IvQuat
-IvQuat::operator-() const
-{
-    return IvQuat(-w, -x, -y, -z);
-}    // End of IvQuat::operator-()
-
-
-//-------------------------------------------------------------------------------
-// @ operator*()
-//-------------------------------------------------------------------------------
-// Scalar multiplication
-//-------------------------------------------------------------------------------
-IvQuat  
-operator*( float scalar, const IvQuat& quat )
-{
-    return IvQuat( scalar*quat.w, scalar*quat.x, scalar*quat.y, scalar*quat.z );
-
-}   // End of operator*()
-
-
-//-------------------------------------------------------------------------------
-// @ IvQuat::operator*=()
-//-------------------------------------------------------------------------------
-// Scalar multiplication by self
-//-------------------------------------------------------------------------------
-IvQuat&
-IvQuat::operator*=( float scalar )
-{
-    w *= scalar;
-    x *= scalar;
-    y *= scalar;
-    z *= scalar;
-
-    return *this;
-
-}   // End of IvQuat::operator*=()
-
-
-//-------------------------------------------------------------------------------
-// @ IvQuat::operator*()
-//-------------------------------------------------------------------------------
-// Quaternion multiplication
-//-------------------------------------------------------------------------------
-IvQuat  
-IvQuat::operator*( const IvQuat& other ) const
-{
-    return IvQuat( w*other.w - x*other.x - y*other.y - z*other.z,
-                   w*other.x + x*other.w + y*other.z - z*other.y,
-                   w*other.y + y*other.w + z*other.x - x*other.z,
-                   w*other.z + z*other.w + x*other.y - y*other.x );
-
-}   // End of IvQuat::operator*()
-
-
-//-------------------------------------------------------------------------------
-// @ IvQuat::operator*=()
-//-------------------------------------------------------------------------------
-// Quaternion multiplication by self
-//-------------------------------------------------------------------------------
-IvQuat&
-IvQuat::operator*=( const IvQuat& other )
-{
-    Set( w*other.w - x*other.x - y*other.y - z*other.z,
-         w*other.x + x*other.w + y*other.z - z*other.y,
-         w*other.y + y*other.w + z*other.x - x*other.z,
-         w*other.z + z*other.w + x*other.y - y*other.x );
-  
-    return *this;
-
-}   // End of IvQuat::operator*=()
-
-
-//-------------------------------------------------------------------------------
-// @ IvQuat::Dot()
-//-------------------------------------------------------------------------------
-// Dot product by self
-//-------------------------------------------------------------------------------
-float               
-IvQuat::Dot( const IvQuat& quat ) const
-{
-    return ( w*quat.w + x*quat.x + y*quat.y + z*quat.z);
-
-}   // End of IvQuat::Dot()
-
-
-//-------------------------------------------------------------------------------
-// @ Dot()
-//-------------------------------------------------------------------------------
-// Dot product friend operator
-//-------------------------------------------------------------------------------
-float               
-Dot( const IvQuat& quat1, const IvQuat& quat2 )
-{
-    return (quat1.w*quat2.w + quat1.x*quat2.x + quat1.y*quat2.y + quat1.z*quat2.z);
-
-}   // End of Dot()
-
-
-//-------------------------------------------------------------------------------
-// @ IvQuat::Rotate()
-//-------------------------------------------------------------------------------
-// Rotate vector by quaternion
-// Assumes quaternion is normalized!
-//-------------------------------------------------------------------------------
-IvVector3   
-IvQuat::Rotate( const IvVector3& vector ) const
-{
-    ASSERT( IsUnit() );
-
-    float vMult = 2.0f*(x*vector.x + y*vector.y + z*vector.z);
-    float crossMult = 2.0f*w;
-    float pMult = crossMult*w - 1.0f;
-
-    return IvVector3( pMult*vector.x + vMult*x + crossMult*(y*vector.z - z*vector.y),
-                      pMult*vector.y + vMult*y + crossMult*(z*vector.x - x*vector.z),
-                      pMult*vector.z + vMult*z + crossMult*(x*vector.y - y*vector.x) );
-
-}   // End of IvQuat::Rotate()
-
-
 //-------------------------------------------------------------------------------
 // @ Lerp()
 //-------------------------------------------------------------------------------
@@ -822,7 +775,8 @@ ApproxSlerp( IvQuat& result, const IvQuat& start, const IvQuat& end, float t )
     float cosTheta = start.Dot( end );
 
     // correct time by using cosine of angle between quaternions
-    float factor = 1.0f - 0.7878088f*cosTheta;
+    // (along the shorter path)
+    float factor = 1.0f - 0.7878088f*IvAbs( cosTheta );
     float k = 0.5069269f;
     factor *= factor;
     k *= factor;
@@ -831,7 +785,7 @@ ApproxSlerp( IvQuat& result, const IvQuat& start, const IvQuat& end, float t )
     float c = -3*k;
     float d = 1 + k;
 
-    t = t*(b*t + c) + d;
+    t = t*(t*(b*t + c) + d);
 
     // initialize result
     result = t*end;
@@ -848,4 +802,96 @@ ApproxSlerp( IvQuat& result, const IvQuat& start, const IvQuat& end, float t )
         result += (t-1.0f)*start;
     }
 
+    // the time correction assumes a unit result
+    result.Normalize();
+
+}   // End of ApproxSlerp()
+
+
+//-------------------------------------------------------------------------------
+// @ Lerp()
+//-------------------------------------------------------------------------------
+// Linearly interpolate count pairs of quaternions with a shared t
+//-------------------------------------------------------------------------------
+void 
+Lerp( IvQuat* result, const IvQuat* start, const IvQuat* end, float t, unsigned int count )
+{
+    IvInterpolateBatch( kLerp, result, start, end, 0, t, count );
+
+}   // End of Lerp()
+
+
+//-------------------------------------------------------------------------------
+// @ Lerp()
+//-------------------------------------------------------------------------------
+// Linearly interpolate count pairs of quaternions with one t per pair
+//-------------------------------------------------------------------------------
+void 
+Lerp( IvQuat* result, const IvQuat* start, const IvQuat* end, const float* t, 
+      unsigned int count )
+{
+    IvInterpolateBatch( kLerp, result, start, end, t, 0.0f, count );
+
+}   // End of Lerp()
+
+
+//-------------------------------------------------------------------------------
+// @ Slerp()
+//-------------------------------------------------------------------------------
+// Spherical linearly interpolate count pairs of quaternions with a shared t
+//
+// The SIMD version uses the polynomial arc cosine and sine from IvSIMDMath.h
+// and expects t in [0,1].  Over unit quaternions each component differs
+// from the scalar Slerp() by at most 1e-6 (1e-4 with IV_APPROX_TRIG).
+//-------------------------------------------------------------------------------
+void 
+Slerp( IvQuat* result, const IvQuat* start, const IvQuat* end, float t, unsigned int count )
+{
+    IvInterpolateBatch( kSlerp, result, start, end, 0, t, count );
+
+}   // End of Slerp()
+
+
+//-------------------------------------------------------------------------------
+// @ Slerp()
+//-------------------------------------------------------------------------------
+// Spherical linearly interpolate count pairs of quaternions with one t per
+// pair.  Accuracy is as above.
+//-------------------------------------------------------------------------------
+void 
+Slerp( IvQuat* result, const IvQuat* start, const IvQuat* end, const float* t, 
+       unsigned int count )
+{
+    IvInterpolateBatch( kSlerp, result, start, end, t, 0.0f, count );
+
+}   // End of Slerp()
+
+
+//-------------------------------------------------------------------------------
+// @ ApproxSlerp()
+//-------------------------------------------------------------------------------
+// Approximate spherical linear interpolation of count pairs of quaternions
+// with a shared t.  Each component is within 1e-2 of the scalar Slerp().
+//-------------------------------------------------------------------------------
+void 
+ApproxSlerp( IvQuat* result, const IvQuat* start, const IvQuat* end, float t, 
+             unsigned int count )
+{
+    IvInterpolateBatch( kApproxSlerp, result, start, end, 0, t, count );
+
+}   // End of ApproxSlerp()
+
+
+//-------------------------------------------------------------------------------
+// @ ApproxSlerp()
+//-------------------------------------------------------------------------------
+// Approximate spherical linear interpolation of count pairs of quaternions
+// with one t per pair.  Accuracy is as above.
+//-------------------------------------------------------------------------------
+void 
+ApproxSlerp( IvQuat* result, const IvQuat* start, const IvQuat* end, const float* t, 
+             unsigned int count )
+{
+    IvInterpolateBatch( kApproxSlerp, result, start, end, t, 0.0f, count );
+
 }   // End of ApproxSlerp()
@@ -35,6 +35,9 @@ class IvMatrix33;
 
 class IvQuat
 {
+    friend class IvAffine34;
+    friend class IvDualQuat;
+    template <class T> friend class IvFixedQuat;
     friend class IvMatrix33;
     friend class IvMatrix44;
     
@@ -125,6 +128,21 @@ public:
     friend void Slerp( IvQuat& result, const IvQuat& start, const IvQuat& end, float t );
     friend void ApproxSlerp( IvQuat& result, const IvQuat& start, const IvQuat& end, float t );
 
+    // batch interpolation of count pairs, with a shared t or one per pair
+    // result may be the same array as start or end
+    friend void Lerp( IvQuat* result, const IvQuat* start, const IvQuat* end,
+                      float t, unsigned int count );
+    friend void Lerp( IvQuat* result, const IvQuat* start, const IvQuat* end,
+                      const float* t, unsigned int count );
+    friend void Slerp( IvQuat* result, const IvQuat* start, const IvQuat* end,
+                       float t, unsigned int count );
+    friend void Slerp( IvQuat* result, const IvQuat* start, const IvQuat* end,
+                       const float* t, unsigned int count );
+    friend void ApproxSlerp( IvQuat* result, const IvQuat* start, const IvQuat* end,
+                             float t, unsigned int count );
+    friend void ApproxSlerp( IvQuat* result, const IvQuat* start, const IvQuat* end,
+                             const float* t, unsigned int count );
+
     // useful defaults
     static IvQuat   zero;
     static IvQuat   identity;
@@ -174,6 +192,10 @@ IvQuat::Identity()
     w = 1.0f;
 }   // End of IvQuat::Identity
 
+#if defined(IV_INLINE_MATH)
+#include "IvQuat.inl"
+#endif
+
 //-------------------------------------------------------------------------------
 //-- Externs --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
@@ -0,0 +1,255 @@
+//===============================================================================
+// @ IvQuat.inl
+// 
+// Quaternion class inline operators
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// These definitions are compiled into IvMath by default.  If IV_INLINE_MATH
+// is defined they are instead included by IvQuat.h and expanded inline.
+//===============================================================================
+
+#ifndef __IvQuat__inl__
+#define __IvQuat__inl__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvQuat.h"
+#include "IvVector3.h"
+#include "IvMath.h"
+#include "IvAssert.h"
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvQuat::IvQuat()
+//-------------------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------------------
+IV_INLINE IvQuat::IvQuat(const IvQuat& other) :
+    w( other.w ),
+    x( other.x ),
+    y( other.y ),
+    z( other.z )
+{
+
+}   // End of IvQuat::IvQuat()
+
+
+//-------------------------------------------------------------------------------
+// @ IvQuat::operator=()
+//-------------------------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------------------
+IV_INLINE IvQuat&
+IvQuat::operator=(const IvQuat& other)
+{
+    // if same object
+    if ( this == &other )
+        return *this;
+        
+    w = other.w;
+    x = other.x;
+    y = other.y;
+    z = other.z;
+    
+    return *this;
+
+}   // End of IvQuat::operator=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvQuat::operator+()
+//-------------------------------------------------------------------------------
+// Add quat to self and return
+//-------------------------------------------------------------------------------
+IV_INLINE IvQuat
+IvQuat::operator+( const IvQuat& other ) const
+{
+    return IvQuat( w + other.w, x + other.x, y + other.y, z + other.z );
+
+}   // End of IvQuat::operator+()
+
+
+//-------------------------------------------------------------------------------
+// @ IvQuat::operator+=()
+//-------------------------------------------------------------------------------
+// Add quat to self, store in self
+//-------------------------------------------------------------------------------
+IV_INLINE IvQuat&
+IvQuat::operator+=( const IvQuat& other )
+{
+    w += other.w;
+    x += other.x;
+    y += other.y;
+    z += other.z;
+
+    return *this;
+
+}   // End of IvQuat::operator+=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvQuat::operator-()
+//-------------------------------------------------------------------------------
+// Subtract quat from self and return
+//-------------------------------------------------------------------------------
+IV_INLINE IvQuat
+IvQuat::operator-( const IvQuat& other ) const
+{
+    return IvQuat( w - other.w, x - other.x, y - other.y, z - other.z );
+
+}   // End of IvQuat::operator-()
+
+
+//-------------------------------------------------------------------------------
+// @ IvQuat::operator-=()
+//-------------------------------------------------------------------------------
+// Subtract quat from self, store in self
+//-------------------------------------------------------------------------------
+IV_INLINE IvQuat&
+IvQuat::operator-=( const IvQuat& other )
+{
+    w -= other.w;
+    x -= other.x;
+    y -= other.y;
+    z -= other.z;
+
+    return *this;
+
+}   // End of IvQuat::operator-=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvQuat::operator-=() (unary)
+//-------------------------------------------------------------------------------
+// Negate self and return
+//-------------------------------------------------------------------------------
+IV_INLINE IvQuat
+IvQuat::operator-() const
+{
+    return IvQuat(-w, -x, -y, -z);
+}    // End of IvQuat::operator-()
+
+
+//-------------------------------------------------------------------------------
+// @ operator*()
+//-------------------------------------------------------------------------------
+// Scalar multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvQuat
+operator*( float scalar, const IvQuat& quat )
+{
+    return IvQuat( scalar*quat.w, scalar*quat.x, scalar*quat.y, scalar*quat.z );
+
+}   // End of operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ IvQuat::operator*=()
+//-------------------------------------------------------------------------------
+// Scalar multiplication by self
+//-------------------------------------------------------------------------------
+IV_INLINE IvQuat&
+IvQuat::operator*=( float scalar )
+{
+    w *= scalar;
+    x *= scalar;
+    y *= scalar;
+    z *= scalar;
+
+    return *this;
+
+}   // End of IvQuat::operator*=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvQuat::operator*()
+//-------------------------------------------------------------------------------
+// Quaternion multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvQuat
+IvQuat::operator*( const IvQuat& other ) const
+{
+    return IvQuat( w*other.w - x*other.x - y*other.y - z*other.z,
+                   w*other.x + x*other.w + y*other.z - z*other.y,
+                   w*other.y + y*other.w + z*other.x - x*other.z,
+                   w*other.z + z*other.w + x*other.y - y*other.x );
+
+}   // End of IvQuat::operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ IvQuat::operator*=()
+//-------------------------------------------------------------------------------
+// Quaternion multiplication by self
+//-------------------------------------------------------------------------------
+IV_INLINE IvQuat&
+IvQuat::operator*=( const IvQuat& other )
+{
+    Set( w*other.w - x*other.x - y*other.y - z*other.z,
+         w*other.x + x*other.w + y*other.z - z*other.y,
+         w*other.y + y*other.w + z*other.x - x*other.z,
+         w*other.z + z*other.w + x*other.y - y*other.x );
+  
+    return *this;
+
+}   // End of IvQuat::operator*=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvQuat::Dot()
+//-------------------------------------------------------------------------------
+// Dot product by self
+//-------------------------------------------------------------------------------
+IV_INLINE float
+IvQuat::Dot( const IvQuat& quat ) const
+{
+    return ( w*quat.w + x*quat.x + y*quat.y + z*quat.z);
+
+}   // End of IvQuat::Dot()
+
+
+//-------------------------------------------------------------------------------
+// @ Dot()
+//-------------------------------------------------------------------------------
+// Dot product friend operator
+//-------------------------------------------------------------------------------
+IV_INLINE float
+Dot( const IvQuat& quat1, const IvQuat& quat2 )
+{
+    return (quat1.w*quat2.w + quat1.x*quat2.x + quat1.y*quat2.y + quat1.z*quat2.z);
+
+}   // End of Dot()
+
+
+//-------------------------------------------------------------------------------
+// @ IvQuat::Rotate()
+//-------------------------------------------------------------------------------
+// Rotate vector by quaternion
+// Assumes quaternion is normalized!
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvQuat::Rotate( const IvVector3& vector ) const
+{
+    ASSERT( IsUnit() );
+
+    float vMult = 2.0f*(x*vector.x + y*vector.y + z*vector.z);
+    float crossMult = 2.0f*w;
+    float pMult = crossMult*w - 1.0f;
+
+    return IvVector3( pMult*vector.x + vMult*x + crossMult*(y*vector.z - z*vector.y),
+                      pMult*vector.y + vMult*y + crossMult*(z*vector.x - x*vector.z),
+                      pMult*vector.z + vMult*z + crossMult*(x*vector.y - y*vector.x) );
+
+}   // End of IvQuat::Rotate()
+
+#endif
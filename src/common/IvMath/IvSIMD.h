@@ -0,0 +1,229 @@
+//===============================================================================
+// @ IvSIMD.h
+//
+// SIMD instruction set selection and helpers
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// The SIMD paths in IvMath are chosen at compile time from the instruction
+// sets the compiler is targeting.  SSE2 is the baseline on x86 and x64; AVX
+// and FMA are used when enabled (e.g. -mavx -mfma, or /arch:AVX2).  Define
+// IV_NO_SIMD to force the scalar code everywhere.
+//
+//===============================================================================
+
+#ifndef __IvSIMD__h__
+#define __IvSIMD__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#if !defined(IV_NO_SIMD)
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IV_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(IV_SSE2) && defined(__AVX__)
+#define IV_AVX
+#include <immintrin.h>
+#endif
+
+// MSVC has no __FMA__, so there /arch:AVX2 stands in for it
+#if defined(IV_AVX) && (defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__)))
+#define IV_FMA
+#endif
+
+#endif
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// alignment for SIMD-friendly storage
+#if defined(_MSC_VER)
+#define IV_ALIGN(n) __declspec(align(n))
+#else
+#define IV_ALIGN(n) __attribute__((aligned(n)))
+#endif
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#if defined(IV_SSE2)
+
+//-------------------------------------------------------------------------------
+// @ IvMulAdd()
+//-------------------------------------------------------------------------------
+// Returns a*b + c, fused if the target supports it
+//-------------------------------------------------------------------------------
+inline __m128 IvMulAdd( __m128 a, __m128 b, __m128 c )
+{
+#if defined(IV_FMA)
+    return _mm_fmadd_ps( a, b, c );
+#else
+    return _mm_add_ps( _mm_mul_ps( a, b ), c );
+#endif
+
+}   // End of IvMulAdd()
+
+//-------------------------------------------------------------------------------
+// @ IvSplat()
+//-------------------------------------------------------------------------------
+// Broadcast one lane of a vector to all four lanes
+//-------------------------------------------------------------------------------
+#define IvSplat( v, i ) _mm_shuffle_ps( (v), (v), _MM_SHUFFLE(i,i,i,i) )
+
+//-------------------------------------------------------------------------------
+// @ IvLoadXYZ4()
+//-------------------------------------------------------------------------------
+// Load four packed xyz triples (12 floats) and split them into x, y and z
+// lanes.  No alignment is required.
+//-------------------------------------------------------------------------------
+inline void IvLoadXYZ4( const float* p, __m128& x, __m128& y, __m128& z )
+{
+    __m128 a0 = _mm_loadu_ps( p );       // x0 y0 z0 x1
+    __m128 a1 = _mm_loadu_ps( p + 4 );   // y1 z1 x2 y2
+    __m128 a2 = _mm_loadu_ps( p + 8 );   // z2 x3 y3 z3
+
+    __m128 x23 = _mm_shuffle_ps( a1, a2, _MM_SHUFFLE(1,1,2,2) );
+    x = _mm_shuffle_ps( a0, x23, _MM_SHUFFLE(2,0,3,0) );
+    __m128 y01 = _mm_shuffle_ps( a0, a1, _MM_SHUFFLE(0,0,1,1) );
+    __m128 y23 = _mm_shuffle_ps( a1, a2, _MM_SHUFFLE(2,2,3,3) );
+    y = _mm_shuffle_ps( y01, y23, _MM_SHUFFLE(2,0,2,0) );
+    __m128 z01 = _mm_shuffle_ps( a0, a1, _MM_SHUFFLE(1,1,2,2) );
+    z = _mm_shuffle_ps( z01, a2, _MM_SHUFFLE(3,0,2,0) );
+
+}   // End of IvLoadXYZ4()
+
+//-------------------------------------------------------------------------------
+// @ IvStoreXYZ4()
+//-------------------------------------------------------------------------------
+// Interleave x, y and z lanes and store them as four packed xyz triples
+//-------------------------------------------------------------------------------
+inline void IvStoreXYZ4( float* p, __m128 x, __m128 y, __m128 z )
+{
+    __m128 xy0 = _mm_shuffle_ps( x, y, _MM_SHUFFLE(0,0,0,0) );
+    __m128 zx0 = _mm_shuffle_ps( z, x, _MM_SHUFFLE(1,1,0,0) );
+    __m128 yz1 = _mm_shuffle_ps( y, z, _MM_SHUFFLE(1,1,1,1) );
+    __m128 xy2 = _mm_shuffle_ps( x, y, _MM_SHUFFLE(2,2,2,2) );
+    __m128 zx2 = _mm_shuffle_ps( z, x, _MM_SHUFFLE(3,3,2,2) );
+    __m128 yz3 = _mm_shuffle_ps( y, z, _MM_SHUFFLE(3,3,3,3) );
+
+    _mm_storeu_ps( p,     _mm_shuffle_ps( xy0, zx0, _MM_SHUFFLE(2,0,2,0) ) );
+    _mm_storeu_ps( p + 4, _mm_shuffle_ps( yz1, xy2, _MM_SHUFFLE(2,0,2,0) ) );
+    _mm_storeu_ps( p + 8, _mm_shuffle_ps( zx2, yz3, _MM_SHUFFLE(2,0,2,0) ) );
+
+}   // End of IvStoreXYZ4()
+
+//-------------------------------------------------------------------------------
+// @ Lane primitives
+//-------------------------------------------------------------------------------
+// Thin wrappers over the SSE and AVX intrinsics, overloaded on register
+// type so kernels can be written once as templates for 4 or 8 lanes.
+// Functions that only differ by return type take it as a template argument,
+// e.g. IvBroadcast<__m128>( 1.0f ).  Comparisons return all-ones lane masks.
+//-------------------------------------------------------------------------------
+template <class V> inline V IvBroadcast( float f );
+template <class V> inline V IvLoad( const float* p );    // 16/32-byte aligned
+template <class V> inline V IvLoadU( const float* p );   // unaligned
+
+template <class V> inline V IvGather( const float* p, const unsigned int* indices );  // p[indices[lane]]
+
+template <> inline __m128 IvBroadcast<__m128>( float f )     { return _mm_set1_ps( f ); }
+template <> inline __m128 IvLoad<__m128>( const float* p )   { return _mm_load_ps( p ); }
+template <> inline __m128 IvLoadU<__m128>( const float* p )  { return _mm_loadu_ps( p ); }
+template <> inline __m128 IvGather<__m128>( const float* p, const unsigned int* indices )
+{
+    return _mm_set_ps( p[indices[3]], p[indices[2]], p[indices[1]], p[indices[0]] );
+}
+inline void IvStore( float* p, __m128 v )                     { _mm_store_ps( p, v ); }
+inline void IvStoreU( float* p, __m128 v )                    { _mm_storeu_ps( p, v ); }
+
+inline __m128 IvAdd( __m128 a, __m128 b )     { return _mm_add_ps( a, b ); }
+inline __m128 IvSub( __m128 a, __m128 b )     { return _mm_sub_ps( a, b ); }
+inline __m128 IvMul( __m128 a, __m128 b )     { return _mm_mul_ps( a, b ); }
+inline __m128 IvDiv( __m128 a, __m128 b )     { return _mm_div_ps( a, b ); }
+inline __m128 IvMin( __m128 a, __m128 b )     { return _mm_min_ps( a, b ); }
+inline __m128 IvMax( __m128 a, __m128 b )     { return _mm_max_ps( a, b ); }
+inline __m128 IvSqrt( __m128 a )              { return _mm_sqrt_ps( a ); }
+inline __m128 IvAnd( __m128 a, __m128 b )     { return _mm_and_ps( a, b ); }
+inline __m128 IvAndNot( __m128 a, __m128 b )  { return _mm_andnot_ps( a, b ); }  // ~a & b
+inline __m128 IvOr( __m128 a, __m128 b )      { return _mm_or_ps( a, b ); }
+inline __m128 IvXor( __m128 a, __m128 b )     { return _mm_xor_ps( a, b ); }
+inline __m128 IvCmpEq( __m128 a, __m128 b )   { return _mm_cmpeq_ps( a, b ); }
+inline __m128 IvCmpLt( __m128 a, __m128 b )   { return _mm_cmplt_ps( a, b ); }
+inline __m128 IvCmpLe( __m128 a, __m128 b )   { return _mm_cmple_ps( a, b ); }
+inline __m128 IvSelect( __m128 mask, __m128 a, __m128 b )
+{
+    return _mm_or_ps( _mm_and_ps( mask, a ), _mm_andnot_ps( mask, b ) );
+}
+// one bit per lane, set where the lane's sign bit (e.g. a mask) is set
+inline int IvMoveMask( __m128 a )             { return _mm_movemask_ps( a ); }
+// round to nearest integer; valid for |a| < 2^31
+inline __m128 IvRound( __m128 a )             { return _mm_cvtepi32_ps( _mm_cvtps_epi32( a ) ); }
+
+#endif
+
+#if defined(IV_AVX)
+
+//-------------------------------------------------------------------------------
+// @ IvMulAdd()
+//-------------------------------------------------------------------------------
+// Returns a*b + c for eight lanes, fused if the target supports it
+//-------------------------------------------------------------------------------
+inline __m256 IvMulAdd( __m256 a, __m256 b, __m256 c )
+{
+#if defined(IV_FMA)
+    return _mm256_fmadd_ps( a, b, c );
+#else
+    return _mm256_add_ps( _mm256_mul_ps( a, b ), c );
+#endif
+
+}   // End of IvMulAdd()
+
+template <> inline __m256 IvBroadcast<__m256>( float f )     { return _mm256_set1_ps( f ); }
+template <> inline __m256 IvLoad<__m256>( const float* p )   { return _mm256_load_ps( p ); }
+template <> inline __m256 IvLoadU<__m256>( const float* p )  { return _mm256_loadu_ps( p ); }
+template <> inline __m256 IvGather<__m256>( const float* p, const unsigned int* indices )
+{
+    return _mm256_set_ps( p[indices[7]], p[indices[6]], p[indices[5]], p[indices[4]],
+                          p[indices[3]], p[indices[2]], p[indices[1]], p[indices[0]] );
+}
+inline void IvStore( float* p, __m256 v )                     { _mm256_store_ps( p, v ); }
+inline void IvStoreU( float* p, __m256 v )                    { _mm256_storeu_ps( p, v ); }
+
+inline __m256 IvAdd( __m256 a, __m256 b )     { return _mm256_add_ps( a, b ); }
+inline __m256 IvSub( __m256 a, __m256 b )     { return _mm256_sub_ps( a, b ); }
+inline __m256 IvMul( __m256 a, __m256 b )     { return _mm256_mul_ps( a, b ); }
+inline __m256 IvDiv( __m256 a, __m256 b )     { return _mm256_div_ps( a, b ); }
+inline __m256 IvMin( __m256 a, __m256 b )     { return _mm256_min_ps( a, b ); }
+inline __m256 IvMax( __m256 a, __m256 b )     { return _mm256_max_ps( a, b ); }
+inline __m256 IvSqrt( __m256 a )              { return _mm256_sqrt_ps( a ); }
+inline __m256 IvAnd( __m256 a, __m256 b )     { return _mm256_and_ps( a, b ); }
+inline __m256 IvAndNot( __m256 a, __m256 b )  { return _mm256_andnot_ps( a, b ); }
+inline __m256 IvOr( __m256 a, __m256 b )      { return _mm256_or_ps( a, b ); }
+inline __m256 IvXor( __m256 a, __m256 b )     { return _mm256_xor_ps( a, b ); }
+inline __m256 IvCmpEq( __m256 a, __m256 b )   { return _mm256_cmp_ps( a, b, _CMP_EQ_OQ ); }
+inline __m256 IvCmpLt( __m256 a, __m256 b )   { return _mm256_cmp_ps( a, b, _CMP_LT_OQ ); }
+inline __m256 IvCmpLe( __m256 a, __m256 b )   { return _mm256_cmp_ps( a, b, _CMP_LE_OQ ); }
+inline __m256 IvSelect( __m256 mask, __m256 a, __m256 b )
+{
+    return _mm256_blendv_ps( b, a, mask );
+}
+inline int IvMoveMask( __m256 a )             { return _mm256_movemask_ps( a ); }
+inline __m256 IvRound( __m256 a )
+{
+    return _mm256_round_ps( a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC );
+}
+
+#endif
+
+#endif
@@ -0,0 +1,423 @@
+//===============================================================================
+// @ IvSIMDMath.h
+//
+// Vectorized transcendental functions
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Sine, cosine, arc cosine, arc tangent, reciprocal square root and exp for
+// 4 (__m128) or 8 (__m256) lanes.  Each has a default version accurate to
+// within a few float ulps and a faster one, selected by the IV_APPROX_*
+// category macros in IvMath.h.  Maximum absolute errors, measured against
+// the double precision C library (relative error for exp and rsqrt):
+//
+//                          default         IV_APPROX_*
+//   sin, cos  |x| < 100     1e-7            4e-5
+//   acos                    5e-7            7e-5
+//   atan2                   3e-7            2e-5
+//   recip sqrt              1e-7 relative   3e-7 relative
+//   exp                     2e-7 relative   6e-5 relative
+//
+//===============================================================================
+
+#ifndef __IvSIMDMath__h__
+#define __IvSIMDMath__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvMath.h"
+#include "IvSIMD.h"
+
+#if defined(IV_SSE2)
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvPow2()
+//-------------------------------------------------------------------------------
+// Returns 2^n, for integer-valued n in [-126,127]
+//-------------------------------------------------------------------------------
+inline __m128 IvPow2( __m128 n )
+{
+    __m128i e = _mm_add_epi32( _mm_cvtps_epi32( n ), _mm_set1_epi32( 127 ) );
+    return _mm_castsi128_ps( _mm_slli_epi32( e, 23 ) );
+
+}   // End of IvPow2()
+
+#if defined(IV_AVX)
+inline __m256 IvPow2( __m256 n )
+{
+#if defined(__AVX2__)
+    __m256i e = _mm256_add_epi32( _mm256_cvtps_epi32( n ), _mm256_set1_epi32( 127 ) );
+    return _mm256_castsi256_ps( _mm256_slli_epi32( e, 23 ) );
+#else
+    // no 256-bit integer ops, so do each half
+    __m128 low = IvPow2( _mm256_castps256_ps128( n ) );
+    __m128 high = IvPow2( _mm256_extractf128_ps( n, 1 ) );
+    return _mm256_insertf128_ps( _mm256_castps128_ps256( low ), high, 1 );
+#endif
+
+}   // End of IvPow2()
+#endif
+
+//-------------------------------------------------------------------------------
+// @ IvSinCosT()
+//-------------------------------------------------------------------------------
+// Sine and cosine for any lane width.  The argument is reduced to
+// r in [-pi/4,pi/4] with x = q*pi/2 + r, and the quadrant q mod 4 selects
+// and negates the polynomial results.
+//-------------------------------------------------------------------------------
+template <class V> inline void
+IvSinCosT( V x, V& sina, V& cosa )
+{
+    const V one = IvBroadcast<V>( 1.0f );
+    V q = IvRound( IvMul( x, IvBroadcast<V>( 0.63661977236758134f ) ) );
+
+    // subtract q*pi/2 in parts, so the leading products are exact
+    V r = IvSub( x, IvMul( q, IvBroadcast<V>( 1.5703125f ) ) );
+#if defined(IV_APPROX_TRIG)
+    r = IvSub( r, IvMul( q, IvBroadcast<V>( 4.8382679e-4f ) ) );
+    V r2 = IvMul( r, r );
+
+    V s = IvMulAdd( r2, IvBroadcast<V>( 8.3333333e-3f ), IvBroadcast<V>( -1.6666667e-1f ) );
+    s = IvMulAdd( IvMul( r, r2 ), s, r );
+    V c = IvMulAdd( r2, IvBroadcast<V>( -1.3888889e-3f ), IvBroadcast<V>( 4.1666667e-2f ) );
+    c = IvMulAdd( r2, c, IvBroadcast<V>( -0.5f ) );
+    c = IvMulAdd( r2, c, one );
+#else
+    r = IvSub( r, IvMul( q, IvBroadcast<V>( 4.837512969970703125e-4f ) ) );
+    r = IvSub( r, IvMul( q, IvBroadcast<V>( 7.54978995489188216e-8f ) ) );
+    V r2 = IvMul( r, r );
+
+    V s = IvMulAdd( r2, IvBroadcast<V>( -1.9515295891e-4f ), IvBroadcast<V>( 8.3321608736e-3f ) );
+    s = IvMulAdd( r2, s, IvBroadcast<V>( -1.6666654611e-1f ) );
+    s = IvMulAdd( IvMul( r, r2 ), s, r );
+    V c = IvMulAdd( r2, IvBroadcast<V>( 2.443315711809948e-5f ),
+                    IvBroadcast<V>( -1.388731625493765e-3f ) );
+    c = IvMulAdd( r2, c, IvBroadcast<V>( 4.166664568298827e-2f ) );
+    c = IvMulAdd( r2, c, IvBroadcast<V>( -0.5f ) );
+    c = IvMulAdd( r2, c, one );
+#endif
+
+    // quadrant = q - 4*floor(q/4); the offset avoids ties when rounding
+    V quadrant = IvRound( IvSub( IvMul( q, IvBroadcast<V>( 0.25f ) ),
+                                 IvBroadcast<V>( 0.375f ) ) );
+    quadrant = IvSub( q, IvMul( quadrant, IvBroadcast<V>( 4.0f ) ) );
+
+    const V two = IvBroadcast<V>( 2.0f );
+    const V signBit = IvBroadcast<V>( -0.0f );
+    V odd = IvOr( IvCmpEq( quadrant, one ), IvCmpEq( quadrant, IvBroadcast<V>( 3.0f ) ) );
+    V sinSign = IvAnd( IvCmpLe( two, quadrant ), signBit );
+    V cosSign = IvAnd( IvOr( IvCmpEq( quadrant, one ), IvCmpEq( quadrant, two ) ), signBit );
+
+    sina = IvXor( IvSelect( odd, c, s ), sinSign );
+    cosa = IvXor( IvSelect( odd, s, c ), cosSign );
+
+}   // End of IvSinCosT()
+
+//-------------------------------------------------------------------------------
+// @ IvACosT()
+//-------------------------------------------------------------------------------
+// Arc cosine for any lane width, from Abramowitz and Stegun 4.4.46 (or
+// 4.4.45 if approximating) on |x|, reflected for negative x
+//-------------------------------------------------------------------------------
+template <class V> inline V
+IvACosT( V x )
+{
+    const V one = IvBroadcast<V>( 1.0f );
+    V a = IvMin( IvAndNot( IvBroadcast<V>( -0.0f ), x ), one );
+
+#if defined(IV_APPROX_TRIG)
+    V p = IvMulAdd( a, IvBroadcast<V>( -0.0187293f ), IvBroadcast<V>( 0.0742610f ) );
+    p = IvMulAdd( a, p, IvBroadcast<V>( -0.2121144f ) );
+    p = IvMulAdd( a, p, IvBroadcast<V>( 1.5707288f ) );
+#else
+    V p = IvMulAdd( a, IvBroadcast<V>( -0.0012624911f ), IvBroadcast<V>( 0.0066700901f ) );
+    p = IvMulAdd( a, p, IvBroadcast<V>( -0.0170881256f ) );
+    p = IvMulAdd( a, p, IvBroadcast<V>( 0.0308918810f ) );
+    p = IvMulAdd( a, p, IvBroadcast<V>( -0.0501743046f ) );
+    p = IvMulAdd( a, p, IvBroadcast<V>( 0.0889789874f ) );
+    p = IvMulAdd( a, p, IvBroadcast<V>( -0.2145988016f ) );
+    p = IvMulAdd( a, p, IvBroadcast<V>( 1.5707963050f ) );
+#endif
+    V result = IvMul( p, IvSqrt( IvSub( one, a ) ) );
+
+    return IvSelect( IvCmpLt( x, IvBroadcast<V>( 0.0f ) ),
+                     IvSub( IvBroadcast<V>( kPI ), result ), result );
+
+}   // End of IvACosT()
+
+//-------------------------------------------------------------------------------
+// @ IvATan2T()
+//-------------------------------------------------------------------------------
+// Arc tangent of y/x for any lane width.  The ratio of the smaller to the
+// larger magnitude is in [0,1]; the octant is restored afterwards.
+//-------------------------------------------------------------------------------
+template <class V> inline V
+IvATan2T( V y, V x )
+{
+    const V zero = IvBroadcast<V>( 0.0f );
+    const V signBit = IvBroadcast<V>( -0.0f );
+    V absX = IvAndNot( signBit, x );
+    V absY = IvAndNot( signBit, y );
+    V denom = IvMax( absX, absY );
+    V a = IvSelect( IvCmpEq( denom, zero ), zero, IvDiv( IvMin( absX, absY ), denom ) );
+
+#if defined(IV_APPROX_TRIG)
+    // Abramowitz and Stegun 4.4.49
+    V a2 = IvMul( a, a );
+    V p = IvMulAdd( a2, IvBroadcast<V>( 0.0208351f ), IvBroadcast<V>( -0.0851330f ) );
+    p = IvMulAdd( a2, p, IvBroadcast<V>( 0.1801410f ) );
+    p = IvMulAdd( a2, p, IvBroadcast<V>( -0.3302995f ) );
+    p = IvMulAdd( a2, p, IvBroadcast<V>( 0.9998660f ) );
+    V result = IvMul( a, p );
+#else
+    // reduce further to [0,tan(pi/8)] using atan(a) = pi/4 + atan((a-1)/(a+1))
+    const V one = IvBroadcast<V>( 1.0f );
+    V big = IvCmpLt( IvBroadcast<V>( 0.41421356f ), a );
+    a = IvSelect( big, IvDiv( IvSub( a, one ), IvAdd( a, one ) ), a );
+    V a2 = IvMul( a, a );
+    V p = IvMulAdd( a2, IvBroadcast<V>( 8.05374449538e-2f ), IvBroadcast<V>( -1.38776856032e-1f ) );
+    p = IvMulAdd( a2, p, IvBroadcast<V>( 1.99777106478e-1f ) );
+    p = IvMulAdd( a2, p, IvBroadcast<V>( -3.33329491539e-1f ) );
+    V result = IvMulAdd( IvMul( a, a2 ), p, a );
+    result = IvAdd( result, IvAnd( big, IvBroadcast<V>( 0.25f*kPI ) ) );
+#endif
+
+    result = IvSelect( IvCmpLt( absX, absY ), IvSub( IvBroadcast<V>( kHalfPI ), result ), result );
+    result = IvSelect( IvCmpLt( x, zero ), IvSub( IvBroadcast<V>( kPI ), result ), result );
+    return IvXor( result, IvAnd( y, signBit ) );
+
+}   // End of IvATan2T()
+
+//-------------------------------------------------------------------------------
+// @ IvExpT()
+//-------------------------------------------------------------------------------
+// e^x for any lane width.  With x = n*ln(2) + r, |r| <= ln(2)/2, this is
+// 2^n times a polynomial in r.  Results are clamped to the normal range.
+//-------------------------------------------------------------------------------
+template <class V> inline V
+IvExpT( V x )
+{
+    x = IvMin( IvMax( x, IvBroadcast<V>( -87.33654f ) ), IvBroadcast<V>( 88.37626f ) );
+    V n = IvRound( IvMul( x, IvBroadcast<V>( 1.44269504088896341f ) ) );
+    V r = IvSub( x, IvMul( n, IvBroadcast<V>( 0.693359375f ) ) );
+    r = IvSub( r, IvMul( n, IvBroadcast<V>( -2.12194440e-4f ) ) );
+
+    const V one = IvBroadcast<V>( 1.0f );
+#if defined(IV_APPROX_EXP)
+    V p = IvMulAdd( r, IvBroadcast<V>( 4.1666667e-2f ), IvBroadcast<V>( 1.6666667e-1f ) );
+    p = IvMulAdd( r, p, IvBroadcast<V>( 0.5f ) );
+    p = IvMulAdd( r, p, one );
+    p = IvMulAdd( r, p, one );
+#else
+    V p = IvMulAdd( r, IvBroadcast<V>( 1.9875691500e-4f ), IvBroadcast<V>( 1.3981999507e-3f ) );
+    p = IvMulAdd( r, p, IvBroadcast<V>( 8.3334519073e-3f ) );
+    p = IvMulAdd( r, p, IvBroadcast<V>( 4.1665795894e-2f ) );
+    p = IvMulAdd( r, p, IvBroadcast<V>( 1.6666665459e-1f ) );
+    p = IvMulAdd( r, p, IvBroadcast<V>( 5.0000001201e-1f ) );
+    p = IvMulAdd( IvMul( r, r ), p, IvAdd( r, one ) );
+#endif
+
+    return IvMul( p, IvPow2( n ) );
+
+}   // End of IvExpT()
+
+//-------------------------------------------------------------------------------
+// @ IvSinCos()
+//-------------------------------------------------------------------------------
+// Sine and cosine of four lanes
+//-------------------------------------------------------------------------------
+inline void IvSinCos( __m128 a, __m128& sina, __m128& cosa )
+{
+    IvSinCosT( a, sina, cosa );
+
+}   // End of IvSinCos()
+
+//-------------------------------------------------------------------------------
+// @ IvSin()
+//-------------------------------------------------------------------------------
+// Sine of four lanes
+//-------------------------------------------------------------------------------
+inline __m128 IvSin( __m128 a )
+{
+    __m128 sina, cosa;
+    IvSinCosT( a, sina, cosa );
+    return sina;
+
+}   // End of IvSin()
+
+//-------------------------------------------------------------------------------
+// @ IvCos()
+//-------------------------------------------------------------------------------
+// Cosine of four lanes
+//-------------------------------------------------------------------------------
+inline __m128 IvCos( __m128 a )
+{
+    __m128 sina, cosa;
+    IvSinCosT( a, sina, cosa );
+    return cosa;
+
+}   // End of IvCos()
+
+//-------------------------------------------------------------------------------
+// @ IvACos()
+//-------------------------------------------------------------------------------
+// Arc cosine of four lanes; input is clamped to [-1,1]
+//-------------------------------------------------------------------------------
+inline __m128 IvACos( __m128 a )
+{
+    return IvACosT( a );
+
+}   // End of IvACos()
+
+//-------------------------------------------------------------------------------
+// @ IvATan2()
+//-------------------------------------------------------------------------------
+// Arc tangent of y/x for four lanes, in [-pi,pi]
+//-------------------------------------------------------------------------------
+inline __m128 IvATan2( __m128 y, __m128 x )
+{
+    return IvATan2T( y, x );
+
+}   // End of IvATan2()
+
+//-------------------------------------------------------------------------------
+// @ IvExp()
+//-------------------------------------------------------------------------------
+// e^a for four lanes
+//-------------------------------------------------------------------------------
+inline __m128 IvExp( __m128 a )
+{
+    return IvExpT( a );
+
+}   // End of IvExp()
+
+//-------------------------------------------------------------------------------
+// @ IvRecipSqrt()
+//-------------------------------------------------------------------------------
+// 1/sqrt(a) for four lanes.  The approximation refines the hardware
+// estimate with one Newton-Raphson step.
+//-------------------------------------------------------------------------------
+inline __m128 IvRecipSqrt( __m128 a )
+{
+#if defined(IV_APPROX_SQRT)
+    __m128 estimate = _mm_rsqrt_ps( a );
+    __m128 halfA = _mm_mul_ps( _mm_set1_ps( 0.5f ), a );
+    __m128 correction = _mm_sub_ps( _mm_set1_ps( 1.5f ),
+                            _mm_mul_ps( halfA, _mm_mul_ps( estimate, estimate ) ) );
+    return _mm_mul_ps( estimate, correction );
+#else
+    return _mm_div_ps( _mm_set1_ps( 1.0f ), _mm_sqrt_ps( a ) );
+#endif
+
+}   // End of IvRecipSqrt()
+
+#if defined(IV_AVX)
+
+//-------------------------------------------------------------------------------
+// @ IvSinCos()
+//-------------------------------------------------------------------------------
+// Sine and cosine of eight lanes
+//-------------------------------------------------------------------------------
+inline void IvSinCos( __m256 a, __m256& sina, __m256& cosa )
+{
+    IvSinCosT( a, sina, cosa );
+
+}   // End of IvSinCos()
+
+//-------------------------------------------------------------------------------
+// @ IvSin()
+//-------------------------------------------------------------------------------
+// Sine of eight lanes
+//-------------------------------------------------------------------------------
+inline __m256 IvSin( __m256 a )
+{
+    __m256 sina, cosa;
+    IvSinCosT( a, sina, cosa );
+    return sina;
+
+}   // End of IvSin()
+
+//-------------------------------------------------------------------------------
+// @ IvCos()
+//-------------------------------------------------------------------------------
+// Cosine of eight lanes
+//-------------------------------------------------------------------------------
+inline __m256 IvCos( __m256 a )
+{
+    __m256 sina, cosa;
+    IvSinCosT( a, sina, cosa );
+    return cosa;
+
+}   // End of IvCos()
+
+//-------------------------------------------------------------------------------
+// @ IvACos()
+//-------------------------------------------------------------------------------
+// Arc cosine of eight lanes; input is clamped to [-1,1]
+//-------------------------------------------------------------------------------
+inline __m256 IvACos( __m256 a )
+{
+    return IvACosT( a );
+
+}   // End of IvACos()
+
+//-------------------------------------------------------------------------------
+// @ IvATan2()
+//-------------------------------------------------------------------------------
+// Arc tangent of y/x for eight lanes, in [-pi,pi]
+//-------------------------------------------------------------------------------
+inline __m256 IvATan2( __m256 y, __m256 x )
+{
+    return IvATan2T( y, x );
+
+}   // End of IvATan2()
+
+//-------------------------------------------------------------------------------
+// @ IvExp()
+//-------------------------------------------------------------------------------
+// e^a for eight lanes
+//-------------------------------------------------------------------------------
+inline __m256 IvExp( __m256 a )
+{
+    return IvExpT( a );
+
+}   // End of IvExp()
+
+//-------------------------------------------------------------------------------
+// @ IvRecipSqrt()
+//-------------------------------------------------------------------------------
+// 1/sqrt(a) for eight lanes
+//-------------------------------------------------------------------------------
+inline __m256 IvRecipSqrt( __m256 a )
+{
+#if defined(IV_APPROX_SQRT)
+    __m256 estimate = _mm256_rsqrt_ps( a );
+    __m256 halfA = _mm256_mul_ps( _mm256_set1_ps( 0.5f ), a );
+    __m256 correction = _mm256_sub_ps( _mm256_set1_ps( 1.5f ),
+                            _mm256_mul_ps( halfA, _mm256_mul_ps( estimate, estimate ) ) );
+    return _mm256_mul_ps( estimate, correction );
+#else
+    return _mm256_div_ps( _mm256_set1_ps( 1.0f ), _mm256_sqrt_ps( a ) );
+#endif
+
+}   // End of IvRecipSqrt()
+
+#endif
+
+#endif
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
@@ -21,6 +21,10 @@
 #include "IvRay3.h"
 #include "IvMath.h"
 #include "IvPlane.h"
+#include "IvSIMD.h"
+#include "IvTriangleStream.h"
+#include "IvVec3Stream.h"
+#include "IvAssert.h"
 
 //----------------------------------------------------------------------------
 //-- Functions ---------------------------------------------------------------
@@ -43,6 +47,17 @@ inline bool CoplanarTriangleIntersect( const IvVector3& P0,
 inline bool EdgeTest( const IvVector2& edgePoint, const IvVector2& edgeVector, 
        float n, const IvVector2& P0, const IvVector2& P1, const IvVector2& P2 );
 
+// Register type for the batched ray tests
+#if defined(IV_AVX)
+#define IV_TRIANGLE_SIMD
+typedef __m256 IvLanes;
+static const unsigned int kWidth = 8;
+#elif defined(IV_SSE2)
+#define IV_TRIANGLE_SIMD
+typedef __m128 IvLanes;
+static const unsigned int kWidth = 4;
+#endif
+
 //-------------------------------------------------------------------------------
 // @ ::IsPointInTriangle()
 //-------------------------------------------------------------------------------
@@ -448,6 +463,262 @@ TriangleIntersect( float& t, const IvVector3& P0, const IvVector3& P1,
 }
 
 
+//-------------------------------------------------------------------------------
+// @ ::RayTriangleHit()
+//-------------------------------------------------------------------------------
+// Helper for the batched TriangleIntersect()
+//
+// Same test as the single ray version, with the edges precomputed.  Returns
+// the line parameter t and the barycentric coordinates u, v of P1 and P2.
+//-------------------------------------------------------------------------------
+static inline bool
+RayTriangleHit( float& t, float& u, float& v,
+                float ox, float oy, float oz, float dx, float dy, float dz,
+                float p0x, float p0y, float p0z, float e1x, float e1y, float e1z,
+                float e2x, float e2y, float e2z )
+{
+    // p = d x e2
+    float px = dy*e2z - dz*e2y;
+    float py = dz*e2x - dx*e2z;
+    float pz = dx*e2y - dy*e2x;
+    float a = e1x*px + e1y*py + e1z*pz;
+    if ( IvIsZero(a) )
+        return false;
+    float f = 1.0f/a;
+
+    float sx = ox - p0x, sy = oy - p0y, sz = oz - p0z;
+    u = f*(sx*px + sy*py + sz*pz);
+    if (u < 0.0f || u > 1.0f) 
+        return false;
+
+    // q = s x e1
+    float qx = sy*e1z - sz*e1y;
+    float qy = sz*e1x - sx*e1z;
+    float qz = sx*e1y - sy*e1x;
+    v = f*(dx*qx + dy*qy + dz*qz);
+    if (v < 0.0f || u+v > 1.0f) 
+        return false;
+
+    t = f*(e2x*qx + e2y*qy + e2z*qz);
+    return (t >= 0.0f);
+
+}   // End of ::RayTriangleHit()
+
+
+#if defined(IV_TRIANGLE_SIMD)
+//-------------------------------------------------------------------------------
+// @ ::RayTriangleLanes()
+//-------------------------------------------------------------------------------
+// Helper for the batched TriangleIntersect()
+//
+// RayTriangleHit() across kWidth ray/triangle pairs.  Returns a mask of the
+// lanes that hit closer than tMax.
+//-------------------------------------------------------------------------------
+static inline IvLanes
+RayTriangleLanes( IvLanes& t, IvLanes& u, IvLanes& v,
+                  IvLanes ox, IvLanes oy, IvLanes oz, IvLanes dx, IvLanes dy, IvLanes dz,
+                  IvLanes p0x, IvLanes p0y, IvLanes p0z, IvLanes e1x, IvLanes e1y, IvLanes e1z,
+                  IvLanes e2x, IvLanes e2y, IvLanes e2z, IvLanes tMax )
+{
+    const IvLanes zero = IvBroadcast<IvLanes>( 0.0f );
+    const IvLanes one = IvBroadcast<IvLanes>( 1.0f );
+    const IvLanes epsilon = IvBroadcast<IvLanes>( kEpsilon );
+
+    IvLanes px = IvSub( IvMul( dy, e2z ), IvMul( dz, e2y ) );
+    IvLanes py = IvSub( IvMul( dz, e2x ), IvMul( dx, e2z ) );
+    IvLanes pz = IvSub( IvMul( dx, e2y ), IvMul( dy, e2x ) );
+    IvLanes a = IvMulAdd( e1z, pz, IvMulAdd( e1y, py, IvMul( e1x, px ) ) );
+    IvLanes mask = IvOr( IvCmpLe( epsilon, a ), IvCmpLe( a, IvSub( zero, epsilon ) ) );
+    IvLanes f = IvDiv( one, a );
+
+    IvLanes sx = IvSub( ox, p0x ), sy = IvSub( oy, p0y ), sz = IvSub( oz, p0z );
+    u = IvMul( f, IvMulAdd( sz, pz, IvMulAdd( sy, py, IvMul( sx, px ) ) ) );
+
+    IvLanes qx = IvSub( IvMul( sy, e1z ), IvMul( sz, e1y ) );
+    IvLanes qy = IvSub( IvMul( sz, e1x ), IvMul( sx, e1z ) );
+    IvLanes qz = IvSub( IvMul( sx, e1y ), IvMul( sy, e1x ) );
+    v = IvMul( f, IvMulAdd( dz, qz, IvMulAdd( dy, qy, IvMul( dx, qx ) ) ) );
+    t = IvMul( f, IvMulAdd( e2z, qz, IvMulAdd( e2y, qy, IvMul( e2x, qx ) ) ) );
+
+    mask = IvAnd( mask, IvAnd( IvCmpLe( zero, u ), IvCmpLe( zero, v ) ) );
+    mask = IvAnd( mask, IvCmpLe( IvAdd( u, v ), one ) );
+    mask = IvAnd( mask, IvAnd( IvCmpLe( zero, t ), IvCmpLt( t, tMax ) ) );
+    return mask;
+
+}   // End of ::RayTriangleLanes()
+#endif
+
+
+//-------------------------------------------------------------------------------
+// @ ::TriangleIntersect()
+//-------------------------------------------------------------------------------
+// Finds the nearest triangle in the stream hit by the ray, if it is nearer
+// than the current hit.  Returns true if the hit was replaced.
+//-------------------------------------------------------------------------------
+bool
+TriangleIntersect( IvTriangleHit& hit, const IvRay3& ray, const IvTriangleStream& triangles )
+{
+    IvVector3 origin = ray.GetOrigin();
+    IvVector3 direction = ray.GetDirection();
+    const IvVec3Stream& P0 = triangles.GetP0();
+    const IvVec3Stream& e1 = triangles.GetEdge1();
+    const IvVec3Stream& e2 = triangles.GetEdge2();
+    const float* p0x = P0.GetX(); const float* p0y = P0.GetY(); const float* p0z = P0.GetZ();
+    const float* e1x = e1.GetX(); const float* e1y = e1.GetY(); const float* e1z = e1.GetZ();
+    const float* e2x = e2.GetX(); const float* e2y = e2.GetY(); const float* e2z = e2.GetZ();
+
+    bool found = false;
+#if defined(IV_TRIANGLE_SIMD)
+    // padding triangles are degenerate, so run over the whole padded stream
+    const unsigned int count = triangles.GetPaddedCount();
+    IvLanes ox = IvBroadcast<IvLanes>( origin.x );
+    IvLanes oy = IvBroadcast<IvLanes>( origin.y );
+    IvLanes oz = IvBroadcast<IvLanes>( origin.z );
+    IvLanes dx = IvBroadcast<IvLanes>( direction.x );
+    IvLanes dy = IvBroadcast<IvLanes>( direction.y );
+    IvLanes dz = IvBroadcast<IvLanes>( direction.z );
+    IvLanes tMax = IvBroadcast<IvLanes>( hit.t );
+    IV_ALIGN(32) float tLanes[kWidth], uLanes[kWidth], vLanes[kWidth];
+    for ( unsigned int i = 0; i < count; i += kWidth )
+    {
+        IvLanes tl, ul, vl;
+        IvLanes mask = RayTriangleLanes( tl, ul, vl, ox, oy, oz, dx, dy, dz,
+            IvLoad<IvLanes>( p0x + i ), IvLoad<IvLanes>( p0y + i ), IvLoad<IvLanes>( p0z + i ),
+            IvLoad<IvLanes>( e1x + i ), IvLoad<IvLanes>( e1y + i ), IvLoad<IvLanes>( e1z + i ),
+            IvLoad<IvLanes>( e2x + i ), IvLoad<IvLanes>( e2y + i ), IvLoad<IvLanes>( e2z + i ),
+            tMax );
+        int bits = IvMoveMask( mask );
+        if ( !bits )
+            continue;
+
+        // rare: pick the nearest of the lanes that hit
+        IvStore( tLanes, tl );
+        IvStore( uLanes, ul );
+        IvStore( vLanes, vl );
+        for ( unsigned int lane = 0; lane < kWidth; ++lane )
+        {
+            if ( (bits & (1 << lane)) && tLanes[lane] < hit.t )
+            {
+                hit.t = tLanes[lane];
+                hit.s = uLanes[lane];
+                hit.u = vLanes[lane];
+                hit.index = (int)(i + lane);
+                found = true;
+            }
+        }
+        tMax = IvBroadcast<IvLanes>( hit.t );
+    }
+#else
+    const unsigned int count = triangles.GetCount();
+    float t, u, v;
+    for ( unsigned int i = 0; i < count; ++i )
+    {
+        if ( RayTriangleHit( t, u, v, origin.x, origin.y, origin.z,
+                             direction.x, direction.y, direction.z,
+                             p0x[i], p0y[i], p0z[i], e1x[i], e1y[i], e1z[i],
+                             e2x[i], e2y[i], e2z[i] ) && t < hit.t )
+        {
+            hit.t = t;
+            hit.s = u;
+            hit.u = v;
+            hit.index = (int)i;
+            found = true;
+        }
+    }
+#endif
+    if ( found )
+        hit.r = 1.0f - hit.s - hit.u;
+
+    return found;
+
+}   // End of ::TriangleIntersect()
+
+
+//-------------------------------------------------------------------------------
+// @ ::TriangleIntersect()
+//-------------------------------------------------------------------------------
+// Tests a stream of rays against triangle P0P1P2.  For each ray that hits
+// nearer than its current hit, the hit is replaced and tagged with index.
+// Returns true if any hit was replaced.
+//-------------------------------------------------------------------------------
+bool
+TriangleIntersect( IvTriangleHit* hits, const IvVec3Stream& origins,
+                   const IvVec3Stream& directions, const IvVector3& P0,
+                   const IvVector3& P1, const IvVector3& P2, int index )
+{
+    ASSERT( origins.GetCount() == directions.GetCount() );
+
+    IvVector3 e1 = P1 - P0;
+    IvVector3 e2 = P2 - P0;
+    const float* ox = origins.GetX(); const float* oy = origins.GetY(); const float* oz = origins.GetZ();
+    const float* dx = directions.GetX(); const float* dy = directions.GetY(); const float* dz = directions.GetZ();
+    const unsigned int count = origins.GetCount();
+
+    bool found = false;
+    unsigned int i = 0;
+    float t, u, v;
+#if defined(IV_TRIANGLE_SIMD)
+    IvLanes p0x = IvBroadcast<IvLanes>( P0.x );
+    IvLanes p0y = IvBroadcast<IvLanes>( P0.y );
+    IvLanes p0z = IvBroadcast<IvLanes>( P0.z );
+    IvLanes e1x = IvBroadcast<IvLanes>( e1.x );
+    IvLanes e1y = IvBroadcast<IvLanes>( e1.y );
+    IvLanes e1z = IvBroadcast<IvLanes>( e1.z );
+    IvLanes e2x = IvBroadcast<IvLanes>( e2.x );
+    IvLanes e2y = IvBroadcast<IvLanes>( e2.y );
+    IvLanes e2z = IvBroadcast<IvLanes>( e2.z );
+    IvLanes tMax = IvBroadcast<IvLanes>( FLT_MAX );
+    IV_ALIGN(32) float tLanes[kWidth], uLanes[kWidth], vLanes[kWidth];
+    for ( ; i + kWidth <= count; i += kWidth )
+    {
+        IvLanes tl, ul, vl;
+        IvLanes mask = RayTriangleLanes( tl, ul, vl,
+            IvLoad<IvLanes>( ox + i ), IvLoad<IvLanes>( oy + i ), IvLoad<IvLanes>( oz + i ),
+            IvLoad<IvLanes>( dx + i ), IvLoad<IvLanes>( dy + i ), IvLoad<IvLanes>( dz + i ),
+            p0x, p0y, p0z, e1x, e1y, e1z, e2x, e2y, e2z, tMax );
+        int bits = IvMoveMask( mask );
+        if ( !bits )
+            continue;
+
+        IvStore( tLanes, tl );
+        IvStore( uLanes, ul );
+        IvStore( vLanes, vl );
+        for ( unsigned int lane = 0; lane < kWidth; ++lane )
+        {
+            IvTriangleHit& hit = hits[i + lane];
+            if ( (bits & (1 << lane)) && tLanes[lane] < hit.t )
+            {
+                hit.t = tLanes[lane];
+                hit.r = 1.0f - uLanes[lane] - vLanes[lane];
+                hit.s = uLanes[lane];
+                hit.u = vLanes[lane];
+                hit.index = index;
+                found = true;
+            }
+        }
+    }
+#endif
+    for ( ; i < count; ++i )
+    {
+        IvTriangleHit& hit = hits[i];
+        if ( RayTriangleHit( t, u, v, ox[i], oy[i], oz[i], dx[i], dy[i], dz[i],
+                             P0.x, P0.y, P0.z, e1.x, e1.y, e1.z, e2.x, e2.y, e2.z )
+             && t < hit.t )
+        {
+            hit.t = t;
+            hit.r = 1.0f - u - v;
+            hit.s = u;
+            hit.u = v;
+            hit.index = index;
+            found = true;
+        }
+    }
+
+    return found;
+
+}   // End of ::TriangleIntersect()
+
+
 //-------------------------------------------------------------------------------
 // @ ::TriangleClassify()
 //-------------------------------------------------------------------------------
@@ -18,6 +18,8 @@
 //-- Dependencies ---------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+#include <float.h>
+
 //-------------------------------------------------------------------------------
 //-- Typedefs, Structs ----------------------------------------------------------
 //-------------------------------------------------------------------------------
@@ -26,6 +28,18 @@ class IvVector2;
 class IvVector3;
 class IvRay3;
 class IvPlane;
+class IvVec3Stream;
+class IvTriangleStream;
+
+// nearest hit found by the batched ray tests
+struct IvTriangleHit
+{
+    inline IvTriangleHit() : t( FLT_MAX ), r( 0.0f ), s( 0.0f ), u( 0.0f ), index( -1 ) {}
+
+    float t;            // ray parameter
+    float r, s, u;      // barycentric coordinates, as BarycentricCoordinates() returns r, s, t
+    int   index;        // triangle index, -1 if nothing hit
+};
 
 //-------------------------------------------------------------------------------
 //-- Function Prototypes --------------------------------------------------------
@@ -45,6 +59,16 @@ bool TriangleIntersect( const IvVector3& P0, const IvVector3& P1,
 bool TriangleIntersect( float& t, const IvVector3& P0, const IvVector3& P1, 
                         const IvVector3& P2, const IvRay3& ray );
 
+// batched ray intersection -- hits are only replaced by nearer ones, so
+// results can be accumulated over several calls
+// one ray against a stream of triangles
+bool TriangleIntersect( IvTriangleHit& hit, const IvRay3& ray,
+                        const IvTriangleStream& triangles );
+// a stream of rays against triangle number index, hits[] holds one entry per ray
+bool TriangleIntersect( IvTriangleHit* hits, const IvVec3Stream& origins,
+                        const IvVec3Stream& directions, const IvVector3& P0,
+                        const IvVector3& P1, const IvVector3& P2, int index );
+
 // plane classification
 float TriangleClassify( const IvVector3& P0, const IvVector3& P1, 
                         const IvVector3& P2, const IvPlane& plane );
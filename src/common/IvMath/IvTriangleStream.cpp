@@ -0,0 +1,102 @@
+//===============================================================================
+// @ IvTriangleStream.cpp
+//
+// Structure-of-arrays container for triangles
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvTriangleStream.h"
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleStream::IvTriangleStream()
+//-------------------------------------------------------------------------------
+// Construct a stream of count degenerate triangles
+//-------------------------------------------------------------------------------
+IvTriangleStream::IvTriangleStream( unsigned int count ) :
+    mP0( count ),
+    mEdge1( count ),
+    mEdge2( count )
+{
+}   // End of IvTriangleStream::IvTriangleStream()
+
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleStream::Resize()
+//-------------------------------------------------------------------------------
+// Change the number of triangles
+//-------------------------------------------------------------------------------
+void
+IvTriangleStream::Resize( unsigned int count )
+{
+    mP0.Resize( count );
+    mEdge1.Resize( count );
+    mEdge2.Resize( count );
+
+}   // End of IvTriangleStream::Resize()
+
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleStream::Get()
+//-------------------------------------------------------------------------------
+// Gather one triangle
+//-------------------------------------------------------------------------------
+void
+IvTriangleStream::Get( unsigned int i, IvVector3& P0, IvVector3& P1, IvVector3& P2 ) const
+{
+    P0 = mP0.Get( i );
+    P1 = P0 + mEdge1.Get( i );
+    P2 = P0 + mEdge2.Get( i );
+
+}   // End of IvTriangleStream::Get()
+
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleStream::Set()
+//-------------------------------------------------------------------------------
+// Scatter one triangle
+//-------------------------------------------------------------------------------
+void
+IvTriangleStream::Set( unsigned int i, const IvVector3& P0, const IvVector3& P1,
+                       const IvVector3& P2 )
+{
+    mP0.Set( i, P0 );
+    mEdge1.Set( i, P1 - P0 );
+    mEdge2.Set( i, P2 - P0 );
+
+}   // End of IvTriangleStream::Set()
+
+
+//-------------------------------------------------------------------------------
+// @ IvTriangleStream::Set()
+//-------------------------------------------------------------------------------
+// Resize to triangleCount and copy in an indexed triangle list
+//-------------------------------------------------------------------------------
+void
+IvTriangleStream::Set( const IvVector3* positions, const UInt32* indices,
+                       unsigned int triangleCount )
+{
+    Resize( triangleCount );
+
+    for ( unsigned int i = 0; i < triangleCount; ++i )
+    {
+        Set( i, positions[indices[3*i]], positions[indices[3*i+1]], positions[indices[3*i+2]] );
+    }
+
+}   // End of IvTriangleStream::Set()
@@ -0,0 +1,77 @@
+//===============================================================================
+// @ IvTriangleStream.h
+//
+// Structure-of-arrays container for triangles
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Each triangle P0P1P2 is kept as P0 and the two edges P1-P0 and P2-P0,
+// which is what the ray tests in IvTriangle.h consume.  Padding triangles
+// are degenerate, so they never report a hit.
+//
+//===============================================================================
+
+#ifndef __IvTriangleStream__h__
+#define __IvTriangleStream__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvVec3Stream.h"
+#include "IvTypes.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvTriangleStream
+{
+public:
+    // constructor/destructor
+    inline IvTriangleStream() {}
+    explicit IvTriangleStream( unsigned int count );
+    inline ~IvTriangleStream() {}
+
+    // size -- existing triangles are kept, new ones are degenerate
+    void Resize( unsigned int count );
+    inline unsigned int GetCount() const       { return mP0.GetCount(); }
+    inline unsigned int GetPaddedCount() const { return mP0.GetPaddedCount(); }
+
+    // element accessors
+    void Get( unsigned int i, IvVector3& P0, IvVector3& P1, IvVector3& P2 ) const;
+    void Set( unsigned int i, const IvVector3& P0, const IvVector3& P1, const IvVector3& P2 );
+
+    // resize and copy in an indexed triangle list
+    void Set( const IvVector3* positions, const UInt32* indices, unsigned int triangleCount );
+
+    // lane accessors
+    inline const IvVec3Stream& GetP0() const    { return mP0; }
+    inline const IvVec3Stream& GetEdge1() const { return mEdge1; }
+    inline const IvVec3Stream& GetEdge2() const { return mEdge2; }
+
+protected:
+    IvVec3Stream mP0;           // first vertex
+    IvVec3Stream mEdge1;        // P1 - P0
+    IvVec3Stream mEdge2;        // P2 - P0
+
+private:
+};
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,534 @@
+//===============================================================================
+// @ IvVec3Stream.cpp
+//
+// Structure-of-arrays container for 3D vectors
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvVec3Stream.h"
+#include "IvMath.h"
+#include "IvSIMDMath.h"
+
+#include "IvAssert.h"
+
+#include <string.h>
+
+//-------------------------------------------------------------------------------
+//-- Static Members -------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// Register type for the kernels below.  Loads and stores of stream data
+// are aligned; float results supplied by the caller may not be.
+#if defined(IV_AVX)
+#define IV_STREAM_SIMD
+typedef __m256 IvLanes;
+static const unsigned int kWidth = 8;
+#elif defined(IV_SSE2)
+#define IV_STREAM_SIMD
+typedef __m128 IvLanes;
+static const unsigned int kWidth = 4;
+#endif
+
+#if defined(IV_STREAM_SIMD)
+//-------------------------------------------------------------------------------
+// @ LengthSquaredLanes()
+//-------------------------------------------------------------------------------
+// Squared length of kWidth elements starting at index i
+//-------------------------------------------------------------------------------
+static inline IvLanes
+LengthSquaredLanes( const float* x, const float* y, const float* z, unsigned int i )
+{
+    IvLanes vx = IvLoad<IvLanes>( x + i );
+    IvLanes vy = IvLoad<IvLanes>( y + i );
+    IvLanes vz = IvLoad<IvLanes>( z + i );
+    return IvMulAdd( vz, vz, IvMulAdd( vy, vy, IvMul( vx, vx ) ) );
+
+}   // End of LengthSquaredLanes()
+#endif
+
+//-------------------------------------------------------------------------------
+// @ Dot()
+//-------------------------------------------------------------------------------
+// Per-element dot product of two streams of the same size
+//-------------------------------------------------------------------------------
+void
+Dot( float* result, const IvVec3Stream& stream1, const IvVec3Stream& stream2 )
+{
+    ASSERT( stream1.mCount == stream2.mCount );
+
+    const unsigned int count = stream1.mCount;
+    unsigned int i = 0;
+#if defined(IV_STREAM_SIMD)
+    for ( ; i + kWidth <= count; i += kWidth )
+    {
+        IvLanes x1 = IvLoad<IvLanes>( stream1.mX + i ), x2 = IvLoad<IvLanes>( stream2.mX + i );
+        IvLanes y1 = IvLoad<IvLanes>( stream1.mY + i ), y2 = IvLoad<IvLanes>( stream2.mY + i );
+        IvLanes z1 = IvLoad<IvLanes>( stream1.mZ + i ), z2 = IvLoad<IvLanes>( stream2.mZ + i );
+        IvLanes dot = IvMulAdd( z1, z2, IvMulAdd( y1, y2, IvMul( x1, x2 ) ) );
+        IvStoreU( result + i, dot );
+    }
+#endif
+    for ( ; i < count; ++i )
+    {
+        result[i] = stream1.mX[i]*stream2.mX[i] + stream1.mY[i]*stream2.mY[i]
+                  + stream1.mZ[i]*stream2.mZ[i];
+    }
+
+}   // End of Dot()
+
+
+//-------------------------------------------------------------------------------
+// @ Cross()
+//-------------------------------------------------------------------------------
+// Per-element cross product of two streams of the same size.  The result
+// may be one of the inputs.
+//-------------------------------------------------------------------------------
+void
+Cross( IvVec3Stream& result, const IvVec3Stream& stream1, const IvVec3Stream& stream2 )
+{
+    ASSERT( stream1.mCount == stream2.mCount );
+
+    result.Resize( stream1.mCount );
+    const unsigned int count = stream1.GetPaddedCount();
+    unsigned int i = 0;
+#if defined(IV_STREAM_SIMD)
+    for ( ; i < count; i += kWidth )
+    {
+        IvLanes x1 = IvLoad<IvLanes>( stream1.mX + i ), x2 = IvLoad<IvLanes>( stream2.mX + i );
+        IvLanes y1 = IvLoad<IvLanes>( stream1.mY + i ), y2 = IvLoad<IvLanes>( stream2.mY + i );
+        IvLanes z1 = IvLoad<IvLanes>( stream1.mZ + i ), z2 = IvLoad<IvLanes>( stream2.mZ + i );
+        IvStore( result.mX + i, IvSub( IvMul( y1, z2 ), IvMul( z1, y2 ) ) );
+        IvStore( result.mY + i, IvSub( IvMul( z1, x2 ), IvMul( x1, z2 ) ) );
+        IvStore( result.mZ + i, IvSub( IvMul( x1, y2 ), IvMul( y1, x2 ) ) );
+    }
+#endif
+    for ( ; i < count; ++i )
+    {
+        float x1 = stream1.mX[i], y1 = stream1.mY[i], z1 = stream1.mZ[i];
+        float x2 = stream2.mX[i], y2 = stream2.mY[i], z2 = stream2.mZ[i];
+        result.mX[i] = y1*z2 - z1*y2;
+        result.mY[i] = z1*x2 - x1*z2;
+        result.mZ[i] = x1*y2 - y1*x2;
+    }
+
+}   // End of Cross()
+
+
+//-------------------------------------------------------------------------------
+// @ Lerp()
+//-------------------------------------------------------------------------------
+// Per-element linear interpolation between two streams of the same size.
+// The result may be one of the inputs.
+//-------------------------------------------------------------------------------
+void
+Lerp( IvVec3Stream& result, const IvVec3Stream& start, const IvVec3Stream& end, float t )
+{
+    ASSERT( start.mCount == end.mCount );
+
+    result.Resize( start.mCount );
+    const unsigned int count = start.GetPaddedCount();
+    unsigned int i = 0;
+#if defined(IV_STREAM_SIMD)
+    IvLanes vt = IvBroadcast<IvLanes>( t );
+    for ( ; i < count; i += kWidth )
+    {
+        IvLanes x0 = IvLoad<IvLanes>( start.mX + i );
+        IvLanes y0 = IvLoad<IvLanes>( start.mY + i );
+        IvLanes z0 = IvLoad<IvLanes>( start.mZ + i );
+        IvStore( result.mX + i, IvMulAdd( vt, IvSub( IvLoad<IvLanes>( end.mX + i ), x0 ), x0 ) );
+        IvStore( result.mY + i, IvMulAdd( vt, IvSub( IvLoad<IvLanes>( end.mY + i ), y0 ), y0 ) );
+        IvStore( result.mZ + i, IvMulAdd( vt, IvSub( IvLoad<IvLanes>( end.mZ + i ), z0 ), z0 ) );
+    }
+#endif
+    for ( ; i < count; ++i )
+    {
+        result.mX[i] = start.mX[i] + t*(end.mX[i] - start.mX[i]);
+        result.mY[i] = start.mY[i] + t*(end.mY[i] - start.mY[i]);
+        result.mZ[i] = start.mZ[i] + t*(end.mZ[i] - start.mZ[i]);
+    }
+
+}   // End of Lerp()
+
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::IvVec3Stream()
+//-------------------------------------------------------------------------------
+// Default constructor
+//-------------------------------------------------------------------------------
+IvVec3Stream::IvVec3Stream() :
+    mCount( 0 ),
+    mCapacity( 0 ),
+    mX( 0 ),
+    mY( 0 ),
+    mZ( 0 ),
+    mBuffer( 0 )
+{
+}   // End of IvVec3Stream::IvVec3Stream()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::IvVec3Stream()
+//-------------------------------------------------------------------------------
+// Construct a stream of count zero vectors
+//-------------------------------------------------------------------------------
+IvVec3Stream::IvVec3Stream( unsigned int count ) :
+    mCount( 0 ),
+    mCapacity( 0 ),
+    mX( 0 ),
+    mY( 0 ),
+    mZ( 0 ),
+    mBuffer( 0 )
+{
+    Resize( count );
+
+}   // End of IvVec3Stream::IvVec3Stream()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::~IvVec3Stream()
+//-------------------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------------------
+IvVec3Stream::~IvVec3Stream()
+{
+    delete [] mBuffer;
+
+}   // End of IvVec3Stream::~IvVec3Stream()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::IvVec3Stream()
+//-------------------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------------------
+IvVec3Stream::IvVec3Stream( const IvVec3Stream& other ) :
+    mCount( 0 ),
+    mCapacity( 0 ),
+    mX( 0 ),
+    mY( 0 ),
+    mZ( 0 ),
+    mBuffer( 0 )
+{
+    *this = other;
+
+}   // End of IvVec3Stream::IvVec3Stream()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::operator=()
+//-------------------------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------------------
+IvVec3Stream&
+IvVec3Stream::operator=( const IvVec3Stream& other )
+{
+    // if same object
+    if ( this == &other )
+        return *this;
+
+    mCount = 0;
+    Resize( other.mCount );
+    unsigned int padded = other.GetPaddedCount();
+    if ( padded == 0 )
+        return *this;
+    memcpy( mX, other.mX, padded*sizeof(float) );
+    memcpy( mY, other.mY, padded*sizeof(float) );
+    memcpy( mZ, other.mZ, padded*sizeof(float) );
+
+    return *this;
+
+}   // End of IvVec3Stream::operator=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::Allocate()
+//-------------------------------------------------------------------------------
+// Replace the lane arrays with new zeroed storage for capacity elements,
+// keeping the current contents
+//-------------------------------------------------------------------------------
+void
+IvVec3Stream::Allocate( unsigned int capacity )
+{
+    ASSERT( (capacity & (kLanes-1)) == 0 );
+
+    // one block for all three lanes, plus slack for alignment
+    char* buffer = new char[3*capacity*sizeof(float) + 32];
+    float* x = reinterpret_cast<float*>( (reinterpret_cast<size_t>(buffer) + 31) & ~size_t(31) );
+    memset( x, 0, 3*capacity*sizeof(float) );
+
+    if ( mBuffer )
+    {
+        memcpy( x, mX, mCount*sizeof(float) );
+        memcpy( x + capacity, mY, mCount*sizeof(float) );
+        memcpy( x + 2*capacity, mZ, mCount*sizeof(float) );
+        delete [] mBuffer;
+    }
+
+    mBuffer = buffer;
+    mCapacity = capacity;
+    mX = x;
+    mY = x + capacity;
+    mZ = x + 2*capacity;
+
+}   // End of IvVec3Stream::Allocate()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::Resize()
+//-------------------------------------------------------------------------------
+// Change the number of elements.  Elements past the old count, including
+// the padding, are set to zero.
+//-------------------------------------------------------------------------------
+void
+IvVec3Stream::Resize( unsigned int count )
+{
+    unsigned int padded = (count + kLanes-1) & ~(kLanes-1);
+    if ( padded > mCapacity )
+    {
+        if ( count < mCount )
+            mCount = count;
+        Allocate( padded );
+    }
+    else if ( count > mCount )
+    {
+        // clear anything a previous shrink left behind
+        unsigned int extra = padded - mCount;
+        memset( mX + mCount, 0, extra*sizeof(float) );
+        memset( mY + mCount, 0, extra*sizeof(float) );
+        memset( mZ + mCount, 0, extra*sizeof(float) );
+    }
+    else if ( GetPaddedCount() > count )
+    {
+        // nothing to clear when the padded size is unchanged, and an empty
+        // stream has no storage to pass to memset
+        unsigned int extra = GetPaddedCount() - count;
+        memset( mX + count, 0, extra*sizeof(float) );
+        memset( mY + count, 0, extra*sizeof(float) );
+        memset( mZ + count, 0, extra*sizeof(float) );
+    }
+    mCount = count;
+
+}   // End of IvVec3Stream::Resize()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::Set()
+//-------------------------------------------------------------------------------
+// Resize to count and copy in an array of packed vectors
+//-------------------------------------------------------------------------------
+void
+IvVec3Stream::Set( const IvVector3* vectors, unsigned int count )
+{
+    ASSERT( sizeof(IvVector3) == 3*sizeof(float) );
+
+    Resize( count );
+
+    const float* in = &vectors->x;
+    unsigned int i = 0;
+#if defined(IV_SSE2)
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        __m128 x, y, z;
+        IvLoadXYZ4( in + 3*i, x, y, z );
+        _mm_store_ps( mX + i, x );
+        _mm_store_ps( mY + i, y );
+        _mm_store_ps( mZ + i, z );
+    }
+#endif
+    for ( ; i < count; ++i )
+    {
+        mX[i] = in[3*i];
+        mY[i] = in[3*i+1];
+        mZ[i] = in[3*i+2];
+    }
+
+}   // End of IvVec3Stream::Set()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::Get()
+//-------------------------------------------------------------------------------
+// Copy out to an array of GetCount() packed vectors
+//-------------------------------------------------------------------------------
+void
+IvVec3Stream::Get( IvVector3* vectors ) const
+{
+    ASSERT( sizeof(IvVector3) == 3*sizeof(float) );
+
+    float* out = &vectors->x;
+    unsigned int i = 0;
+#if defined(IV_SSE2)
+    for ( ; i + 4 <= mCount; i += 4 )
+    {
+        IvStoreXYZ4( out + 3*i, _mm_load_ps( mX + i ), _mm_load_ps( mY + i ),
+                     _mm_load_ps( mZ + i ) );
+    }
+#endif
+    for ( ; i < mCount; ++i )
+    {
+        out[3*i] = mX[i];
+        out[3*i+1] = mY[i];
+        out[3*i+2] = mZ[i];
+    }
+
+}   // End of IvVec3Stream::Get()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::Length()
+//-------------------------------------------------------------------------------
+// Length of each element
+//-------------------------------------------------------------------------------
+void
+IvVec3Stream::Length( float* result ) const
+{
+    unsigned int i = 0;
+#if defined(IV_STREAM_SIMD)
+    for ( ; i + kWidth <= mCount; i += kWidth )
+    {
+        IvStoreU( result + i, IvSqrt( LengthSquaredLanes( mX, mY, mZ, i ) ) );
+    }
+#endif
+    for ( ; i < mCount; ++i )
+    {
+        result[i] = ::IvSqrt( mX[i]*mX[i] + mY[i]*mY[i] + mZ[i]*mZ[i] );
+    }
+
+}   // End of IvVec3Stream::Length()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::LengthSquared()
+//-------------------------------------------------------------------------------
+// Squared length of each element
+//-------------------------------------------------------------------------------
+void
+IvVec3Stream::LengthSquared( float* result ) const
+{
+    unsigned int i = 0;
+#if defined(IV_STREAM_SIMD)
+    for ( ; i + kWidth <= mCount; i += kWidth )
+    {
+        IvStoreU( result + i, LengthSquaredLanes( mX, mY, mZ, i ) );
+    }
+#endif
+    for ( ; i < mCount; ++i )
+    {
+        result[i] = mX[i]*mX[i] + mY[i]*mY[i] + mZ[i]*mZ[i];
+    }
+
+}   // End of IvVec3Stream::LengthSquared()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::Normalize()
+//-------------------------------------------------------------------------------
+// Set each element to unit length, or to zero if it is near zero length
+//-------------------------------------------------------------------------------
+void
+IvVec3Stream::Normalize()
+{
+    const unsigned int count = GetPaddedCount();
+    unsigned int i = 0;
+#if defined(IV_STREAM_SIMD)
+    const IvLanes epsilon = IvBroadcast<IvLanes>( kEpsilon );
+    for ( ; i < count; i += kWidth )
+    {
+        IvLanes lengthsq = LengthSquaredLanes( mX, mY, mZ, i );
+        IvLanes factor = IvAndNot( IvCmpLe( lengthsq, epsilon ), IvRecipSqrt( lengthsq ) );
+        IvStore( mX + i, IvMul( IvLoad<IvLanes>( mX + i ), factor ) );
+        IvStore( mY + i, IvMul( IvLoad<IvLanes>( mY + i ), factor ) );
+        IvStore( mZ + i, IvMul( IvLoad<IvLanes>( mZ + i ), factor ) );
+    }
+#endif
+    for ( ; i < count; ++i )
+    {
+        float lengthsq = mX[i]*mX[i] + mY[i]*mY[i] + mZ[i]*mZ[i];
+        float factor = IvIsZero( lengthsq ) ? 0.0f : IvRecipSqrt( lengthsq );
+        mX[i] *= factor;
+        mY[i] *= factor;
+        mZ[i] *= factor;
+    }
+
+}   // End of IvVec3Stream::Normalize()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::MinMax()
+//-------------------------------------------------------------------------------
+// Componentwise minimum and maximum over all elements
+//-------------------------------------------------------------------------------
+void
+IvVec3Stream::MinMax( IvVector3& min, IvVector3& max ) const
+{
+    ASSERT( mCount > 0 );
+    if ( mCount == 0 )
+    {
+        min.Zero();
+        max.Zero();
+        return;
+    }
+
+    min.Set( mX[0], mY[0], mZ[0] );
+    max = min;
+    unsigned int i = 0;
+#if defined(IV_STREAM_SIMD)
+    if ( mCount >= kWidth )
+    {
+        IvLanes minX = IvLoad<IvLanes>( mX );
+        IvLanes minY = IvLoad<IvLanes>( mY );
+        IvLanes minZ = IvLoad<IvLanes>( mZ );
+        IvLanes maxX = minX, maxY = minY, maxZ = minZ;
+        for ( i = kWidth; i + kWidth <= mCount; i += kWidth )
+        {
+            IvLanes x = IvLoad<IvLanes>( mX + i );
+            IvLanes y = IvLoad<IvLanes>( mY + i );
+            IvLanes z = IvLoad<IvLanes>( mZ + i );
+            minX = IvMin( minX, x ); maxX = IvMax( maxX, x );
+            minY = IvMin( minY, y ); maxY = IvMax( maxY, y );
+            minZ = IvMin( minZ, z ); maxZ = IvMax( maxZ, z );
+        }
+
+        IV_ALIGN(32) float lanes[6][kWidth];
+        IvStore( lanes[0], minX ); IvStore( lanes[1], minY ); IvStore( lanes[2], minZ );
+        IvStore( lanes[3], maxX ); IvStore( lanes[4], maxY ); IvStore( lanes[5], maxZ );
+        for ( unsigned int j = 0; j < kWidth; ++j )
+        {
+            for ( unsigned int k = 0; k < 3; ++k )
+            {
+                if ( lanes[k][j] < min[k] )
+                    min[k] = lanes[k][j];
+                if ( lanes[k+3][j] > max[k] )
+                    max[k] = lanes[k+3][j];
+            }
+        }
+    }
+#endif
+    for ( ; i < mCount; ++i )
+    {
+        if ( mX[i] < min.x ) min.x = mX[i];
+        else if ( mX[i] > max.x ) max.x = mX[i];
+        if ( mY[i] < min.y ) min.y = mY[i];
+        else if ( mY[i] > max.y ) max.y = mY[i];
+        if ( mZ[i] < min.z ) min.z = mZ[i];
+        else if ( mZ[i] > max.z ) max.z = mZ[i];
+    }
+
+}   // End of IvVec3Stream::MinMax()
@@ -0,0 +1,134 @@
+//===============================================================================
+// @ IvVec3Stream.h
+//
+// Structure-of-arrays container for 3D vectors
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// The x, y and z components are stored in three separate arrays, each
+// aligned to 32 bytes and padded with zeros to a multiple of kLanes
+// elements, so the operations below can run 4 or 8 vectors at a time.
+//
+//===============================================================================
+
+#ifndef __IvVec3Stream__h__
+#define __IvVec3Stream__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvVector3.h"
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+//-- Classes --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvVec3Stream
+{
+public:
+    // padding granularity, in elements
+    static const unsigned int kLanes = 8;
+
+    // constructor/destructor
+    IvVec3Stream();
+    explicit IvVec3Stream( unsigned int count );
+    ~IvVec3Stream();
+
+    // copy operations
+    IvVec3Stream( const IvVec3Stream& other );
+    IvVec3Stream& operator=( const IvVec3Stream& other );
+
+    // size -- existing elements are kept, new ones are zero
+    void Resize( unsigned int count );
+    inline unsigned int GetCount() const       { return mCount; }
+    inline unsigned int GetPaddedCount() const { return (mCount + kLanes-1) & ~(kLanes-1); }
+
+    // lane accessors
+    inline float* GetX()             { return mX; }
+    inline float* GetY()             { return mY; }
+    inline float* GetZ()             { return mZ; }
+    inline const float* GetX() const { return mX; }
+    inline const float* GetY() const { return mY; }
+    inline const float* GetZ() const { return mZ; }
+
+    // element accessors
+    inline IvVector3 Get( unsigned int i ) const;
+    inline void Set( unsigned int i, const IvVector3& vector );
+
+    // conversion to and from packed arrays
+    void Set( const IvVector3* vectors, unsigned int count );
+    void Get( IvVector3* vectors ) const;
+
+    // per-element operations -- float results hold GetCount() values
+    void Length( float* result ) const;
+    void LengthSquared( float* result ) const;
+    void Normalize();   // zero-length elements are set to 0
+
+    friend void Dot( float* result, const IvVec3Stream& stream1, const IvVec3Stream& stream2 );
+    friend void Cross( IvVec3Stream& result,
+                       const IvVec3Stream& stream1, const IvVec3Stream& stream2 );
+    friend void Lerp( IvVec3Stream& result,
+                      const IvVec3Stream& start, const IvVec3Stream& end, float t );
+
+    // reductions
+    void MinMax( IvVector3& min, IvVector3& max ) const;
+
+protected:
+    void Allocate( unsigned int capacity );
+
+    unsigned int mCount;        // number of elements
+    unsigned int mCapacity;     // allocated elements per lane
+    float*       mX;            // lane arrays, aligned to 32 bytes
+    float*       mY;
+    float*       mZ;
+    char*        mBuffer;       // unaligned allocation
+
+private:
+};
+
+void Dot( float* result, const IvVec3Stream& stream1, const IvVec3Stream& stream2 );
+void Cross( IvVec3Stream& result, const IvVec3Stream& stream1, const IvVec3Stream& stream2 );
+void Lerp( IvVec3Stream& result, const IvVec3Stream& start, const IvVec3Stream& end, float t );
+
+//-------------------------------------------------------------------------------
+//-- Inlines --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::Get()
+//-------------------------------------------------------------------------------
+// Gather one element
+//-------------------------------------------------------------------------------
+inline IvVector3
+IvVec3Stream::Get( unsigned int i ) const
+{
+    return IvVector3( mX[i], mY[i], mZ[i] );
+
+}   // End of IvVec3Stream::Get()
+
+//-------------------------------------------------------------------------------
+// @ IvVec3Stream::Set()
+//-------------------------------------------------------------------------------
+// Scatter one element
+//-------------------------------------------------------------------------------
+inline void
+IvVec3Stream::Set( unsigned int i, const IvVector3& vector )
+{
+    mX[i] = vector.x; mY[i] = vector.y; mZ[i] = vector.z;
+
+}   // End of IvVec3Stream::Set()
+
+//-------------------------------------------------------------------------------
+//-- Externs --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#endif
@@ -124,6 +124,10 @@ IvVector2::Zero()
     x = y = 0.0f;
 }   // End of IvVector2::Zero()
 
+#if defined(IV_INLINE_MATH)
+#include "IvVector2.inl"
+#endif
+
 //-------------------------------------------------------------------------------
 //-- Externs --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
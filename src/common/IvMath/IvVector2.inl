@@ -0,0 +1,272 @@
+//===============================================================================
+// @ IvVector2.inl
+// 
+// 2D vector class inline operators
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// These definitions are compiled into IvMath by default.  If IV_INLINE_MATH
+// is defined they are instead included by IvVector2.h and expanded inline.
+//===============================================================================
+
+#ifndef __IvVector2__inl__
+#define __IvVector2__inl__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvVector2.h"
+#include "IvMath.h"
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvVector2::Length()
+//-------------------------------------------------------------------------------
+// Vector length
+//-------------------------------------------------------------------------------
+IV_INLINE float
+IvVector2::Length() const
+{
+    return IvSqrt( x*x + y*y );
+
+}   // End of IvVector2::Length()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector2::LengthSquared()
+//-------------------------------------------------------------------------------
+// Vector length squared (avoids square root)
+//-------------------------------------------------------------------------------
+IV_INLINE float
+IvVector2::LengthSquared() const
+{
+    return (x*x + y*y);
+
+}   // End of IvVector2::LengthSquared()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector2::Normalize()
+//-------------------------------------------------------------------------------
+// Set to unit vector
+//-------------------------------------------------------------------------------
+IV_INLINE void
+IvVector2::Normalize()
+{
+    float lengthsq = x*x + y*y;
+
+    if ( IvIsZero( lengthsq ) )
+    {
+        Zero();
+    }
+    else
+    {
+        float factor = IvRecipSqrt( lengthsq );
+        x *= factor;
+        y *= factor;
+    }
+
+}   // End of IvVector2::Normalize()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector2::operator+()
+//-------------------------------------------------------------------------------
+// Add vector to self and return
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector2
+IvVector2::operator+( const IvVector2& other ) const
+{
+    return IvVector2( x + other.x, y + other.y );
+
+}   // End of IvVector2::operator+()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector2::operator+=()
+//-------------------------------------------------------------------------------
+// Add vector to self, store in self
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector2&
+operator+=( IvVector2& self, const IvVector2& other )
+{
+    self.x += other.x;
+    self.y += other.y;
+
+    return self;
+
+}   // End of IvVector2::operator+=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector2::operator-()
+//-------------------------------------------------------------------------------
+// Subtract vector from self and return
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector2
+IvVector2::operator-( const IvVector2& other ) const
+{
+    return IvVector2( x - other.x, y - other.y );
+
+}   // End of IvVector2::operator-()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector2::operator-=()
+//-------------------------------------------------------------------------------
+// Subtract vector from self, store in self
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector2&
+operator-=( IvVector2& self, const IvVector2& other )
+{
+    self.x -= other.x;
+    self.y -= other.y;
+
+    return self;
+
+}   // End of IvVector2::operator-=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector2::operator-() (unary)
+//-------------------------------------------------------------------------------
+// Negate self and return
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector2
+IvVector2::operator-() const
+{
+    return IvVector2(-x, -y);
+}    // End of IvVector2::operator-()
+
+
+//-------------------------------------------------------------------------------
+// @ operator*()
+//-------------------------------------------------------------------------------
+// Scalar multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector2
+IvVector2::operator*( float scalar )
+{
+    return IvVector2( scalar*x, scalar*y );
+
+}   // End of operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ operator*()
+//-------------------------------------------------------------------------------
+// Scalar multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector2
+operator*( float scalar, const IvVector2& vector )
+{
+    return IvVector2( scalar*vector.x, scalar*vector.y );
+
+}   // End of operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector2::operator*()
+//-------------------------------------------------------------------------------
+// Scalar multiplication by self
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector2&
+IvVector2::operator*=( float scalar )
+{
+    x *= scalar;
+    y *= scalar;
+
+    return *this;
+
+}   // End of IvVector2::operator*=()
+
+
+//-------------------------------------------------------------------------------
+// @ operator/()
+//-------------------------------------------------------------------------------
+// Scalar division
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector2
+IvVector2::operator/( float scalar )
+{
+    return IvVector2( x/scalar, y/scalar );
+
+}   // End of operator/()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector2::operator/=()
+//-------------------------------------------------------------------------------
+// Scalar division by self
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector2&
+IvVector2::operator/=( float scalar )
+{
+    x /= scalar;
+    y /= scalar;
+
+    return *this;
+
+}   // End of IvVector2::operator/=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector2::Dot()
+//-------------------------------------------------------------------------------
+// Dot product by self
+//-------------------------------------------------------------------------------
+IV_INLINE float
+IvVector2::Dot( const IvVector2& vector ) const
+{
+    return (x*vector.x + y*vector.y);
+
+}   // End of IvVector2::Dot()
+
+
+//-------------------------------------------------------------------------------
+// @ Dot()
+//-------------------------------------------------------------------------------
+// Dot product friend operator
+//-------------------------------------------------------------------------------
+IV_INLINE float
+Dot( const IvVector2& vector1, const IvVector2& vector2 )
+{
+    return (vector1.x*vector2.x + vector1.y*vector2.y);
+
+}   // End of Dot()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector2::PerpDot()
+//-------------------------------------------------------------------------------
+// Perpendicular dot product by self
+//-------------------------------------------------------------------------------
+IV_INLINE float
+IvVector2::PerpDot( const IvVector2& vector ) const
+{
+    return (x*vector.y - y*vector.x);
+
+}   // End of IvVector2::Dot()
+
+
+//-------------------------------------------------------------------------------
+// @ Dot()
+//-------------------------------------------------------------------------------
+// Dot product friend operator
+//-------------------------------------------------------------------------------
+IV_INLINE float
+PerpDot( const IvVector2& vector1, const IvVector2& vector2 )
+{
+    return (vector1.x*vector2.y - vector1.y*vector2.x);
+
+}   // End of Dot()
+
+#endif
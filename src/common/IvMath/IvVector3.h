@@ -142,6 +142,10 @@ IvVector3::Zero()
     x = y = z = 0.0f;
 }   // End of IvVector3::Zero()
 
+#if defined(IV_INLINE_MATH)
+#include "IvVector3.inl"
+#endif
+
 //-------------------------------------------------------------------------------
 //-- Externs --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
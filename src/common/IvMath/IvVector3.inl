@@ -0,0 +1,350 @@
+//===============================================================================
+// @ IvVector3.inl
+// 
+// 3D vector class inline operators
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// These definitions are compiled into IvMath by default.  If IV_INLINE_MATH
+// is defined they are instead included by IvVector3.h and expanded inline.
+//===============================================================================
+
+#ifndef __IvVector3__inl__
+#define __IvVector3__inl__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvVector3.h"
+#include "IvMath.h"
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::IvVector3()
+//-------------------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3::IvVector3(const IvVector3& other) :
+    x( other.x ),
+    y( other.y ),
+    z( other.z )
+{
+
+}   // End of IvVector3::IvVector3()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::operator=()
+//-------------------------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3&
+IvVector3::operator=(const IvVector3& other)
+{
+    // if same object
+    if ( this == &other )
+        return *this;
+        
+    x = other.x;
+    y = other.y;
+    z = other.z;
+    
+    return *this;
+
+}   // End of IvVector3::operator=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::Length()
+//-------------------------------------------------------------------------------
+// Vector length
+//-------------------------------------------------------------------------------
+IV_INLINE float
+IvVector3::Length() const
+{
+    return IvSqrt( x*x + y*y + z*z );
+
+}   // End of IvVector3::Length()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::LengthSquared()
+//-------------------------------------------------------------------------------
+// Vector length squared (avoids square root)
+//-------------------------------------------------------------------------------
+IV_INLINE float
+IvVector3::LengthSquared() const
+{
+    return (x*x + y*y + z*z);
+
+}   // End of IvVector3::LengthSquared()
+
+
+//-------------------------------------------------------------------------------
+// @ ::Distance()
+//-------------------------------------------------------------------------------
+// Point distance
+//-------------------------------------------------------------------------------
+IV_INLINE float
+Distance( const IvVector3& p0, const IvVector3& p1 )
+{
+    float x = p0.x - p1.x;
+    float y = p0.y - p1.y;
+    float z = p0.z - p1.z;
+
+    return IvSqrt( x*x + y*y + z*z );
+
+}   // End of IvVector3::Length()
+
+
+//-------------------------------------------------------------------------------
+// @ ::DistanceSquared()
+//-------------------------------------------------------------------------------
+// Point distance
+//-------------------------------------------------------------------------------
+IV_INLINE float
+DistanceSquared( const IvVector3& p0, const IvVector3& p1 )
+{
+    float x = p0.x - p1.x;
+    float y = p0.y - p1.y;
+    float z = p0.z - p1.z;
+
+    return ( x*x + y*y + z*z );
+
+}   // End of ::DistanceSquared()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::Normalize()
+//-------------------------------------------------------------------------------
+// Set to unit vector
+//-------------------------------------------------------------------------------
+IV_INLINE void
+IvVector3::Normalize()
+{
+    float lengthsq = x*x + y*y + z*z;
+
+    if ( IvIsZero( lengthsq ) )
+    {
+        Zero();
+    }
+    else
+    {
+        float factor = IvRecipSqrt( lengthsq );
+        x *= factor;
+        y *= factor;
+        z *= factor;
+    }
+
+}   // End of IvVector3::Normalize()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::operator+()
+//-------------------------------------------------------------------------------
+// Add vector to self and return
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvVector3::operator+( const IvVector3& other ) const
+{
+    return IvVector3( x + other.x, y + other.y, z + other.z );
+
+}   // End of IvVector3::operator+()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::operator+=()
+//-------------------------------------------------------------------------------
+// Add vector to self, store in self
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3&
+operator+=( IvVector3& self, const IvVector3& other )
+{
+    self.x += other.x;
+    self.y += other.y;
+    self.z += other.z;
+
+    return self;
+
+}   // End of IvVector3::operator+=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::operator-()
+//-------------------------------------------------------------------------------
+// Subtract vector from self and return
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvVector3::operator-( const IvVector3& other ) const
+{
+    return IvVector3( x - other.x, y - other.y, z - other.z );
+
+}   // End of IvVector3::operator-()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::operator-=()
+//-------------------------------------------------------------------------------
+// Subtract vector from self, store in self
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3&
+operator-=( IvVector3& self, const IvVector3& other )
+{
+    self.x -= other.x;
+    self.y -= other.y;
+    self.z -= other.z;
+
+    return self;
+
+}   // End of IvVector3::operator-=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::operator-=() (unary)
+//-------------------------------------------------------------------------------
+// Negate self and return
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvVector3::operator-() const
+{
+    return IvVector3(-x, -y, -z);
+}    // End of IvVector3::operator-()
+
+
+//-------------------------------------------------------------------------------
+// @ operator*()
+//-------------------------------------------------------------------------------
+// Scalar multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvVector3::operator*( float scalar )
+{
+    return IvVector3( scalar*x, scalar*y, scalar*z );
+
+}   // End of operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ operator*()
+//-------------------------------------------------------------------------------
+// Scalar multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+operator*( float scalar, const IvVector3& vector )
+{
+    return IvVector3( scalar*vector.x, scalar*vector.y, scalar*vector.z );
+
+}   // End of operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::operator*()
+//-------------------------------------------------------------------------------
+// Scalar multiplication by self
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3&
+IvVector3::operator*=( float scalar )
+{
+    x *= scalar;
+    y *= scalar;
+    z *= scalar;
+
+    return *this;
+
+}   // End of IvVector3::operator*=()
+
+
+//-------------------------------------------------------------------------------
+// @ operator/()
+//-------------------------------------------------------------------------------
+// Scalar division
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvVector3::operator/( float scalar )
+{
+    return IvVector3( x/scalar, y/scalar, z/scalar );
+
+}   // End of operator/()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::operator/=()
+//-------------------------------------------------------------------------------
+// Scalar division by self
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3&
+IvVector3::operator/=( float scalar )
+{
+    x /= scalar;
+    y /= scalar;
+    z /= scalar;
+
+    return *this;
+
+}   // End of IvVector3::operator/=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::Dot()
+//-------------------------------------------------------------------------------
+// Dot product by self
+//-------------------------------------------------------------------------------
+IV_INLINE float
+IvVector3::Dot( const IvVector3& vector ) const
+{
+    return (x*vector.x + y*vector.y + z*vector.z);
+
+}   // End of IvVector3::Dot()
+
+
+//-------------------------------------------------------------------------------
+// @ Dot()
+//-------------------------------------------------------------------------------
+// Dot product friend operator
+//-------------------------------------------------------------------------------
+IV_INLINE float
+Dot( const IvVector3& vector1, const IvVector3& vector2 )
+{
+    return (vector1.x*vector2.x + vector1.y*vector2.y + vector1.z*vector2.z);
+
+}   // End of Dot()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector3::Cross()
+//-------------------------------------------------------------------------------
+// Cross product by self
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+IvVector3::Cross( const IvVector3& vector ) const
+{
+    return IvVector3( y*vector.z - z*vector.y,
+                      z*vector.x - x*vector.z,
+                      x*vector.y - y*vector.x );
+
+}   // End of IvVector3::Cross()
+
+
+//-------------------------------------------------------------------------------
+// @ Cross()
+//-------------------------------------------------------------------------------
+// Cross product friend operator
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector3
+Cross( const IvVector3& vector1, const IvVector3& vector2 )
+{
+    return IvVector3( vector1.y*vector2.z - vector1.z*vector2.y,
+                      vector1.z*vector2.x - vector1.x*vector2.z,
+                      vector1.x*vector2.y - vector1.y*vector2.x );
+
+}   // End of Cross()
+
+#endif
@@ -21,6 +21,7 @@
 //-------------------------------------------------------------------------------
 
 #include "IvWriter.h"
+#include "IvSIMD.h"
 
 //-------------------------------------------------------------------------------
 //-- Typedefs, Structs ----------------------------------------------------------
@@ -32,7 +33,8 @@ class IvMatrix44;
 //-- Classes --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
-class IvVector4
+// 16-byte aligned so it can be loaded directly into a SIMD register
+class IV_ALIGN(16) IvVector4
 {
     friend class IvMatrix44;
     
@@ -130,6 +132,10 @@ IvVector4::Zero()
     x = y = z = w = 0.0f;
 }   // End of IvVector4::Zero()
 
+#if defined(IV_INLINE_MATH)
+#include "IvVector4.inl"
+#endif
+
 //-------------------------------------------------------------------------------
 //-- Externs --------------------------------------------------------------------
 //-------------------------------------------------------------------------------
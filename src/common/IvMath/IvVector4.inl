@@ -0,0 +1,284 @@
+//===============================================================================
+// @ IvVector4.inl
+// 
+// 4D vector class inline operators
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// These definitions are compiled into IvMath by default.  If IV_INLINE_MATH
+// is defined they are instead included by IvVector4.h and expanded inline.
+//===============================================================================
+
+#ifndef __IvVector4__inl__
+#define __IvVector4__inl__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvVector4.h"
+#include "IvMath.h"
+
+//-------------------------------------------------------------------------------
+//-- Methods --------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvVector4::IvVector4()
+//-------------------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector4::IvVector4(const IvVector4& other) :
+    x( other.x ),
+    y( other.y ),
+    z( other.z ),
+    w( other.w )
+{
+
+}   // End of IvVector4::IvVector4()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector4::operator=()
+//-------------------------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector4&
+IvVector4::operator=(const IvVector4& other)
+{
+    // if same object
+    if ( this == &other )
+        return *this;
+        
+    x = other.x;
+    y = other.y;
+    z = other.z;
+    w = other.w;
+    
+    return *this;
+
+}   // End of IvVector4::operator=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector4::Length()
+//-------------------------------------------------------------------------------
+// Vector length
+//-------------------------------------------------------------------------------
+IV_INLINE float
+IvVector4::Length() const
+{
+    return IvSqrt( x*x + y*y + z*z + w*w );
+
+}   // End of IvVector4::Length()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector4::LengthSquared()
+//-------------------------------------------------------------------------------
+// Vector length squared (avoids square root)
+//-------------------------------------------------------------------------------
+IV_INLINE float
+IvVector4::LengthSquared() const
+{
+    return ( x*x + y*y + z*z + w*w );
+
+}   // End of IvVector4::LengthSquared()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector4::Normalize()
+//-------------------------------------------------------------------------------
+// Set to unit vector
+//-------------------------------------------------------------------------------
+IV_INLINE void
+IvVector4::Normalize()
+{
+    float lengthsq = x*x + y*y + z*z + w*w;
+
+    if (IvIsZero(lengthsq))
+    {
+        Zero();
+    }
+    else
+    {
+        float factor = IvRecipSqrt(lengthsq);
+        x *= factor;
+        y *= factor;
+        z *= factor;
+        w *= factor;
+    }
+
+}   // End of IvVector4::Normalize()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector4::operator+()
+//-------------------------------------------------------------------------------
+// Add vector to self and return
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector4
+IvVector4::operator+( const IvVector4& other ) const
+{
+    return IvVector4( x + other.x, y + other.y, z + other.z, w + other.w );
+
+}   // End of IvVector4::operator+()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector4::operator+=()
+//-------------------------------------------------------------------------------
+// Add vector to self, store in self
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector4&
+IvVector4::operator+=( const IvVector4& other )
+{
+    x += other.x;
+    y += other.y;
+    z += other.z;
+    w += other.w;
+
+    return *this;
+
+}   // End of IvVector4::operator+=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector4::operator-()
+//-------------------------------------------------------------------------------
+// Subtract vector from self and return
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector4
+IvVector4::operator-( const IvVector4& other ) const
+{
+    return IvVector4( x - other.x, y - other.y, z - other.z, w - other.w );
+
+}   // End of IvVector4::operator-()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector4::operator-=()
+//-------------------------------------------------------------------------------
+// Subtract vector from self, store in self
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector4&
+IvVector4::operator-=( const IvVector4& other )
+{
+    x -= other.x;
+    y -= other.y;
+    z -= other.z;
+    w -= other.w;
+
+    return *this;
+
+}   // End of IvVector4::operator-=()
+
+
+//-------------------------------------------------------------------------------
+// @ operator*()
+//-------------------------------------------------------------------------------
+// Scalar multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector4
+IvVector4::operator*( float scalar )
+{
+    return IvVector4( scalar*x, scalar*y, scalar*z,
+                      scalar*w );
+
+}   // End of operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ operator*()
+//-------------------------------------------------------------------------------
+// Scalar multiplication
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector4
+operator*( float scalar, const IvVector4& vector )
+{
+    return IvVector4( scalar*vector.x, scalar*vector.y, scalar*vector.z,
+                      scalar*vector.w );
+
+}   // End of operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector4::operator*()
+//-------------------------------------------------------------------------------
+// Scalar multiplication by self
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector4&
+IvVector4::operator*=( float scalar )
+{
+    x *= scalar;
+    y *= scalar;
+    z *= scalar;
+    w *= scalar;
+
+    return *this;
+
+}   // End of IvVector4::operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ operator/()
+//-------------------------------------------------------------------------------
+// Scalar division
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector4
+IvVector4::operator/( float scalar )
+{
+    return IvVector4( x/scalar, y/scalar, z/scalar, w/scalar );
+
+}   // End of operator*()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector4::operator/=()
+//-------------------------------------------------------------------------------
+// Scalar division by self
+//-------------------------------------------------------------------------------
+IV_INLINE IvVector4&
+IvVector4::operator/=( float scalar )
+{
+    x /= scalar;
+    y /= scalar;
+    z /= scalar;
+    w /= scalar;
+
+    return *this;
+
+}   // End of IvVector4::operator/=()
+
+
+//-------------------------------------------------------------------------------
+// @ IvVector4::Dot()
+//-------------------------------------------------------------------------------
+// Dot product by self
+//-------------------------------------------------------------------------------
+IV_INLINE float
+IvVector4::Dot( const IvVector4& vector ) const
+{
+    return (x*vector.x + y*vector.y + z*vector.z + w*vector.w);
+
+}   // End of IvVector4::Dot()
+
+
+//-------------------------------------------------------------------------------
+// @ Dot()
+//-------------------------------------------------------------------------------
+// Dot product friend operator
+//-------------------------------------------------------------------------------
+IV_INLINE float
+Dot( const IvVector4& vector1, const IvVector4& vector2 )
+{
+    return (vector1.x*vector2.x + vector1.y*vector2.y + vector1.z*vector2.z
+            + vector1.w*vector2.w);
+
+}   // End of Dot()
+
+#endif
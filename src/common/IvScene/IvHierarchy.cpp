@@ -43,6 +43,7 @@ IvHierarchy::IvHierarchy()
     , mParents(nullptr)
     , mLocalTransforms(nullptr)
     , mWorldTransforms(nullptr)
+    , mWorldMatrices(nullptr)
     , mWorldSpheres(nullptr)
     , mLocalCapsules(nullptr)
     , mWorldCapsules(nullptr)
@@ -61,6 +62,7 @@ IvHierarchy::~IvHierarchy()
     delete[] mParents;
     delete[] mLocalTransforms;
     delete[] mWorldTransforms;
+    delete[] mWorldMatrices;
     delete[] mWorldSpheres;
     delete[] mLocalCapsules;
     delete[] mWorldCapsules;
@@ -85,6 +87,7 @@ bool IvHierarchy::AllocNodes(int count)
     mParents = new unsigned char[count];
     mLocalTransforms = new Transform[count];
     mWorldTransforms = new Transform[count];
+    mWorldMatrices = new IvAffine34[count];
     mWorldSpheres = new IvBoundingSphere[count];
     mLocalCapsules = new IvCapsule[count];
     mWorldCapsules = new IvCapsule[count];
@@ -131,6 +134,9 @@ void IvHierarchy::UpdateWorldTransforms()
     ASSERT(mParents[0] == 0);  // root node should be 0
     mWorldTransforms[0] = mLocalTransforms[0];
     mWorldTransforms[0].mRotate.Normalize();
+    mWorldMatrices[0].Set(mWorldTransforms[0].mScale,
+                          mWorldTransforms[0].mRotate,
+                          mWorldTransforms[0].mTranslate);
     mWorldCapsules[0] = mLocalCapsules[0].Transform(mWorldTransforms[0].mScale,
                                                     mWorldTransforms[0].mRotate,
                                                     mWorldTransforms[0].mTranslate);
@@ -153,6 +159,11 @@ void IvHierarchy::UpdateWorldTransforms()
         mWorldTransforms[i].mRotate = mWorldTransforms[parent].mRotate*mLocalTransforms[i].mRotate;
         mWorldTransforms[i].mRotate.Normalize();
 
+        // build affine matrix once for rendering
+        mWorldMatrices[i].Set(mWorldTransforms[i].mScale,
+                              mWorldTransforms[i].mRotate,
+                              mWorldTransforms[i].mTranslate);
+
         // transform local capsule into world space
         mWorldCapsules[i] = mLocalCapsules[i].Transform(mWorldTransforms[i].mScale,
                                                         mWorldTransforms[i].mRotate,
@@ -183,23 +194,8 @@ void IvHierarchy::Render()
 {
     for (int i = 0; i < mNumNodes; ++i)
     {
-        // build 4x4 matrix
-        IvMatrix44 transform(mWorldTransforms[i].mRotate);
-        transform(0, 0) *= mWorldTransforms[i].mScale;
-        transform(1, 0) *= mWorldTransforms[i].mScale;
-        transform(2, 0) *= mWorldTransforms[i].mScale;
-        transform(0, 1) *= mWorldTransforms[i].mScale;
-        transform(1, 1) *= mWorldTransforms[i].mScale;
-        transform(2, 1) *= mWorldTransforms[i].mScale;
-        transform(0, 2) *= mWorldTransforms[i].mScale;
-        transform(1, 2) *= mWorldTransforms[i].mScale;
-        transform(2, 2) *= mWorldTransforms[i].mScale;
-        transform(0, 3) = mWorldTransforms[i].mTranslate.x;
-        transform(1, 3) = mWorldTransforms[i].mTranslate.y;
-        transform(2, 3) = mWorldTransforms[i].mTranslate.z;
-
         // set current local-to-world matrix
-        IvSetWorldMatrix(transform);
+        IvSetWorldMatrix(IvMatrix44(mWorldMatrices[i]));
 
         mGeometries[i].Render();
 
@@ -21,6 +21,7 @@
 //-- Dependencies ---------------------------------------------------------------
 //-------------------------------------------------------------------------------
 
+#include <IvAffine34.h>
 #include <IvBoundingSphere.h>
 #include <IvQuat.h>
 #include <IvReader.h>
@@ -72,6 +73,7 @@ public:
     inline float GetWorldScale(int i) const { return mWorldTransforms[i].mScale; }
     inline const IvQuat& GetWorldRotate(int i) const { return mWorldTransforms[i].mRotate; }
     inline const IvVector3& GetWorldTranslate(int i) const { return mWorldTransforms[i].mTranslate; }
+    inline const IvAffine34& GetWorldMatrix(int i) const { return mWorldMatrices[i]; }
 
     inline const IvBoundingSphere& GetWorldBoundingSphere(int i) const
     {
@@ -93,6 +95,7 @@ protected:
     unsigned char* mParents;
     Transform*     mLocalTransforms;
     Transform*     mWorldTransforms;
+    IvAffine34*    mWorldMatrices;
 
     IvBoundingSphere* mWorldSpheres;
 
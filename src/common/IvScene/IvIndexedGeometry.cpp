@@ -25,6 +25,7 @@
 #include <IvVertexBuffer.h>
 #include <IvIndexBuffer.h>
 #include <IvCapsule.h>
+#include <IvTriangleMesh.h>
 
 //-------------------------------------------------------------------------------
 //-- Static Members -------------------------------------------------------------
@@ -83,8 +84,12 @@ IvIndexedGeometry::~IvIndexedGeometry()
 // Triangle indices 
 // ...
 //
+// If triangleMesh is non-null, the positions and indices are also copied
+// into it.
+//
 //-------------------------------------------------------------------------------
-bool IvIndexedGeometry::LoadFromStream(IvReader& in, IvCapsule& capsule)
+bool IvIndexedGeometry::LoadFromStream(IvReader& in, IvCapsule& capsule, 
+                                       IvTriangleMesh* triangleMesh)
 {
     // no memory leaks
     ASSERT(mVertices == 0);
@@ -93,6 +98,7 @@ bool IvIndexedGeometry::LoadFromStream(IvReader& in, IvCapsule& capsule)
     IvCNPVertex* dataPtr = 0;  
     IvVector3* tempPosition = 0;
     UInt32* indexPtr = 0;
+    UInt32* tempIndices = 0;
 
     // get number of vertices
     UInt32 numVerts;
@@ -162,6 +168,10 @@ bool IvIndexedGeometry::LoadFromStream(IvReader& in, IvCapsule& capsule)
     mIndices = IvRenderer::mRenderer->GetResourceManager()->CreateIndexBuffer(numIndices,
                                                                               nullptr, kDefaultUsage);
     indexPtr = static_cast<UInt32*>(mIndices->BeginLoadData());
+    if (triangleMesh)
+    {
+        tempIndices = new UInt32[numIndices]; // save for triangle mesh
+    }
     for ( UInt32 i = 0; i < numIndices; ++i )
     {
         in >> indexPtr[i];
@@ -169,6 +179,10 @@ bool IvIndexedGeometry::LoadFromStream(IvReader& in, IvCapsule& capsule)
         {
             goto error_exit;
         }
+        if (tempIndices)
+        {
+            tempIndices[i] = indexPtr[i];
+        }
     }
     if (!mIndices->EndLoadData())
     {
@@ -179,13 +193,21 @@ bool IvIndexedGeometry::LoadFromStream(IvReader& in, IvCapsule& capsule)
     // initialize the model-space capsule to the vertex data
     capsule.Set(tempPosition, numVerts);
 
+    // and the collision mesh
+    if (triangleMesh)
+    {
+        triangleMesh->Set(tempPosition, numVerts, tempIndices, numIndices);
+    }
+
     delete [] tempPosition;
+    delete [] tempIndices;
 
     return true;
 
 error_exit:
     // error cleanup case
     delete [] tempPosition;
+    delete [] tempIndices;
 
     if (dataPtr)
     {
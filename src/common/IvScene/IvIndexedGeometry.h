@@ -24,6 +24,7 @@
 class IvVertexBuffer;
 class IvIndexBuffer;
 class IvCapsule;
+class IvTriangleMesh;
 
 //-------------------------------------------------------------------------------
 //-- Typedefs, Structs ----------------------------------------------------------
@@ -40,7 +41,10 @@ public:
     IvIndexedGeometry();
     ~IvIndexedGeometry();
 
-    bool LoadFromStream(IvReader& in, IvCapsule& boundingCapsule);
+    // if triangleMesh is given, a CPU-side copy of the triangles is kept
+    // there for collision against the mesh itself
+    bool LoadFromStream(IvReader& in, IvCapsule& boundingCapsule, 
+                        IvTriangleMesh* triangleMesh = 0);
     void FreeResources();
 
     void Render();
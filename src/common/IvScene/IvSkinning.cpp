@@ -0,0 +1,273 @@
+//===============================================================================
+// @ IvSkinning.cpp
+//
+// Dual quaternion skinning of vertex arrays on the CPU
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+//===============================================================================
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+#include "IvSkinning.h"
+#include <IvAssert.h>
+#include <IvDualQuat.h>
+#include <IvSIMDMath.h>
+#include <IvVertexFormats.h>
+
+#include <thread>
+#include <vector>
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------
+// @ IvSkinVertex()
+//-------------------------------------------------------------------------------
+// Skin a single vertex
+//-------------------------------------------------------------------------------
+template <class Vertex>
+static inline void
+IvSkinVertex( Vertex& outVertex, const Vertex& inVertex, const IvSkinWeights& skinWeights,
+              const IvDualQuat* bones )
+{
+    IvDualQuat influences[4] = { bones[skinWeights.bones[0]], bones[skinWeights.bones[1]],
+                                 bones[skinWeights.bones[2]], bones[skinWeights.bones[3]] };
+    IvDualQuat blend;
+    Blend( blend, influences, skinWeights.weights, 4 );
+
+    IvVector3 position = blend.TransformPoint( inVertex.position );
+    IvVector3 normal = blend.Transform( inVertex.normal );
+    outVertex = inVertex;
+    outVertex.position = position;
+    outVertex.normal = normal;
+
+}   // End of IvSkinVertex()
+
+
+#if defined(IV_SSE2)
+//-------------------------------------------------------------------------------
+// @ IvBlendBones()
+//-------------------------------------------------------------------------------
+// Weighted sum of a vertex's bones, all on the first bone's hemisphere.
+// The real and dual parts are each one register (w, x, y, z).
+//-------------------------------------------------------------------------------
+static inline void
+IvBlendBones( __m128& real, __m128& dual, const IvSkinWeights& skinWeights,
+              const IvDualQuat* bones )
+{
+    const float* pivot = bones[skinWeights.bones[0]];
+    real = _mm_setzero_ps();
+    dual = _mm_setzero_ps();
+    for (unsigned int j = 0; j < 4; ++j)
+    {
+        const float* bone = bones[skinWeights.bones[j]];
+        float weight = skinWeights.weights[j];
+        if ( pivot[0]*bone[0] + pivot[1]*bone[1] + pivot[2]*bone[2] + pivot[3]*bone[3] < 0.0f )
+            weight = -weight;
+
+        __m128 w = _mm_set1_ps( weight );
+        real = IvMulAdd( w, _mm_loadu_ps( bone ), real );
+        dual = IvMulAdd( w, _mm_loadu_ps( bone + 4 ), dual );
+    }
+
+}   // End of IvBlendBones()
+
+
+//-------------------------------------------------------------------------------
+// @ IvRotate4()
+//-------------------------------------------------------------------------------
+// Rotate four vectors by four unit quaternions, one per lane
+//-------------------------------------------------------------------------------
+static inline void
+IvRotate4( __m128& vx, __m128& vy, __m128& vz,
+           __m128 qw, __m128 qx, __m128 qy, __m128 qz )
+{
+    const __m128 two = _mm_set1_ps( 2.0f );
+    __m128 vMult = IvMul( two, IvMulAdd( qx, vx, IvMulAdd( qy, vy, IvMul( qz, vz ) ) ) );
+    __m128 crossMult = IvMul( two, qw );
+    __m128 pMult = IvSub( IvMul( crossMult, qw ), _mm_set1_ps( 1.0f ) );
+
+    __m128 cx = IvSub( IvMul( qy, vz ), IvMul( qz, vy ) );
+    __m128 cy = IvSub( IvMul( qz, vx ), IvMul( qx, vz ) );
+    __m128 cz = IvSub( IvMul( qx, vy ), IvMul( qy, vx ) );
+
+    vx = IvMulAdd( pMult, vx, IvMulAdd( vMult, qx, IvMul( crossMult, cx ) ) );
+    vy = IvMulAdd( pMult, vy, IvMulAdd( vMult, qy, IvMul( crossMult, cy ) ) );
+    vz = IvMulAdd( pMult, vz, IvMulAdd( vMult, qz, IvMul( crossMult, cz ) ) );
+
+}   // End of IvRotate4()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSkin4()
+//-------------------------------------------------------------------------------
+// Skin four vertices, one per lane
+//-------------------------------------------------------------------------------
+template <class Vertex>
+static inline void
+IvSkin4( Vertex* outVertices, const Vertex* inVertices, const IvSkinWeights* skinWeights,
+         const IvDualQuat* bones )
+{
+    // blend each vertex's bones, then transpose so each lane is a vertex
+    __m128 rw, rx, ry, rz, dw, dx, dy, dz;
+    IvBlendBones( rw, dw, skinWeights[0], bones );
+    IvBlendBones( rx, dx, skinWeights[1], bones );
+    IvBlendBones( ry, dy, skinWeights[2], bones );
+    IvBlendBones( rz, dz, skinWeights[3], bones );
+    _MM_TRANSPOSE4_PS( rw, rx, ry, rz );
+    _MM_TRANSPOSE4_PS( dw, dx, dy, dz );
+
+    // translation is 2*dual*conjugate(real)/|real|^2, using the unnormalized parts
+    __m128 lengthsq = IvMulAdd( rw, rw, IvMulAdd( rx, rx, IvMulAdd( ry, ry, IvMul( rz, rz ) ) ) );
+    __m128 recipLength = IvRecipSqrt( lengthsq );
+    __m128 scale = IvMul( _mm_set1_ps( 2.0f ), IvMul( recipLength, recipLength ) );
+    __m128 tx = IvMul( scale, IvSub( IvSub( IvMul( rw, dx ), IvMul( dw, rx ) ),
+                                     IvSub( IvMul( rz, dy ), IvMul( ry, dz ) ) ) );
+    __m128 ty = IvMul( scale, IvSub( IvSub( IvMul( rw, dy ), IvMul( dw, ry ) ),
+                                     IvSub( IvMul( rx, dz ), IvMul( rz, dx ) ) ) );
+    __m128 tz = IvMul( scale, IvSub( IvSub( IvMul( rw, dz ), IvMul( dw, rz ) ),
+                                     IvSub( IvMul( ry, dx ), IvMul( rx, dy ) ) ) );
+
+    rw = IvMul( rw, recipLength );
+    rx = IvMul( rx, recipLength );
+    ry = IvMul( ry, recipLength );
+    rz = IvMul( rz, recipLength );
+
+    const Vertex* v = inVertices;
+    __m128 px = _mm_setr_ps( v[0].position.x, v[1].position.x, v[2].position.x, v[3].position.x );
+    __m128 py = _mm_setr_ps( v[0].position.y, v[1].position.y, v[2].position.y, v[3].position.y );
+    __m128 pz = _mm_setr_ps( v[0].position.z, v[1].position.z, v[2].position.z, v[3].position.z );
+    __m128 nx = _mm_setr_ps( v[0].normal.x, v[1].normal.x, v[2].normal.x, v[3].normal.x );
+    __m128 ny = _mm_setr_ps( v[0].normal.y, v[1].normal.y, v[2].normal.y, v[3].normal.y );
+    __m128 nz = _mm_setr_ps( v[0].normal.z, v[1].normal.z, v[2].normal.z, v[3].normal.z );
+
+    IvRotate4( px, py, pz, rw, rx, ry, rz );
+    IvRotate4( nx, ny, nz, rw, rx, ry, rz );
+    px = IvAdd( px, tx );
+    py = IvAdd( py, ty );
+    pz = IvAdd( pz, tz );
+
+    IV_ALIGN(16) float position[12];
+    IV_ALIGN(16) float normal[12];
+    IvStore( position, px );
+    IvStore( position + 4, py );
+    IvStore( position + 8, pz );
+    IvStore( normal, nx );
+    IvStore( normal + 4, ny );
+    IvStore( normal + 8, nz );
+    for (unsigned int k = 0; k < 4; ++k)
+    {
+        if ( outVertices != inVertices )
+            outVertices[k] = inVertices[k];
+        outVertices[k].position.Set( position[k], position[k + 4], position[k + 8] );
+        outVertices[k].normal.Set( normal[k], normal[k + 4], normal[k + 8] );
+    }
+
+}   // End of IvSkin4()
+#endif
+
+
+//-------------------------------------------------------------------------------
+// @ IvSkinRange()
+//-------------------------------------------------------------------------------
+// Skin vertices [begin, end)
+//-------------------------------------------------------------------------------
+template <class Vertex>
+static void
+IvSkinRange( Vertex* outVertices, const Vertex* inVertices, const IvSkinWeights* skinWeights,
+             unsigned int begin, unsigned int end, const IvDualQuat* bones )
+{
+    unsigned int i = begin;
+#if defined(IV_SSE2)
+    for ( ; i + 4 <= end; i += 4)
+    {
+        IvSkin4( outVertices + i, inVertices + i, skinWeights + i, bones );
+    }
+#endif
+    for ( ; i < end; ++i)
+    {
+        IvSkinVertex( outVertices[i], inVertices[i], skinWeights[i], bones );
+    }
+
+}   // End of IvSkinRange()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSkinThreaded()
+//-------------------------------------------------------------------------------
+// Split the vertex array into one block per thread.  Each vertex is written
+// by exactly one thread, so the result doesn't depend on the thread count.
+//-------------------------------------------------------------------------------
+template <class Vertex>
+static void
+IvSkinThreaded( Vertex* outVertices, const Vertex* inVertices, const IvSkinWeights* skinWeights,
+                unsigned int count, const IvDualQuat* bones, unsigned int numThreads )
+{
+    ASSERT( outVertices && inVertices && skinWeights && bones );
+
+    if ( numThreads < 1 )
+        numThreads = 1;
+    // keep blocks a multiple of the SIMD width
+    unsigned int blockSize = (((count + numThreads - 1)/numThreads) + 3) & ~3u;
+    if ( numThreads == 1 || blockSize >= count )
+    {
+        IvSkinRange( outVertices, inVertices, skinWeights, 0, count, bones );
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    unsigned int begin = blockSize;
+    for ( ; begin < count; begin += blockSize)
+    {
+        unsigned int end = (begin + blockSize < count) ? begin + blockSize : count;
+        workers.push_back( std::thread( IvSkinRange<Vertex>, outVertices, inVertices,
+                                        skinWeights, begin, end, bones ) );
+    }
+
+    // first block on the calling thread
+    IvSkinRange( outVertices, inVertices, skinWeights, 0, blockSize, bones );
+
+    for (unsigned int t = 0; t < workers.size(); ++t)
+    {
+        workers[t].join();
+    }
+
+}   // End of IvSkinThreaded()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSkinVertices()
+//-------------------------------------------------------------------------------
+// Skin color/normal/position vertices
+//-------------------------------------------------------------------------------
+void
+IvSkinVertices( IvCNPVertex* outVertices, const IvCNPVertex* inVertices,
+                const IvSkinWeights* skinWeights, unsigned int count,
+                const IvDualQuat* bones, unsigned int numThreads )
+{
+    IvSkinThreaded( outVertices, inVertices, skinWeights, count, bones, numThreads );
+
+}   // End of IvSkinVertices()
+
+
+//-------------------------------------------------------------------------------
+// @ IvSkinVertices()
+//-------------------------------------------------------------------------------
+// Skin texture/normal/position vertices
+//-------------------------------------------------------------------------------
+void
+IvSkinVertices( IvTNPVertex* outVertices, const IvTNPVertex* inVertices,
+                const IvSkinWeights* skinWeights, unsigned int count,
+                const IvDualQuat* bones, unsigned int numThreads )
+{
+    IvSkinThreaded( outVertices, inVertices, skinWeights, count, bones, numThreads );
+
+}   // End of IvSkinVertices()
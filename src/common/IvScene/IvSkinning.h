@@ -0,0 +1,57 @@
+//===============================================================================
+// @ IvSkinning.h
+//
+// Dual quaternion skinning of vertex arrays on the CPU
+// ------------------------------------------------------------------------------
+// Copyright (C) 2008-2015 by James M. Van Verth and Lars M. Bishop.
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Each vertex is bound to up to four bones.  The bone transforms are blended
+// as dual quaternions, which keeps the result rigid and avoids the collapsing
+// joints of blended matrices.  The skinning routines only read the bone and
+// bind data, so the vertex array can be split across threads.
+//
+//===============================================================================
+
+#ifndef __IvSkinning__h__
+#define __IvSkinning__h__
+
+//-------------------------------------------------------------------------------
+//-- Dependencies ---------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+class IvDualQuat;
+struct IvCNPVertex;
+struct IvTNPVertex;
+
+//-------------------------------------------------------------------------------
+//-- Typedefs, Structs ----------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// bone influences for one vertex
+// unused influences should have zero weight; weights should sum to 1
+struct IvSkinWeights
+{
+    unsigned char bones[4];
+    float weights[4];
+};
+
+//-------------------------------------------------------------------------------
+//-- Functions ------------------------------------------------------------------
+//-------------------------------------------------------------------------------
+
+// transform count bind pose vertices by their blended bone transforms
+// outVertices may be the same array as inVertices
+// other attributes are copied; positions and normals are skinned
+// work is split across numThreads threads, including the calling one
+void IvSkinVertices( IvCNPVertex* outVertices, const IvCNPVertex* inVertices,
+                     const IvSkinWeights* skinWeights, unsigned int count,
+                     const IvDualQuat* bones, unsigned int numThreads = 1 );
+void IvSkinVertices( IvTNPVertex* outVertices, const IvTNPVertex* inVertices,
+                     const IvSkinWeights* skinWeights, unsigned int count,
+                     const IvDualQuat* bones, unsigned int numThreads = 1 );
+
+#endif